@@ -9,12 +9,16 @@ in vec3 TangentFragPos;
 
 out vec4 FragColor;
 
+uniform mat4 view;
+uniform mat4 projection;
 uniform vec3 lightPos;
 uniform vec3 lightColor;
 uniform vec3 viewPos;
 uniform vec3 planetColor;
 uniform float planetSeed;
 
+#include "lights.glsl"
+
 // Noise functions for procedural textures
 float hash(vec2 p) {
     return fract(sin(dot(p, vec2(127.1, 311.7))) * 43758.5453);
@@ -125,6 +129,7 @@ void main() {
     // Add slight rim lighting for better visibility
     vec3 worldNormal = normalize(Normal);
     vec3 worldViewDir = normalize(viewPos - FragPos);
+    result += getClusteredLighting(FragPos, worldNormal, worldViewDir, albedo, 0.1, 16.0);
     float rim = 1.0 - max(dot(worldNormal, worldViewDir), 0.0);
     rim = pow(rim, 3.0);
     result += rim * lightColor * 0.1;
@@ -0,0 +1,45 @@
+// Clustered point lights (see LightClusters and ClusteredLighting), shared by lit fragment shaders.
+// The including shader must also declare the view and projection matrices.
+#ifndef LIGHTS_GLSL
+#define LIGHTS_GLSL
+
+uniform samplerBuffer clusterLightData; // Two texels per light: (position, radius), (color, 0)
+uniform usamplerBuffer clusterRanges;   // Per cluster: first index, light count
+uniform usamplerBuffer clusterIndices;  // Light indices of every cluster, back to back
+uniform vec3 clusterGrid;               // Screen tiles across, tiles down, depth slices
+uniform float clusterNearPlane;
+uniform float clusterSliceScale;        // Slices / log(far / near)
+
+// Diffuse and Blinn-Phong specular from every point light whose range covers the fragment
+vec3 getClusteredLighting(vec3 fragPos, vec3 normal, vec3 viewDir, vec3 albedo, float specularStrength, float shininess) {
+    vec4 clip = projection * view * vec4(fragPos, 1.0);
+    if (clip.w <= clusterNearPlane) {
+        return vec3(0.0);
+    }
+    ivec3 grid = ivec3(clusterGrid);
+    ivec2 tile = clamp(ivec2((clip.xy / clip.w * 0.5 + 0.5) * vec2(grid.xy)), ivec2(0), grid.xy - 1);
+    int slice = clamp(int(log(clip.w / clusterNearPlane) * clusterSliceScale), 0, grid.z - 1);
+    uvec2 range = texelFetch(clusterRanges, (slice * grid.y + tile.y) * grid.x + tile.x).xy;
+    
+    vec3 result = vec3(0.0);
+    for (uint i = 0u; i < range.y; ++i) {
+        int light = int(texelFetch(clusterIndices, int(range.x + i)).x);
+        vec4 positionRadius = texelFetch(clusterLightData, light * 2);
+        vec3 color = texelFetch(clusterLightData, light * 2 + 1).rgb;
+        
+        vec3 toLight = positionRadius.xyz - fragPos;
+        float distanceSquared = dot(toLight, toLight);
+        // Inverse square falloff, windowed to reach zero at the light's radius
+        float window = clamp(1.0 - distanceSquared * distanceSquared /
+                             (positionRadius.w * positionRadius.w * positionRadius.w * positionRadius.w), 0.0, 1.0);
+        float attenuation = window * window / (1.0 + distanceSquared);
+        
+        vec3 lightDir = toLight * inversesqrt(max(distanceSquared, 1e-8));
+        float diff = max(dot(normal, lightDir), 0.0);
+        float spec = pow(max(dot(normal, normalize(lightDir + viewDir)), 0.0), shininess) * specularStrength;
+        result += (diff * albedo + spec) * color * attenuation;
+    }
+    return result;
+}
+
+#endif
@@ -10,7 +10,7 @@ in float ParticleSize;
 
 // Uniforms
 uniform float time;
-uniform int particleType; // 0: solar flare, 1: cosmic dust, 2: stellar wind, 3: corona
+// Particle type is compiled in, see particle.vert
 uniform vec3 viewPos;
 uniform float globalIntensity;
 
@@ -90,46 +90,46 @@ void main()
     float shape = createParticleShape(uv);
     
     // Apply particle type-specific effects
-    if (particleType == 0) { // Solar flare
-        // Intense, flickering energy
-        float energy = createEnergyField(uv, time * 2.0);
-        float flicker = 0.8 + 0.2 * sin(time * 10.0 + WorldPos.x);
-        
-        finalColor = mix(vec3(1.0, 0.3, 0.1), vec3(1.0, 0.8, 0.2), energy);
-        finalColor *= (1.0 + energy * 0.5) * flicker;
-        finalAlpha *= (1.0 - Life * 0.3); // Fade over time
-        
-    } else if (particleType == 1) { // Cosmic dust
-        // Subtle, twinkling particles
-        float twinkle = 0.7 + 0.3 * sin(time * 3.0 + WorldPos.y);
-        float dustNoise = noise(uv * 8.0 + time * 0.1);
-        
-        finalColor = vec3(0.6, 0.7, 0.9) * (0.5 + dustNoise * 0.5);
-        finalColor *= twinkle;
-        finalAlpha *= (0.3 + Life * 0.4); // Grow brighter over time
-        
-    } else if (particleType == 2) { // Stellar wind
-        // Fast-moving, streaky particles
-        float speed = length(ViewDir);
-        float streak = 1.0 + speed * 0.5;
-        
-        // Create elongated shape for motion blur
-        vec2 stretchedUV = uv;
-        stretchedUV.x *= (1.0 + speed * 0.3);
-        shape = createParticleShape(stretchedUV);
-        
-        finalColor = vec3(0.8, 0.9, 1.0) * streak;
-        finalAlpha *= (1.0 - Life * 0.7); // Quick fade
-        
-    } else if (particleType == 3) { // Corona
-        // Glowing, pulsing corona particles
-        float pulse = 0.6 + 0.4 * sin(time * 1.5 + WorldPos.z);
-        float corona = createEnergyField(uv, time * 0.8);
-        
-        finalColor = calculateTemperatureColor(6000.0 + corona * 2000.0);
-        finalColor *= pulse * (1.0 + corona * 0.3);
-        finalAlpha *= (0.8 - Life * 0.2); // Slow fade
-    }
+#if defined(PARTICLE_COSMIC_DUST)
+    // Subtle, twinkling particles
+    float twinkle = 0.7 + 0.3 * sin(time * 3.0 + WorldPos.y);
+    float dustNoise = noise(uv * 8.0 + time * 0.1);
+    
+    finalColor = vec3(0.6, 0.7, 0.9) * (0.5 + dustNoise * 0.5);
+    finalColor *= twinkle;
+    finalAlpha *= (0.3 + Life * 0.4); // Grow brighter over time
+    
+#elif defined(PARTICLE_STELLAR_WIND)
+    // Fast-moving, streaky particles
+    float speed = length(ViewDir);
+    float streak = 1.0 + speed * 0.5;
+    
+    // Create elongated shape for motion blur
+    vec2 stretchedUV = uv;
+    stretchedUV.x *= (1.0 + speed * 0.3);
+    shape = createParticleShape(stretchedUV);
+    
+    finalColor = vec3(0.8, 0.9, 1.0) * streak;
+    finalAlpha *= (1.0 - Life * 0.7); // Quick fade
+    
+#elif defined(PARTICLE_CORONA)
+    // Glowing, pulsing corona particles
+    float pulse = 0.6 + 0.4 * sin(time * 1.5 + WorldPos.z);
+    float corona = createEnergyField(uv, time * 0.8);
+    
+    finalColor = calculateTemperatureColor(6000.0 + corona * 2000.0);
+    finalColor *= pulse * (1.0 + corona * 0.3);
+    finalAlpha *= (0.8 - Life * 0.2); // Slow fade
+    
+#else // Solar flare
+    // Intense, flickering energy
+    float energy = createEnergyField(uv, time * 2.0);
+    float flicker = 0.8 + 0.2 * sin(time * 10.0 + WorldPos.x);
+    
+    finalColor = mix(vec3(1.0, 0.3, 0.1), vec3(1.0, 0.8, 0.2), energy);
+    finalColor *= (1.0 + energy * 0.5) * flicker;
+    finalAlpha *= (1.0 - Life * 0.3); // Fade over time
+#endif
     
     // Apply distance-based fading
     float distanceToCamera = length(viewPos - WorldPos);
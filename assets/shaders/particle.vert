@@ -15,7 +15,8 @@ uniform mat4 view;
 uniform mat4 projection;
 uniform vec3 viewPos;
 uniform float time;
-uniform int particleType; // 0: solar flare, 1: cosmic dust, 2: stellar wind, 3: corona
+// Particle type is compiled in: PARTICLE_SOLAR_FLARE (default), PARTICLE_COSMIC_DUST,
+// PARTICLE_STELLAR_WIND or PARTICLE_CORONA (see ParticleSystem::getShaderVariantSymbols)
 
 // Outputs to fragment shader
 out vec2 TexCoord;
@@ -39,17 +40,16 @@ void main()
     vec3 cameraUp = vec3(view[0][1], view[1][1], view[2][1]);
     
     // Apply size scaling based on particle type and life
-    float sizeMultiplier = 1.0;
-    if (particleType == 0) { // Solar flare
-        sizeMultiplier = 1.0 + sin(time * 3.0 + particlePos.x) * 0.3;
-        sizeMultiplier *= (1.0 - particleLife * 0.5); // Shrink over time
-    } else if (particleType == 1) { // Cosmic dust
-        sizeMultiplier = 0.5 + particleLife * 0.5; // Grow over time
-    } else if (particleType == 2) { // Stellar wind
-        sizeMultiplier = 1.0 - particleLife * 0.8; // Fade and shrink
-    } else if (particleType == 3) { // Corona
-        sizeMultiplier = 1.0 + sin(time * 2.0 + particlePos.y) * 0.4;
-    }
+#if defined(PARTICLE_COSMIC_DUST)
+    float sizeMultiplier = 0.5 + particleLife * 0.5; // Grow over time
+#elif defined(PARTICLE_STELLAR_WIND)
+    float sizeMultiplier = 1.0 - particleLife * 0.8; // Fade and shrink
+#elif defined(PARTICLE_CORONA)
+    float sizeMultiplier = 1.0 + sin(time * 2.0 + particlePos.y) * 0.4;
+#else // Solar flare
+    float sizeMultiplier = 1.0 + sin(time * 3.0 + particlePos.x) * 0.3;
+    sizeMultiplier *= (1.0 - particleLife * 0.5); // Shrink over time
+#endif
     
     float finalSize = particleSize * sizeMultiplier;
     
@@ -59,9 +59,9 @@ void main()
                    cameraUp * aPos.y * finalSize;
     
     // Apply some movement based on velocity for trailing effect
-    if (particleType == 0 || particleType == 2) { // Solar flare or stellar wind
-        worldPos += particleVel * aPos.z * 0.1; // Use Z for trailing
-    }
+#if !defined(PARTICLE_COSMIC_DUST) && !defined(PARTICLE_CORONA) // Solar flare or stellar wind
+    worldPos += particleVel * aPos.z * 0.1; // Use Z for trailing
+#endif
     
     // Transform to clip space
     gl_Position = projection * view * vec4(worldPos, 1.0);
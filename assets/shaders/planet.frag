@@ -9,167 +9,167 @@ in vec3 TangentFragPos;
 
 out vec4 FragColor;
 
+uniform mat4 view;
+uniform mat4 projection;
 uniform vec3 lightPos;
 uniform vec3 lightColor;
 uniform vec3 viewPos;
 uniform vec3 planetColor;
-uniform float planetSeed;
-uniform int planetType; // 0=rocky, 1=gas, 2=ice, 3=desert
 uniform float lightIntensity;
 
-// Noise functions for procedural textures
-float hash(vec2 p) {
-    return fract(sin(dot(p, vec2(127.1, 311.7))) * 43758.5453);
-}
+#include "lights.glsl"
 
-float noise(vec2 p) {
-    vec2 i = floor(p);
-    vec2 f = fract(p);
-    f = f * f * (3.0 - 2.0 * f);
-    
-    float a = hash(i);
-    float b = hash(i + vec2(1.0, 0.0));
-    float c = hash(i + vec2(0.0, 1.0));
-    float d = hash(i + vec2(1.0, 1.0));
-    
-    return mix(mix(a, b, f.x), mix(c, d, f.x), f.y);
+// Surface maps baked once per planet on the CPU (see PlanetSurface)
+uniform sampler2D albedoMap; // rgb albedo, a roughness
+uniform sampler2D normalMap; // rgb tangent-space normal, a height
+
+#ifdef PLANET_BIOMES
+// Biome indices baked per planet on the CPU (see PlanetBiomes), looked up in the palette
+in vec3 SurfaceDir;
+uniform samplerCube biomeMap;   // r biome index / 255, nearest filtered
+uniform vec4 biomePalette[16];  // rgb albedo, a roughness
+uniform float biomeMapSize;     // Texels per face edge
+
+vec4 getBiomeTexel(vec3 major, vec3 sAxis, vec3 tAxis, vec2 texel) {
+    vec2 st = (texel + 0.5) / biomeMapSize * 2.0 - 1.0;
+    float index = textureLod(biomeMap, major + sAxis * st.x + tAxis * st.y, 0.0).r * 255.0;
+    return biomePalette[clamp(int(index + 0.5), 0, 15)];
 }
 
-float fbm(vec2 p) {
-    float value = 0.0;
-    float amplitude = 0.5;
-    float frequency = 1.0;
-    
-    for(int i = 0; i < 6; i++) {
-        value += amplitude * noise(p * frequency);
-        amplitude *= 0.5;
-        frequency *= 2.0;
+// Indices cannot be filtered, so the palette entries of the four nearest texels
+// are blended instead; taps stay on the face, which only shows at face edges
+vec4 getBiome(vec3 direction) {
+    // Face axes of the GL cubemap layout, as in CubeFace.hpp
+    vec3 a = abs(direction);
+    vec3 major;
+    vec3 sAxis;
+    vec3 tAxis;
+    if (a.x >= a.y && a.x >= a.z) {
+        major = vec3(sign(direction.x), 0.0, 0.0);
+        sAxis = vec3(0.0, 0.0, -major.x);
+        tAxis = vec3(0.0, -1.0, 0.0);
+    } else if (a.y >= a.z) {
+        major = vec3(0.0, sign(direction.y), 0.0);
+        sAxis = vec3(1.0, 0.0, 0.0);
+        tAxis = vec3(0.0, 0.0, major.y);
+    } else {
+        major = vec3(0.0, 0.0, sign(direction.z));
+        sAxis = vec3(major.z, 0.0, 0.0);
+        tAxis = vec3(0.0, -1.0, 0.0);
     }
-    return value;
+    vec3 onFace = direction / dot(direction, major);
+    vec2 texel = clamp((vec2(dot(onFace, sAxis), dot(onFace, tAxis)) * 0.5 + 0.5) * biomeMapSize - 0.5,
+                       0.0, biomeMapSize - 1.0);
+    vec2 base = min(floor(texel), biomeMapSize - 2.0);
+    vec2 f = texel - base;
+    vec4 lower = mix(getBiomeTexel(major, sAxis, tAxis, base),
+                     getBiomeTexel(major, sAxis, tAxis, base + vec2(1.0, 0.0)), f.x);
+    vec4 upper = mix(getBiomeTexel(major, sAxis, tAxis, base + vec2(0.0, 1.0)),
+                     getBiomeTexel(major, sAxis, tAxis, base + vec2(1.0, 1.0)), f.x);
+    return mix(lower, upper, f.y);
 }
+#endif
 
-// Generate procedural normal map
-vec3 generateNormalMap(vec2 uv, float seed, int type) {
-    vec2 p = uv * 16.0 + seed;
-    float offset = 0.001;
-    
-    // Sample height at current position and neighbors
-    float h = fbm(p);
-    float hx = fbm(p + vec2(offset, 0.0));
-    float hy = fbm(p + vec2(0.0, offset));
-    
-    // Calculate normal from height differences
-    vec3 normal;
-    normal.x = (h - hx) / offset;
-    normal.y = (h - hy) / offset;
-    normal.z = 1.0;
-    
-    // Adjust normal strength based on planet type
-    float strength = 1.0;
-    if(type == 0) strength = 2.0;      // Rocky - strong normals
-    else if(type == 1) strength = 0.5; // Gas - smooth normals
-    else if(type == 2) strength = 1.5; // Ice - medium normals
-    else strength = 1.8;               // Desert - strong normals
-    
-    normal.xy *= strength;
-    return normalize(normal);
+#ifdef PLANET_ATMOSPHERE
+// Precomputed scattering tables of the planet's atmosphere (see AtmosphereTables); distances
+// below are in planet radii with the planet at the origin, so the ground is at r = 1
+uniform sampler2D transmittanceTable; // left half view rays to the ground, right half sun rays
+uniform sampler2D scatteringTable;    // rgb Rayleigh, a red Mie in-scatter
+uniform vec3 planetCenter;
+uniform float planetRadius;
+uniform float atmosphereTop;
+uniform vec3 rayleighScattering;
+uniform float mieG;
+
+// Table layout and parametrizations, mirrored from AtmosphereTables
+const float TRANSMITTANCE_R = 32.0;
+const float TRANSMITTANCE_MU = 64.0;
+const float SCATTERING_R = 16.0;
+const float SCATTERING_MU = 32.0;
+const float SCATTERING_MU_S = 32.0;
+const float SCATTERING_NU = 8.0;
+const float MU_S_MIN = -0.2;
+
+// Tables are not physical radiance at solar system scale; brings the sky up to the surface lighting
+const float ATMOSPHERE_SUN_INTENSITY = 12.0;
+const float PI = 3.14159265;
+
+float radiusToUnit(float r) {
+    return clamp(sqrt(max(r * r - 1.0, 0.0)) / sqrt(atmosphereTop * atmosphereTop - 1.0), 0.0, 1.0);
 }
 
-// Calculate atmospheric glow effect
-vec3 calculateAtmosphere(vec3 normal, vec3 viewDir, int type) {
-    float fresnel = 1.0 - max(dot(normal, viewDir), 0.0);
-    fresnel = pow(fresnel, 2.0);
-    
-    vec3 atmosphereColor;
-    float intensity;
-    
-    if(type == 0) { // Rocky planet - blue atmosphere
-        atmosphereColor = vec3(0.4, 0.7, 1.0);
-        intensity = 0.3;
-    }
-    else if(type == 1) { // Gas giant - colorful atmosphere
-        atmosphereColor = vec3(1.0, 0.8, 0.4);
-        intensity = 0.5;
-    }
-    else if(type == 2) { // Ice planet - pale blue atmosphere
-        atmosphereColor = vec3(0.8, 0.9, 1.0);
-        intensity = 0.2;
-    }
-    else { // Desert planet - orange atmosphere
-        atmosphereColor = vec3(1.0, 0.6, 0.3);
-        intensity = 0.25;
-    }
-    
-    return atmosphereColor * fresnel * intensity;
+float viewMuToUnit(float r, float mu) {
+    float rho = sqrt(max(r * r - 1.0, 0.0));
+    float dMin = r - 1.0;
+    float d = max(-r * mu - sqrt(max(r * r * (mu * mu - 1.0) + 1.0, 0.0)), 0.0);
+    return clamp((d - dMin) / max(rho - dMin, 1e-6), 0.0, 1.0);
 }
 
-vec3 generatePlanetTexture(vec2 uv, float seed, int type) {
-    vec2 p = uv * 8.0 + seed;
-    
-    if(type == 0) { // Rocky planet
-        float continents = fbm(p * 0.5);
-        float mountains = fbm(p * 2.0) * 0.3;
-        float detail = fbm(p * 8.0) * 0.1;
-        
-        float height = continents + mountains + detail;
-        
-        vec3 ocean = vec3(0.1, 0.3, 0.8);
-        vec3 land = vec3(0.4, 0.6, 0.2);
-        vec3 mountain = vec3(0.6, 0.5, 0.4);
-        vec3 snow = vec3(0.9, 0.9, 0.95);
-        
-        vec3 color = mix(ocean, land, smoothstep(0.3, 0.4, height));
-        color = mix(color, mountain, smoothstep(0.6, 0.7, height));
-        color = mix(color, snow, smoothstep(0.8, 0.9, height));
-        
-        return color;
-    }
-    else if(type == 1) { // Gas giant
-        float bands = sin(uv.y * 20.0 + fbm(p) * 2.0) * 0.5 + 0.5;
-        float storms = fbm(p * 3.0);
-        
-        vec3 color1 = vec3(0.8, 0.6, 0.3);
-        vec3 color2 = vec3(0.9, 0.7, 0.4);
-        vec3 storm = vec3(0.9, 0.4, 0.2);
-        
-        vec3 color = mix(color1, color2, bands);
-        color = mix(color, storm, smoothstep(0.7, 0.8, storms));
-        
-        return color;
-    }
-    else if(type == 2) { // Ice planet
-        float cracks = fbm(p * 4.0);
-        float ice = fbm(p * 1.0);
-        
-        vec3 ice_color = vec3(0.8, 0.9, 1.0);
-        vec3 deep_ice = vec3(0.6, 0.8, 0.9);
-        vec3 crack_color = vec3(0.3, 0.4, 0.6);
-        
-        vec3 color = mix(deep_ice, ice_color, ice);
-        color = mix(color, crack_color, smoothstep(0.6, 0.7, cracks));
-        
-        return color;
-    }
-    else { // Desert planet
-        float dunes = fbm(p * 2.0);
-        float rocks = fbm(p * 6.0);
-        
-        vec3 sand = vec3(0.8, 0.7, 0.4);
-        vec3 dark_sand = vec3(0.6, 0.5, 0.3);
-        vec3 rock = vec3(0.5, 0.4, 0.3);
-        
-        vec3 color = mix(dark_sand, sand, dunes);
-        color = mix(color, rock, smoothstep(0.7, 0.8, rocks));
-        
-        return color;
-    }
+float sunMuToUnit(float muS) {
+    return clamp((muS - MU_S_MIN) / (1.0 - MU_S_MIN), 0.0, 1.0);
+}
+
+// Texel center coordinate of a unit parameter across n texels
+float unitToTexel(float u, float n) {
+    return 0.5 + u * (n - 1.0);
+}
+
+vec3 getViewTransmittance(float r, float mu) {
+    vec2 uv = vec2(unitToTexel(viewMuToUnit(r, mu), TRANSMITTANCE_MU) / (2.0 * TRANSMITTANCE_MU),
+                   unitToTexel(radiusToUnit(r), TRANSMITTANCE_R) / TRANSMITTANCE_R);
+    return texture(transmittanceTable, uv).rgb;
+}
+
+vec3 getSunTransmittance(float r, float muS) {
+    vec2 uv = vec2((TRANSMITTANCE_MU + unitToTexel(sunMuToUnit(muS), TRANSMITTANCE_MU)) / (2.0 * TRANSMITTANCE_MU),
+                   unitToTexel(radiusToUnit(r), TRANSMITTANCE_R) / TRANSMITTANCE_R);
+    return texture(transmittanceTable, uv).rgb;
+}
+
+// The 4D table is a 2D atlas: filtering covers view and sun zenith inside a block,
+// altitude and view-sun angle are blended between neighbouring blocks here
+vec4 getScattering(float r, float mu, float muS, float nu) {
+    float rCoord = radiusToUnit(r) * (SCATTERING_R - 1.0);
+    float nuCoord = clamp(nu * 0.5 + 0.5, 0.0, 1.0) * (SCATTERING_NU - 1.0);
+    float r0 = min(floor(rCoord), SCATTERING_R - 2.0);
+    float nu0 = min(floor(nuCoord), SCATTERING_NU - 2.0);
+    float muTexel = unitToTexel(viewMuToUnit(r, mu), SCATTERING_MU);
+    float muSTexel = unitToTexel(sunMuToUnit(muS), SCATTERING_MU_S);
+
+    vec2 atlasSize = vec2(SCATTERING_MU_S * SCATTERING_NU, SCATTERING_MU * SCATTERING_R);
+    vec2 uv00 = vec2(nu0 * SCATTERING_MU_S + muSTexel, r0 * SCATTERING_MU + muTexel) / atlasSize;
+    vec2 nuStep = vec2(SCATTERING_MU_S / atlasSize.x, 0.0);
+    vec2 rStep = vec2(0.0, SCATTERING_MU / atlasSize.y);
+
+    vec4 lower = mix(texture(scatteringTable, uv00), texture(scatteringTable, uv00 + nuStep), nuCoord - nu0);
+    vec4 upper = mix(texture(scatteringTable, uv00 + rStep), texture(scatteringTable, uv00 + rStep + nuStep), nuCoord - nu0);
+    return mix(lower, upper, rCoord - r0);
+}
+
+float rayleighPhase(float nu) {
+    return 3.0 / (16.0 * PI) * (1.0 + nu * nu);
+}
+
+float miePhase(float nu) {
+    float g2 = mieG * mieG;
+    return 3.0 / (8.0 * PI) * (1.0 - g2) * (1.0 + nu * nu) /
+           ((2.0 + g2) * pow(max(1.0 + g2 - 2.0 * mieG * nu, 1e-4), 1.5));
 }
+#endif
 
 void main()
 {
-    // Generate procedural planet texture and normal map
-    vec3 surfaceColor = generatePlanetTexture(TexCoord, planetSeed, planetType);
-    vec3 normalMap = generateNormalMap(TexCoord, planetSeed, planetType);
+    // Baked planet texture and normal map
+    vec4 albedo = texture(albedoMap, TexCoord);
+    vec3 surfaceColor = albedo.rgb;
+    float roughness = albedo.a;
+#ifdef PLANET_BIOMES
+    // Biomes decide the color and roughness; the baked albedo only adds detail through its brightness
+    vec4 biome = getBiome(SurfaceDir);
+    surfaceColor = biome.rgb * (0.7 + 0.6 * dot(albedo.rgb, vec3(0.2126, 0.7152, 0.0722)));
+    roughness = biome.a;
+#endif
+    vec3 surfaceNormal = normalize(texture(normalMap, TexCoord).rgb * 2.0 - 1.0);
     
     // Use normal mapping for enhanced surface detail
     vec3 lightDir = normalize(TangentLightPos - TangentFragPos);
@@ -184,23 +184,55 @@ void main()
     vec3 ambient = ambientStrength * lightColor * attenuation;
     
     // Diffuse lighting with normal mapping and dynamic intensity
-    float diff = max(dot(normalMap, lightDir), 0.0);
+    float diff = max(dot(surfaceNormal, lightDir), 0.0);
     vec3 diffuse = diff * lightColor * lightIntensity * attenuation;
     
-    // Specular lighting with normal mapping and dynamic intensity
-    float specularStrength = 0.15;
-    vec3 reflectDir = reflect(-lightDir, normalMap);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
+    // Specular lighting with normal mapping and dynamic intensity; roughness 0.5
+    // gives the former fixed strength 0.15 and shininess 32
+    float specularStrength = 0.15 * (1.5 - roughness);
+    float shininess = exp2(mix(7.0, 3.0, roughness));
+    vec3 reflectDir = reflect(-lightDir, surfaceNormal);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), shininess);
     vec3 specular = specularStrength * spec * lightColor * lightIntensity * attenuation;
     
-    // Calculate atmospheric glow
     vec3 worldNormal = normalize(Normal);
     vec3 worldViewDir = normalize(viewPos - FragPos);
-    vec3 atmosphere = calculateAtmosphere(worldNormal, worldViewDir, planetType);
     
-    // Combine all lighting effects
+#ifdef PLANET_ATMOSPHERE
+    // Aerial perspective from the tables. The view ray starts where it enters the atmosphere,
+    // and the fragment is treated as lying on the ground sphere
+    vec3 groundPoint = normalize(FragPos - planetCenter);
+    vec3 cameraPoint = (viewPos - planetCenter) / planetRadius;
+    vec3 rayDir = normalize(groundPoint - cameraPoint);
+    float b = dot(cameraPoint, rayDir);
+    float entry = -b - sqrt(max(b * b - dot(cameraPoint, cameraPoint) + atmosphereTop * atmosphereTop, 0.0));
+    cameraPoint += rayDir * max(entry, 0.0);
+    
+    vec3 sunDir = normalize(lightPos - planetCenter);
+    float r = clamp(length(cameraPoint), 1.0, atmosphereTop);
+    float mu = dot(cameraPoint, rayDir) / length(cameraPoint);
+    float muS = dot(cameraPoint, sunDir) / length(cameraPoint);
+    float nu = dot(rayDir, sunDir);
+    
+    vec3 viewTransmittance = getViewTransmittance(r, mu);
+    vec3 sunTransmittance = getSunTransmittance(1.0, dot(groundPoint, sunDir));
+    vec4 scattering = getScattering(r, mu, muS, nu);
+    
+    // Only red Mie is stored; the other channels follow the Rayleigh ratio
+    vec3 mie = scattering.rgb * scattering.a / max(scattering.r, 1e-6) * (rayleighScattering.r / rayleighScattering);
+    vec3 atmosphere = (scattering.rgb * rayleighPhase(nu) + mie * miePhase(nu)) *
+                      lightColor * lightIntensity * attenuation * ATMOSPHERE_SUN_INTENSITY;
+    
+    // Direct sunlight reaching the ground is filtered by the atmosphere, the surface by the air in front
+    vec3 lighting = ambient + (diffuse + specular) * sunTransmittance;
+    vec3 result = lighting * surfaceColor * viewTransmittance + atmosphere;
+    result += getClusteredLighting(FragPos, worldNormal, worldViewDir, surfaceColor, specularStrength, shininess) *
+              viewTransmittance;
+#else
     vec3 lighting = ambient + diffuse + specular;
-    vec3 result = lighting * surfaceColor + atmosphere;
+    vec3 result = lighting * surfaceColor;
+    result += getClusteredLighting(FragPos, worldNormal, worldViewDir, surfaceColor, specularStrength, shininess);
+#endif
     
     // Add subtle rim lighting for depth
     float rim = 1.0 - max(dot(worldNormal, worldViewDir), 0.0);
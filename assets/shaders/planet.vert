@@ -10,6 +10,17 @@ uniform mat4 projection;
 uniform vec3 lightPos;
 uniform vec3 viewPos;
 
+#ifdef PLANET_HEIGHTMAP
+// Shared unit grid (PlanetGridCache) displaced by the planet's baked terrain
+uniform samplerCube heightMap;
+uniform float terrainRadius; // Planet radius before the model scale
+uniform float heightScale;
+#endif
+
+#ifdef PLANET_BIOMES
+out vec3 SurfaceDir; // Object-space direction the biome cubemap is looked up with
+#endif
+
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
@@ -19,7 +30,17 @@ out vec3 TangentFragPos;
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
+#ifdef PLANET_HEIGHTMAP
+    vec3 direction = normalize(aPos);
+    float height = textureLod(heightMap, direction, 0.0).r * heightScale;
+    vec3 position = direction * (terrainRadius + height);
+#else
+    vec3 position = aPos;
+#endif
+#ifdef PLANET_BIOMES
+    SurfaceDir = position;
+#endif
+    FragPos = vec3(model * vec4(position, 1.0));
     Normal = mat3(transpose(inverse(model))) * aNormal;
     TexCoord = aTexCoord;
     
@@ -6,12 +6,16 @@ in vec3 Normal;
 
 out vec4 FragColor;
 
+uniform mat4 view;
+uniform mat4 projection;
 uniform vec3 lightPos;
 uniform vec3 lightColor;
 uniform vec3 viewPos;
 uniform vec3 planetColor;
 uniform float alpha;
 
+#include "lights.glsl"
+
 // Noise function for particle texture
 float hash(vec2 p) {
     return fract(sin(dot(p, vec2(127.1, 311.7))) * 43758.5453);
@@ -64,6 +68,9 @@ void main() {
     vec3 diffuse = diff * lightColor * planetColor * attenuation;
     vec3 result = ambient + diffuse;
     
+    // Billboards face the camera, so point lights shade them as if lit from the front
+    result += getClusteredLighting(FragPos, viewDir, viewDir, planetColor, 0.0, 1.0);
+    
     // Add slight glow effect
     float glow = pow(circle, 0.5);
     result += glow * planetColor * 0.3;
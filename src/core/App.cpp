@@ -2,18 +2,31 @@
 #include "Window.hpp"
 #include "InputManager.hpp"
 #include "Shader.hpp"
+#include "ShaderCache.hpp"
+#include "ShaderVariants.hpp"
 #include "Camera.hpp"
 #include "Geometry.hpp"
 #include "Texture.hpp"
+#include "TextureStreamer.hpp"
 #include "Noise.hpp"
 #include "Planet.hpp"
 #include "PlanetManager.hpp"
+#include "ParticleSystem.hpp"
 #include "Sun.hpp"
 #include "SolarSystemManager.hpp"
+#include "SystemGenerator.hpp"
 #include "ConfigManager.hpp"
+#include "SessionRecorder.hpp"
+#include "FrameTimingLog.hpp"
+#include "CameraPathBenchmark.hpp"
+#include "RenderStats.hpp"
+#include "ThumbnailRenderer.hpp"
+#include "GLApi.hpp"
+#include <algorithm>
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <vector>
 #include <spdlog/spdlog.h>
 #include <iomanip>
 #include <sstream>
@@ -23,6 +36,45 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/vec3.hpp>
 
+namespace {
+
+SessionAction cameraCommand(SessionAction::CameraCommand command, int planetIndex = 0) {
+    return SessionAction::withInts(SessionAction::Type::CameraCommand, static_cast<int32_t>(command), planetIndex);
+}
+
+// Wall-clock time of each init() phase, to compare cold and warm starts
+class StartupTimer {
+public:
+    StartupTimer()
+        : start_(std::chrono::steady_clock::now())
+        , last_(start_) {
+    }
+
+    void mark(const char* phase) {
+        auto now = std::chrono::steady_clock::now();
+        phases_.emplace_back(phase, std::chrono::duration<double, std::milli>(now - last_).count());
+        last_ = now;
+    }
+
+    std::string format() const {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(1)
+           << std::chrono::duration<double, std::milli>(last_ - start_).count() << " ms (";
+        for (size_t i = 0; i < phases_.size(); ++i) {
+            ss << (i > 0 ? ", " : "") << phases_[i].first << " " << phases_[i].second;
+        }
+        ss << ")";
+        return ss.str();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::steady_clock::time_point last_;
+    std::vector<std::pair<const char*, double>> phases_;
+};
+
+} // namespace
+
 App::App() = default;
 App::~App() = default;
 
@@ -31,7 +83,11 @@ int App::run(int argc, char** argv) {
     
     processCommandLine(argc, argv);
     init();
-    loop();
+    if (thumbnailCount_ > 0) {
+        renderThumbnails();
+    } else {
+        loop();
+    }
     shutdown();
     
     spdlog::info("Application terminated successfully.");
@@ -41,28 +97,53 @@ int App::run(int argc, char** argv) {
 void App::init() {
     spdlog::set_level(spdlog::level::debug);
     spdlog::info("Initializing application...");
+    StartupTimer startupTimer;
+    
+    // Open session logs and benchmark paths first: both can override the startup seeds
+    initSession();
+    initBenchmark();
+    
+    // Thumbnail batches render offscreen; a cache entry per seed would only fill the disk
+    if (thumbnailCount_ > 0) {
+        useSnapshots_ = false;
+        useMeshCache_ = false;
+    }
     
     // Create window
-    window_ = std::make_unique<Window>(1280, 720, "Procedural Universe Generator");
+    Window::Surface surface = Window::Surface::Visible;
+    if (headless_) {
+        surface = Window::Surface::Headless;
+    } else if (hiddenWindow_ || thumbnailCount_ > 0) {
+        surface = Window::Surface::Hidden;
+    }
+    window_ = std::make_unique<Window>(1280, 720, "Procedural Universe Generator", surface);
     
     if (!window_->isValid()) {
         throw std::runtime_error("Failed to create window!");
     }
     
+    if (isScriptedRun()) {
+        // Replays, benchmarks and thumbnail batches run as fast as the GPU allows
+        window_->setVSync(false);
+    }
+    
+    startupTimer.mark("window");
     spdlog::info("Window validation passed, testing OpenGL core profile...");
     
     // Make sure the OpenGL context is current
     glfwMakeContextCurrent(window_->getGLFWwindow());
     
-    // Test basic OpenGL functionality without extension loader
+    // Every renderer class calls OpenGL through this table; the null backend leaves ImGui on the real context
+    if (!GLApi::load(glNullBackend_ ? GLApi::Backend::Null : GLApi::Backend::Native, glStats_)) {
+        throw std::runtime_error("Failed to load OpenGL functions!");
+    }
+    
     spdlog::info("Testing basic OpenGL calls...");
     
-    // Try to get OpenGL version using core functions
     try {
-        // These are core OpenGL functions that should work without extension loaders
-        const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
-        const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
-        const char* vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
+        const char* version = reinterpret_cast<const char*>(gl.GetString(GL_VERSION));
+        const char* renderer = reinterpret_cast<const char*>(gl.GetString(GL_RENDERER));
+        const char* vendor = reinterpret_cast<const char*>(gl.GetString(GL_VENDOR));
         
         if (version) {
             spdlog::info("OpenGL Version: {}", version);
@@ -75,8 +156,9 @@ void App::init() {
         }
         
         // Set up basic OpenGL state using core functions
-        glEnable(GL_DEPTH_TEST);
-        glClearColor(0.1f, 0.1f, 0.2f, 1.0f);
+        gl.Enable(GL_DEPTH_TEST);
+        gl.Enable(GL_TEXTURE_CUBE_MAP_SEAMLESS); // Filter across cube face edges (skybox, planet height maps)
+        gl.ClearColor(0.1f, 0.1f, 0.2f, 1.0f);
         
         spdlog::info("OpenGL core profile working successfully!");
     }
@@ -85,10 +167,12 @@ void App::init() {
         throw;
     }
     
+    startupTimer.mark("opengl");
     spdlog::info("OpenGL setup complete, initializing Input Manager...");
     
     // Initialize Input Manager
     Core::InputManager::getInstance().initialize(window_->getGLFWwindow());
+    Core::InputManager::getInstance().setPlaybackMode(sessionPlayer_ != nullptr);
     
     spdlog::info("Input Manager initialization complete");
     
@@ -127,113 +211,67 @@ void App::init() {
         }
     });
     
+    // Initialize configuration manager
+    spdlog::info("Initializing configuration manager...");
+    try {
+        configManager_ = std::make_unique<ConfigManager>();
+        // Scripted runs must not overwrite the user's autosaves
+        configManager_->setAutosave("configs/autosave.json", isScriptedRun() ? 0.0f : autosaveInterval_, AUTOSAVE_HISTORY);
+        spdlog::info("Configuration manager initialized successfully");
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to initialize configuration manager: {}", e.what());
+        throw;
+    }
+    
+    startupTimer.mark("input+config");
+    
     // Initialize shader system
     spdlog::info("Initializing shader system...");
+    
+    // Every program is submitted up front; the driver compiles them while the rest of init() runs
+    const std::pair<std::unique_ptr<Shader>*, const char*> shaderPrograms[] = {
+        {&basicShader_, "basic"},
+        {&texturedShader_, "textured"},
+        {&skyboxShader_, "skybox"},
+        {&sunShader_, "sun"},
+        {&asteroidShader_, "asteroid"},
+        {&ringShader_, "ring"}
+    };
+    std::vector<std::pair<Shader*, std::string>> pendingShaders;
     try {
-        basicShader_ = std::make_unique<Shader>("assets/shaders/basic.vert", "assets/shaders/basic.frag");
-        spdlog::info("Basic shader created, checking validity...");
-        if (!basicShader_->isValid()) {
-            throw std::runtime_error("Failed to create basic shader");
-        }
-        
-        spdlog::info("Basic shader validation passed, proceeding to textured shader...");
-        spdlog::info("Loading textured shader...");
-        try {
-            texturedShader_ = std::make_unique<Shader>("assets/shaders/textured.vert", "assets/shaders/textured.frag");
-            if (!texturedShader_->isValid()) {
-                spdlog::error("Textured shader is not valid!");
-                throw std::runtime_error("Failed to create textured shader");
-            }
-            spdlog::info("Textured shader loaded successfully");
-        } catch (const std::exception& e) {
-            spdlog::error("Exception during textured shader creation: {}", e.what());
-            throw;
-        }
-        
-        spdlog::info("Loading skybox shader...");
-        try {
-            skyboxShader_ = std::make_unique<Shader>("assets/shaders/skybox.vert", "assets/shaders/skybox.frag");
-            if (!skyboxShader_->isValid()) {
-                spdlog::error("Skybox shader is not valid!");
-                throw std::runtime_error("Failed to create skybox shader");
-            }
-            spdlog::info("Skybox shader loaded successfully");
-        } catch (const std::exception& e) {
-            spdlog::error("Exception during skybox shader creation: {}", e.what());
-            throw;
+        if (useShaderCache_) {
+            shaderCache_ = std::make_unique<ShaderCache>(configManager_->getDefaultSaveDirectory() + "/shaders");
         }
+        Shader::enableParallelCompile();
         
-        spdlog::info("Loading planet shader...");
-        try {
-            planetShader_ = std::make_unique<Shader>("assets/shaders/planet.vert", "assets/shaders/planet.frag");
-            if (!planetShader_->isValid()) {
-                spdlog::error("Planet shader is not valid!");
-                throw std::runtime_error("Failed to create planet shader");
-            }
-            spdlog::info("Planet shader loaded successfully");
-        } catch (const std::exception& e) {
-            spdlog::error("Exception during planet shader creation: {}", e.what());
-            throw;
-        }
-        
-        spdlog::info("Loading sun shader...");
-        try {
-            sunShader_ = std::make_unique<Shader>("assets/shaders/sun.vert", "assets/shaders/sun.frag");
-            if (!sunShader_->isValid()) {
-                spdlog::error("Sun shader is not valid!");
-                throw std::runtime_error("Failed to create sun shader");
-            }
-            spdlog::info("Sun shader loaded successfully");
-        } catch (const std::exception& e) {
-            spdlog::error("Exception during sun shader creation: {}", e.what());
-            throw;
-        }
-        
-        spdlog::info("Loading asteroid shader...");
-        try {
-            asteroidShader_ = std::make_unique<Shader>("assets/shaders/asteroid.vert", "assets/shaders/asteroid.frag");
-            if (!asteroidShader_->isValid()) {
-                spdlog::error("Asteroid shader is not valid!");
-                throw std::runtime_error("Failed to create asteroid shader");
-            }
-            spdlog::info("Asteroid shader loaded successfully");
-        } catch (const std::exception& e) {
-            spdlog::error("Exception during asteroid shader creation: {}", e.what());
-            throw;
-        }
-        
-        spdlog::info("Loading ring shader...");
-        try {
-            ringShader_ = std::make_unique<Shader>("assets/shaders/ring.vert", "assets/shaders/ring.frag");
-            if (!ringShader_->isValid()) {
-                spdlog::error("Ring shader is not valid!");
-                throw std::runtime_error("Failed to create ring shader");
-            }
-            spdlog::info("Ring shader loaded successfully");
-        } catch (const std::exception& e) {
-            spdlog::error("Exception during ring shader creation: {}", e.what());
-            throw;
+        for (const auto& [shader, name] : shaderPrograms) {
+            std::string path = std::string("assets/shaders/") + name;
+            *shader = std::make_unique<Shader>(path + ".vert", path + ".frag", shaderCache_.get());
+            pendingShaders.emplace_back(shader->get(), name);
         }
         
-        spdlog::info("Loading particle shader...");
-        try {
-            particleShader_ = std::make_unique<Shader>("assets/shaders/particle.vert", "assets/shaders/particle.frag");
-            if (!particleShader_->isValid()) {
-                spdlog::error("Particle shader is not valid!");
-                throw std::runtime_error("Failed to create particle shader");
-            }
-            spdlog::info("Particle shader loaded successfully");
-        } catch (const std::exception& e) {
-            spdlog::error("Exception during particle shader creation: {}", e.what());
-            throw;
+        // Planet and particle programs are specialized instead of branching on a uniform;
+        // every variant in use is submitted now so none compiles mid-frame
+        planetShaders_ = std::make_unique<ShaderVariants>("assets/shaders/planet.vert", "assets/shaders/planet.frag",
+                                                          PlanetManager::getShaderVariantSymbols(), shaderCache_.get());
+        pendingShaders.emplace_back(planetShaders_->submit(PlanetManager::getShaderVariant(true, shaderDisplacement_)), "planet");
+        pendingShaders.emplace_back(planetShaders_->submit(PlanetManager::getShaderVariant(true, shaderDisplacement_, true)),
+                                    "planet biomes");
+        pendingShaders.emplace_back(planetShaders_->submit(PlanetManager::getShaderVariant(false)), "moon");
+        particleShaders_ = std::make_unique<ShaderVariants>("assets/shaders/particle.vert", "assets/shaders/particle.frag",
+                                                            ParticleSystem::getShaderVariantSymbols(), shaderCache_.get());
+        for (int type = 0; type < 4; ++type) {
+            pendingShaders.emplace_back(particleShaders_->submit(ParticleSystem::getShaderVariant(static_cast<ParticleType>(type))),
+                                        "particle " + ParticleSystem::getShaderVariantSymbols()[type]);
         }
-        
-        spdlog::info("Shader system initialized successfully");
+        spdlog::info("Shader programs submitted for compilation");
     } catch (const std::exception& e) {
         spdlog::error("Failed to initialize shader system: {}", e.what());
         throw;
     }
     
+    startupTimer.mark("shader submit");
+    
     // Initialize camera system
     spdlog::info("Initializing camera system...");
     try {
@@ -266,11 +304,20 @@ void App::init() {
         throw;
     }
     
+    startupTimer.mark("camera+geometry");
+    
     // Initialize texture system
     spdlog::info("Initializing texture system...");
     try {
-        checkerboardTexture_ = std::make_unique<Core::Texture>("assets/textures/checkerboard.png");
-        brickTexture_ = std::make_unique<Core::Texture>("assets/textures/brick.png");
+        // Images decode in the background and upload a few MB per frame; placeholders are bound until then
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        int decodeThreads = std::clamp(static_cast<int>(hardwareThreads) - 1, 1, 4);
+        textureStreamer_ = std::make_unique<Core::TextureStreamer>(decodeThreads, TEXTURE_UPLOAD_BUDGET);
+        
+        checkerboardTexture_ = std::make_unique<Core::Texture>();
+        brickTexture_ = std::make_unique<Core::Texture>();
+        textureStreamer_->loadTexture(*checkerboardTexture_, "assets/textures/checkerboard.png");
+        textureStreamer_->loadTexture(*brickTexture_, "assets/textures/brick.png");
         
         // Load skybox cubemap texture - temporarily disabled for procedural starfield
         skyboxTexture_ = std::make_unique<Core::Texture>();
@@ -283,6 +330,8 @@ void App::init() {
         throw;
     }
     
+    startupTimer.mark("textures");
+    
     // Initialize noise system
     spdlog::info("Initializing noise system...");
     try {
@@ -305,6 +354,17 @@ void App::init() {
     try {
         solarSystemManager_ = std::make_unique<SolarSystemManager>();
         solarSystemManager_->initialize(noise_.get());
+        solarSystemManager_->setSnapshotDirectory(configManager_->getDefaultSaveDirectory() + "/snapshots");
+        solarSystemManager_->setSnapshotsEnabled(useSnapshots_);
+        if (useMeshCache_) {
+            solarSystemManager_->getPlanetManager()->setMeshCacheDirectory(
+                configManager_->getDefaultSaveDirectory() + "/meshes");
+            solarSystemManager_->getPlanetManager()->setSurfaceCacheDirectory(
+                configManager_->getDefaultSaveDirectory() + "/surfaces");
+        }
+        if (shaderDisplacement_) {
+            solarSystemManager_->getPlanetManager()->setShaderDisplacement(true);
+        }
         solarSystemManager_->generateSolarSystem(systemSeed_, planetCount_);
         
         spdlog::info("Solar system initialized successfully with {} planets", planetCount_);
@@ -313,20 +373,54 @@ void App::init() {
         throw;
     }
     
-    // Initialize configuration manager
-    spdlog::info("Initializing configuration manager...");
-    try {
-        configManager_ = std::make_unique<ConfigManager>();
-        spdlog::info("Configuration manager initialized successfully");
-    } catch (const std::exception& e) {
-        spdlog::error("Failed to initialize configuration manager: {}", e.what());
-        throw;
+    startupTimer.mark("noise+solar system");
+    
+    // Collect the shader programs, finished ones first, so errors are reported as soon as they are known
+    spdlog::info("Finishing shader compilation...");
+    const size_t shaderProgramCount = pendingShaders.size();
+    size_t readyBeforeWait = 0;
+    for (const auto& [shader, name] : pendingShaders) {
+        if (shader->isReady()) {
+            ++readyBeforeWait;
+        }
     }
+    while (!pendingShaders.empty()) {
+        size_t remaining = pendingShaders.size();
+        for (auto it = pendingShaders.begin(); it != pendingShaders.end();) {
+            // Without KHR_parallel_shader_compile every program reports ready and finish() blocks instead
+            if (!it->first->isReady()) {
+                ++it;
+                continue;
+            }
+            if (!it->first->finish()) {
+                spdlog::error("{} shader is not valid!", it->second);
+                throw std::runtime_error("Failed to create " + it->second + " shader");
+            }
+            it = pendingShaders.erase(it);
+        }
+        if (pendingShaders.size() == remaining) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+    if (shaderCache_ && shaderCache_->isSupported()) {
+        spdlog::info("Shader system initialized successfully ({} of {} programs ready before waiting, {} from cache)",
+                     readyBeforeWait, shaderProgramCount, shaderCache_->getHitCount());
+    } else {
+        spdlog::info("Shader system initialized successfully ({} of {} programs ready before waiting)",
+                     readyBeforeWait, shaderProgramCount);
+    }
+    startupTimer.mark("shader wait");
     
     // Initialize ImGui
     initImGui();
+    startupTimer.mark("imgui");
+    
+    if (benchmark_) {
+        benchmark_->start(*camera_);
+    }
     
     spdlog::info("Application initialized successfully.");
+    spdlog::info("Startup took {}", startupTimer.format());
 }
 
 std::string App::getCurrentTimeString() const {
@@ -338,13 +432,104 @@ std::string App::getCurrentTimeString() const {
     return ss.str();
 }
 
+void App::initSession() {
+    if (!replayPath_.empty()) {
+        sessionPlayer_ = std::make_unique<SessionPlayer>();
+        if (!sessionPlayer_->open(replayPath_)) {
+            throw std::runtime_error("Failed to open session log: " + replayPath_);
+        }
+        
+        const SessionHeader& header = sessionPlayer_->getHeader();
+        seed_ = header.starSeed;
+        systemSeed_ = header.systemSeed;
+        planetCount_ = header.planetCount;
+        
+        if (timingsPath_.empty()) {
+            timingsPath_ = replayPath_ + ".timings.csv";
+        }
+    }
+    else if (!recordPath_.empty()) {
+        sessionRecorder_ = std::make_unique<SessionRecorder>();
+        SessionHeader header;
+        header.starSeed = seed_;
+        header.systemSeed = systemSeed_;
+        header.planetCount = planetCount_;
+        if (!sessionRecorder_->open(recordPath_, header)) {
+            sessionRecorder_.reset();
+        }
+    }
+    
+    if (!timingsPath_.empty()) {
+        frameTimings_ = std::make_unique<FrameTimingLog>();
+        if (!frameTimings_->open(timingsPath_)) {
+            frameTimings_.reset();
+        }
+    }
+}
+
+void App::initBenchmark() {
+    if (benchmarkPath_.empty()) {
+        return;
+    }
+    if (sessionPlayer_) {
+        throw std::runtime_error("--benchmark-path cannot be combined with --replay");
+    }
+    
+    benchmark_ = std::make_unique<CameraPathBenchmark>();
+    if (!benchmark_->load(benchmarkPath_)) {
+        throw std::runtime_error("Failed to load benchmark path: " + benchmarkPath_);
+    }
+    
+    const auto& settings = benchmark_->getSettings();
+    if (settings.seed >= 0) {
+        systemSeed_ = settings.seed;
+    }
+    if (settings.planetCount > 0) {
+        planetCount_ = settings.planetCount;
+    }
+    if (benchmarkOutput_.empty()) {
+        benchmarkOutput_ = benchmarkPath_ + ".results.json";
+    }
+}
+
+void App::finishBenchmark() {
+    CameraPathBenchmark::RunInfo info;
+    if (const char* renderer = reinterpret_cast<const char*>(gl.GetString(GL_RENDERER))) {
+        info.renderer = renderer;
+    }
+    if (const char* version = reinterpret_cast<const char*>(gl.GetString(GL_VERSION))) {
+        info.glVersion = version;
+    }
+    info.width = window_->getWidth();
+    info.height = window_->getHeight();
+    info.seed = systemSeed_;
+    info.planetCount = planetCount_;
+    if (GLApi::isCounting()) {
+        const GLStats& totals = GLApi::getTotals();
+        for (size_t i = 0; i < totals.calls.size(); ++i) {
+            if (totals.calls[i] > 0) {
+                info.glFunctionCalls.emplace_back(GLApi::getFunctionName(static_cast<GLFunction>(i)), totals.calls[i]);
+            }
+        }
+        std::stable_sort(info.glFunctionCalls.begin(), info.glFunctionCalls.end(),
+                         [](const auto& a, const auto& b) { return a.second > b.second; });
+    }
+    benchmark_->writeReport(benchmarkOutput_, info);
+}
+
 void App::loop() {
     spdlog::info("Entering main loop...");
     
-    auto lastTime = std::chrono::high_resolution_clock::now();
+    using Clock = std::chrono::high_resolution_clock;
+    auto elapsedMs = [](Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<double, std::milli>(to - from).count();
+    };
+    
+    auto lastTime = Clock::now();
+    SessionFrame sessionFrame;
     
     while (running_ && !window_->shouldClose()) {
-        auto currentTime = std::chrono::high_resolution_clock::now();
+        auto currentTime = Clock::now();
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
         lastTime = currentTime;
         
@@ -354,22 +539,295 @@ void App::loop() {
         // Update input manager
         Core::InputManager::getInstance().update();
         
+        // Replace live input and timing with the recorded frame
+        if (sessionPlayer_) {
+            if (!sessionPlayer_->nextFrame(sessionFrame)) {
+                spdlog::info("Replay finished after {} frames", sessionPlayer_->getFrameIndex());
+                break;
+            }
+            Core::InputManager::getInstance().applySnapshot(sessionFrame.input);
+            deltaTime = sessionFrame.deltaTime;
+        }
+        else if (benchmark_) {
+            deltaTime = benchmark_->getSettings().timestep;
+        }
+        
         // Update
+        auto updateStart = Clock::now();
         update(deltaTime);
         
+        if (sessionPlayer_) {
+            for (const auto& action : sessionFrame.actions) {
+                applyAction(action);
+            }
+        }
+        
         // Render
+        auto renderStart = Clock::now();
         render();
         
         // Swap buffers
+        auto presentStart = Clock::now();
         window_->swapBuffers();
+        auto frameEnd = Clock::now();
+        
+        if (sessionRecorder_) {
+            sessionFrame.deltaTime = deltaTime;
+            sessionFrame.input = Core::InputManager::getInstance().captureSnapshot();
+            sessionFrame.actions.swap(pendingActions_);
+            sessionRecorder_->recordFrame(sessionFrame);
+            pendingActions_.clear();
+        }
+        
+        FrameTiming timing;
+        timing.deltaTime = deltaTime;
+        timing.updateMs = elapsedMs(updateStart, renderStart);
+        timing.renderMs = elapsedMs(renderStart, presentStart);
+        timing.presentMs = elapsedMs(presentStart, frameEnd);
+        timing.frameMs = elapsedMs(currentTime, frameEnd);
+        if (frameTimings_) {
+            frameTimings_->record(timing);
+        }
+        
+        RenderStats::Counters renderCounters = RenderStats::takeFrame();
+        if (GLApi::isCounting()) {
+            GLStats glFrame = GLApi::takeFrame();
+            renderCounters.glCalls = glFrame.totalCalls;
+            renderCounters.uploadBytes = glFrame.getUploadBytes();
+        }
+        lastFrameStats_ = renderCounters;
+        if (benchmark_ && !benchmark_->finishFrame(*camera_, timing, renderCounters)) {
+            finishBenchmark();
+            break;
+        }
         
-        // Cap framerate to ~120 FPS
-        std::this_thread::sleep_for(std::chrono::microseconds(8333));
+        // Cap framerate to ~120 FPS (scripted runs are uncapped)
+        if (!isScriptedRun()) {
+            std::this_thread::sleep_for(std::chrono::microseconds(8333));
+        }
+    }
+}
+
+void App::renderThumbnails() {
+    if (!running_) {
+        return;
+    }
+    
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    int encoderThreads = static_cast<int>(std::max(1u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u));
+    ThumbnailRenderer thumbnails(thumbnailWidth_, thumbnailHeight_, thumbnailDirectory_, encoderThreads);
+    if (!thumbnails.isValid()) {
+        spdlog::error("Thumbnail rendering unavailable");
+        return;
+    }
+    
+    const int firstSeed = thumbnailFirstSeed_ >= 0 ? thumbnailFirstSeed_ : systemSeed_;
+    constexpr int SETTLE_STEPS = 10;
+    constexpr float SETTLE_TIMESTEP = 0.05f;
+    
+    spdlog::info("Rendering {} thumbnails starting at seed {} ({}x{}) to {}",
+                 thumbnailCount_, firstSeed, thumbnailWidth_, thumbnailHeight_, thumbnailDirectory_);
+    
+    // Per-system generation logging would dominate the run
+    auto previousLevel = spdlog::get_level();
+    spdlog::set_level(spdlog::level::warn);
+    
+    auto startTime = std::chrono::high_resolution_clock::now();
+    int rendered = 0;
+    for (int i = 0; i < thumbnailCount_ && running_ && !window_->shouldClose(); ++i) {
+        const int seed = firstSeed + i;
+        solarSystemManager_->generateSolarSystem(seed, planetCount_);
+        
+        // Overview framing of the whole system
+        camera_->setMode(Camera::Mode::FREE_FLY);
+        camera_->setPosition(glm::vec3(0.0f, 150.0f, 600.0f));
+        camera_->setYaw(-90.0f);
+        camera_->setPitch(-14.0f);
+        
+        // Let particle systems emit before the frame is taken
+        for (int step = 0; step < SETTLE_STEPS; ++step) {
+            solarSystemManager_->update(SETTLE_TIMESTEP);
+        }
+        
+        thumbnails.beginFrame();
+        renderScene(thumbnailWidth_, thumbnailHeight_);
+        thumbnails.endFrame(seed);
+        RenderStats::takeFrame();
+        GLApi::takeFrame();
+        ++rendered;
+        
+        // Keep the window system responsive during long batches
+        window_->pollEvents();
+        
+        if (rendered % 100 == 0) {
+            float elapsed = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - startTime).count();
+            spdlog::set_level(previousLevel);
+            spdlog::info("Rendered {}/{} thumbnails ({:.1f} seeds/s)", rendered, thumbnailCount_, rendered / elapsed);
+            spdlog::set_level(spdlog::level::warn);
+        }
+    }
+    
+    thumbnails.finish();
+    spdlog::set_level(previousLevel);
+    
+    float elapsed = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - startTime).count();
+    spdlog::info("Rendered {} thumbnails in {:.2f} s ({:.1f} seeds/s)",
+                 thumbnails.getImagesWritten(), elapsed, elapsed > 0.0f ? rendered / elapsed : 0.0f);
+    
+    gl.Viewport(0, 0, window_->getWidth(), window_->getHeight());
+}
+
+void App::applyCameraCommand(const SessionAction& action) {
+    PlanetInstance* planet = nullptr;
+    if (solarSystemManager_->getPlanetManager()) {
+        planet = solarSystemManager_->getPlanetManager()->getPlanet(action.intValue2);
+    }
+    
+    switch (static_cast<SessionAction::CameraCommand>(action.intValue)) {
+        case SessionAction::CameraCommand::Reset:
+            camera_->resetToDefault();
+            break;
+        case SessionAction::CameraCommand::SystemTour: {
+            std::vector<glm::vec3> waypoints = {
+                glm::vec3(0.0f, 0.0f, 500.0f),
+                glm::vec3(200.0f, 100.0f, 200.0f),
+                glm::vec3(0.0f, 200.0f, 0.0f),
+                glm::vec3(-200.0f, 50.0f, 200.0f),
+                glm::vec3(0.0f, 0.0f, 100.0f)
+            };
+            camera_->startCinematicPath(waypoints, 15.0f);
+            camera_->playCinematicSequence();
+            break;
+        }
+        case SessionAction::CameraCommand::ToggleQuickTour:
+            if (camera_->isCinematicPlaying()) {
+                camera_->stopCinematicSequence();
+            } else {
+                std::vector<glm::vec3> waypoints = {
+                    glm::vec3(0.0f, 0.0f, 500.0f),
+                    glm::vec3(200.0f, 100.0f, 200.0f),
+                    glm::vec3(0.0f, 200.0f, 0.0f),
+                    glm::vec3(0.0f, 0.0f, 100.0f)
+                };
+                camera_->startCinematicPath(waypoints, 12.0f);
+                camera_->playCinematicSequence();
+            }
+            break;
+        case SessionAction::CameraCommand::FocusSun:
+            camera_->transitionToTarget(glm::vec3(0.0f, 0.0f, 0.0f), 300.0f, 2.0f, Camera::TransitionType::EASE_IN_OUT);
+            break;
+        case SessionAction::CameraCommand::OrbitSun:
+            camera_->setMode(Camera::Mode::ORBIT);
+            camera_->setTarget(glm::vec3(0.0f, 0.0f, 0.0f));
+            break;
+        case SessionAction::CameraCommand::TargetSun:
+            if (solarSystemManager_->getSun()) {
+                camera_->setTargetSun(solarSystemManager_->getSun());
+            }
+            break;
+        case SessionAction::CameraCommand::TargetPlanet:
+            if (planet) {
+                camera_->setTarget(planet->position);
+            }
+            break;
+        case SessionAction::CameraCommand::GoToPlanet:
+            if (planet) {
+                camera_->setTarget(planet->position);
+                camera_->transitionToTarget(planet->position, 100.0f, 2.0f, Camera::TransitionType::EASE_IN_OUT);
+            }
+            break;
+    }
+}
+
+void App::performAction(const SessionAction& action) {
+    if (isScriptedRun()) {
+        // The replayed log or benchmark path is the only source of changes
+        return;
+    }
+    
+    applyAction(action);
+    if (sessionRecorder_) {
+        pendingActions_.push_back(action);
+    }
+}
+
+void App::applyAction(const SessionAction& action) {
+    if (!solarSystemManager_ || !camera_) {
+        return;
+    }
+    
+    switch (action.type) {
+        case SessionAction::Type::Regenerate:
+            systemSeed_ = action.intValue;
+            planetCount_ = action.intValue2;
+            solarSystemManager_->generateSolarSystem(systemSeed_, planetCount_);
+            break;
+        case SessionAction::Type::SetAsteroidsVisible:
+            solarSystemManager_->setAsteroidBeltsVisible(action.intValue != 0);
+            break;
+        case SessionAction::Type::SetRingsVisible:
+            solarSystemManager_->setPlanetaryRingsVisible(action.intValue != 0);
+            break;
+        case SessionAction::Type::SetParticlesVisible:
+            solarSystemManager_->setParticleSystemsVisible(action.intValue != 0);
+            break;
+        case SessionAction::Type::SetAsteroidDensity:
+            solarSystemManager_->setAsteroidDensity(action.floatValue);
+            break;
+        case SessionAction::Type::SetRingDensity:
+            solarSystemManager_->setRingDensity(action.floatValue);
+            break;
+        case SessionAction::Type::SetEmissionRate:
+            solarSystemManager_->setParticleEmissionRate(action.floatValue);
+            break;
+        case SessionAction::Type::SetCameraMode:
+            camera_->setMode(static_cast<Camera::Mode>(action.intValue));
+            break;
+        case SessionAction::Type::SetMaxRenderDistance:
+            maxRenderDistance_ = action.floatValue;
+            if (solarSystemManager_->getPlanetManager()) {
+                solarSystemManager_->getPlanetManager()->setMaxRenderDistance(maxRenderDistance_);
+            }
+            break;
+        case SessionAction::Type::ApplyConfig:
+            if (configManager_ && configManager_->applyConfigJson(action.text, camera_.get(), solarSystemManager_.get())) {
+                systemSeed_ = solarSystemManager_->getSeed();
+            }
+            break;
+        case SessionAction::Type::SetMovementSpeed:
+            camera_->setMovementSpeed(action.floatValue);
+            break;
+        case SessionAction::Type::SetMouseSensitivity:
+            camera_->setMouseSensitivity(action.floatValue);
+            break;
+        case SessionAction::Type::SetMotionBlur:
+            camera_->enableMotionBlur(action.intValue != 0);
+            break;
+        case SessionAction::Type::SetOrbitDistance:
+            camera_->setOrbitDistance(action.floatValue);
+            break;
+        case SessionAction::Type::SetOrbitSpeed:
+            camera_->setOrbitSpeed(action.floatValue);
+            break;
+        case SessionAction::Type::CameraCommand:
+            applyCameraCommand(action);
+            break;
+        default:
+            spdlog::warn("Ignoring unknown session action {}", static_cast<int>(action.type));
+            break;
     }
 }
 
 void App::shutdown() {
     spdlog::info("Shutting down application...");
+    if (configManager_) {
+        // Let pending saves land before the process exits
+        configManager_->flush();
+    }
+    sessionRecorder_.reset();
+    frameTimings_.reset();
+    textureStreamer_.reset();
+    GLApi::logSummary(10);
     shutdownImGui();
     Core::InputManager::getInstance().shutdown();
     window_.reset();
@@ -389,11 +847,120 @@ void App::processCommandLine(int argc, char** argv) {
                 spdlog::warn("Invalid seed value: {}", argv[i + 1]);
             }
         }
+        else if (arg == "--no-snapshot") {
+            useSnapshots_ = false;
+            spdlog::info("System snapshots disabled");
+        }
+        else if (arg == "--watch-shaders") {
+            watchShaders_ = true;
+            spdlog::info("Shader hot reload enabled");
+        }
+        else if (arg == "--no-shader-cache") {
+            useShaderCache_ = false;
+            spdlog::info("Shader program cache disabled");
+        }
+        else if (arg == "--no-mesh-cache") {
+            useMeshCache_ = false;
+            spdlog::info("Planet mesh cache disabled");
+        }
+        else if (arg == "--gpu-displacement") {
+            shaderDisplacement_ = true;
+        }
+        else if (arg == "--autosave" && i + 1 < argc) {
+            try {
+                autosaveInterval_ = std::stof(argv[i + 1]);
+                spdlog::info("Autosave interval: {}s", autosaveInterval_);
+                ++i; // Skip next argument
+            }
+            catch (const std::exception& e) {
+                spdlog::warn("Invalid autosave interval: {}", argv[i + 1]);
+            }
+        }
+        else if (arg == "--record" && i + 1 < argc) {
+            recordPath_ = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            replayPath_ = argv[++i];
+        }
+        else if (arg == "--timings" && i + 1 < argc) {
+            timingsPath_ = argv[++i];
+        }
+        else if (arg == "--benchmark-path" && i + 1 < argc) {
+            benchmarkPath_ = argv[++i];
+        }
+        else if (arg == "--benchmark-output" && i + 1 < argc) {
+            benchmarkOutput_ = argv[++i];
+        }
+        else if (arg == "--hidden") {
+            hiddenWindow_ = true;
+        }
+        else if (arg == "--headless") {
+            headless_ = true;
+        }
+        else if (arg == "--gl-null") {
+            glNullBackend_ = true;
+        }
+        else if (arg == "--gl-stats") {
+            glStats_ = true;
+        }
+        else if (arg == "--thumbnails" && i + 1 < argc) {
+            try {
+                thumbnailCount_ = std::max(std::stoi(argv[i + 1]), 0);
+                ++i; // Skip next argument
+            }
+            catch (const std::exception& e) {
+                spdlog::warn("Invalid thumbnail count: {}", argv[i + 1]);
+            }
+        }
+        else if (arg == "--thumbnail-seed" && i + 1 < argc) {
+            try {
+                thumbnailFirstSeed_ = std::max(std::stoi(argv[i + 1]), 0);
+                ++i; // Skip next argument
+            }
+            catch (const std::exception& e) {
+                spdlog::warn("Invalid thumbnail seed: {}", argv[i + 1]);
+            }
+        }
+        else if (arg == "--thumbnail-size" && i + 1 < argc) {
+            int width = 0;
+            int height = 0;
+            char separator = 0;
+            std::istringstream size(argv[i + 1]);
+            if (size >> width >> separator >> height && separator == 'x' && width > 0 && height > 0) {
+                thumbnailWidth_ = width;
+                thumbnailHeight_ = height;
+            } else {
+                spdlog::warn("Invalid thumbnail size: {} (expected <width>x<height>)", argv[i + 1]);
+            }
+            ++i; // Skip next argument
+        }
+        else if (arg == "--thumbnail-dir" && i + 1 < argc) {
+            thumbnailDirectory_ = argv[++i];
+        }
         else if (arg == "--help" || arg == "-h") {
             std::cout << "Procedural Universe Generator\n";
             std::cout << "Usage: " << argv[0] << " [options]\n";
             std::cout << "Options:\n";
             std::cout << "  --seed <number>  Set generation seed (default: 1337)\n";
+            std::cout << "  --no-snapshot    Always regenerate instead of loading system snapshots\n";
+            std::cout << "  --no-mesh-cache  Always evaluate terrain noise instead of using cached heights and surface maps\n";
+            std::cout << "  --gpu-displacement  Displace planet terrain in the vertex shader from height cubemaps\n";
+            std::cout << "  --no-shader-cache  Always compile shaders instead of loading cached program binaries\n";
+            std::cout << "  --watch-shaders   Recompile shaders when their source files change\n";
+            std::cout << "  --autosave <sec> Autosave interval in seconds, 0 to disable (default: 120)\n";
+            std::cout << "  --record <file>  Record input and UI actions to a session log\n";
+            std::cout << "  --replay <file>  Replay a session log uncapped and write per-frame timings\n";
+            std::cout << "  --timings <file> Per-frame timing CSV (default on replay: <log>.timings.csv)\n";
+            std::cout << "  --hidden         Run with an invisible window (for unattended replays)\n";
+            std::cout << "  --benchmark-path <file>    Fly a keyframed camera path at a fixed timestep and report timings\n";
+            std::cout << "  --benchmark-output <file>  Benchmark report (default: <path>.results.json)\n";
+            std::cout << "  --thumbnails <count>       Render <count> consecutive seeds offscreen to PNG files and exit\n";
+            std::cout << "  --thumbnail-seed <number>  First thumbnail seed (default: system seed)\n";
+            std::cout << "  --thumbnail-size <WxH>     Thumbnail resolution (default: 256x256)\n";
+            std::cout << "  --thumbnail-dir <dir>      Thumbnail output directory (default: thumbnails)\n";
+            std::cout << "  --headless       Use an OSMesa/EGL context without a window system, falling back to --hidden\n";
+            std::cout << "  --gl-null        Send renderer OpenGL calls to a null backend (CPU cost only, implies --gl-stats)\n";
+            std::cout << "  --gl-stats       Count OpenGL calls and upload bytes per frame and per function\n";
             std::cout << "  --help, -h       Show this help message\n";
             running_ = false;
             return;
@@ -466,27 +1033,79 @@ void App::update(float deltaTime) {
     if (solarSystemManager_) {
         solarSystemManager_->update(deltaTime);
     }
+    
+    // Apply configs finished loading in the background and run autosave
+    if (configManager_) {
+        if (configManager_->applyLoadedConfigs(camera_.get(), solarSystemManager_.get()) > 0) {
+            // Update systemSeed_ to match the loaded configuration
+            systemSeed_ = solarSystemManager_->getSeed();
+            
+            // Record the resulting state; the file may not exist when the session is replayed
+            if (sessionRecorder_) {
+                pendingActions_.push_back(SessionAction::withText(SessionAction::Type::ApplyConfig,
+                    configManager_->captureConfigJson(camera_.get(), solarSystemManager_.get())));
+            }
+        }
+        configManager_->updateAutosave(deltaTime, camera_.get(), solarSystemManager_.get());
+    }
+    
+    if (watchShaders_) {
+        shaderWatchTimer_ += deltaTime;
+        if (shaderWatchTimer_ >= SHADER_WATCH_INTERVAL) {
+            shaderWatchTimer_ = 0.0f;
+            reloadChangedShaders();
+        }
+    }
+}
+
+void App::reloadChangedShaders() {
+    int reloaded = 0;
+    for (Shader* shader : {basicShader_.get(), texturedShader_.get(), skyboxShader_.get(), sunShader_.get(),
+                           asteroidShader_.get(), ringShader_.get()}) {
+        if (shader && shader->reloadIfChanged()) {
+            ++reloaded;
+        }
+    }
+    for (ShaderVariants* variants : {planetShaders_.get(), particleShaders_.get()}) {
+        if (variants) {
+            reloaded += variants->reloadIfChanged();
+        }
+    }
+    if (reloaded > 0) {
+        spdlog::info("Reloaded {} shader programs", reloaded);
+    }
 }
 
 void App::render() {
+    if (textureStreamer_) {
+        textureStreamer_->update();
+    }
+    
+    renderScene(window_->getWidth(), window_->getHeight());
+    
+    // Render ImGui
+    renderImGui();
+}
+
+void App::renderScene(int width, int height) {
+    const float aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+    
     // Clear screen
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    gl.Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     
     // Render skybox first (before other objects)
     if (skyboxShader_ && skyboxShader_->isValid() && skyboxGeometry_ && skyboxGeometry_->isValid() && camera_) {
         // Disable face culling for skybox (we're inside the cube)
-        glDisable(GL_CULL_FACE);
+        gl.Disable(GL_CULL_FACE);
         
         // Change depth function to less equal for skybox
-        glDepthFunc(GL_LEQUAL);
+        gl.DepthFunc(GL_LEQUAL);
         
         skyboxShader_->use();
         
         // Get camera matrices (remove translation from view matrix)
         glm::mat4 view = glm::mat4(glm::mat3(camera_->getViewMatrix())); // Remove translation
-        glm::mat4 projection = camera_->getProjectionMatrix(
-            static_cast<float>(window_->getWidth()) / static_cast<float>(window_->getHeight())
-        );
+        glm::mat4 projection = camera_->getProjectionMatrix(aspectRatio);
         
         // Send matrices to skybox shader
         skyboxShader_->setMat4("uView", view);
@@ -521,8 +1140,8 @@ void App::render() {
         skyboxShader_->unuse();
         
         // Re-enable face culling and reset depth function
-        glEnable(GL_CULL_FACE);
-        glDepthFunc(GL_LESS);
+        gl.Enable(GL_CULL_FACE);
+        gl.DepthFunc(GL_LESS);
     }
     
 
@@ -530,98 +1149,18 @@ void App::render() {
 
     
     // Render solar system (sun and planets)
-    if (solarSystemManager_ && planetShader_ && sunShader_) {
+    if (solarSystemManager_ && planetShaders_ && sunShader_) {
         // Get camera matrices
         glm::mat4 view = camera_->getViewMatrix();
-        glm::mat4 projection = camera_->getProjectionMatrix(
-            static_cast<float>(window_->getWidth()) / static_cast<float>(window_->getHeight())
-        );
+        glm::mat4 projection = camera_->getProjectionMatrix(aspectRatio);
         
         glm::vec3 viewPos = camera_->getPosition();
         
-        // Set motion blur uniforms for all shaders if motion blur is enabled
-        if (camera_->isMotionBlurEnabled()) {
-            glm::vec3 cameraVelocity = camera_->getVelocity();
-            
-            // Set velocity uniform for planet shader
-            if (planetShader_->isValid()) {
-                planetShader_->use();
-                planetShader_->setVec3("uCameraVelocity", cameraVelocity);
-                planetShader_->setBool("uMotionBlurEnabled", true);
-                planetShader_->unuse();
-            }
-            
-            // Set velocity uniform for sun shader
-            if (sunShader_->isValid()) {
-                sunShader_->use();
-                sunShader_->setVec3("uCameraVelocity", cameraVelocity);
-                sunShader_->setBool("uMotionBlurEnabled", true);
-                sunShader_->unuse();
-            }
-            
-            // Set velocity uniform for asteroid shader
-            if (asteroidShader_ && asteroidShader_->isValid()) {
-                asteroidShader_->use();
-                asteroidShader_->setVec3("uCameraVelocity", cameraVelocity);
-                asteroidShader_->setBool("uMotionBlurEnabled", true);
-                asteroidShader_->unuse();
-            }
-            
-            // Set velocity uniform for ring shader
-            if (ringShader_ && ringShader_->isValid()) {
-                ringShader_->use();
-                ringShader_->setVec3("uCameraVelocity", cameraVelocity);
-                ringShader_->setBool("uMotionBlurEnabled", true);
-                ringShader_->unuse();
-            }
-            
-            // Set velocity uniform for particle shader
-            if (particleShader_ && particleShader_->isValid()) {
-                particleShader_->use();
-                particleShader_->setVec3("uCameraVelocity", cameraVelocity);
-                particleShader_->setBool("uMotionBlurEnabled", true);
-                particleShader_->unuse();
-            }
-        } else {
-            // Disable motion blur for all shaders
-            if (planetShader_->isValid()) {
-                planetShader_->use();
-                planetShader_->setBool("uMotionBlurEnabled", false);
-                planetShader_->unuse();
-            }
-            
-            if (sunShader_->isValid()) {
-                sunShader_->use();
-                sunShader_->setBool("uMotionBlurEnabled", false);
-                sunShader_->unuse();
-            }
-            
-            if (asteroidShader_ && asteroidShader_->isValid()) {
-                asteroidShader_->use();
-                asteroidShader_->setBool("uMotionBlurEnabled", false);
-                asteroidShader_->unuse();
-            }
-            
-            if (ringShader_ && ringShader_->isValid()) {
-                ringShader_->use();
-                ringShader_->setBool("uMotionBlurEnabled", false);
-                ringShader_->unuse();
-            }
-            
-            if (particleShader_ && particleShader_->isValid()) {
-                particleShader_->use();
-                particleShader_->setBool("uMotionBlurEnabled", false);
-                particleShader_->unuse();
-            }
-        }
-        
         // Render entire solar system (sun provides lighting for planets)
-        solarSystemManager_->render(planetShader_.get(), sunShader_.get(), asteroidShader_.get(), 
-                                   ringShader_.get(), particleShader_.get(), camera_.get(), view, projection, viewPos);
+        solarSystemManager_->render(planetShaders_.get(), sunShader_.get(), asteroidShader_.get(), 
+                                   ringShader_.get(), particleShaders_.get(), camera_.get(), view, projection, viewPos,
+                                   height);
     }
-    
-    // Render ImGui
-    renderImGui();
 }
 
 void App::initImGui() {
@@ -676,6 +1215,9 @@ void App::renderImGui() {
     
     if (ImGui::Begin("Astralis Engine Control Panel", nullptr, ImGuiWindowFlags_NoCollapse)) {
         
+        // Controls are read-only while a recorded session drives the state
+        ImGui::BeginDisabled(isScriptedRun());
+        
         // Tab bar for organized sections
         if (ImGui::BeginTabBar("ControlTabs")) {
             
@@ -688,24 +1230,18 @@ void App::renderImGui() {
                 ImGui::Separator();
                 
                 if (ImGui::SliderInt("Planets", &planetCount_, 3, 15)) {
-                    if (solarSystemManager_) {
-                        solarSystemManager_->generateSolarSystem(systemSeed_, planetCount_);
-                    }
+                    performAction(SessionAction::withInts(SessionAction::Type::Regenerate, systemSeed_, planetCount_));
                 }
                 
                 ImGui::PushItemWidth(200);
                 if (ImGui::InputInt("Seed", &systemSeed_)) {
-                    if (solarSystemManager_) {
-                        solarSystemManager_->generateSolarSystem(systemSeed_, planetCount_);
-                    }
+                    performAction(SessionAction::withInts(SessionAction::Type::Regenerate, systemSeed_, planetCount_));
                 }
                 ImGui::PopItemWidth();
                 
                 if (ImGui::Button("🎲 Random System", ImVec2(-1, 0))) {
-                    systemSeed_ = static_cast<int>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-                    if (solarSystemManager_) {
-                        solarSystemManager_->generateSolarSystem(systemSeed_, planetCount_);
-                    }
+                    int randomSeed = static_cast<int>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+                    performAction(SessionAction::withInts(SessionAction::Type::Regenerate, randomSeed, planetCount_));
                 }
                 
                 ImGui::Spacing();
@@ -716,19 +1252,37 @@ void App::renderImGui() {
                     static bool asteroidsVisible = true;
                     ImGui::Checkbox("Asteroid Belts", &asteroidsVisible);
                     if (ImGui::IsItemDeactivatedAfterEdit()) {
-                        solarSystemManager_->setAsteroidBeltsVisible(asteroidsVisible);
+                        performAction(SessionAction::withInts(SessionAction::Type::SetAsteroidsVisible, asteroidsVisible));
                     }
                     
                     static bool ringsVisible = true;
                     ImGui::Checkbox("Planetary Rings", &ringsVisible);
                     if (ImGui::IsItemDeactivatedAfterEdit()) {
-                        solarSystemManager_->setPlanetaryRingsVisible(ringsVisible);
+                        performAction(SessionAction::withInts(SessionAction::Type::SetRingsVisible, ringsVisible));
                     }
                     
                     static bool particlesVisible = true;
                     ImGui::Checkbox("Particle Effects", &particlesVisible);
                     if (ImGui::IsItemDeactivatedAfterEdit()) {
-                        solarSystemManager_->setParticleSystemsVisible(particlesVisible);
+                        performAction(SessionAction::withInts(SessionAction::Type::SetParticlesVisible, particlesVisible));
+                    }
+                    
+                    // Density changes regenerate geometry, so apply them once the slider is released
+                    float asteroidDensity = solarSystemManager_->getAsteroidDensity();
+                    ImGui::SliderFloat("Asteroid Density", &asteroidDensity, 0.1f, 2.0f);
+                    if (ImGui::IsItemDeactivatedAfterEdit()) {
+                        performAction(SessionAction::withFloat(SessionAction::Type::SetAsteroidDensity, asteroidDensity));
+                    }
+                    
+                    float ringDensity = solarSystemManager_->getRingDensity();
+                    ImGui::SliderFloat("Ring Density", &ringDensity, 0.1f, 3.0f);
+                    if (ImGui::IsItemDeactivatedAfterEdit()) {
+                        performAction(SessionAction::withFloat(SessionAction::Type::SetRingDensity, ringDensity));
+                    }
+                    
+                    float emissionRate = solarSystemManager_->getParticleEmissionRate();
+                    if (ImGui::SliderFloat("Particle Rate", &emissionRate, 0.1f, 5.0f)) {
+                        performAction(SessionAction::withFloat(SessionAction::Type::SetEmissionRate, emissionRate));
                     }
                 }
                 
@@ -757,7 +1311,7 @@ void App::renderImGui() {
                 const char* modes[] = {"Free Fly", "Orbit", "Follow", "Cinematic", "First Person", "Planetary Surface"};
                 
                 if (ImGui::Combo("Mode", &currentMode, modes, IM_ARRAYSIZE(modes))) {
-                    camera_->setMode(static_cast<Camera::Mode>(currentMode));
+                    performAction(SessionAction::withInts(SessionAction::Type::SetCameraMode, currentMode));
                 }
                 
                 ImGui::Spacing();
@@ -768,17 +1322,17 @@ void App::renderImGui() {
                 static float mouseSensitivity = 0.1f;
                 
                 if (ImGui::SliderFloat("Speed", &moveSpeed, 0.1f, 50.0f)) {
-                    camera_->setMovementSpeed(moveSpeed);
+                    performAction(SessionAction::withFloat(SessionAction::Type::SetMovementSpeed, moveSpeed));
                 }
                 
                 if (ImGui::SliderFloat("Sensitivity", &mouseSensitivity, 0.01f, 1.0f)) {
-                    camera_->setMouseSensitivity(mouseSensitivity);
+                    performAction(SessionAction::withFloat(SessionAction::Type::SetMouseSensitivity, mouseSensitivity));
                 }
                 
                 // Motion Blur setting
                 static bool motionBlurEnabled = false;
                 if (ImGui::Checkbox("Motion Blur", &motionBlurEnabled)) {
-                    camera_->enableMotionBlur(motionBlurEnabled);
+                    performAction(SessionAction::withInts(SessionAction::Type::SetMotionBlur, motionBlurEnabled));
                 }
                 
                 // Mode-specific controls
@@ -791,17 +1345,15 @@ void App::renderImGui() {
                     static float orbitSpeed = 1.0f;
                     
                     if (ImGui::SliderFloat("Distance", &orbitDistance, 50.0f, 1000.0f)) {
-                        camera_->setOrbitDistance(orbitDistance);
+                        performAction(SessionAction::withFloat(SessionAction::Type::SetOrbitDistance, orbitDistance));
                     }
                     
                     if (ImGui::SliderFloat("Speed", &orbitSpeed, 0.1f, 5.0f)) {
-                        camera_->setOrbitSpeed(orbitSpeed);
+                        performAction(SessionAction::withFloat(SessionAction::Type::SetOrbitSpeed, orbitSpeed));
                     }
                     
                     if (ImGui::Button("Target Sun", ImVec2(-1, 0))) {
-                        if (solarSystemManager_ && solarSystemManager_->getSun()) {
-                            camera_->setTargetSun(solarSystemManager_->getSun());
-                        }
+                        performAction(cameraCommand(SessionAction::CameraCommand::TargetSun));
                     }
                     
                     // Planet targeting buttons
@@ -815,18 +1367,11 @@ void App::renderImGui() {
                         int maxPlanets = static_cast<int>(solarSystemManager_->getPlanetManager()->getPlanetCount()) - 1;
                         
                         if (ImGui::SliderInt("Planet", &targetPlanetIndex, 0, maxPlanets)) {
-                            PlanetInstance* planet = solarSystemManager_->getPlanetManager()->getPlanet(targetPlanetIndex);
-                            if (planet) {
-                                camera_->setTarget(planet->position);
-                            }
+                            performAction(cameraCommand(SessionAction::CameraCommand::TargetPlanet, targetPlanetIndex));
                         }
                         
                         if (ImGui::Button("Go to Planet", ImVec2(-1, 0))) {
-                            PlanetInstance* planet = solarSystemManager_->getPlanetManager()->getPlanet(targetPlanetIndex);
-                            if (planet) {
-                                camera_->setTarget(planet->position);
-                                camera_->transitionToTarget(planet->position, 100.0f, 2.0f, Camera::TransitionType::EASE_IN_OUT);
-                            }
+                            performAction(cameraCommand(SessionAction::CameraCommand::GoToPlanet, targetPlanetIndex));
                         }
                     }
                 }
@@ -836,19 +1381,11 @@ void App::renderImGui() {
                 ImGui::Separator();
                 
                 if (ImGui::Button("System Tour", ImVec2(-1, 0))) {
-                    std::vector<glm::vec3> waypoints = {
-                        glm::vec3(0.0f, 0.0f, 500.0f),
-                        glm::vec3(200.0f, 100.0f, 200.0f),
-                        glm::vec3(0.0f, 200.0f, 0.0f),
-                        glm::vec3(-200.0f, 50.0f, 200.0f),
-                        glm::vec3(0.0f, 0.0f, 100.0f)
-                    };
-                    camera_->startCinematicPath(waypoints, 15.0f);
-                    camera_->playCinematicSequence();
+                    performAction(cameraCommand(SessionAction::CameraCommand::SystemTour));
                 }
                 
                 if (ImGui::Button("Reset Camera", ImVec2(-1, 0))) {
-                    camera_->resetToDefault();
+                    performAction(cameraCommand(SessionAction::CameraCommand::Reset));
                 }
                 
                 ImGui::EndTabItem();
@@ -878,9 +1415,7 @@ void App::renderImGui() {
                 ImGui::Separator();
                 
                 if (ImGui::SliderFloat("Max Distance", &maxRenderDistance_, 100.0f, 2000.0f)) {
-                    if (solarSystemManager_ && solarSystemManager_->getPlanetManager()) {
-                        solarSystemManager_->getPlanetManager()->setMaxRenderDistance(maxRenderDistance_);
-                    }
+                    performAction(SessionAction::withFloat(SessionAction::Type::SetMaxRenderDistance, maxRenderDistance_));
                 }
                 
                 ImGui::Spacing();
@@ -889,6 +1424,17 @@ void App::renderImGui() {
                 
                 ImGui::Text("FPS: %.1f", ImGui::GetIO().Framerate);
                 ImGui::Text("Frame Time: %.3f ms", 1000.0f / ImGui::GetIO().Framerate);
+                ImGui::Text("Draw Calls: %llu", static_cast<unsigned long long>(lastFrameStats_.drawCalls));
+                if (solarSystemManager_) {
+                    const ScreenSpaceLOD& lod = solarSystemManager_->getLOD();
+                    ImGui::Text("LOD Triangles: %llu / %llu", static_cast<unsigned long long>(lod.getTriangleCount()),
+                                static_cast<unsigned long long>(lod.getTriangleBudget()));
+                    ImGui::Text("LOD Coarsened: %zu of %zu", lod.getCoarsenedCount(), lod.getRequestCount());
+                }
+                if (GLApi::isCounting()) {
+                    ImGui::Text("GL Calls: %llu", static_cast<unsigned long long>(lastFrameStats_.glCalls));
+                    ImGui::Text("Uploads: %.1f KB", static_cast<double>(lastFrameStats_.uploadBytes) / 1024.0);
+                }
                 
                 ImGui::EndTabItem();
             }
@@ -931,6 +1477,37 @@ void App::renderImGui() {
                             ImGui::Text("Geometry Info:");
                             ImGui::Text("Vertices: %d", planet->planet->getGeometry()->getVertexCount());
                             ImGui::Text("Resolution: %d", planet->planet->getResolution());
+                            
+                            // Applied on the next frame; with --gpu-displacement only the height map is re-baked
+                            ImGui::Separator();
+                            ImGui::Text("Terrain (%s):", planet->planet->usesShaderDisplacement() ? "vertex shader" : "mesh");
+                            Planet* terrain = planet->planet.get();
+                            float heightScale = terrain->getHeightScale();
+                            if (ImGui::SliderFloat("Height Scale", &heightScale, 0.0f, 2.0f)) {
+                                terrain->setHeightScale(heightScale);
+                            }
+                            float noiseFrequency = terrain->getNoiseFrequency();
+                            if (ImGui::SliderFloat("Noise Frequency", &noiseFrequency, 0.005f, 0.1f, "%.3f")) {
+                                terrain->setNoiseFrequency(noiseFrequency);
+                            }
+                            bool terrainEdited = ImGui::IsItemDeactivatedAfterEdit();
+                            int noiseOctaves = terrain->getNoiseOctaves();
+                            if (ImGui::SliderInt("Octaves", &noiseOctaves, 1, 8)) {
+                                terrain->setNoiseOctaves(noiseOctaves);
+                            }
+                            terrainEdited = terrainEdited || ImGui::IsItemDeactivatedAfterEdit();
+                            bool terrainFeatures = terrain->getTerrainPostProcess().isEnabled();
+                            if (ImGui::Checkbox("Craters & Erosion", &terrainFeatures)) {
+                                terrain->setTerrainPostProcess(terrainFeatures
+                                    ? SystemGenerator::generateTerrainFeatures(planet->type, planet->seed)
+                                    : TerrainPostProcess::Settings{});
+                            }
+                            terrainEdited = terrainEdited || ImGui::IsItemDeactivatedAfterEdit();
+                            
+                            // Biomes follow the heights; re-bake them once the edit is finished
+                            if (terrainEdited) {
+                                solarSystemManager_->getPlanetManager()->refreshBiomeMap(*planet);
+                            }
                         }
                     }
                 } else {
@@ -953,9 +1530,7 @@ void App::renderImGui() {
                 if (ImGui::Button("💾 Save Full Config", ImVec2(-1, 0))) {
                     if (configManager_ && camera_ && solarSystemManager_) {
                         std::string filename = "configs/full_config_" + getCurrentTimeString() + ".json";
-                        if (configManager_->saveConfig(filename, camera_.get(), solarSystemManager_.get())) {
-                            spdlog::info("Configuration saved to: {}", filename);
-                        } else {
+                        if (!configManager_->saveConfigAsync(filename, camera_.get(), solarSystemManager_.get())) {
                             spdlog::error("Failed to save configuration");
                         }
                     }
@@ -964,9 +1539,7 @@ void App::renderImGui() {
                 if (ImGui::Button("📷 Save Camera Only", ImVec2(-1, 0))) {
                     if (configManager_ && camera_) {
                         std::string filename = "configs/camera_config_" + getCurrentTimeString() + ".json";
-                        if (configManager_->saveCameraConfig(filename, camera_.get())) {
-                            spdlog::info("Camera configuration saved to: {}", filename);
-                        } else {
+                        if (!configManager_->saveCameraConfigAsync(filename, camera_.get())) {
                             spdlog::error("Failed to save camera configuration");
                         }
                     }
@@ -980,24 +1553,14 @@ void App::renderImGui() {
                     // Use the most recent config file
                     if (configManager_ && camera_ && solarSystemManager_) {
                         std::string filename = "configs/full_config_20250928_144917.json";
-                        if (configManager_->loadConfig(filename, camera_.get(), solarSystemManager_.get())) {
-                            // Update systemSeed_ to match the loaded configuration
-                            systemSeed_ = solarSystemManager_->getSeed();
-                            spdlog::info("Configuration loaded from: {}", filename);
-                        } else {
-                            spdlog::warn("Could not load configuration from: {}", filename);
-                        }
+                        configManager_->loadConfigAsync(filename);
                     }
                 }
                 
                 if (ImGui::Button("📷 Load Camera Only", ImVec2(-1, 0))) {
                     if (configManager_ && camera_) {
                         std::string filename = "configs/camera_config.json";
-                        if (configManager_->loadCameraConfig(filename, camera_.get())) {
-                            spdlog::info("Camera configuration loaded from: {}", filename);
-                        } else {
-                            spdlog::warn("Could not load camera configuration from: {}", filename);
-                        }
+                        configManager_->loadConfigAsync(filename, true);
                     }
                 }
                 
@@ -1008,18 +1571,14 @@ void App::renderImGui() {
                 if (ImGui::Button("🔄 Auto-Save Current", ImVec2(-1, 0))) {
                     if (configManager_ && camera_ && solarSystemManager_) {
                         std::string filename = "configs/autosave.json";
-                        if (configManager_->saveConfig(filename, camera_.get(), solarSystemManager_.get())) {
-                            spdlog::info("Auto-saved configuration");
-                        }
+                        configManager_->saveConfigAsync(filename, camera_.get(), solarSystemManager_.get());
                     }
                 }
                 
                 if (ImGui::Button("⚡ Load Auto-Save", ImVec2(-1, 0))) {
                     if (configManager_ && camera_ && solarSystemManager_) {
                         std::string filename = "configs/autosave.json";
-                        if (configManager_->loadConfig(filename, camera_.get(), solarSystemManager_.get())) {
-                            spdlog::info("Loaded auto-saved configuration");
-                        }
+                        configManager_->loadConfigAsync(filename);
                     }
                 }
                 
@@ -1028,6 +1587,8 @@ void App::renderImGui() {
             
             ImGui::EndTabBar();
         }
+        
+        ImGui::EndDisabled();
     }
     ImGui::End();
 
@@ -1050,33 +1611,23 @@ void App::renderImGui() {
         }
         
         // Quick camera controls
+        ImGui::BeginDisabled(isScriptedRun());
         if (ImGui::Button("🏠", ImVec2(30, 25))) {
-            camera_->resetToDefault();
+            performAction(cameraCommand(SessionAction::CameraCommand::Reset));
         }
         ImGui::SameLine();
         if (ImGui::Button("☀️", ImVec2(30, 25))) {
-            camera_->transitionToTarget(glm::vec3(0.0f, 0.0f, 0.0f), 300.0f, 2.0f, Camera::TransitionType::EASE_IN_OUT);
+            performAction(cameraCommand(SessionAction::CameraCommand::FocusSun));
         }
         ImGui::SameLine();
         if (ImGui::Button("🔄", ImVec2(30, 25))) {
-            camera_->setMode(Camera::Mode::ORBIT);
-            camera_->setTarget(glm::vec3(0.0f, 0.0f, 0.0f));
+            performAction(cameraCommand(SessionAction::CameraCommand::OrbitSun));
         }
         ImGui::SameLine();
         if (ImGui::Button("🎬", ImVec2(30, 25))) {
-            if (camera_->isCinematicPlaying()) {
-                camera_->stopCinematicSequence();
-            } else {
-                std::vector<glm::vec3> waypoints = {
-                    glm::vec3(0.0f, 0.0f, 500.0f),
-                    glm::vec3(200.0f, 100.0f, 200.0f),
-                    glm::vec3(0.0f, 200.0f, 0.0f),
-                    glm::vec3(0.0f, 0.0f, 100.0f)
-                };
-                camera_->startCinematicPath(waypoints, 12.0f);
-                camera_->playCinematicSequence();
-            }
+            performAction(cameraCommand(SessionAction::CameraCommand::ToggleQuickTour));
         }
+        ImGui::EndDisabled();
     }
     ImGui::End();
 
@@ -2,7 +2,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
+#include "RenderStats.hpp"
 
 // ImGui includes
 #include "imgui.h"
@@ -12,6 +14,8 @@
 // Forward declarations
 class Window;
 class Shader;
+class ShaderCache;
+class ShaderVariants;
 class Camera;
 class Geometry;
 class Noise;
@@ -19,9 +23,15 @@ class Planet;
 class PlanetManager;
 class SolarSystemManager;
 class ConfigManager;
+class SessionRecorder;
+class SessionPlayer;
+class FrameTimingLog;
+class CameraPathBenchmark;
+struct SessionAction;
 namespace Core { 
     class InputManager; 
     class Texture;
+    class TextureStreamer;
 }
 
 class App {
@@ -45,12 +55,33 @@ private:
     void processCommandLine(int argc, char** argv);
     void update(float deltaTime);
     void render();
+    // Rebuild programs whose sources changed on disk (--watch-shaders)
+    void reloadChangedShaders();
+    // Draw the skybox and solar system into the bound framebuffer of the given size
+    void renderScene(int width, int height);
     
     // ImGui methods
     void initImGui();
     void shutdownImGui();
     void renderImGui();
     
+    // Session recording and replay
+    void initSession();
+    // Apply a UI action and record it when a session is being recorded
+    void performAction(const SessionAction& action);
+    void applyAction(const SessionAction& action);
+    void applyCameraCommand(const SessionAction& action);
+    
+    // Camera path benchmark
+    void initBenchmark();
+    void finishBenchmark();
+    
+    // Batch thumbnail rendering, runs instead of the main loop
+    void renderThumbnails();
+    
+    // Replays, benchmarks and thumbnail batches own the simulation: no UI edits, vsync, frame cap or autosave
+    bool isScriptedRun() const { return sessionPlayer_ != nullptr || benchmark_ != nullptr || thumbnailCount_ > 0; }
+    
     // Utility methods
     std::string getCurrentTimeString() const;
 
@@ -58,17 +89,24 @@ private:
     std::unique_ptr<Shader> basicShader_;
     std::unique_ptr<Shader> texturedShader_;
     std::unique_ptr<Shader> skyboxShader_;
-    std::unique_ptr<Shader> planetShader_;
+    std::unique_ptr<ShaderVariants> planetShaders_;
     std::unique_ptr<Shader> sunShader_;
     std::unique_ptr<Shader> asteroidShader_;
     std::unique_ptr<Shader> ringShader_;
-    std::unique_ptr<Shader> particleShader_;
+    std::unique_ptr<ShaderVariants> particleShaders_;
+    std::unique_ptr<ShaderCache> shaderCache_;
+    bool useShaderCache_ = true;
+    bool watchShaders_ = false;
+    float shaderWatchTimer_ = 0.0f;
+    static constexpr float SHADER_WATCH_INTERVAL = 0.5f; // Seconds between source file checks
     std::unique_ptr<Camera> camera_;
 
     std::unique_ptr<Geometry> skyboxGeometry_;
     std::unique_ptr<Core::Texture> checkerboardTexture_;
     std::unique_ptr<Core::Texture> brickTexture_;
     std::unique_ptr<Core::Texture> skyboxTexture_;
+    std::unique_ptr<Core::TextureStreamer> textureStreamer_;
+    static constexpr size_t TEXTURE_UPLOAD_BUDGET = 4 * 1024 * 1024; // Bytes streamed to the GPU per frame
     std::unique_ptr<Noise> noise_;
     std::unique_ptr<SolarSystemManager> solarSystemManager_;
     std::unique_ptr<ConfigManager> configManager_;
@@ -84,4 +122,39 @@ private:
     int planetCount_ = 8;
     int systemSeed_ = 1337;
     float maxRenderDistance_ = 500.0f;
+    bool useSnapshots_ = true;
+    bool useMeshCache_ = true;
+    bool shaderDisplacement_ = false; // Displace planet terrain in planet.vert (--gpu-displacement)
+    
+    // Autosave parameters
+    static constexpr int AUTOSAVE_HISTORY = 5;
+    float autosaveInterval_ = 120.0f;
+    
+    // Session recording and replay
+    std::string recordPath_;
+    std::string replayPath_;
+    std::string timingsPath_;
+    bool hiddenWindow_ = false;
+    bool headless_ = false;
+    std::unique_ptr<SessionRecorder> sessionRecorder_;
+    std::unique_ptr<SessionPlayer> sessionPlayer_;
+    std::unique_ptr<FrameTimingLog> frameTimings_;
+    std::vector<SessionAction> pendingActions_;
+    
+    // Camera path benchmark
+    std::string benchmarkPath_;
+    std::string benchmarkOutput_;
+    std::unique_ptr<CameraPathBenchmark> benchmark_;
+    
+    // Batch thumbnail rendering
+    int thumbnailCount_ = 0;
+    int thumbnailFirstSeed_ = -1; // -1 starts at the system seed
+    int thumbnailWidth_ = 256;
+    int thumbnailHeight_ = 256;
+    std::string thumbnailDirectory_ = "thumbnails";
+    
+    // OpenGL dispatch backend
+    bool glNullBackend_ = false;
+    bool glStats_ = false;
+    RenderStats::Counters lastFrameStats_; // Shown in the performance panel
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "AsteroidBelt.hpp"
 #include "Shader.hpp"
+#include "ClusteredLighting.hpp"
 #include "Camera.hpp"
 #include "Geometry.hpp"
 #include <random>
@@ -10,21 +11,39 @@ AsteroidBelt::AsteroidBelt(float innerRadius, float outerRadius, int asteroidCou
     : innerRadius_(innerRadius)
     , outerRadius_(outerRadius)
     , asteroidCount_(asteroidCount)
+    , baseAsteroidCount_(asteroidCount)
     , seed_(seed)
     , visible_(true)
     , orbitSpeedMultiplier_(1.0f)
     , maxRenderDistance_(5000.0f)
-    , asteroidGeometry_(nullptr)
+    , lodLevels_(nullptr)
 {
     generateAsteroids();
     spdlog::info("Created asteroid belt: inner={:.1f}, outer={:.1f}, count={}", 
                  innerRadius_, outerRadius_, asteroidCount_);
 }
 
+AsteroidBelt::AsteroidBelt(float innerRadius, float outerRadius, std::vector<Asteroid> asteroids, int seed)
+    : innerRadius_(innerRadius)
+    , outerRadius_(outerRadius)
+    , asteroidCount_(static_cast<int>(asteroids.size()))
+    , baseAsteroidCount_(static_cast<int>(asteroids.size()))
+    , seed_(seed)
+    , visible_(true)
+    , orbitSpeedMultiplier_(1.0f)
+    , maxRenderDistance_(5000.0f)
+    , asteroids_(std::move(asteroids))
+    , lodLevels_(nullptr)
+{
+    spdlog::info("Restored asteroid belt: inner={:.1f}, outer={:.1f}, count={}", 
+                 innerRadius_, outerRadius_, asteroidCount_);
+}
+
 AsteroidBelt::~AsteroidBelt() = default;
 
-void AsteroidBelt::initialize(Geometry* asteroidGeometry) {
-    asteroidGeometry_ = asteroidGeometry;
+void AsteroidBelt::initialize(std::vector<Geometry*> lodGeometries, const std::vector<ScreenSpaceLOD::Level>* lodLevels) {
+    lodGeometries_ = std::move(lodGeometries);
+    lodLevels_ = lodLevels;
 }
 
 void AsteroidBelt::generateAsteroids() {
@@ -101,12 +120,31 @@ void AsteroidBelt::updateAsteroidPositions(float deltaTime) {
     }
 }
 
+void AsteroidBelt::requestLOD(ScreenSpaceLOD& lod, const glm::vec3& cameraPos) {
+    lodRequests_.clear();
+    if (!visible_ || !lodLevels_) {
+        return;
+    }
+
+    // Same distance cut as render()
+    for (const auto& asteroid : asteroids_) {
+        if (glm::length(asteroid.position - cameraPos) > maxRenderDistance_) {
+            lodRequests_.push_back(ScreenSpaceLOD::NO_REQUEST);
+        } else {
+            lodRequests_.push_back(lod.request(asteroid.position, asteroid.scale, *lodLevels_, -1, true));
+        }
+    }
+}
+
 void AsteroidBelt::render(Shader* shader, const Camera* camera, const glm::mat4& view, 
                          const glm::mat4& projection, const glm::vec3& lightPos, 
-                         const glm::vec3& lightColor, const glm::vec3& viewPos) {
-    if (!visible_ || !shader || !camera || !asteroidGeometry_ || !asteroidGeometry_->isValid()) {
+                         const glm::vec3& lightColor, const glm::vec3& viewPos,
+                         const ScreenSpaceLOD* lod, const ClusteredLighting* lights) {
+    if (!visible_ || !shader || !camera || lodGeometries_.empty() || !lodGeometries_.back() ||
+        !lodGeometries_.back()->isValid()) {
         return;
     }
+    const bool useLOD = lod && lodRequests_.size() == asteroids_.size();
 
     shader->use();
     shader->setMat4("view", view);
@@ -114,17 +152,33 @@ void AsteroidBelt::render(Shader* shader, const Camera* camera, const glm::mat4&
     shader->setVec3("lightPos", lightPos);
     shader->setVec3("lightColor", lightColor);
     shader->setVec3("viewPos", viewPos);
+    if (lights) {
+        lights->setUniforms(shader);
+    }
 
     glm::vec3 cameraPos = camera->getPosition();
     int asteroidsRendered = 0;
 
-    for (const auto& asteroid : asteroids_) {
+    for (size_t i = 0; i < asteroids_.size(); ++i) {
+        const Asteroid& asteroid = asteroids_[i];
         float distance = glm::length(asteroid.position - cameraPos);
         
         // Skip asteroids that are too far away
         if (distance > maxRenderDistance_) {
             continue;
         }
+        
+        // Pick the mesh chosen by the frame's screen-space error selection
+        Geometry* geometry = lodGeometries_.back();
+        if (useLOD && lodRequests_[i] != ScreenSpaceLOD::NO_REQUEST) {
+            int level = lod->getLevel(lodRequests_[i]);
+            if (level == ScreenSpaceLOD::CULLED) {
+                continue;
+            }
+            if (static_cast<size_t>(level) < lodGeometries_.size() && lodGeometries_[level]) {
+                geometry = lodGeometries_[level];
+            }
+        }
 
         // Create model matrix
         glm::mat4 model = glm::translate(glm::mat4(1.0f), asteroid.position);
@@ -136,11 +190,11 @@ void AsteroidBelt::render(Shader* shader, const Camera* camera, const glm::mat4&
         // Set uniforms
         shader->setMat4("model", model);
         shader->setVec3("planetColor", asteroid.color);
-        shader->setFloat("planetSeed", static_cast<float>(seed_ + (&asteroid - &asteroids_[0])));
+        shader->setFloat("planetSeed", static_cast<float>(seed_ + static_cast<int>(i)));
         shader->setInt("planetType", 0); // Rocky type for asteroids
 
         // Render asteroid
-        asteroidGeometry_->draw();
+        geometry->draw();
         asteroidsRendered++;
     }
 
@@ -157,7 +211,7 @@ void AsteroidBelt::setDensity(float density) {
     // Clamp density between 0.1 and 2.0
     density = std::clamp(density, 0.1f, 2.0f);
     
-    int newCount = static_cast<int>(asteroidCount_ * density);
+    int newCount = static_cast<int>(baseAsteroidCount_ * density);
     if (newCount != static_cast<int>(asteroids_.size())) {
         asteroidCount_ = newCount;
         generateAsteroids();
@@ -4,25 +4,18 @@
 #include <memory>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "SceneRecords.hpp"
+#include "ScreenSpaceLOD.hpp"
 
 class Shader;
 class Camera;
+class ClusteredLighting;
 class Geometry;
 
-struct Asteroid {
-    glm::vec3 position;
-    glm::vec3 rotation;
-    glm::vec3 rotationSpeed;
-    float scale;
-    float orbitRadius;
-    float orbitAngle;
-    float orbitSpeed;
-    glm::vec3 color;
-};
-
 class AsteroidBelt {
 public:
     AsteroidBelt(float innerRadius, float outerRadius, int asteroidCount, int seed = 0);
+    AsteroidBelt(float innerRadius, float outerRadius, std::vector<Asteroid> asteroids, int seed = 0);
     ~AsteroidBelt();
 
     // Non-copyable, non-movable
@@ -31,16 +24,23 @@ public:
     AsteroidBelt(AsteroidBelt&&) = delete;
     AsteroidBelt& operator=(AsteroidBelt&&) = delete;
 
-    void initialize(Geometry* asteroidGeometry);
+    // Shared asteroid meshes and their LOD levels, coarsest first; both must outlive the belt
+    void initialize(std::vector<Geometry*> lodGeometries, const std::vector<ScreenSpaceLOD::Level>* lodLevels);
     void update(float deltaTime);
+    // Request a level per asteroid in render distance; tiny and off-screen asteroids get culled
+    void requestLOD(ScreenSpaceLOD& lod, const glm::vec3& cameraPos);
+    // Without a resolved selector every asteroid uses the finest mesh
     void render(Shader* shader, const Camera* camera, const glm::mat4& view, 
                 const glm::mat4& projection, const glm::vec3& lightPos, 
-                const glm::vec3& lightColor, const glm::vec3& viewPos);
+                const glm::vec3& lightColor, const glm::vec3& viewPos,
+                const ScreenSpaceLOD* lod = nullptr, const ClusteredLighting* lights = nullptr);
 
     // Getters
     float getInnerRadius() const { return innerRadius_; }
     float getOuterRadius() const { return outerRadius_; }
     int getAsteroidCount() const { return asteroids_.size(); }
+    int getSeed() const { return seed_; }
+    const std::vector<Asteroid>& getAsteroids() const { return asteroids_; }
     bool isVisible() const { return visible_; }
 
     // Setters
@@ -55,11 +55,14 @@ private:
     float innerRadius_;
     float outerRadius_;
     int asteroidCount_;
+    int baseAsteroidCount_;  // Count at density 1.0
     int seed_;
     bool visible_;
     float orbitSpeedMultiplier_;
     float maxRenderDistance_;
 
     std::vector<Asteroid> asteroids_;
-    Geometry* asteroidGeometry_;
+    std::vector<Geometry*> lodGeometries_;
+    const std::vector<ScreenSpaceLOD::Level>* lodLevels_;
+    std::vector<size_t> lodRequests_;  // Per asteroid, from requestLOD()
 };
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "AtmosphereTables.hpp"
+#include "CacheEntry.hpp"
+#include "Hasher.hpp"
+#include "ParallelFor.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+// Bump whenever the integration or the profiles change
+static constexpr uint32_t ATMOSPHERE_VERSION = 1;
+
+namespace {
+
+constexpr CacheEntry::Format ATMOSPHERE_ENTRY = {
+    "atmosphere", "atmosphere", {'A', 'S', 'T', 'R', 'A', 'T', 'M', 'O'}, AtmosphereTables::FORMAT_VERSION
+};
+
+// Sun zenith cosines below this are in the planet's shadow for every altitude the tables cover
+constexpr double MU_S_MIN = -0.2;
+constexpr int TRANSMITTANCE_STEPS = 64;
+constexpr int SCATTERING_STEPS = 32;
+
+using Rgb = std::array<double, 3>;
+
+/*
+ * Texel parametrizations, mirrored in planet.frag. Altitude maps through the
+ * distance to the horizon and view zenith through the distance to the ground,
+ * which spends texels near the horizon where the tables change fastest.
+ * Only view rays that hit the ground are tabulated: planet.frag shades the
+ * planet surface, never the sky.
+ */
+double horizonDistance(double top) {
+    return std::sqrt(top * top - 1.0);
+}
+
+double radiusToUnit(double r, double top) {
+    return std::clamp(std::sqrt(std::max(r * r - 1.0, 0.0)) / horizonDistance(top), 0.0, 1.0);
+}
+
+double unitToRadius(double u, double top) {
+    double rho = u * horizonDistance(top);
+    return std::sqrt(rho * rho + 1.0);
+}
+
+double groundDistance(double r, double mu) {
+    double discriminant = r * r * (mu * mu - 1.0) + 1.0;
+    return std::max(-r * mu - std::sqrt(std::max(discriminant, 0.0)), 0.0);
+}
+
+double topDistance(double r, double mu, double top) {
+    double discriminant = r * r * (mu * mu - 1.0) + top * top;
+    return std::max(-r * mu + std::sqrt(std::max(discriminant, 0.0)), 0.0);
+}
+
+bool hitsGround(double r, double mu) {
+    return mu < 0.0 && r * r * (mu * mu - 1.0) + 1.0 >= 0.0;
+}
+
+double unitToViewMu(double u, double r) {
+    double rho = std::sqrt(std::max(r * r - 1.0, 0.0));
+    double dMin = r - 1.0;
+    double d = dMin + u * (rho - dMin);
+    if (d <= 0.0) {
+        return -1.0;
+    }
+    return std::clamp(-(rho * rho + d * d) / (2.0 * r * d), -1.0, 1.0);
+}
+
+double sunMuToUnit(double muS) {
+    return std::clamp((muS - MU_S_MIN) / (1.0 - MU_S_MIN), 0.0, 1.0);
+}
+
+double unitToSunMu(double u) {
+    return MU_S_MIN + u * (1.0 - MU_S_MIN);
+}
+
+struct Densities {
+    double rayleigh;
+    double mie;
+};
+
+Densities getDensities(const AtmosphereTables::Profile& profile, double r) {
+    double altitude = std::max(r - 1.0, 0.0);
+    return {std::exp(-altitude / profile.rayleighScaleHeight), std::exp(-altitude / profile.mieScaleHeight)};
+}
+
+Rgb getExtinction(const AtmosphereTables::Profile& profile, double r) {
+    Densities density = getDensities(profile, r);
+    Rgb extinction;
+    for (int c = 0; c < 3; ++c) {
+        extinction[c] = (profile.rayleighScattering[c] + profile.absorption[c]) * density.rayleigh +
+                        profile.mieExtinction * density.mie;
+    }
+    return extinction;
+}
+
+Rgb integrateTransmittance(const AtmosphereTables::Profile& profile, double r, double mu, double distance) {
+    Rgb depth = {0.0, 0.0, 0.0};
+    const double dt = distance / TRANSMITTANCE_STEPS;
+    for (int i = 0; i < TRANSMITTANCE_STEPS; ++i) {
+        double t = (i + 0.5) * dt;
+        Rgb extinction = getExtinction(profile, std::sqrt(r * r + t * t + 2.0 * r * t * mu));
+        for (int c = 0; c < 3; ++c) {
+            depth[c] += extinction[c] * dt;
+        }
+    }
+    return {std::exp(-depth[0]), std::exp(-depth[1]), std::exp(-depth[2])};
+}
+
+// Bilinear lookup of the sun half of the transmittance table, as planet.frag does it
+Rgb lookupSunTransmittance(const std::vector<float>& table, double r, double muS, double top) {
+    constexpr int rows = AtmosphereTables::TRANSMITTANCE_R;
+    constexpr int columns = AtmosphereTables::TRANSMITTANCE_MU;
+    double y = radiusToUnit(r, top) * (rows - 1);
+    double x = sunMuToUnit(muS) * (columns - 1);
+    int y0 = std::min(static_cast<int>(y), rows - 2);
+    int x0 = std::min(static_cast<int>(x), columns - 2);
+    double fy = y - y0;
+    double fx = x - x0;
+
+    Rgb result = {0.0, 0.0, 0.0};
+    for (int dy = 0; dy < 2; ++dy) {
+        for (int dx = 0; dx < 2; ++dx) {
+            double weight = (dx ? fx : 1.0 - fx) * (dy ? fy : 1.0 - fy);
+            size_t texel = static_cast<size_t>(y0 + dy) * AtmosphereTables::TRANSMITTANCE_WIDTH +
+                           static_cast<size_t>(columns + x0 + dx);
+            for (int c = 0; c < 3; ++c) {
+                result[c] += weight * table[texel * 4 + static_cast<size_t>(c)];
+            }
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+AtmosphereTables::Profile AtmosphereTables::getProfile(int type) {
+    // Far thicker than real atmospheres relative to the planet, so they read at solar system scale;
+    // coefficients give optical depths close to the real ones at these scale heights
+    switch (type) {
+        case 1: // Gas giant: deep, hazy, blue absorbed by the haze
+            return {0.12f, 0.03f, {2.0f, 4.7f, 11.3f}, {1.7f, 8.3f, 26.7f}, 0.02f, 7.5f, 8.0f, 0.7f};
+        case 2: // Ice: thin and clear
+            return {0.05f, 0.01f, {2.0f, 4.5f, 11.0f}, {0.0f, 0.0f, 0.0f}, 0.004f, 2.5f, 2.6f, 0.8f};
+        case 3: // Desert: little gas, lots of reddish dust
+            return {0.06f, 0.011f, {0.45f, 1.1f, 2.7f}, {4.0f, 12.0f, 28.0f}, 0.011f, 27.0f, 36.0f, 0.6f};
+        default: // Rocky: Earth-like
+            return {0.08f, 0.012f, {3.8f, 9.0f, 22.1f}, {0.0f, 0.0f, 0.0f}, 0.004f, 5.0f, 5.5f, 0.76f};
+    }
+}
+
+void AtmosphereTables::bake(int type) {
+    type_ = type;
+    profile_ = getProfile(type);
+    const double top = 1.0 + profile_.thickness;
+
+    transmittance_.assign(static_cast<size_t>(TRANSMITTANCE_WIDTH) * TRANSMITTANCE_HEIGHT * 4, 0.0f);
+    for (int y = 0; y < TRANSMITTANCE_HEIGHT; ++y) {
+        const double r = unitToRadius(static_cast<double>(y) / (TRANSMITTANCE_R - 1), top);
+        for (int x = 0; x < TRANSMITTANCE_MU; ++x) {
+            const double u = static_cast<double>(x) / (TRANSMITTANCE_MU - 1);
+
+            // Left half: view rays down to the ground
+            double mu = unitToViewMu(u, r);
+            Rgb view = integrateTransmittance(profile_, r, mu, groundDistance(r, mu));
+
+            // Right half: sun rays up to the top of the atmosphere
+            double muS = unitToSunMu(u);
+            Rgb sun = {0.0, 0.0, 0.0};
+            if (!hitsGround(r, muS)) {
+                sun = integrateTransmittance(profile_, r, muS, topDistance(r, muS, top));
+            }
+
+            size_t viewTexel = static_cast<size_t>(y) * TRANSMITTANCE_WIDTH + static_cast<size_t>(x);
+            size_t sunTexel = viewTexel + TRANSMITTANCE_MU;
+            for (int c = 0; c < 3; ++c) {
+                transmittance_[viewTexel * 4 + static_cast<size_t>(c)] = static_cast<float>(view[c]);
+                transmittance_[sunTexel * 4 + static_cast<size_t>(c)] = static_cast<float>(sun[c]);
+            }
+            transmittance_[viewTexel * 4 + 3] = 1.0f;
+            transmittance_[sunTexel * 4 + 3] = 1.0f;
+        }
+    }
+
+    // Scattering samples the sun transmittance at every step, so it needs the finished table
+    scattering_.assign(static_cast<size_t>(SCATTERING_WIDTH) * SCATTERING_HEIGHT * 4, 0.0f);
+    forEachRowRange(SCATTERING_HEIGHT, [this](int first, int end) { bakeScatteringRows(first, end); });
+}
+
+void AtmosphereTables::bakeScatteringRows(int firstRow, int endRow) {
+    const double top = 1.0 + profile_.thickness;
+    for (int y = firstRow; y < endRow; ++y) {
+        const double r = unitToRadius(static_cast<double>(y / SCATTERING_MU) / (SCATTERING_R - 1), top);
+        const double mu = unitToViewMu(static_cast<double>(y % SCATTERING_MU) / (SCATTERING_MU - 1), r);
+        const double distance = groundDistance(r, mu);
+        const double dt = distance / SCATTERING_STEPS;
+
+        for (int x = 0; x < SCATTERING_WIDTH; ++x) {
+            const double muS = unitToSunMu(static_cast<double>(x % SCATTERING_MU_S) / (SCATTERING_MU_S - 1));
+            double nu = -1.0 + 2.0 * static_cast<double>(x / SCATTERING_MU_S) / (SCATTERING_NU - 1);
+
+            // Not every view-sun angle is possible for a pair of zenith angles
+            double spread = std::sqrt(std::max((1.0 - mu * mu) * (1.0 - muS * muS), 0.0));
+            nu = std::clamp(nu, mu * muS - spread, mu * muS + spread);
+
+            Rgb rayleigh = {0.0, 0.0, 0.0};
+            Rgb mie = {0.0, 0.0, 0.0};
+            Rgb depth = {0.0, 0.0, 0.0};
+            for (int i = 0; i < SCATTERING_STEPS; ++i) {
+                double t = (i + 0.5) * dt;
+                double rI = std::sqrt(r * r + t * t + 2.0 * r * t * mu);
+                double muSI = std::clamp((r * muS + t * nu) / rI, -1.0, 1.0);
+
+                Densities density = getDensities(profile_, rI);
+                Rgb extinction = getExtinction(profile_, rI);
+                Rgb sun = lookupSunTransmittance(transmittance_, rI, muSI, top);
+                for (int c = 0; c < 3; ++c) {
+                    // Transmittance back to the ray origin at the sample's midpoint
+                    double view = std::exp(-(depth[c] + 0.5 * extinction[c] * dt));
+                    rayleigh[c] += density.rayleigh * view * sun[c] * dt;
+                    mie[c] += density.mie * view * sun[c] * dt;
+                    depth[c] += extinction[c] * dt;
+                }
+            }
+
+            size_t texel = static_cast<size_t>(y) * SCATTERING_WIDTH + static_cast<size_t>(x);
+            for (int c = 0; c < 3; ++c) {
+                scattering_[texel * 4 + static_cast<size_t>(c)] =
+                    static_cast<float>(rayleigh[c] * profile_.rayleighScattering[c]);
+            }
+            scattering_[texel * 4 + 3] = static_cast<float>(mie[0] * profile_.mieScattering);
+        }
+    }
+}
+
+uint64_t AtmosphereTables::getKey(int type) {
+    Profile profile = getProfile(type);
+    return Hasher()
+        .add(FORMAT_VERSION)
+        .add(ATMOSPHERE_VERSION)
+        .add(type)
+        .add(&profile, sizeof(profile))
+        .get();
+}
+
+bool AtmosphereTables::load(const std::string& directory, int type) {
+    const size_t transmittanceFloats = static_cast<size_t>(TRANSMITTANCE_WIDTH) * TRANSMITTANCE_HEIGHT * 4;
+    const size_t scatteringFloats = static_cast<size_t>(SCATTERING_WIDTH) * SCATTERING_HEIGHT * 4;
+    const size_t payloadSize = (transmittanceFloats + scatteringFloats) * sizeof(float);
+    std::vector<uint8_t> payload;
+    if (!CacheEntry(ATMOSPHERE_ENTRY, directory, getKey(type)).read(static_cast<uint32_t>(type), payloadSize, payloadSize, payload)) {
+        return false;
+    }
+
+    type_ = type;
+    profile_ = getProfile(type);
+    transmittance_.resize(transmittanceFloats);
+    scattering_.resize(scatteringFloats);
+    std::memcpy(transmittance_.data(), payload.data(), transmittanceFloats * sizeof(float));
+    std::memcpy(scattering_.data(), payload.data() + transmittanceFloats * sizeof(float), scatteringFloats * sizeof(float));
+    return true;
+}
+
+bool AtmosphereTables::save(const std::string& directory) const {
+    if (isEmpty()) {
+        return false;
+    }
+
+    const uint64_t key = getKey(type_);
+    const std::initializer_list<CacheEntry::Part> parts = {
+        {transmittance_.data(), transmittance_.size() * sizeof(float)},
+        {scattering_.data(), scattering_.size() * sizeof(float)}
+    };
+    if (!CacheEntry(ATMOSPHERE_ENTRY, directory, key).write(static_cast<uint32_t>(type_), parts)) {
+        return false;
+    }
+
+    spdlog::debug("Stored atmosphere cache entry {:016x} for planet type {}", key, type_);
+    return true;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Precomputed atmospheric scattering lookup tables of one atmosphere profile
+ *
+ * Bruneton-style tables for single Rayleigh and Mie scattering, so planet.frag
+ * gets physically based atmospheres for four texture fetches per table instead
+ * of ray marching. Distances are in planet radii (the ground is at r = 1).
+ * Both tables are RGBA float, first row first:
+ *  - transmittance: TRANSMITTANCE_WIDTH x TRANSMITTANCE_HEIGHT, rows indexed
+ *    by altitude. The left half holds the transmittance of view rays down to
+ *    the ground, the right half that of sun rays up to the top of the
+ *    atmosphere (zero when the ground is in the way).
+ *  - scattering: SCATTERING_WIDTH x SCATTERING_HEIGHT, a 4D table
+ *    (altitude, view zenith, sun zenith, view-sun angle) packed as
+ *    SCATTERING_NU blocks across and SCATTERING_R blocks down. RGB is Rayleigh
+ *    in-scatter along a view ray to the ground, A is the red channel of Mie
+ *    in-scatter. Phase functions are applied in the shader.
+ *
+ * The texel parametrizations are mirrored in planet.frag; change both together
+ * and bump FORMAT_VERSION.
+ */
+class AtmosphereTables {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    static constexpr int TRANSMITTANCE_R = 32;
+    static constexpr int TRANSMITTANCE_MU = 64;
+    static constexpr int TRANSMITTANCE_WIDTH = TRANSMITTANCE_MU * 2;
+    static constexpr int TRANSMITTANCE_HEIGHT = TRANSMITTANCE_R;
+
+    static constexpr int SCATTERING_R = 16;
+    static constexpr int SCATTERING_MU = 32;
+    static constexpr int SCATTERING_MU_S = 32;
+    static constexpr int SCATTERING_NU = 8;
+    static constexpr int SCATTERING_WIDTH = SCATTERING_MU_S * SCATTERING_NU;
+    static constexpr int SCATTERING_HEIGHT = SCATTERING_MU * SCATTERING_R;
+
+    /**
+     * @brief Physical description of an atmosphere, in planet radii
+     */
+    struct Profile {
+        float thickness;             // Height of the atmosphere top above the ground
+        float rayleighScaleHeight;
+        float rayleighScattering[3]; // Per planet radius at ground level
+        float absorption[3];         // Haze absorption, follows the Rayleigh density
+        float mieScaleHeight;
+        float mieScattering;
+        float mieExtinction;         // At least mieScattering; the difference is dust absorption
+        float mieG;                  // Mie phase asymmetry
+    };
+
+    /**
+     * @brief Get the atmosphere profile of a planet type
+     * @param type Planet type (0=rocky, 1=gas, 2=ice, 3=desert)
+     * @return Profile Atmosphere profile
+     */
+    static Profile getProfile(int type);
+
+    AtmosphereTables() = default;
+
+    /**
+     * @brief Integrate both tables for a planet type
+     * @param type Planet type
+     */
+    void bake(int type);
+
+    /**
+     * @brief Read tables from a cache directory
+     * @param directory Cache directory
+     * @param type Planet type
+     * @return true if a valid entry was found
+     */
+    bool load(const std::string& directory, int type);
+
+    /**
+     * @brief Write the tables to a cache directory
+     * @param directory Cache directory (created if missing)
+     * @return true if successful
+     */
+    bool save(const std::string& directory) const;
+
+    /**
+     * @brief Compute the cache key of a planet type's tables
+     * @param type Planet type
+     * @return uint64_t Cache key, changes with the profile and the table layout
+     */
+    static uint64_t getKey(int type);
+
+    bool isEmpty() const { return transmittance_.empty(); }
+    const Profile& getProfileData() const { return profile_; }
+
+    const std::vector<float>& getTransmittance() const { return transmittance_; }
+    const std::vector<float>& getScattering() const { return scattering_; }
+
+private:
+    void bakeScatteringRows(int firstRow, int endRow);
+
+    int type_ = 0;
+    Profile profile_{};
+    std::vector<float> transmittance_;  // TRANSMITTANCE_WIDTH * TRANSMITTANCE_HEIGHT RGBA
+    std::vector<float> scattering_;     // SCATTERING_WIDTH * SCATTERING_HEIGHT RGBA
+};
@@ -0,0 +1,106 @@
+#include "CacheEntry.hpp"
+#include "Hasher.hpp"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+struct CacheEntryHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t tag;
+    uint64_t key;
+    uint64_t payloadSize;
+    uint64_t payloadHash;
+};
+
+static_assert(sizeof(CacheEntryHeader) == 40, "Cache entry header layout changed");
+
+} // namespace
+
+CacheEntry::CacheEntry(const Format& format, const std::string& directory, uint64_t key)
+    : format_(format)
+    , directory_(directory)
+    , key_(key) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s_%016llx.bin", format.prefix, static_cast<unsigned long long>(key));
+    path_ = (std::filesystem::path(directory) / name).string();
+}
+
+bool CacheEntry::read(uint32_t tag, uint64_t minPayloadSize, uint64_t maxPayloadSize, std::vector<uint8_t>& payload) const {
+    std::ifstream file(path_, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    CacheEntryHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+
+    if (std::memcmp(header.magic, format_.magic, sizeof(header.magic)) != 0 ||
+        header.formatVersion != format_.version ||
+        header.key != key_ ||
+        header.tag != tag ||
+        header.payloadSize < minPayloadSize ||
+        header.payloadSize > maxPayloadSize) {
+        spdlog::warn("Ignoring mismatched {} cache entry {:016x}", format_.name, key_);
+        return false;
+    }
+
+    payload.resize(static_cast<size_t>(header.payloadSize));
+    if (!file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()))) {
+        return false;
+    }
+    if (Hasher::hash(payload.data(), payload.size()) != header.payloadHash) {
+        spdlog::warn("Ignoring corrupt {} cache entry {:016x}", format_.name, key_);
+        return false;
+    }
+
+    return true;
+}
+
+bool CacheEntry::write(uint32_t tag, std::initializer_list<Part> parts) const {
+    CacheEntryHeader header{};
+    std::memcpy(header.magic, format_.magic, sizeof(header.magic));
+    header.formatVersion = format_.version;
+    header.tag = tag;
+    header.key = key_;
+
+    Hasher hasher;
+    for (const Part& part : parts) {
+        hasher.add(part.data, part.size);
+        header.payloadSize += part.size;
+    }
+    header.payloadHash = hasher.get();
+
+    try {
+        std::filesystem::create_directories(directory_);
+
+        const std::string tempPath = path_ + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                spdlog::error("Failed to open {} cache entry for writing: {}", format_.name, tempPath);
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (const Part& part : parts) {
+                file.write(static_cast<const char*>(part.data), static_cast<std::streamsize>(part.size));
+            }
+            if (!file.good()) {
+                spdlog::error("Failed to write {} cache entry: {}", format_.name, tempPath);
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, path_);
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to store {} cache entry {:016x}: {}", format_.name, key_, e.what());
+        return false;
+    }
+
+    return true;
+}
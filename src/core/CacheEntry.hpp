@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One entry of a content-addressed on-disk cache
+ *
+ * Every cache under the cache directory (mesh heights, surface maps, shader
+ * programs, atmosphere tables, biome maps) stores an entry as a fixed header
+ * followed by an opaque payload. The header names the cache (magic and format
+ * version), repeats the entry key, carries one cache-specific tag and records
+ * the payload size and hash. Entries whose header does not match or whose
+ * payload does not hash to the recorded value are ignored, so a stale or torn
+ * entry only costs a rebuild.
+ *
+ * Entries are written to a temporary file and renamed into place, so readers
+ * never see a partial entry.
+ */
+class CacheEntry {
+public:
+    /**
+     * @brief Entry format shared by all entries of one cache
+     */
+    struct Format {
+        const char* name;    ///< Cache name used in log messages
+        const char* prefix;  ///< File name prefix, entries are <prefix>_<key>.bin
+        char magic[8];       ///< File magic
+        uint32_t version;    ///< Entry format version
+    };
+
+    /**
+     * @brief A contiguous piece of a payload
+     */
+    struct Part {
+        const void* data;
+        size_t size;
+    };
+
+    /**
+     * @brief Address an entry
+     * @param format Entry format of the cache
+     * @param directory Cache directory (created on first write)
+     * @param key Content key of the entry
+     */
+    CacheEntry(const Format& format, const std::string& directory, uint64_t key);
+
+    /**
+     * @brief Read and validate the entry
+     * @param tag Expected cache-specific tag
+     * @param minPayloadSize Smallest acceptable payload size in bytes
+     * @param maxPayloadSize Largest acceptable payload size in bytes
+     * @param payload Output payload
+     * @return true if the entry exists, matches and is intact
+     */
+    bool read(uint32_t tag, uint64_t minPayloadSize, uint64_t maxPayloadSize, std::vector<uint8_t>& payload) const;
+
+    /**
+     * @brief Write the entry atomically
+     * @param tag Cache-specific tag checked by read()
+     * @param parts Payload pieces, written and hashed in order
+     * @return true if successful
+     */
+    bool write(uint32_t tag, std::initializer_list<Part> parts) const;
+
+    const std::string& getPath() const { return path_; }
+    uint64_t getKey() const { return key_; }
+
+private:
+    Format format_;
+    std::string directory_;
+    std::string path_;
+    uint64_t key_;
+};
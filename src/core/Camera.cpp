@@ -1,6 +1,4 @@
 #include "Camera.hpp"
-#include "Planet.hpp"
-#include "Sun.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -407,7 +405,7 @@ void Camera::updateMode(float deltaTime) {
             updateOrbit(deltaTime);
             break;
         case Mode::CINEMATIC:
-            updateCinematic(deltaTime);
+            // Advanced once per frame by update(); stepping here too doubled playback speed
             break;
         default:
             break;
@@ -0,0 +1,264 @@
+#include "CameraPathBenchmark.hpp"
+#include "Camera.hpp"
+#include "Json.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+/**
+ * @brief Fills CameraPathBenchmark::Settings from a path file
+ *
+ * Unknown keys are skipped, so path files can carry comments or metadata
+ * as extra fields.
+ */
+class PathJsonHandler : public JsonHandler {
+public:
+    explicit PathJsonHandler(CameraPathBenchmark::Settings& settings)
+        : settings_(settings) {
+    }
+
+    bool startObject() override {
+        ++depth_;
+        if (inKeyframes_ && depth_ == 3) {
+            settings_.keyframes.emplace_back();
+        }
+        key_.clear();
+        return true;
+    }
+
+    bool endObject() override {
+        --depth_;
+        key_.clear();
+        return true;
+    }
+
+    bool startArray() override {
+        ++depth_;
+        if (depth_ == 2 && key_ == "keyframes") {
+            inKeyframes_ = true;
+        } else if (inKeyframes_ && depth_ == 4) {
+            vector_ = key_ == "position" ? &settings_.keyframes.back().position
+                    : key_ == "lookAt" ? &settings_.keyframes.back().lookAt
+                    : nullptr;
+            component_ = 0;
+        }
+        return true;
+    }
+
+    bool endArray() override {
+        if (depth_ == 2) {
+            inKeyframes_ = false;
+        }
+        vector_ = nullptr;
+        --depth_;
+        key_.clear();
+        return true;
+    }
+
+    bool key(std::string_view name) override {
+        key_.assign(name);
+        return true;
+    }
+
+    bool number(double value) override {
+        if (vector_) {
+            if (component_ < 3) {
+                (*vector_)[component_] = static_cast<float>(value);
+            }
+            ++component_;
+        } else if (depth_ == 1) {
+            if (key_ == "timestep") {
+                settings_.timestep = static_cast<float>(value);
+            } else if (key_ == "warmupFrames") {
+                settings_.warmupFrames = static_cast<int>(value);
+            } else if (key_ == "seed") {
+                settings_.seed = static_cast<int>(value);
+            } else if (key_ == "planets") {
+                settings_.planetCount = static_cast<int>(value);
+            }
+        } else if (inKeyframes_ && depth_ == 3 && key_ == "time") {
+            settings_.keyframes.back().time = static_cast<float>(value);
+        }
+        return true;
+    }
+
+private:
+    CameraPathBenchmark::Settings& settings_;
+    std::string key_;
+    int depth_ = 0;
+    bool inKeyframes_ = false;
+    glm::vec3* vector_ = nullptr;
+    int component_ = 0;
+};
+
+/**
+ * @brief Write mean/p50/p95/p99/max of a sample set as an object
+ */
+void writeDistribution(JsonWriter& json, std::string_view name, std::vector<double> samples) {
+    json.key(name).beginObject();
+    if (!samples.empty()) {
+        double sum = 0.0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        std::sort(samples.begin(), samples.end());
+        json.key("mean").value(sum / static_cast<double>(samples.size()));
+        json.key("p50").value(FrameTimingLog::percentile(samples, 0.50));
+        json.key("p95").value(FrameTimingLog::percentile(samples, 0.95));
+        json.key("p99").value(FrameTimingLog::percentile(samples, 0.99));
+        json.key("max").value(samples.back());
+    }
+    json.endObject();
+}
+
+void writeCounter(JsonWriter& json, std::string_view name, const std::vector<uint64_t>& perFrame) {
+    uint64_t total = 0;
+    uint64_t maximum = 0;
+    for (uint64_t count : perFrame) {
+        total += count;
+        maximum = std::max(maximum, count);
+    }
+
+    json.key(name).beginObject();
+    json.key("total").value(static_cast<long long>(total));
+    json.key("perFrameMean").value(perFrame.empty() ? 0.0 : static_cast<double>(total) / static_cast<double>(perFrame.size()));
+    json.key("perFrameMax").value(static_cast<long long>(maximum));
+    json.endObject();
+}
+
+} // namespace
+
+bool CameraPathBenchmark::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        spdlog::error("Failed to open benchmark path: {}", filename);
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    settings_ = Settings{};
+    PathJsonHandler handler(settings_);
+    std::string error;
+    if (!JsonReader::parse(buffer.str(), handler, error)) {
+        spdlog::error("Failed to parse benchmark path {}: {}", filename, error);
+        return false;
+    }
+
+    if (settings_.keyframes.size() < 2) {
+        spdlog::error("Benchmark path {} needs at least two keyframes", filename);
+        return false;
+    }
+    if (settings_.timestep <= 0.0f) {
+        spdlog::error("Benchmark path {} has an invalid timestep", filename);
+        return false;
+    }
+    settings_.warmupFrames = std::max(settings_.warmupFrames, 0);
+
+    filename_ = filename;
+    spdlog::info("Loaded benchmark path {}: {} keyframes, {:.2f}s at {:.4f}s per frame",
+                 filename, settings_.keyframes.size(),
+                 std::max_element(settings_.keyframes.begin(), settings_.keyframes.end(),
+                     [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; })->time,
+                 settings_.timestep);
+    return true;
+}
+
+void CameraPathBenchmark::start(Camera& camera) {
+    camera.stopCinematicSequence();
+    for (const auto& keyframe : settings_.keyframes) {
+        camera.addCinematicKeyframe(keyframe.position, keyframe.lookAt, keyframe.time);
+    }
+
+    // Warm up at the first keyframe so its LOD meshes are built before measuring
+    const Keyframe& first = *std::min_element(settings_.keyframes.begin(), settings_.keyframes.end(),
+        [](const Keyframe& a, const Keyframe& b) { return a.time < b.time; });
+    camera.setPosition(first.position);
+    glm::vec3 direction = first.lookAt - first.position;
+    if (glm::length(direction) > 0.0f) {
+        direction = glm::normalize(direction);
+        camera.setYaw(glm::degrees(std::atan2(direction.z, direction.x)));
+        camera.setPitch(glm::degrees(std::asin(direction.y)));
+    }
+
+    warmupRemaining_ = settings_.warmupFrames;
+    if (warmupRemaining_ == 0) {
+        camera.playCinematicSequence();
+    }
+}
+
+bool CameraPathBenchmark::finishFrame(Camera& camera, const FrameTiming& timing, const RenderStats::Counters& counters) {
+    if (warmupRemaining_ > 0) {
+        warmupLodRebuilds_ += counters.lodRebuilds;
+        if (--warmupRemaining_ == 0) {
+            camera.playCinematicSequence();
+        }
+        return true;
+    }
+
+    frameTimes_.push_back(timing.frameMs);
+    updateTimes_.push_back(timing.updateMs);
+    renderTimes_.push_back(timing.renderMs);
+    drawCalls_.push_back(counters.drawCalls);
+    triangles_.push_back(counters.triangles);
+    glCalls_.push_back(counters.glCalls);
+    uploadBytes_.push_back(counters.uploadBytes);
+    lodRebuilds_ += counters.lodRebuilds;
+
+    return camera.isCinematicPlaying();
+}
+
+bool CameraPathBenchmark::writeReport(const std::string& filename, const RunInfo& info) const {
+    JsonWriter json;
+    json.beginObject();
+    json.key("path").value(filename_);
+    json.key("renderer").value(info.renderer);
+    json.key("glVersion").value(info.glVersion);
+    json.key("resolution").beginArray(true).value(info.width).value(info.height).endArray();
+    json.key("seed").value(info.seed);
+    json.key("planets").value(info.planetCount);
+    json.key("timestep").value(settings_.timestep);
+    json.key("warmupFrames").value(settings_.warmupFrames);
+    json.key("frames").value(static_cast<long long>(frameTimes_.size()));
+    writeDistribution(json, "frameTimeMs", frameTimes_);
+    writeDistribution(json, "updateTimeMs", updateTimes_);
+    writeDistribution(json, "renderTimeMs", renderTimes_);
+    writeCounter(json, "drawCalls", drawCalls_);
+    writeCounter(json, "triangles", triangles_);
+    json.key("lodRebuilds").value(static_cast<long long>(lodRebuilds_));
+    json.key("warmupLodRebuilds").value(static_cast<long long>(warmupLodRebuilds_));
+    if (!info.glFunctionCalls.empty()) {
+        writeCounter(json, "glCalls", glCalls_);
+        writeCounter(json, "uploadBytes", uploadBytes_);
+        json.key("glFunctionCalls").beginObject();
+        for (const auto& [name, calls] : info.glFunctionCalls) {
+            json.key(name).value(static_cast<long long>(calls));
+        }
+        json.endObject();
+    }
+    json.endObject();
+
+    std::ofstream file(filename, std::ios::trunc);
+    if (!file.is_open()) {
+        spdlog::error("Failed to write benchmark report: {}", filename);
+        return false;
+    }
+    file << json.str() << '\n';
+    if (!file.good()) {
+        spdlog::error("Failed to write benchmark report: {}", filename);
+        return false;
+    }
+
+    std::vector<double> sorted = frameTimes_;
+    std::sort(sorted.begin(), sorted.end());
+    if (!sorted.empty()) {
+        spdlog::info("Benchmark finished: {} frames, p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms -> {}",
+                     sorted.size(), FrameTimingLog::percentile(sorted, 0.50), FrameTimingLog::percentile(sorted, 0.95),
+                     FrameTimingLog::percentile(sorted, 0.99), sorted.back(), filename);
+    }
+    return true;
+}
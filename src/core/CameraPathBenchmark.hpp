@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include <glm/glm.hpp>
+#include "FrameTimingLog.hpp"
+#include "RenderStats.hpp"
+
+class Camera;
+
+/**
+ * @brief Scripted fly-through used for repeatable performance measurements
+ *
+ * A path file is JSON:
+ *
+ *     {
+ *       "timestep": 0.0166667,      // optional, seconds per frame
+ *       "warmupFrames": 30,         // optional, frames rendered before measuring
+ *       "seed": 1337,               // optional, overrides --seed of the system
+ *       "planets": 8,               // optional
+ *       "keyframes": [
+ *         { "time": 0.0, "position": [0, 20, 300], "lookAt": [0, 0, 0] },
+ *         ...
+ *       ]
+ *     }
+ *
+ * The keyframes are played with Camera's cinematic system at a fixed
+ * timestep, so every run renders exactly the same frames. Per-frame timings
+ * and RenderStats counters are summarized into a JSON report.
+ */
+class CameraPathBenchmark {
+public:
+    struct Keyframe {
+        float time = 0.0f;
+        glm::vec3 position{0.0f};
+        glm::vec3 lookAt{0.0f};
+    };
+
+    struct Settings {
+        float timestep = 1.0f / 60.0f;
+        int warmupFrames = 30;
+        int seed = -1;       // -1 keeps the application default
+        int planetCount = -1;
+        std::vector<Keyframe> keyframes;
+    };
+
+    /**
+     * @brief Environment details copied into the report
+     */
+    struct RunInfo {
+        std::string renderer;
+        std::string glVersion;
+        int width = 0;
+        int height = 0;
+        int seed = 0;
+        int planetCount = 0;
+        std::vector<std::pair<std::string, uint64_t>> glFunctionCalls; // Whole-run totals, empty unless GL calls were counted
+    };
+
+    /**
+     * @brief Load and validate a path file
+     * @param filename Path file
+     * @return true if the file describes a playable path
+     */
+    bool load(const std::string& filename);
+
+    const Settings& getSettings() const { return settings_; }
+
+    /**
+     * @brief Queue the keyframes on the camera; playback starts after warm-up
+     * @param camera Camera to drive
+     */
+    void start(Camera& camera);
+
+    /**
+     * @brief Account for a finished frame
+     * @param camera Camera being driven
+     * @param timing Frame timings
+     * @param counters Render counters of the frame
+     * @return false once the path has been played to the end
+     */
+    bool finishFrame(Camera& camera, const FrameTiming& timing, const RenderStats::Counters& counters);
+
+    /**
+     * @brief Write the summary report
+     * @param filename Output JSON path
+     * @param info Environment details
+     * @return true if the report was written
+     */
+    bool writeReport(const std::string& filename, const RunInfo& info) const;
+
+private:
+    std::string filename_;
+    Settings settings_;
+    int warmupRemaining_ = 0;
+
+    std::vector<double> frameTimes_;
+    std::vector<double> updateTimes_;
+    std::vector<double> renderTimes_;
+    std::vector<uint64_t> drawCalls_;
+    std::vector<uint64_t> triangles_;
+    std::vector<uint64_t> glCalls_;
+    std::vector<uint64_t> uploadBytes_;
+    uint64_t lodRebuilds_ = 0;
+    uint64_t warmupLodRebuilds_ = 0;
+};
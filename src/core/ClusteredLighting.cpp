@@ -0,0 +1,80 @@
+#include "ClusteredLighting.hpp"
+#include "GLApi.hpp"
+#include "Shader.hpp"
+
+ClusteredLighting::ClusteredLighting() {
+    if (!GLApi::isLoaded()) {
+        return;
+    }
+    createBufferTexture(lightData_, GL_RGBA32F);
+    createBufferTexture(clusterRanges_, GL_RG32UI);
+    createBufferTexture(indices_, GL_R32UI);
+}
+
+ClusteredLighting::~ClusteredLighting() {
+    if (!GLApi::isLoaded()) {
+        return;
+    }
+    for (BufferTexture* target : {&lightData_, &clusterRanges_, &indices_}) {
+        if (target->texture != 0) {
+            gl.DeleteTextures(1, &target->texture);
+        }
+        if (target->buffer != 0) {
+            gl.DeleteBuffers(1, &target->buffer);
+        }
+    }
+}
+
+void ClusteredLighting::update(const std::vector<PointLight>& lights, const glm::mat4& view, const glm::mat4& projection) {
+    clusters_.build(lights, view, projection);
+    if (!GLApi::isLoaded()) {
+        return;
+    }
+    upload(lightData_, clusters_.getLightData().data(), clusters_.getLightData().size() * sizeof(glm::vec4));
+    upload(clusterRanges_, clusters_.getClusters().data(), clusters_.getClusters().size() * sizeof(uint32_t));
+    upload(indices_, clusters_.getIndices().data(), clusters_.getIndices().size() * sizeof(uint32_t));
+}
+
+void ClusteredLighting::bindTextures() const {
+    if (!GLApi::isLoaded()) {
+        return;
+    }
+    int unit = FIRST_TEXTURE_UNIT;
+    for (const BufferTexture* target : {&lightData_, &clusterRanges_, &indices_}) {
+        gl.ActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(unit++));
+        gl.BindTexture(GL_TEXTURE_BUFFER, target->texture);
+    }
+    gl.ActiveTexture(GL_TEXTURE0);
+}
+
+void ClusteredLighting::setUniforms(Shader* shader) const {
+    shader->setInt("clusterLightData", FIRST_TEXTURE_UNIT);
+    shader->setInt("clusterRanges", FIRST_TEXTURE_UNIT + 1);
+    shader->setInt("clusterIndices", FIRST_TEXTURE_UNIT + 2);
+    shader->setVec3("clusterGrid", glm::vec3(LightClusters::TILES_X, LightClusters::TILES_Y, LightClusters::SLICES));
+    shader->setFloat("clusterNearPlane", clusters_.getNearPlane());
+    shader->setFloat("clusterSliceScale", clusters_.getSliceScale());
+}
+
+void ClusteredLighting::createBufferTexture(BufferTexture& target, unsigned int internalFormat) {
+    gl.GenBuffers(1, &target.buffer);
+    gl.GenTextures(1, &target.texture);
+    gl.BindTexture(GL_TEXTURE_BUFFER, target.texture);
+    gl.BindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+    gl.TexBuffer(GL_TEXTURE_BUFFER, internalFormat, target.buffer);
+    gl.BindBuffer(GL_TEXTURE_BUFFER, 0);
+    gl.BindTexture(GL_TEXTURE_BUFFER, 0);
+}
+
+void ClusteredLighting::upload(const BufferTexture& target, const void* data, size_t bytes) {
+    // Respecify the whole store every frame so the driver can hand out fresh memory instead of
+    // waiting for draws still reading the previous frame's lights; never empty, some drivers reject that
+    static const uint32_t zero[4] = {0, 0, 0, 0};
+    gl.BindBuffer(GL_TEXTURE_BUFFER, target.buffer);
+    if (bytes == 0) {
+        gl.BufferData(GL_TEXTURE_BUFFER, sizeof(zero), zero, GL_STREAM_DRAW);
+    } else {
+        gl.BufferData(GL_TEXTURE_BUFFER, static_cast<ptrdiff_t>(bytes), data, GL_STREAM_DRAW);
+    }
+    gl.BindBuffer(GL_TEXTURE_BUFFER, 0);
+}
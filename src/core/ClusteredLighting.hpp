@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "LightClusters.hpp"
+
+class Shader;
+
+/**
+ * @brief GPU side of clustered forward lighting
+ *
+ * Every frame, update() clusters the frame's point lights on the CPU (see
+ * LightClusters) and streams the light data, per-cluster ranges and light
+ * indices into three texture buffers. Lit shaders include lights.glsl and
+ * add getClusteredLighting() on top of the sun, so a fragment's cost depends
+ * on the lights in its cluster rather than on the total light count.
+ *
+ * The sun stays the primary light of every shader; these lights are extra.
+ */
+class ClusteredLighting {
+public:
+    /// Texture units of the light buffers; 0-3 hold planet surface maps and atmosphere tables
+    static constexpr int FIRST_TEXTURE_UNIT = 4;
+
+    ClusteredLighting();
+    ~ClusteredLighting();
+
+    // Non-copyable, non-movable
+    ClusteredLighting(const ClusteredLighting&) = delete;
+    ClusteredLighting& operator=(const ClusteredLighting&) = delete;
+    ClusteredLighting(ClusteredLighting&&) = delete;
+    ClusteredLighting& operator=(ClusteredLighting&&) = delete;
+
+    /**
+     * @brief Cluster the lights of this frame and upload them
+     * @param lights Point lights in world space
+     * @param view View matrix
+     * @param projection Projection matrix
+     */
+    void update(const std::vector<PointLight>& lights, const glm::mat4& view, const glm::mat4& projection);
+
+    /**
+     * @brief Bind the light buffers to their texture units
+     */
+    void bindTextures() const;
+
+    /**
+     * @brief Point a bound shader's light samplers and cluster parameters at this frame's lights
+     * @param shader Shader including lights.glsl, already in use
+     */
+    void setUniforms(Shader* shader) const;
+
+    size_t getLightCount() const { return clusters_.getLightCount(); }
+    size_t getIndexCount() const { return clusters_.getIndices().size(); }
+
+private:
+    struct BufferTexture {
+        unsigned int buffer = 0;
+        unsigned int texture = 0;
+    };
+
+    void createBufferTexture(BufferTexture& target, unsigned int internalFormat);
+    void upload(const BufferTexture& target, const void* data, size_t bytes);
+
+    LightClusters clusters_;
+    BufferTexture lightData_;
+    BufferTexture clusterRanges_;
+    BufferTexture indices_;
+};
@@ -0,0 +1,451 @@
+#include "CompressedTexture.hpp"
+#include "Hasher.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+struct TextureHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint64_t payloadSize;
+    uint64_t payloadHash;
+};
+
+constexpr char TEXTURE_MAGIC[8] = {'A', 'S', 'T', 'R', 'A', 'T', 'E', 'X'};
+constexpr int MAX_DIMENSION = 16384;
+
+size_t getBlockBytes(CompressedTexture::Format format) {
+    return format == CompressedTexture::Format::BC1 ? 8 : 16;
+}
+
+int getMipLevelCount(int width, int height) {
+    int levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+        ++levels;
+    }
+    return levels;
+}
+
+/**
+ * @brief Halve an RGBA8 image with a 2x2 box filter (edge pixels repeat on odd sizes)
+ */
+std::vector<uint8_t> downsample(const std::vector<uint8_t>& rgba, int width, int height, int& outWidth, int& outHeight) {
+    outWidth = std::max(width / 2, 1);
+    outHeight = std::max(height / 2, 1);
+    std::vector<uint8_t> out(static_cast<size_t>(outWidth) * static_cast<size_t>(outHeight) * 4);
+
+    for (int y = 0; y < outHeight; ++y) {
+        int y0 = std::min(y * 2, height - 1);
+        int y1 = std::min(y * 2 + 1, height - 1);
+        for (int x = 0; x < outWidth; ++x) {
+            int x0 = std::min(x * 2, width - 1);
+            int x1 = std::min(x * 2 + 1, width - 1);
+            for (int c = 0; c < 4; ++c) {
+                auto at = [&](int px, int py) {
+                    return static_cast<int>(rgba[(static_cast<size_t>(py) * static_cast<size_t>(width) + static_cast<size_t>(px)) * 4 + static_cast<size_t>(c)]);
+                };
+                int sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                out[(static_cast<size_t>(y) * static_cast<size_t>(outWidth) + static_cast<size_t>(x)) * 4 + static_cast<size_t>(c)] =
+                    static_cast<uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+    return out;
+}
+
+uint16_t packColor565(const float color[3]) {
+    auto quantize = [](float value, int maxValue) {
+        return static_cast<uint16_t>(std::clamp(static_cast<int>(std::lround(value / 255.0f * static_cast<float>(maxValue))), 0, maxValue));
+    };
+    return static_cast<uint16_t>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) | quantize(color[2], 31));
+}
+
+void unpackColor565(uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 31;
+    int g = (packed >> 5) & 63;
+    int b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+void writeLittleEndian(uint8_t* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+/**
+ * @brief Encode the color half of a BC1/BC3 block in four-color mode
+ *
+ * Endpoints are the extremes of the pixels projected onto the principal axis
+ * of their colors, found with a few power iterations on the covariance matrix.
+ */
+void encodeColorBlock(const uint8_t pixels[16][4], uint8_t* out) {
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            mean[c] += pixels[i][c];
+        }
+    }
+    for (float& m : mean) {
+        m /= 16.0f;
+    }
+
+    float covariance[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}; // rr, rg, rb, gg, gb, bb
+    for (int i = 0; i < 16; ++i) {
+        float r = pixels[i][0] - mean[0];
+        float g = pixels[i][1] - mean[1];
+        float b = pixels[i][2] - mean[2];
+        covariance[0] += r * r;
+        covariance[1] += r * g;
+        covariance[2] += r * b;
+        covariance[3] += g * g;
+        covariance[4] += g * b;
+        covariance[5] += b * b;
+    }
+
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float next[3] = {
+            covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+            covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+            covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2]
+        };
+        float length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+        if (length < 1e-6f) {
+            break; // Flat block: any axis works
+        }
+        for (int c = 0; c < 3; ++c) {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    float minProjection = 1e30f;
+    float maxProjection = -1e30f;
+    for (int i = 0; i < 16; ++i) {
+        float projection = (pixels[i][0] - mean[0]) * axis[0] + (pixels[i][1] - mean[1]) * axis[1] +
+                           (pixels[i][2] - mean[2]) * axis[2];
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+
+    float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float maxColor[3];
+    float minColor[3];
+    for (int c = 0; c < 3; ++c) {
+        maxColor[c] = std::clamp(mean[c] + axis[c] * maxProjection / axisLengthSquared, 0.0f, 255.0f);
+        minColor[c] = std::clamp(mean[c] + axis[c] * minProjection / axisLengthSquared, 0.0f, 255.0f);
+    }
+
+    uint16_t color0 = packColor565(maxColor);
+    uint16_t color1 = packColor565(minColor);
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    uint32_t indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        unpackColor565(color0, palette[0]);
+        unpackColor565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int error = 0;
+                for (int c = 0; c < 3; ++c) {
+                    int delta = static_cast<int>(pixels[i][c]) - palette[p][c];
+                    error += delta * delta;
+                }
+                if (error < bestError) {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (2 * i);
+        }
+    }
+    // Equal endpoints: every index 0 selects color0
+
+    writeLittleEndian(out, color0, 2);
+    writeLittleEndian(out + 2, color1, 2);
+    writeLittleEndian(out + 4, indices, 4);
+}
+
+/**
+ * @brief Encode the alpha half of a BC3 block in eight-value mode
+ */
+void encodeAlphaBlock(const uint8_t pixels[16][4], uint8_t* out) {
+    int alpha0 = 0;
+    int alpha1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        alpha0 = std::max(alpha0, static_cast<int>(pixels[i][3]));
+        alpha1 = std::min(alpha1, static_cast<int>(pixels[i][3]));
+    }
+
+    uint64_t indices = 0;
+    if (alpha0 != alpha1) {
+        int palette[8] = {alpha0, alpha1};
+        for (int p = 1; p < 7; ++p) {
+            palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestError = 1 << 30;
+            for (int p = 0; p < 8; ++p) {
+                int error = std::abs(static_cast<int>(pixels[i][3]) - palette[p]);
+                if (error < bestError) {
+                    bestError = error;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint64_t>(best) << (3 * i);
+        }
+    }
+
+    out[0] = static_cast<uint8_t>(alpha0);
+    out[1] = static_cast<uint8_t>(alpha1);
+    writeLittleEndian(out + 2, indices, 6);
+}
+
+std::vector<uint8_t> encodeLevel(const std::vector<uint8_t>& rgba, int width, int height, CompressedTexture::Format format) {
+    const int blocksX = (width + 3) / 4;
+    const int blocksY = (height + 3) / 4;
+    const size_t blockBytes = getBlockBytes(format);
+    std::vector<uint8_t> out(static_cast<size_t>(blocksX) * static_cast<size_t>(blocksY) * blockBytes);
+
+    uint8_t block[16][4];
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            // Blocks past the edge repeat the last row/column
+            for (int i = 0; i < 16; ++i) {
+                int x = std::min(bx * 4 + i % 4, width - 1);
+                int y = std::min(by * 4 + i / 4, height - 1);
+                std::memcpy(block[i], &rgba[(static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * 4], 4);
+            }
+
+            uint8_t* target = &out[(static_cast<size_t>(by) * static_cast<size_t>(blocksX) + static_cast<size_t>(bx)) * blockBytes];
+            if (format == CompressedTexture::Format::BC3) {
+                encodeAlphaBlock(block, target);
+                target += 8;
+            }
+            encodeColorBlock(block, target);
+        }
+    }
+    return out;
+}
+
+} // namespace
+
+bool CompressedTexture::addFace(const uint8_t* rgba, int width, int height, Format format) {
+    if (width <= 0 || height <= 0 || width > MAX_DIMENSION || height > MAX_DIMENSION) {
+        spdlog::error("Unsupported texture size {}x{}", width, height);
+        return false;
+    }
+    if (faceCount_ > 0 && (format != format_ || width != width_ || height != height_)) {
+        spdlog::error("Texture faces must share format and size");
+        return false;
+    }
+
+    format_ = format;
+    width_ = width;
+    height_ = height;
+    levelCount_ = getMipLevelCount(width, height);
+
+    std::vector<uint8_t> level(rgba, rgba + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+    int levelWidth = width;
+    int levelHeight = height;
+    for (int i = 0; i < levelCount_; ++i) {
+        images_.push_back(encodeLevel(level, levelWidth, levelHeight, format));
+        if (i + 1 < levelCount_) {
+            level = downsample(level, levelWidth, levelHeight, levelWidth, levelHeight);
+        }
+    }
+    ++faceCount_;
+    return true;
+}
+
+bool CompressedTexture::appendFaces(const CompressedTexture& other) {
+    if (other.isEmpty()) {
+        return true;
+    }
+    if (faceCount_ > 0 && (other.format_ != format_ || other.width_ != width_ || other.height_ != height_)) {
+        spdlog::error("Texture faces must share format and size");
+        return false;
+    }
+
+    format_ = other.format_;
+    width_ = other.width_;
+    height_ = other.height_;
+    levelCount_ = other.levelCount_;
+    faceCount_ += other.faceCount_;
+    images_.insert(images_.end(), other.images_.begin(), other.images_.end());
+    return true;
+}
+
+const std::vector<uint8_t>& CompressedTexture::getImage(int face, int level) const {
+    return images_[static_cast<size_t>(face) * static_cast<size_t>(levelCount_) + static_cast<size_t>(level)];
+}
+
+size_t CompressedTexture::getDataSize() const {
+    size_t size = 0;
+    for (const auto& image : images_) {
+        size += image.size();
+    }
+    return size;
+}
+
+size_t CompressedTexture::getLevelSize(Format format, int width, int height) {
+    return static_cast<size_t>((width + 3) / 4) * static_cast<size_t>((height + 3) / 4) * getBlockBytes(format);
+}
+
+std::string CompressedTexture::getPathFor(const std::string& imagePath) {
+    return std::filesystem::path(imagePath).replace_extension(".atex").string();
+}
+
+bool CompressedTexture::isUpToDate(const std::string& imagePath) {
+    std::error_code error;
+    const std::string compressedPath = getPathFor(imagePath);
+    const auto compressedTime = std::filesystem::last_write_time(compressedPath, error);
+    if (error) {
+        return false;
+    }
+    const auto imageTime = std::filesystem::last_write_time(imagePath, error);
+    if (!error && imageTime > compressedTime) {
+        spdlog::warn("Ignoring {}: {} was modified after it, re-run texture_compress", compressedPath, imagePath);
+        return false;
+    }
+    return true;
+}
+
+bool CompressedTexture::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    TextureHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+
+    Format format = static_cast<Format>(header.format);
+    if (std::memcmp(header.magic, TEXTURE_MAGIC, sizeof(TEXTURE_MAGIC)) != 0 ||
+        header.formatVersion != FORMAT_VERSION ||
+        (format != Format::BC1 && format != Format::BC3) ||
+        header.width == 0 || header.height == 0 ||
+        header.width > MAX_DIMENSION || header.height > MAX_DIMENSION ||
+        header.faceCount == 0 || header.faceCount > 6 ||
+        header.levelCount != static_cast<uint32_t>(getMipLevelCount(static_cast<int>(header.width), static_cast<int>(header.height)))) {
+        spdlog::warn("Ignoring unsupported compressed texture: {}", filename);
+        return false;
+    }
+
+    // Level sizes follow from the header, so the payload size is fully determined
+    std::vector<size_t> levelSizes;
+    size_t expectedSize = 0;
+    int levelWidth = static_cast<int>(header.width);
+    int levelHeight = static_cast<int>(header.height);
+    for (uint32_t level = 0; level < header.levelCount; ++level) {
+        levelSizes.push_back(getLevelSize(format, levelWidth, levelHeight));
+        expectedSize += levelSizes.back() * header.faceCount;
+        levelWidth = std::max(levelWidth / 2, 1);
+        levelHeight = std::max(levelHeight / 2, 1);
+    }
+    if (header.payloadSize != expectedSize) {
+        spdlog::warn("Compressed texture {} has an unexpected payload size", filename);
+        return false;
+    }
+
+    std::vector<uint8_t> payload(expectedSize);
+    if (!file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size()))) {
+        spdlog::warn("Compressed texture {} is truncated", filename);
+        return false;
+    }
+    if (Hasher::hash(payload.data(), payload.size()) != header.payloadHash) {
+        spdlog::warn("Compressed texture {} is corrupt, ignoring", filename);
+        return false;
+    }
+
+    format_ = format;
+    width_ = static_cast<int>(header.width);
+    height_ = static_cast<int>(header.height);
+    faceCount_ = static_cast<int>(header.faceCount);
+    levelCount_ = static_cast<int>(header.levelCount);
+    images_.clear();
+    size_t offset = 0;
+    for (uint32_t face = 0; face < header.faceCount; ++face) {
+        for (size_t levelSize : levelSizes) {
+            images_.emplace_back(payload.begin() + static_cast<std::ptrdiff_t>(offset),
+                                 payload.begin() + static_cast<std::ptrdiff_t>(offset + levelSize));
+            offset += levelSize;
+        }
+    }
+    return true;
+}
+
+bool CompressedTexture::save(const std::string& filename) const {
+    if (isEmpty()) {
+        spdlog::error("Refusing to write an empty compressed texture: {}", filename);
+        return false;
+    }
+
+    std::vector<uint8_t> payload;
+    payload.reserve(getDataSize());
+    for (const auto& image : images_) {
+        payload.insert(payload.end(), image.begin(), image.end());
+    }
+
+    TextureHeader header{};
+    std::memcpy(header.magic, TEXTURE_MAGIC, sizeof(TEXTURE_MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.format = static_cast<uint32_t>(format_);
+    header.width = static_cast<uint32_t>(width_);
+    header.height = static_cast<uint32_t>(height_);
+    header.faceCount = static_cast<uint32_t>(faceCount_);
+    header.levelCount = static_cast<uint32_t>(levelCount_);
+    header.payloadSize = payload.size();
+    header.payloadHash = Hasher::hash(payload.data(), payload.size());
+
+    // Write to a temporary file first so the engine never picks up a partial file
+    std::string tempPath = filename + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            spdlog::error("Failed to open compressed texture for writing: {}", tempPath);
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+        if (!file.good()) {
+            spdlog::error("Failed to write compressed texture: {}", tempPath);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(tempPath, filename, error);
+    if (error) {
+        spdlog::error("Failed to write compressed texture {}: {}", filename, error.message());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Block-compressed texture with a precomputed mip chain (.atex files)
+ *
+ * The container is a fixed header followed by every image, face-major and
+ * then largest level first, ready for glCompressedTexImage2D. It plays the
+ * role of KTX for this project: the offline texture_compress tool writes one
+ * next to each source image, and Core::Texture prefers it over the PNG.
+ *
+ * Encoding uses a principal-axis endpoint fit per 4x4 block. It is built for
+ * offline use; it is not fast enough to run at load time.
+ */
+class CompressedTexture {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    enum class Format : uint32_t {
+        BC1 = 1,  // RGB, 8 bytes per block (GL_COMPRESSED_RGB_S3TC_DXT1_EXT)
+        BC3 = 3   // RGBA, 16 bytes per block (GL_COMPRESSED_RGBA_S3TC_DXT5_EXT)
+    };
+
+    CompressedTexture() = default;
+
+    /**
+     * @brief Compress an image and its mip chain as a new face
+     * @param rgba Tightly packed RGBA8 pixels, first row at the bottom as OpenGL expects
+     * @param width Image width
+     * @param height Image height
+     * @param format Block format; must match earlier faces
+     * @return true if the face was added
+     */
+    bool addFace(const uint8_t* rgba, int width, int height, Format format);
+
+    /**
+     * @brief Append every face of another texture with the same format and size
+     * @param other Source texture
+     * @return true if the faces were appended
+     */
+    bool appendFaces(const CompressedTexture& other);
+
+    /**
+     * @brief Read a .atex file
+     * @param filename File to read
+     * @return true if the file was valid
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Write a .atex file
+     * @param filename File to write
+     * @return true if successful
+     */
+    bool save(const std::string& filename) const;
+
+    Format getFormat() const { return format_; }
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    int getFaceCount() const { return faceCount_; }
+    int getLevelCount() const { return levelCount_; }
+    bool isEmpty() const { return faceCount_ == 0; }
+
+    /**
+     * @brief Get the blocks of one mip level
+     * @param face Face index
+     * @param level Mip level, 0 is full size
+     * @return const std::vector<uint8_t>& Compressed blocks
+     */
+    const std::vector<uint8_t>& getImage(int face, int level) const;
+
+    /**
+     * @brief Get the total size of all compressed images
+     * @return size_t Bytes
+     */
+    size_t getDataSize() const;
+
+    /**
+     * @brief Get the compressed size of one mip level
+     * @param format Block format
+     * @param width Level width
+     * @param height Level height
+     * @return size_t Bytes
+     */
+    static size_t getLevelSize(Format format, int width, int height);
+
+    /**
+     * @brief Get the .atex path that belongs to a source image
+     * @param imagePath Source image, e.g. assets/textures/brick.png
+     * @return std::string Same path with the extension replaced, e.g. assets/textures/brick.atex
+     */
+    static std::string getPathFor(const std::string& imagePath);
+
+    /**
+     * @brief Check if the .atex of a source image exists and is not older than the image
+     * @param imagePath Source image; a missing image does not make the .atex stale
+     * @return true if the .atex should be loaded instead of the image
+     */
+    static bool isUpToDate(const std::string& imagePath);
+
+private:
+    Format format_ = Format::BC1;
+    int width_ = 0;
+    int height_ = 0;
+    int faceCount_ = 0;
+    int levelCount_ = 0;
+    std::vector<std::vector<uint8_t>> images_;  // faceCount_ * levelCount_, face-major
+};
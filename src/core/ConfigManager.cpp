@@ -1,12 +1,32 @@
 #include "ConfigManager.hpp"
 #include "Camera.hpp"
 #include "SolarSystemManager.hpp"
+#include "Json.hpp"
+#include "WorkerThread.hpp"
 #include <fstream>
 #include <sstream>
 #include <filesystem>
+#include <algorithm>
 #include <chrono>
+#include <limits>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
 #include <spdlog/spdlog.h>
 
+ConfigManager::ConfigManager()
+    : autosaveInterval_(0.0f)
+    , autosaveTimer_(0.0f)
+    , autosaveHistory_(0)
+    , autosavePending_(false) {
+}
+
+ConfigManager::~ConfigManager() {
+    // Finish queued writes while the state they reference is still alive
+    ioWorker_.reset();
+}
+
 bool ConfigManager::saveConfig(const std::string& filename, const Camera* camera, 
                               const SolarSystemManager* solarSystem) {
     if (!camera || !solarSystem) {
@@ -102,6 +122,205 @@ bool ConfigManager::loadCameraConfig(const std::string& filename, Camera* camera
     return true;
 }
 
+WorkerThread& ConfigManager::getIOWorker() {
+    if (!ioWorker_) {
+        ioWorker_ = std::make_unique<WorkerThread>("Config I/O");
+    }
+    return *ioWorker_;
+}
+
+bool ConfigManager::saveConfigAsync(const std::string& filename, const Camera* camera,
+                                    const SolarSystemManager* solarSystem) {
+    if (!camera || !solarSystem) {
+        spdlog::error("ConfigManager::saveConfigAsync - Invalid camera or solar system pointer");
+        return false;
+    }
+    
+    // Capture on the calling thread; everything after this runs on the I/O thread
+    AppConfig config;
+    config.camera = cameraToConfig(camera);
+    config.solarSystem = solarSystemToConfig(solarSystem);
+    config.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    lastConfig_ = config;
+    
+    getIOWorker().submit([this, filename, config] {
+        if (writeJsonToFile(filename, configToJson(config))) {
+            spdlog::info("Configuration saved to: {}", filename);
+        } else {
+            spdlog::error("Failed to save configuration to: {}", filename);
+        }
+    });
+    return true;
+}
+
+bool ConfigManager::saveCameraConfigAsync(const std::string& filename, const Camera* camera) {
+    if (!camera) {
+        spdlog::error("ConfigManager::saveCameraConfigAsync - Invalid camera pointer");
+        return false;
+    }
+    
+    CameraConfig config = cameraToConfig(camera);
+    getIOWorker().submit([this, filename, config] {
+        if (writeJsonToFile(filename, cameraConfigToJson(config))) {
+            spdlog::info("Camera configuration saved to: {}", filename);
+        } else {
+            spdlog::error("Failed to save camera configuration to: {}", filename);
+        }
+    });
+    return true;
+}
+
+void ConfigManager::loadConfigAsync(const std::string& filename, bool cameraOnly) {
+    getIOWorker().submit([this, filename, cameraOnly] {
+        std::string jsonString;
+        if (!readJsonFromFile(filename, jsonString)) {
+            spdlog::error("Failed to read configuration file: {}", filename);
+            return;
+        }
+        
+        LoadedConfig loaded{filename, AppConfig{}, cameraOnly};
+        if (!jsonToConfig(jsonString, loaded.config)) {
+            spdlog::error("Failed to parse configuration file: {}", filename);
+            return;
+        }
+        
+        std::lock_guard<std::mutex> lock(loadedMutex_);
+        loadedConfigs_.push_back(std::move(loaded));
+    });
+}
+
+size_t ConfigManager::applyLoadedConfigs(Camera* camera, SolarSystemManager* solarSystem) {
+    std::vector<LoadedConfig> loaded;
+    {
+        std::lock_guard<std::mutex> lock(loadedMutex_);
+        if (loadedConfigs_.empty()) {
+            return 0;
+        }
+        loaded.swap(loadedConfigs_);
+    }
+    
+    for (const auto& entry : loaded) {
+        if (camera) {
+            configToCamera(entry.config.camera, camera);
+        }
+        if (!entry.cameraOnly && solarSystem) {
+            configToSolarSystem(entry.config.solarSystem, solarSystem);
+            lastConfig_ = entry.config;
+        }
+        spdlog::info("Configuration loaded from: {}", entry.filename);
+    }
+    return loaded.size();
+}
+
+std::string ConfigManager::captureConfigJson(const Camera* camera, const SolarSystemManager* solarSystem) const {
+    if (!camera || !solarSystem) {
+        spdlog::error("ConfigManager::captureConfigJson - Invalid camera or solar system pointer");
+        return {};
+    }
+    
+    AppConfig config;
+    config.camera = cameraToConfig(camera);
+    config.solarSystem = solarSystemToConfig(solarSystem);
+    return configToJson(config);
+}
+
+bool ConfigManager::applyConfigJson(const std::string& jsonString, Camera* camera, SolarSystemManager* solarSystem) {
+    if (!camera || !solarSystem) {
+        spdlog::error("ConfigManager::applyConfigJson - Invalid camera or solar system pointer");
+        return false;
+    }
+    
+    AppConfig config;
+    if (!jsonToConfig(jsonString, config)) {
+        return false;
+    }
+    
+    configToCamera(config.camera, camera);
+    configToSolarSystem(config.solarSystem, solarSystem);
+    lastConfig_ = config;
+    return true;
+}
+
+void ConfigManager::setAutosave(const std::string& filename, float intervalSeconds, int historySize) {
+    autosaveFilename_ = filename;
+    autosaveInterval_ = intervalSeconds;
+    autosaveHistory_ = std::max(0, historySize);
+    autosaveTimer_ = 0.0f;
+    
+    if (autosaveInterval_ > 0.0f) {
+        spdlog::info("Autosave every {:.0f}s to {} (keeping {} previous)", 
+                     autosaveInterval_, autosaveFilename_, autosaveHistory_);
+    }
+}
+
+void ConfigManager::updateAutosave(float deltaTime, const Camera* camera, const SolarSystemManager* solarSystem) {
+    if (autosaveInterval_ <= 0.0f || autosaveFilename_.empty() || !camera || !solarSystem) {
+        return;
+    }
+    
+    autosaveTimer_ += deltaTime;
+    if (autosaveTimer_ < autosaveInterval_) {
+        return;
+    }
+    autosaveTimer_ = 0.0f;
+    
+    // Skip this round if the previous autosave is still being written
+    if (autosavePending_.exchange(true)) {
+        spdlog::debug("Previous autosave still in progress, skipping");
+        return;
+    }
+    
+    AppConfig config;
+    config.camera = cameraToConfig(camera);
+    config.solarSystem = solarSystemToConfig(solarSystem);
+    config.timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    getIOWorker().submit([this, filename = autosaveFilename_, history = autosaveHistory_, config] {
+        rotateHistory(filename, history);
+        if (writeJsonToFile(filename, configToJson(config))) {
+            spdlog::debug("Autosaved configuration to: {}", filename);
+        } else {
+            spdlog::error("Autosave to {} failed", filename);
+        }
+        autosavePending_ = false;
+    });
+}
+
+void ConfigManager::flush() {
+    if (ioWorker_) {
+        ioWorker_->flush();
+    }
+}
+
+void ConfigManager::rotateHistory(const std::string& filename, int historySize) const {
+    namespace fs = std::filesystem;
+    
+    const fs::path path(filename);
+    auto historyPath = [&](int index) {
+        fs::path numbered = path;
+        numbered.replace_extension(std::to_string(index) + path.extension().string());
+        return numbered;
+    };
+    
+    std::error_code ec;
+    if (historySize <= 0 || !fs::exists(path, ec)) {
+        return;
+    }
+    
+    fs::remove(historyPath(historySize), ec);
+    for (int i = historySize - 1; i >= 1; --i) {
+        if (fs::exists(historyPath(i), ec)) {
+            fs::rename(historyPath(i), historyPath(i + 1), ec);
+        }
+    }
+    fs::rename(path, historyPath(1), ec);
+    if (ec) {
+        spdlog::warn("Failed to rotate autosave history for {}: {}", filename, ec.message());
+    }
+}
+
 bool ConfigManager::isValidConfigFile(const std::string& filename) const {
     std::string jsonString;
     if (!readJsonFromFile(filename, jsonString)) {
@@ -188,8 +407,14 @@ ConfigManager::SolarSystemConfig ConfigManager::solarSystemToConfig(const SolarS
 }
 
 void ConfigManager::configToSolarSystem(const SolarSystemConfig& config, SolarSystemManager* solarSystem) const {
-    // Regenerate solar system with the loaded seed
-    solarSystem->generateSolarSystem(config.seed, 8); // Default planet count
+    // Only a different seed requires regenerating the system; every other
+    // setting is applied in place and the setters skip unchanged values
+    if (config.seed != solarSystem->getSeed()) {
+        solarSystem->generateSolarSystem(config.seed, solarSystem->getRequestedPlanetCount());
+    } else {
+        spdlog::debug("Configuration seed {} matches current system, skipping regeneration", config.seed);
+    }
+    
     solarSystem->setSystemScale(config.systemScale);
     solarSystem->setTimeScale(config.timeScale);
     solarSystem->setAsteroidBeltsVisible(config.asteroidsVisible);
@@ -214,23 +439,27 @@ bool ConfigManager::writeJsonToFile(const std::string& filename, const std::stri
             spdlog::info("Created directory: {}", dirPath.string());
         }
         
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            spdlog::error("Failed to open file for writing: {}", filename);
-            return false;
+        // Write to a temporary file and rename it over the target so a crash
+        // or full disk never leaves a truncated config behind
+        std::string tempName = filename + ".tmp";
+        {
+            std::ofstream file(tempName, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                spdlog::error("Failed to open file for writing: {}", tempName);
+                return false;
+            }
+            
+            file << jsonString;
+            file.flush();
+            if (!file.good()) {
+                spdlog::error("Failed to write file: {}", tempName);
+                return false;
+            }
         }
         
-        file << jsonString;
-        file.close();
-        
-        // Verify file was written successfully
-        if (std::filesystem::exists(filename)) {
-            spdlog::info("Successfully wrote configuration to: {}", filename);
-            return true;
-        } else {
-            spdlog::error("File was not created: {}", filename);
-            return false;
-        }
+        std::filesystem::rename(tempName, filename);
+        spdlog::debug("Successfully wrote configuration to: {}", filename);
+        return true;
     } catch (const std::exception& e) {
         spdlog::error("Error writing to file {}: {}", filename, e.what());
         return false;
@@ -255,229 +484,269 @@ bool ConfigManager::readJsonFromFile(const std::string& filename, std::string& j
     }
 }
 
+namespace {
+
+using FieldTarget = std::variant<float*, int*, bool*, long long*, std::string*, glm::vec3*>;
+
+struct FieldBinding {
+    std::string_view name;
+    FieldTarget target;
+};
+
+const FieldTarget* findField(const std::vector<FieldBinding>& fields, std::string_view name) {
+    for (const auto& field : fields) {
+        if (field.name == name) {
+            return &field.target;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Routes JSON parse events into an AppConfig
+ *
+ * Keys are matched against the known fields of the section they appear in,
+ * so identically named keys in different sections never collide. Unknown
+ * keys, including any nested data below them, are skipped.
+ */
+class ConfigJsonHandler : public JsonHandler {
+public:
+    explicit ConfigJsonHandler(ConfigManager::AppConfig& config)
+        : rootFields_{
+              {"version", &config.version},
+              {"timestamp", &config.timestamp}}
+        , cameraFields_{
+              {"position", &config.camera.position},
+              {"yaw", &config.camera.yaw},
+              {"pitch", &config.camera.pitch},
+              {"zoom", &config.camera.zoom},
+              {"mode", &config.camera.mode},
+              {"movementSpeed", &config.camera.movementSpeed},
+              {"mouseSensitivity", &config.camera.mouseSensitivity},
+              {"motionBlurEnabled", &config.camera.motionBlurEnabled},
+              {"orbitDistance", &config.camera.orbitDistance},
+              {"orbitSpeed", &config.camera.orbitSpeed},
+              {"orbitHeight", &config.camera.orbitHeight},
+              {"autoFollowEnabled", &config.camera.autoFollowEnabled},
+              {"followDistance", &config.camera.followDistance},
+              {"followHeight", &config.camera.followHeight},
+              {"followSmoothing", &config.camera.followSmoothing}}
+        , solarSystemFields_{
+              {"seed", &config.solarSystem.seed},
+              {"systemScale", &config.solarSystem.systemScale},
+              {"timeScale", &config.solarSystem.timeScale},
+              {"asteroidsVisible", &config.solarSystem.asteroidsVisible},
+              {"ringsVisible", &config.solarSystem.ringsVisible},
+              {"particlesVisible", &config.solarSystem.particlesVisible},
+              {"asteroidDensity", &config.solarSystem.asteroidDensity},
+              {"ringDensity", &config.solarSystem.ringDensity},
+              {"particleEmissionRate", &config.solarSystem.particleEmissionRate}} {
+    }
+
+    bool hasCamera() const { return hasCamera_; }
+
+    bool startObject() override {
+        if (depth_ == 1) {
+            section_ = pendingSection_;
+            hasCamera_ = hasCamera_ || section_ == &cameraFields_;
+        }
+        ++depth_;
+        target_ = nullptr;
+        return true;
+    }
+
+    bool endObject() override {
+        --depth_;
+        if (depth_ == 1) {
+            section_ = nullptr;
+        }
+        return true;
+    }
+
+    bool startArray() override {
+        if (depth_ == 2 && target_) {
+            auto vector = std::get_if<glm::vec3*>(target_);
+            vector_ = vector ? *vector : nullptr;
+            arrayIndex_ = 0;
+        }
+        ++depth_;
+        target_ = nullptr;
+        return true;
+    }
+
+    bool endArray() override {
+        --depth_;
+        if (depth_ == 2) {
+            vector_ = nullptr;
+        }
+        return true;
+    }
+
+    bool key(std::string_view name) override {
+        target_ = nullptr;
+        if (depth_ == 1) {
+            target_ = findField(rootFields_, name);
+            pendingSection_ = name == "camera" ? &cameraFields_
+                            : name == "solarSystem" ? &solarSystemFields_
+                            : nullptr;
+        } else if (depth_ == 2 && section_) {
+            target_ = findField(*section_, name);
+        }
+        return true;
+    }
+
+    bool number(double value) override {
+        if (depth_ == 3 && vector_) {
+            if (arrayIndex_ < 3) {
+                (*vector_)[arrayIndex_] = static_cast<float>(value);
+            }
+            ++arrayIndex_;
+            return true;
+        }
+
+        const FieldTarget* target = std::exchange(target_, nullptr);
+        if (!target) {
+            return true;
+        }
+        if (auto field = std::get_if<float*>(target)) {
+            **field = static_cast<float>(value);
+            return true;
+        }
+        if (auto field = std::get_if<int*>(target)) {
+            if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+                return false;
+            }
+            **field = static_cast<int>(value);
+            return true;
+        }
+        if (auto field = std::get_if<long long*>(target)) {
+            **field = static_cast<long long>(value);
+            return true;
+        }
+        return false;
+    }
+
+    bool boolean(bool value) override {
+        const FieldTarget* target = std::exchange(target_, nullptr);
+        if (!target) {
+            return true;
+        }
+        if (auto field = std::get_if<bool*>(target)) {
+            **field = value;
+            return true;
+        }
+        return false;
+    }
+
+    bool string(std::string_view value) override {
+        const FieldTarget* target = std::exchange(target_, nullptr);
+        if (!target) {
+            return true;
+        }
+        if (auto field = std::get_if<std::string*>(target)) {
+            (*field)->assign(value);
+            return true;
+        }
+        return false;
+    }
+
+    bool null() override {
+        target_ = nullptr;
+        return true;
+    }
+
+private:
+    std::vector<FieldBinding> rootFields_;
+    std::vector<FieldBinding> cameraFields_;
+    std::vector<FieldBinding> solarSystemFields_;
+
+    const std::vector<FieldBinding>* pendingSection_ = nullptr;
+    const std::vector<FieldBinding>* section_ = nullptr;
+    const FieldTarget* target_ = nullptr;
+    glm::vec3* vector_ = nullptr;
+    int arrayIndex_ = 0;
+    int depth_ = 0;
+    bool hasCamera_ = false;
+};
+
+void writeCameraConfig(JsonWriter& json, const ConfigManager::CameraConfig& config) {
+    json.key("camera").beginObject();
+    json.key("position").beginArray(true)
+        .value(config.position.x)
+        .value(config.position.y)
+        .value(config.position.z)
+        .endArray();
+    json.key("yaw").value(config.yaw);
+    json.key("pitch").value(config.pitch);
+    json.key("zoom").value(config.zoom);
+    json.key("mode").value(config.mode);
+    json.key("movementSpeed").value(config.movementSpeed);
+    json.key("mouseSensitivity").value(config.mouseSensitivity);
+    json.key("motionBlurEnabled").value(config.motionBlurEnabled);
+    json.key("orbitDistance").value(config.orbitDistance);
+    json.key("orbitSpeed").value(config.orbitSpeed);
+    json.key("orbitHeight").value(config.orbitHeight);
+    json.key("autoFollowEnabled").value(config.autoFollowEnabled);
+    json.key("followDistance").value(config.followDistance);
+    json.key("followHeight").value(config.followHeight);
+    json.key("followSmoothing").value(config.followSmoothing);
+    json.endObject();
+}
+
+} // namespace
+
 std::string ConfigManager::configToJson(const AppConfig& config) const {
-    std::stringstream json;
-    
-    json << "{\n";
-    json << "  \"version\": \"" << config.version << "\",\n";
-    json << "  \"timestamp\": " << config.timestamp << ",\n";
+    JsonWriter json;
+    json.beginObject();
+    json.key("version").value(config.version);
+    json.key("timestamp").value(config.timestamp);
     
     // Camera configuration
-    json << "  \"camera\": {\n";
-    json << "    \"position\": [" << config.camera.position.x << ", " 
-         << config.camera.position.y << ", " << config.camera.position.z << "],\n";
-    json << "    \"yaw\": " << config.camera.yaw << ",\n";
-    json << "    \"pitch\": " << config.camera.pitch << ",\n";
-    json << "    \"zoom\": " << config.camera.zoom << ",\n";
-    json << "    \"mode\": " << config.camera.mode << ",\n";
-    json << "    \"movementSpeed\": " << config.camera.movementSpeed << ",\n";
-    json << "    \"mouseSensitivity\": " << config.camera.mouseSensitivity << ",\n";
-    json << "    \"motionBlurEnabled\": " << (config.camera.motionBlurEnabled ? "true" : "false") << ",\n";
-    json << "    \"orbitDistance\": " << config.camera.orbitDistance << ",\n";
-    json << "    \"orbitSpeed\": " << config.camera.orbitSpeed << ",\n";
-    json << "    \"orbitHeight\": " << config.camera.orbitHeight << ",\n";
-    json << "    \"autoFollowEnabled\": " << (config.camera.autoFollowEnabled ? "true" : "false") << ",\n";
-    json << "    \"followDistance\": " << config.camera.followDistance << ",\n";
-    json << "    \"followHeight\": " << config.camera.followHeight << ",\n";
-    json << "    \"followSmoothing\": " << config.camera.followSmoothing << "\n";
-    json << "  },\n";
+    writeCameraConfig(json, config.camera);
     
     // Solar system configuration
-    json << "  \"solarSystem\": {\n";
-    json << "    \"seed\": " << config.solarSystem.seed << ",\n";
-    json << "    \"systemScale\": " << config.solarSystem.systemScale << ",\n";
-    json << "    \"timeScale\": " << config.solarSystem.timeScale << ",\n";
-    json << "    \"asteroidsVisible\": " << (config.solarSystem.asteroidsVisible ? "true" : "false") << ",\n";
-    json << "    \"ringsVisible\": " << (config.solarSystem.ringsVisible ? "true" : "false") << ",\n";
-    json << "    \"particlesVisible\": " << (config.solarSystem.particlesVisible ? "true" : "false") << ",\n";
-    json << "    \"asteroidDensity\": " << config.solarSystem.asteroidDensity << ",\n";
-    json << "    \"ringDensity\": " << config.solarSystem.ringDensity << ",\n";
-    json << "    \"particleEmissionRate\": " << config.solarSystem.particleEmissionRate << "\n";
-    json << "  }\n";
-    json << "}";
+    json.key("solarSystem").beginObject();
+    json.key("seed").value(config.solarSystem.seed);
+    json.key("systemScale").value(config.solarSystem.systemScale);
+    json.key("timeScale").value(config.solarSystem.timeScale);
+    json.key("asteroidsVisible").value(config.solarSystem.asteroidsVisible);
+    json.key("ringsVisible").value(config.solarSystem.ringsVisible);
+    json.key("particlesVisible").value(config.solarSystem.particlesVisible);
+    json.key("asteroidDensity").value(config.solarSystem.asteroidDensity);
+    json.key("ringDensity").value(config.solarSystem.ringDensity);
+    json.key("particleEmissionRate").value(config.solarSystem.particleEmissionRate);
+    json.endObject();
     
+    json.endObject();
     return json.str();
 }
 
 std::string ConfigManager::cameraConfigToJson(const CameraConfig& config) const {
-    std::stringstream json;
-    
-    json << "{\n";
-    json << "  \"version\": \"1.0.0\",\n";
-    json << "  \"timestamp\": " << std::chrono::duration_cast<std::chrono::seconds>(
-        std::chrono::system_clock::now().time_since_epoch()).count() << ",\n";
+    JsonWriter json;
+    json.beginObject();
+    json.key("version").value("1.0.0");
+    json.key("timestamp").value(static_cast<long long>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count()));
     
     // Camera configuration only
-    json << "  \"camera\": {\n";
-    json << "    \"position\": [" << config.position.x << ", " 
-         << config.position.y << ", " << config.position.z << "],\n";
-    json << "    \"yaw\": " << config.yaw << ",\n";
-    json << "    \"pitch\": " << config.pitch << ",\n";
-    json << "    \"zoom\": " << config.zoom << ",\n";
-    json << "    \"mode\": " << config.mode << ",\n";
-    json << "    \"movementSpeed\": " << config.movementSpeed << ",\n";
-    json << "    \"mouseSensitivity\": " << config.mouseSensitivity << ",\n";
-    json << "    \"motionBlurEnabled\": " << (config.motionBlurEnabled ? "true" : "false") << ",\n";
-    json << "    \"orbitDistance\": " << config.orbitDistance << ",\n";
-    json << "    \"orbitSpeed\": " << config.orbitSpeed << ",\n";
-    json << "    \"orbitHeight\": " << config.orbitHeight << ",\n";
-    json << "    \"autoFollowEnabled\": " << (config.autoFollowEnabled ? "true" : "false") << ",\n";
-    json << "    \"followDistance\": " << config.followDistance << ",\n";
-    json << "    \"followHeight\": " << config.followHeight << ",\n";
-    json << "    \"followSmoothing\": " << config.followSmoothing << "\n";
-    json << "  }\n";
-    json << "}";
+    writeCameraConfig(json, config);
     
+    json.endObject();
     return json.str();
 }
 
 bool ConfigManager::jsonToConfig(const std::string& jsonString, AppConfig& config) const {
-    try {
-        // Simple JSON parsing without external library
-        // This is a basic implementation - in production, use a proper JSON library
-        
-        // Find camera section
-        size_t cameraStart = jsonString.find("\"camera\":");
-        if (cameraStart == std::string::npos) return false;
-        
-        // Parse camera position
-        size_t posStart = jsonString.find("\"position\":", cameraStart);
-        if (posStart != std::string::npos) {
-            size_t arrayStart = jsonString.find("[", posStart);
-            size_t arrayEnd = jsonString.find("]", arrayStart);
-            if (arrayStart != std::string::npos && arrayEnd != std::string::npos) {
-                std::string posStr = jsonString.substr(arrayStart + 1, arrayEnd - arrayStart - 1);
-                std::stringstream ss(posStr);
-                std::string item;
-                int i = 0;
-                while (std::getline(ss, item, ',') && i < 3) {
-                    float value = std::stof(item);
-                    if (i == 0) config.camera.position.x = value;
-                    else if (i == 1) config.camera.position.y = value;
-                    else if (i == 2) config.camera.position.z = value;
-                    i++;
-                }
-            }
-        }
-        
-        // Parse other camera values
-        auto parseFloat = [&](const std::string& key, float& value) {
-            size_t keyPos = jsonString.find("\"" + key + "\":", cameraStart);
-            if (keyPos != std::string::npos) {
-                size_t valueStart = jsonString.find(":", keyPos) + 1;
-                size_t valueEnd = jsonString.find_first_of(",\n}", valueStart);
-                if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                    std::string valueStr = jsonString.substr(valueStart, valueEnd - valueStart);
-                    // Remove whitespace
-                    valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-                    valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
-                    value = std::stof(valueStr);
-                }
-            }
-        };
-        
-        auto parseInt = [&](const std::string& key, int& value) {
-            size_t keyPos = jsonString.find("\"" + key + "\":", cameraStart);
-            if (keyPos != std::string::npos) {
-                size_t valueStart = jsonString.find(":", keyPos) + 1;
-                size_t valueEnd = jsonString.find_first_of(",\n}", valueStart);
-                if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                    std::string valueStr = jsonString.substr(valueStart, valueEnd - valueStart);
-                    valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-                    valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
-                    value = std::stoi(valueStr);
-                }
-            }
-        };
-        
-        auto parseBool = [&](const std::string& key, bool& value) {
-            size_t keyPos = jsonString.find("\"" + key + "\":", cameraStart);
-            if (keyPos != std::string::npos) {
-                size_t valueStart = jsonString.find(":", keyPos) + 1;
-                size_t valueEnd = jsonString.find_first_of(",\n}", valueStart);
-                if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                    std::string valueStr = jsonString.substr(valueStart, valueEnd - valueStart);
-                    valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-                    valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
-                    value = (valueStr == "true");
-                }
-            }
-        };
-        
-        parseFloat("yaw", config.camera.yaw);
-        parseFloat("pitch", config.camera.pitch);
-        parseFloat("zoom", config.camera.zoom);
-        parseInt("mode", config.camera.mode);
-        parseFloat("movementSpeed", config.camera.movementSpeed);
-        parseFloat("mouseSensitivity", config.camera.mouseSensitivity);
-        parseBool("motionBlurEnabled", config.camera.motionBlurEnabled);
-        parseFloat("orbitDistance", config.camera.orbitDistance);
-        parseFloat("orbitSpeed", config.camera.orbitSpeed);
-        parseFloat("orbitHeight", config.camera.orbitHeight);
-        parseBool("autoFollowEnabled", config.camera.autoFollowEnabled);
-        parseFloat("followDistance", config.camera.followDistance);
-        parseFloat("followHeight", config.camera.followHeight);
-        parseFloat("followSmoothing", config.camera.followSmoothing);
-        
-        // Parse solar system section
-        size_t solarSystemStart = jsonString.find("\"solarSystem\":");
-        if (solarSystemStart != std::string::npos) {
-            auto parseFloatSS = [&](const std::string& key, float& value) {
-                size_t keyPos = jsonString.find("\"" + key + "\":", solarSystemStart);
-                if (keyPos != std::string::npos) {
-                    size_t valueStart = jsonString.find(":", keyPos) + 1;
-                    size_t valueEnd = jsonString.find_first_of(",\n}", valueStart);
-                    if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                        std::string valueStr = jsonString.substr(valueStart, valueEnd - valueStart);
-                        valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-                        valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
-                        value = std::stof(valueStr);
-                    }
-                }
-            };
-            
-            auto parseIntSS = [&](const std::string& key, int& value) {
-                size_t keyPos = jsonString.find("\"" + key + "\":", solarSystemStart);
-                if (keyPos != std::string::npos) {
-                    size_t valueStart = jsonString.find(":", keyPos) + 1;
-                    size_t valueEnd = jsonString.find_first_of(",\n}", valueStart);
-                    if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                        std::string valueStr = jsonString.substr(valueStart, valueEnd - valueStart);
-                        valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-                        valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
-                        value = std::stoi(valueStr);
-                    }
-                }
-            };
-            
-            auto parseBoolSS = [&](const std::string& key, bool& value) {
-                size_t keyPos = jsonString.find("\"" + key + "\":", solarSystemStart);
-                if (keyPos != std::string::npos) {
-                    size_t valueStart = jsonString.find(":", keyPos) + 1;
-                    size_t valueEnd = jsonString.find_first_of(",\n}", valueStart);
-                    if (valueStart != std::string::npos && valueEnd != std::string::npos) {
-                        std::string valueStr = jsonString.substr(valueStart, valueEnd - valueStart);
-                        valueStr.erase(0, valueStr.find_first_not_of(" \t"));
-                        valueStr.erase(valueStr.find_last_not_of(" \t") + 1);
-                        value = (valueStr == "true");
-                    }
-                }
-            };
-            
-            parseIntSS("seed", config.solarSystem.seed);
-            parseFloatSS("systemScale", config.solarSystem.systemScale);
-            parseFloatSS("timeScale", config.solarSystem.timeScale);
-            parseBoolSS("asteroidsVisible", config.solarSystem.asteroidsVisible);
-            parseBoolSS("ringsVisible", config.solarSystem.ringsVisible);
-            parseBoolSS("particlesVisible", config.solarSystem.particlesVisible);
-            parseFloatSS("asteroidDensity", config.solarSystem.asteroidDensity);
-            parseFloatSS("ringDensity", config.solarSystem.ringDensity);
-            parseFloatSS("particleEmissionRate", config.solarSystem.particleEmissionRate);
-        }
-        
-        return true;
-    } catch (const std::exception& e) {
-        spdlog::error("Error parsing JSON: {}", e.what());
+    ConfigJsonHandler handler(config);
+    std::string error;
+    if (!JsonReader::parse(jsonString, handler, error)) {
+        spdlog::error("Error parsing JSON: {}", error);
         return false;
     }
-}
\ No newline at end of file
+    
+    if (!handler.hasCamera()) {
+        spdlog::error("Error parsing JSON: missing \"camera\" section");
+        return false;
+    }
+    
+    return true;
+}
@@ -2,17 +2,25 @@
 
 #include <string>
 #include <glm/glm.hpp>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 // Forward declarations
 class Camera;
 class SolarSystemManager;
+class WorkerThread;
 
 /**
  * @brief Configuration manager for saving and loading application state
  * 
  * This class handles saving and loading of camera settings, solar system
  * configurations, and other application state to/from JSON files.
+ *
+ * The *Async methods and autosave run file I/O and JSON serialization on a
+ * background thread so that a slow disk never stalls a frame. All files are
+ * written atomically (temporary file + rename).
  */
 class ConfigManager {
 public:
@@ -66,8 +74,18 @@ public:
         long long timestamp{0};
     };
     
-    ConfigManager() = default;
-    ~ConfigManager() = default;
+    ConfigManager();
+    
+    /**
+     * @brief Destroy the ConfigManager, finishing any queued writes first
+     */
+    ~ConfigManager();
+    
+    // Non-copyable, non-movable
+    ConfigManager(const ConfigManager&) = delete;
+    ConfigManager& operator=(const ConfigManager&) = delete;
+    ConfigManager(ConfigManager&&) = delete;
+    ConfigManager& operator=(ConfigManager&&) = delete;
     
     /**
      * @brief Save current application state to file
@@ -105,6 +123,88 @@ public:
      */
     bool loadCameraConfig(const std::string& filename, Camera* camera);
     
+    /**
+     * @brief Save application state without blocking the calling thread
+     *
+     * State is captured immediately; serialization and the write happen on
+     * the I/O thread and the outcome is logged there.
+     *
+     * @param filename Path to save file
+     * @param camera Camera instance to save
+     * @param solarSystem Solar system manager to save
+     * @return true if the save was queued
+     */
+    bool saveConfigAsync(const std::string& filename, const Camera* camera,
+                         const SolarSystemManager* solarSystem);
+    
+    /**
+     * @brief Save only camera configuration without blocking the calling thread
+     * @param filename Path to save file
+     * @param camera Camera instance to save
+     * @return true if the save was queued
+     */
+    bool saveCameraConfigAsync(const std::string& filename, const Camera* camera);
+    
+    /**
+     * @brief Read and parse a configuration file on the I/O thread
+     *
+     * The result is applied by the next call to applyLoadedConfigs().
+     *
+     * @param filename Path to load file
+     * @param cameraOnly Apply only the camera section
+     */
+    void loadConfigAsync(const std::string& filename, bool cameraOnly = false);
+    
+    /**
+     * @brief Apply configurations finished by loadConfigAsync (main thread only)
+     * @param camera Camera instance to load into
+     * @param solarSystem Solar system manager to load into
+     * @return size_t Number of configurations applied (full or camera-only)
+     */
+    size_t applyLoadedConfigs(Camera* camera, SolarSystemManager* solarSystem);
+    
+    /**
+     * @brief Serialize the current application state without touching disk
+     * @param camera Camera instance to capture
+     * @param solarSystem Solar system manager to capture
+     * @return std::string JSON text, empty if a pointer is null
+     */
+    std::string captureConfigJson(const Camera* camera, const SolarSystemManager* solarSystem) const;
+    
+    /**
+     * @brief Apply a configuration given as JSON text
+     * @param jsonString JSON content as produced by captureConfigJson()
+     * @param camera Camera instance to load into
+     * @param solarSystem Solar system manager to load into
+     * @return true if the text was parsed and applied
+     */
+    bool applyConfigJson(const std::string& jsonString, Camera* camera, SolarSystemManager* solarSystem);
+    
+    /**
+     * @brief Configure periodic autosave
+     *
+     * Each autosave rotates older saves to <name>.1.json ... <name>.N.json
+     * before writing, keeping at most historySize previous versions.
+     *
+     * @param filename Autosave file path
+     * @param intervalSeconds Seconds between autosaves (0 disables autosave)
+     * @param historySize Number of previous autosaves to keep
+     */
+    void setAutosave(const std::string& filename, float intervalSeconds, int historySize);
+    
+    /**
+     * @brief Advance the autosave timer and queue an autosave when it is due
+     * @param deltaTime Time since last frame
+     * @param camera Camera instance to save
+     * @param solarSystem Solar system manager to save
+     */
+    void updateAutosave(float deltaTime, const Camera* camera, const SolarSystemManager* solarSystem);
+    
+    /**
+     * @brief Block until all queued I/O has finished
+     */
+    void flush();
+    
     /**
      * @brief Get the last loaded/saved configuration
      * @return const reference to app config
@@ -131,8 +231,43 @@ public:
     bool createDefaultSaveDirectory() const;
 
 private:
+    /**
+     * @brief Configuration parsed on the I/O thread, waiting to be applied
+     */
+    struct LoadedConfig {
+        std::string filename;
+        AppConfig config;
+        bool cameraOnly;
+    };
+    
     AppConfig lastConfig_;
     
+    // Autosave settings
+    std::string autosaveFilename_;
+    float autosaveInterval_;
+    float autosaveTimer_;
+    int autosaveHistory_;
+    std::atomic<bool> autosavePending_;
+    
+    std::mutex loadedMutex_;
+    std::vector<LoadedConfig> loadedConfigs_;
+    
+    // Declared last so it is destroyed (and drained) before the state its jobs use
+    std::unique_ptr<WorkerThread> ioWorker_;
+    
+    /**
+     * @brief Get the I/O thread, starting it on first use
+     * @return WorkerThread& I/O worker
+     */
+    WorkerThread& getIOWorker();
+    
+    /**
+     * @brief Shift <name>.json to <name>.1.json, <name>.1.json to <name>.2.json, ...
+     * @param filename Newest file of the history
+     * @param historySize Number of previous versions to keep
+     */
+    void rotateHistory(const std::string& filename, int historySize) const;
+    
     /**
      * @brief Convert camera to config structure
      * @param camera Camera instance
@@ -162,7 +297,7 @@ private:
     void configToSolarSystem(const SolarSystemConfig& config, SolarSystemManager* solarSystem) const;
     
     /**
-     * @brief Write JSON string to file
+     * @brief Write JSON string to file atomically (temporary file + rename)
      * @param filename Target file path
      * @param jsonString JSON content
      * @return true if successful
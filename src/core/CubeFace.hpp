@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Get the point of a cube face, oriented like the GL cubemap face of the same index
+ * @param face Face index in GL order (+X, -X, +Y, -Y, +Z, -Z)
+ * @param x Horizontal face coordinate, [-1, 1] on the face
+ * @param y Vertical face coordinate, [-1, 1] on the face
+ * @return glm::vec3 Point on the plane of the face; on the [-1, 1] cube for coordinates in range
+ */
+inline glm::vec3 cubeFacePoint(int face, float x, float y) {
+    // x and y follow the s and t axes of the GL cubemap faces
+    switch (face) {
+        case 0: return glm::vec3(1.0f, -y, -x);
+        case 1: return glm::vec3(-1.0f, -y, x);
+        case 2: return glm::vec3(x, 1.0f, y);
+        case 3: return glm::vec3(x, -1.0f, -y);
+        case 4: return glm::vec3(x, -y, 1.0f);
+        default: return glm::vec3(-x, -y, -1.0f);
+    }
+}
+
+/**
+ * @brief Find the cube face a direction points at, the inverse of cubeFacePoint
+ * @param direction Any non-zero direction
+ * @param x Receives the horizontal face coordinate in [-1, 1]
+ * @param y Receives the vertical face coordinate in [-1, 1]
+ * @return int Face index in GL order
+ */
+inline int cubeFaceCoords(const glm::vec3& direction, float& x, float& y) {
+    const glm::vec3 a = glm::abs(direction);
+    if (a.x >= a.y && a.x >= a.z) {
+        const float inverse = 1.0f / a.x;
+        x = (direction.x > 0.0f ? -direction.z : direction.z) * inverse;
+        y = -direction.y * inverse;
+        return direction.x > 0.0f ? 0 : 1;
+    }
+    if (a.y >= a.z) {
+        const float inverse = 1.0f / a.y;
+        x = direction.x * inverse;
+        y = (direction.y > 0.0f ? direction.z : -direction.z) * inverse;
+        return direction.y > 0.0f ? 2 : 3;
+    }
+    const float inverse = 1.0f / a.z;
+    x = (direction.z > 0.0f ? direction.x : -direction.x) * inverse;
+    y = -direction.y * inverse;
+    return direction.z > 0.0f ? 4 : 5;
+}
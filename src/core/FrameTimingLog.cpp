@@ -0,0 +1,58 @@
+#include "FrameTimingLog.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdio>
+
+FrameTimingLog::~FrameTimingLog() {
+    close();
+}
+
+bool FrameTimingLog::open(const std::string& filename) {
+    close();
+
+    file_.open(filename, std::ios::trunc);
+    if (!file_.is_open()) {
+        spdlog::error("Failed to create frame timing log: {}", filename);
+        return false;
+    }
+
+    file_ << "frame,delta_ms,update_ms,render_ms,present_ms,frame_ms\n";
+    filename_ = filename;
+    frameTimes_.clear();
+    return true;
+}
+
+void FrameTimingLog::record(const FrameTiming& timing) {
+    if (!file_.is_open()) {
+        return;
+    }
+
+    char line[160];
+    int length = std::snprintf(line, sizeof(line), "%zu,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                               frameTimes_.size(), timing.deltaTime * 1000.0,
+                               timing.updateMs, timing.renderMs, timing.presentMs, timing.frameMs);
+    file_.write(line, length);
+    frameTimes_.push_back(timing.frameMs);
+}
+
+double FrameTimingLog::percentile(const std::vector<double>& sorted, double fraction) {
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void FrameTimingLog::close() {
+    if (!file_.is_open()) {
+        return;
+    }
+
+    file_.close();
+    if (frameTimes_.empty()) {
+        return;
+    }
+
+    std::vector<double> sorted = frameTimes_;
+    std::sort(sorted.begin(), sorted.end());
+    spdlog::info("Frame timings written to {}: {} frames, p50 {:.3f} ms, p95 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+                 filename_, sorted.size(), percentile(sorted, 0.50), percentile(sorted, 0.95),
+                 percentile(sorted, 0.99), sorted.back());
+}
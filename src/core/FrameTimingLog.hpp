@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief CPU timings of one frame, in milliseconds
+ */
+struct FrameTiming {
+    float deltaTime = 0.0f;   // Simulation step fed to update(), in seconds
+    double updateMs = 0.0;
+    double renderMs = 0.0;
+    double presentMs = 0.0;   // Buffer swap (includes waiting on the GPU/driver)
+    double frameMs = 0.0;
+};
+
+/**
+ * @brief Writes per-frame timings as CSV and summarizes them on close
+ *
+ * The CSV has one row per frame so two runs of the same session log can be
+ * diffed or plotted frame by frame. Percentiles are computed over frame time.
+ */
+class FrameTimingLog {
+public:
+    FrameTimingLog() = default;
+    ~FrameTimingLog();
+
+    // Non-copyable, non-movable
+    FrameTimingLog(const FrameTimingLog&) = delete;
+    FrameTimingLog& operator=(const FrameTimingLog&) = delete;
+    FrameTimingLog(FrameTimingLog&&) = delete;
+    FrameTimingLog& operator=(FrameTimingLog&&) = delete;
+
+    /**
+     * @brief Create the CSV file and write its column header
+     * @param filename Output path
+     * @return true if the file was created
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Append one frame
+     * @param timing Frame timings
+     */
+    void record(const FrameTiming& timing);
+
+    /**
+     * @brief Close the file and log frame time percentiles
+     */
+    void close();
+
+    bool isOpen() const { return file_.is_open(); }
+
+    /**
+     * @brief Nearest-rank percentile of sorted samples
+     * @param sorted Samples in ascending order (must not be empty)
+     * @param fraction Percentile as a fraction (0.95 for p95)
+     * @return double Sample value
+     */
+    static double percentile(const std::vector<double>& sorted, double fraction);
+
+private:
+    std::ofstream file_;
+    std::string filename_;
+    std::vector<double> frameTimes_;
+};
@@ -0,0 +1,350 @@
+#include "GLApi.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+GLDispatch gl;
+
+namespace {
+
+constexpr size_t FUNCTION_COUNT = static_cast<size_t>(GLFunction::Count);
+
+const char* const FUNCTION_NAMES[FUNCTION_COUNT] = {
+#define ASTRALIS_GL_NAME(ret, name, params, args) "gl" #name,
+    ASTRALIS_GL_ALL_FUNCTIONS(ASTRALIS_GL_NAME)
+#undef ASTRALIS_GL_NAME
+};
+
+bool loaded = false;
+bool counting = false;
+GLApi::Backend activeBackend = GLApi::Backend::Native;
+
+// Table the counting thunks forward to (driver or null backend)
+GLDispatch forward;
+
+GLStats totals;
+GLStats frame;
+
+void countCall(GLFunction function) {
+    size_t index = static_cast<size_t>(function);
+    ++totals.calls[index];
+    ++totals.totalCalls;
+    ++frame.calls[index];
+    ++frame.totalCalls;
+}
+
+void countBufferBytes(ptrdiff_t size, const void* data) {
+    if (data != nullptr && size > 0) {
+        totals.bufferBytes += static_cast<uint64_t>(size);
+        frame.bufferBytes += static_cast<uint64_t>(size);
+    }
+}
+
+uint64_t bytesPerPixel(GLenum format, GLenum type) {
+    uint64_t components = 4;
+    switch (format) {
+        case GL_RED:
+        case GL_ALPHA:
+        case GL_DEPTH_COMPONENT:
+            components = 1;
+            break;
+        case GL_RG:
+            components = 2;
+            break;
+        case GL_RGB:
+        case GL_BGR:
+            components = 3;
+            break;
+        default:
+            break;
+    }
+
+    switch (type) {
+        case GL_UNSIGNED_BYTE:
+        case GL_BYTE:
+            return components;
+        case GL_UNSIGNED_SHORT:
+        case GL_SHORT:
+        case GL_HALF_FLOAT:
+            return components * 2;
+        default:
+            return components * 4;
+    }
+}
+
+void countTextureBytes(GLsizei width, GLsizei height, GLenum format, GLenum type, const void* pixels) {
+    // A null pointer only allocates storage (or reads from a bound unpack buffer)
+    if (pixels != nullptr && width > 0 && height > 0) {
+        uint64_t bytes = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * bytesPerPixel(format, type);
+        totals.textureBytes += bytes;
+        frame.textureBytes += bytes;
+    }
+}
+
+// Counting thunks: bump the counter of the entry, then forward
+#define ASTRALIS_GL_THUNK(ret, name, params, args) \
+    ret ASTRALIS_GL_APIENTRY count##name params { \
+        countCall(GLFunction::name); \
+        return forward.name args; \
+    }
+ASTRALIS_GL_ALL_FUNCTIONS(ASTRALIS_GL_THUNK)
+#undef ASTRALIS_GL_THUNK
+
+// Upload entry points also record their payload size
+void ASTRALIS_GL_APIENTRY countUploadBufferData(GLenum bufferTarget, ptrdiff_t size, const void* data, GLenum usage) {
+    countBufferBytes(size, data);
+    countBufferData(bufferTarget, size, data, usage);
+}
+
+void ASTRALIS_GL_APIENTRY countUploadBufferSubData(GLenum bufferTarget, ptrdiff_t offset, ptrdiff_t size, const void* data) {
+    countBufferBytes(size, data);
+    countBufferSubData(bufferTarget, offset, size, data);
+}
+
+void* ASTRALIS_GL_APIENTRY countUploadMapBufferRange(GLenum bufferTarget, ptrdiff_t offset, ptrdiff_t length,
+                                                    GLbitfield access) {
+    void* mapped = countMapBufferRange(bufferTarget, offset, length, access);
+    // Staging writes through a mapped buffer are uploads too
+    if (access & GL_MAP_WRITE_BIT) {
+        countBufferBytes(length, mapped);
+    }
+    return mapped;
+}
+
+void ASTRALIS_GL_APIENTRY countUploadTexImage2D(GLenum textureTarget, GLint level, GLint internalFormat, GLsizei width,
+                                               GLsizei height, GLint border, GLenum format, GLenum type, const void* pixels) {
+    countTextureBytes(width, height, format, type, pixels);
+    countTexImage2D(textureTarget, level, internalFormat, width, height, border, format, type, pixels);
+}
+
+void ASTRALIS_GL_APIENTRY countUploadTexSubImage2D(GLenum textureTarget, GLint level, GLint xoffset, GLint yoffset,
+                                                  GLsizei width, GLsizei height, GLenum format, GLenum type,
+                                                  const void* pixels) {
+    countTextureBytes(width, height, format, type, pixels);
+    countTexSubImage2D(textureTarget, level, xoffset, yoffset, width, height, format, type, pixels);
+}
+
+void ASTRALIS_GL_APIENTRY countUploadCompressedTexImage2D(GLenum textureTarget, GLint level, GLenum internalFormat,
+                                                         GLsizei width, GLsizei height, GLint border, GLsizei imageSize,
+                                                         const void* data) {
+    if (data != nullptr && imageSize > 0) {
+        totals.textureBytes += static_cast<uint64_t>(imageSize);
+        frame.textureBytes += static_cast<uint64_t>(imageSize);
+    }
+    countCompressedTexImage2D(textureTarget, level, internalFormat, width, height, border, imageSize, data);
+}
+
+// Null backend: by default every entry does nothing and returns zero
+template <typename Function>
+struct NullEntry;
+
+template <typename Ret, typename... Args>
+struct NullEntry<Ret (ASTRALIS_GL_APIENTRY*)(Args...)> {
+    static Ret ASTRALIS_GL_APIENTRY call(Args...) { return Ret(); }
+};
+
+GLuint nextObjectName = 0;
+std::vector<unsigned char> mapScratch;
+
+void ASTRALIS_GL_APIENTRY nullGenNames(GLsizei n, GLuint* names) {
+    for (GLsizei i = 0; i < n; ++i) {
+        names[i] = ++nextObjectName;
+    }
+}
+
+GLuint ASTRALIS_GL_APIENTRY nullCreateShader(GLenum) {
+    return ++nextObjectName;
+}
+
+GLuint ASTRALIS_GL_APIENTRY nullCreateProgram() {
+    return ++nextObjectName;
+}
+
+void ASTRALIS_GL_APIENTRY nullGetObjectiv(GLuint, GLenum pname, GLint* params) {
+    // Every compile and link succeeds immediately without an info log
+    *params = (pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS || pname == GL_COMPLETION_STATUS_KHR) ? GL_TRUE : 0;
+}
+
+void ASTRALIS_GL_APIENTRY nullGetInfoLog(GLuint, GLsizei bufSize, GLsizei* length, char* infoLog) {
+    if (length) {
+        *length = 0;
+    }
+    if (infoLog && bufSize > 0) {
+        infoLog[0] = '\0';
+    }
+}
+
+const GLubyte* ASTRALIS_GL_APIENTRY nullGetString(GLenum) {
+    return reinterpret_cast<const GLubyte*>("Null backend");
+}
+
+void* ASTRALIS_GL_APIENTRY nullMapBufferRange(GLenum, ptrdiff_t, ptrdiff_t length, GLbitfield) {
+    mapScratch.resize(std::max(mapScratch.size(), static_cast<size_t>(std::max<ptrdiff_t>(length, 1))));
+    return mapScratch.data();
+}
+
+GLboolean ASTRALIS_GL_APIENTRY nullUnmapBuffer(GLenum) {
+    return GL_TRUE;
+}
+
+GLenum ASTRALIS_GL_APIENTRY nullCheckFramebufferStatus(GLenum) {
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void* ASTRALIS_GL_APIENTRY nullFenceSync(GLenum, GLbitfield) {
+    return reinterpret_cast<void*>(static_cast<uintptr_t>(++nextObjectName));
+}
+
+GLenum ASTRALIS_GL_APIENTRY nullClientWaitSync(void*, GLbitfield, uint64_t) {
+    return GL_ALREADY_SIGNALED;
+}
+
+GLDispatch createNullDispatch() {
+    GLDispatch dispatch;
+#define ASTRALIS_GL_NULL(ret, name, params, args) dispatch.name = &NullEntry<decltype(dispatch.name)>::call;
+    ASTRALIS_GL_FUNCTIONS(ASTRALIS_GL_NULL)
+#undef ASTRALIS_GL_NULL
+
+    dispatch.GenTextures = nullGenNames;
+    dispatch.GenBuffers = nullGenNames;
+    dispatch.GenVertexArrays = nullGenNames;
+    dispatch.GenFramebuffers = nullGenNames;
+    dispatch.GenRenderbuffers = nullGenNames;
+    dispatch.CreateShader = nullCreateShader;
+    dispatch.CreateProgram = nullCreateProgram;
+    dispatch.GetShaderiv = nullGetObjectiv;
+    dispatch.GetProgramiv = nullGetObjectiv;
+    dispatch.GetShaderInfoLog = nullGetInfoLog;
+    dispatch.GetProgramInfoLog = nullGetInfoLog;
+    dispatch.GetString = nullGetString;
+    dispatch.MapBufferRange = nullMapBufferRange;
+    dispatch.UnmapBuffer = nullUnmapBuffer;
+    dispatch.CheckFramebufferStatus = nullCheckFramebufferStatus;
+    dispatch.FenceSync = nullFenceSync;
+    dispatch.ClientWaitSync = nullClientWaitSync;
+    return dispatch;
+}
+
+bool loadNativeDispatch(GLDispatch& dispatch) {
+    bool complete = true;
+#define ASTRALIS_GL_RESOLVE(ret, name, params, args) \
+    dispatch.name = reinterpret_cast<decltype(dispatch.name)>(glfwGetProcAddress("gl" #name)); \
+    if (!dispatch.name) { \
+        spdlog::error("Missing OpenGL function gl" #name); \
+        complete = false; \
+    }
+    ASTRALIS_GL_FUNCTIONS(ASTRALIS_GL_RESOLVE)
+#undef ASTRALIS_GL_RESOLVE
+
+#define ASTRALIS_GL_RESOLVE_OPTIONAL(ret, name, params, args) \
+    dispatch.name = reinterpret_cast<decltype(dispatch.name)>(glfwGetProcAddress("gl" #name)); \
+    if (!dispatch.name) { \
+        spdlog::info("Optional OpenGL function gl" #name " not available"); \
+    }
+    ASTRALIS_GL_OPTIONAL_FUNCTIONS(ASTRALIS_GL_RESOLVE_OPTIONAL)
+#undef ASTRALIS_GL_RESOLVE_OPTIONAL
+    return complete;
+}
+
+GLDispatch createCountingDispatch() {
+    GLDispatch dispatch;
+#define ASTRALIS_GL_COUNTING(ret, name, params, args) dispatch.name = count##name;
+    ASTRALIS_GL_FUNCTIONS(ASTRALIS_GL_COUNTING)
+#undef ASTRALIS_GL_COUNTING
+
+    // Missing optional entries stay null so callers still see them as unavailable
+#define ASTRALIS_GL_COUNTING_OPTIONAL(ret, name, params, args) dispatch.name = forward.name ? count##name : nullptr;
+    ASTRALIS_GL_OPTIONAL_FUNCTIONS(ASTRALIS_GL_COUNTING_OPTIONAL)
+#undef ASTRALIS_GL_COUNTING_OPTIONAL
+
+    dispatch.BufferData = countUploadBufferData;
+    dispatch.BufferSubData = countUploadBufferSubData;
+    dispatch.MapBufferRange = countUploadMapBufferRange;
+    dispatch.TexImage2D = countUploadTexImage2D;
+    dispatch.TexSubImage2D = countUploadTexSubImage2D;
+    dispatch.CompressedTexImage2D = countUploadCompressedTexImage2D;
+    return dispatch;
+}
+
+} // namespace
+
+bool GLApi::load(Backend backend, bool countCalls) {
+    if (loaded) {
+        if (backend != activeBackend) {
+            spdlog::warn("OpenGL dispatch table already loaded; keeping the first backend");
+        }
+        return true;
+    }
+
+    if (backend == Backend::Null) {
+        forward = createNullDispatch();
+        countCalls = true;
+    } else if (!loadNativeDispatch(forward)) {
+        spdlog::error("Failed to load OpenGL functions");
+        return false;
+    }
+
+    gl = countCalls ? createCountingDispatch() : forward;
+    activeBackend = backend;
+    counting = countCalls;
+    loaded = true;
+
+    spdlog::info("OpenGL functions loaded successfully ({} entry points, {} backend{})", FUNCTION_COUNT,
+                 backend == Backend::Null ? "null" : "native", counting ? ", counting calls" : "");
+    return true;
+}
+
+bool GLApi::isLoaded() {
+    return loaded;
+}
+
+GLApi::Backend GLApi::getBackend() {
+    return activeBackend;
+}
+
+bool GLApi::isCounting() {
+    return counting;
+}
+
+bool GLApi::isExtensionSupported(const char* name) {
+    if (!loaded) {
+        return false;
+    }
+    return activeBackend == Backend::Null || glfwExtensionSupported(name) == GLFW_TRUE;
+}
+
+const GLStats& GLApi::getTotals() {
+    return totals;
+}
+
+GLStats GLApi::takeFrame() {
+    GLStats stats = frame;
+    frame = GLStats{};
+    return stats;
+}
+
+const char* GLApi::getFunctionName(GLFunction function) {
+    size_t index = static_cast<size_t>(function);
+    return index < FUNCTION_COUNT ? FUNCTION_NAMES[index] : "";
+}
+
+void GLApi::logSummary(size_t topCount) {
+    if (!counting) {
+        return;
+    }
+
+    spdlog::info("OpenGL calls: {} total ({} draws), {:.2f} MB buffer uploads, {:.2f} MB texture uploads",
+                 totals.totalCalls, totals.getDrawCalls(),
+                 static_cast<double>(totals.bufferBytes) / (1024.0 * 1024.0),
+                 static_cast<double>(totals.textureBytes) / (1024.0 * 1024.0));
+
+    std::vector<size_t> order(FUNCTION_COUNT);
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [](size_t a, size_t b) {
+        return totals.calls[a] > totals.calls[b];
+    });
+    for (size_t i = 0; i < std::min(topCount, order.size()) && totals.calls[order[i]] > 0; ++i) {
+        spdlog::info("  {:<28} {}", FUNCTION_NAMES[order[i]], totals.calls[order[i]]);
+    }
+}
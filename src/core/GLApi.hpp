@@ -0,0 +1,412 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// OpenGL constants used across the renderer that GL/gl.h (1.1) may not provide
+#ifndef GL_TEXTURE0
+#define GL_TEXTURE0 0x84C0
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE 0x812F
+#endif
+#ifndef GL_TEXTURE_WRAP_R
+#define GL_TEXTURE_WRAP_R 0x8072
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP
+#define GL_TEXTURE_CUBE_MAP 0x8513
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP_POSITIVE_X
+#define GL_TEXTURE_CUBE_MAP_POSITIVE_X 0x8515
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP_NEGATIVE_X
+#define GL_TEXTURE_CUBE_MAP_NEGATIVE_X 0x8516
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP_POSITIVE_Y
+#define GL_TEXTURE_CUBE_MAP_POSITIVE_Y 0x8517
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP_NEGATIVE_Y
+#define GL_TEXTURE_CUBE_MAP_NEGATIVE_Y 0x8518
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP_POSITIVE_Z
+#define GL_TEXTURE_CUBE_MAP_POSITIVE_Z 0x8519
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
+#define GL_TEXTURE_CUBE_MAP_NEGATIVE_Z 0x851A
+#endif
+#ifndef GL_TEXTURE_CUBE_MAP_SEAMLESS
+#define GL_TEXTURE_CUBE_MAP_SEAMLESS 0x884F
+#endif
+#ifndef GL_RG
+#define GL_RG 0x8227
+#endif
+#ifndef GL_BGR
+#define GL_BGR 0x80E0
+#endif
+#ifndef GL_BGRA
+#define GL_BGRA 0x80E1
+#endif
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT 0x140B
+#endif
+#ifndef GL_RGBA16F
+#define GL_RGBA16F 0x881A
+#endif
+#ifndef GL_R16F
+#define GL_R16F 0x822D
+#endif
+#ifndef GL_R8
+#define GL_R8 0x8229
+#endif
+#ifndef GL_RGBA32F
+#define GL_RGBA32F 0x8814
+#endif
+#ifndef GL_RG32UI
+#define GL_RG32UI 0x823C
+#endif
+#ifndef GL_R32UI
+#define GL_R32UI 0x8236
+#endif
+#ifndef GL_TEXTURE_BUFFER
+#define GL_TEXTURE_BUFFER 0x8C2A
+#endif
+#ifndef GL_ARRAY_BUFFER
+#define GL_ARRAY_BUFFER 0x8892
+#endif
+#ifndef GL_ELEMENT_ARRAY_BUFFER
+#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+#endif
+#ifndef GL_PIXEL_PACK_BUFFER
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_STATIC_DRAW
+#define GL_STATIC_DRAW 0x88E4
+#endif
+#ifndef GL_DYNAMIC_DRAW
+#define GL_DYNAMIC_DRAW 0x88E8
+#endif
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW 0x88E0
+#endif
+#ifndef GL_STREAM_READ
+#define GL_STREAM_READ 0x88E1
+#endif
+#ifndef GL_MAP_READ_BIT
+#define GL_MAP_READ_BIT 0x0001
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#endif
+#ifndef GL_VERTEX_SHADER
+#define GL_VERTEX_SHADER 0x8B31
+#endif
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER 0x8B30
+#endif
+#ifndef GL_COMPILE_STATUS
+#define GL_COMPILE_STATUS 0x8B81
+#endif
+#ifndef GL_LINK_STATUS
+#define GL_LINK_STATUS 0x8B82
+#endif
+#ifndef GL_INFO_LOG_LENGTH
+#define GL_INFO_LOG_LENGTH 0x8B84
+#endif
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER 0x8D40
+#endif
+#ifndef GL_RENDERBUFFER
+#define GL_RENDERBUFFER 0x8D41
+#endif
+#ifndef GL_COLOR_ATTACHMENT0
+#define GL_COLOR_ATTACHMENT0 0x8CE0
+#endif
+#ifndef GL_DEPTH_ATTACHMENT
+#define GL_DEPTH_ATTACHMENT 0x8D00
+#endif
+#ifndef GL_DEPTH_COMPONENT24
+#define GL_DEPTH_COMPONENT24 0x81A6
+#endif
+#ifndef GL_RGBA8
+#define GL_RGBA8 0x8058
+#endif
+#ifndef GL_FRAMEBUFFER_COMPLETE
+#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911A
+#endif
+#ifndef GL_TEXTURE_MAX_LEVEL
+#define GL_TEXTURE_MAX_LEVEL 0x813D
+#endif
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED 0x911B
+#endif
+#ifndef GL_WAIT_FAILED
+#define GL_WAIT_FAILED 0x911D
+#endif
+
+#if defined(_WIN32)
+#define ASTRALIS_GL_APIENTRY __stdcall
+#else
+#define ASTRALIS_GL_APIENTRY
+#endif
+
+/**
+ * @brief Every OpenGL entry point the renderer uses
+ *
+ * Each entry is X(return type, name without the gl prefix, parameters, arguments).
+ * Newer GL types are spelled out (ptrdiff_t for GLsizeiptr/GLintptr, void* for
+ * GLsync, char for GLchar) because GL/gl.h only guarantees the 1.1 ones.
+ */
+#define ASTRALIS_GL_FUNCTIONS(X) \
+    /* State and frame */ \
+    X(void, Enable, (GLenum cap), (cap)) \
+    X(void, Disable, (GLenum cap), (cap)) \
+    X(void, Clear, (GLbitfield mask), (mask)) \
+    X(void, ClearColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha)) \
+    X(void, DepthFunc, (GLenum func), (func)) \
+    X(void, DepthMask, (GLboolean flag), (flag)) \
+    X(void, BlendFunc, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor)) \
+    X(void, Viewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height)) \
+    X(const GLubyte*, GetString, (GLenum name), (name)) \
+    X(GLenum, GetError, (), ()) \
+    X(void, GetIntegerv, (GLenum pname, GLint* data), (pname, data)) \
+    X(void, PixelStorei, (GLenum pname, GLint param), (pname, param)) \
+    X(void, ReadPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* pixels), \
+      (x, y, width, height, format, type, pixels)) \
+    /* Drawing */ \
+    X(void, DrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count)) \
+    X(void, DrawElements, (GLenum mode, GLsizei count, GLenum type, const void* indices), (mode, count, type, indices)) \
+    /* Textures */ \
+    X(void, GenTextures, (GLsizei n, GLuint* textures), (n, textures)) \
+    X(void, BindTexture, (GLenum target, GLuint texture), (target, texture)) \
+    X(void, DeleteTextures, (GLsizei n, const GLuint* textures), (n, textures)) \
+    X(void, ActiveTexture, (GLenum texture), (texture)) \
+    X(void, TexParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param)) \
+    X(void, TexImage2D, (GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, \
+                         GLint border, GLenum format, GLenum type, const void* pixels), \
+      (target, level, internalFormat, width, height, border, format, type, pixels)) \
+    X(void, TexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, \
+                            GLenum format, GLenum type, const void* pixels), \
+      (target, level, xoffset, yoffset, width, height, format, type, pixels)) \
+    X(void, CompressedTexImage2D, (GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height, \
+                                   GLint border, GLsizei imageSize, const void* data), \
+      (target, level, internalFormat, width, height, border, imageSize, data)) \
+    X(void, GenerateMipmap, (GLenum target), (target)) \
+    X(void, TexBuffer, (GLenum target, GLenum internalFormat, GLuint buffer), (target, internalFormat, buffer)) \
+    /* Buffers and vertex arrays */ \
+    X(void, GenBuffers, (GLsizei n, GLuint* buffers), (n, buffers)) \
+    X(void, BindBuffer, (GLenum target, GLuint buffer), (target, buffer)) \
+    X(void, DeleteBuffers, (GLsizei n, const GLuint* buffers), (n, buffers)) \
+    X(void, BufferData, (GLenum target, ptrdiff_t size, const void* data, GLenum usage), (target, size, data, usage)) \
+    X(void, BufferSubData, (GLenum target, ptrdiff_t offset, ptrdiff_t size, const void* data), (target, offset, size, data)) \
+    X(void*, MapBufferRange, (GLenum target, ptrdiff_t offset, ptrdiff_t length, GLbitfield access), \
+      (target, offset, length, access)) \
+    X(GLboolean, UnmapBuffer, (GLenum target), (target)) \
+    X(void, GenVertexArrays, (GLsizei n, GLuint* arrays), (n, arrays)) \
+    X(void, BindVertexArray, (GLuint array), (array)) \
+    X(void, DeleteVertexArrays, (GLsizei n, const GLuint* arrays), (n, arrays)) \
+    X(void, VertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, \
+                                  const void* pointer), \
+      (index, size, type, normalized, stride, pointer)) \
+    X(void, EnableVertexAttribArray, (GLuint index), (index)) \
+    /* Shaders */ \
+    X(GLuint, CreateShader, (GLenum type), (type)) \
+    X(void, ShaderSource, (GLuint shader, GLsizei count, const char* const* string, const GLint* length), \
+      (shader, count, string, length)) \
+    X(void, CompileShader, (GLuint shader), (shader)) \
+    X(void, GetShaderiv, (GLuint shader, GLenum pname, GLint* params), (shader, pname, params)) \
+    X(void, GetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei* length, char* infoLog), \
+      (shader, bufSize, length, infoLog)) \
+    X(void, DeleteShader, (GLuint shader), (shader)) \
+    X(GLuint, CreateProgram, (), ()) \
+    X(void, AttachShader, (GLuint program, GLuint shader), (program, shader)) \
+    X(void, LinkProgram, (GLuint program), (program)) \
+    X(void, GetProgramiv, (GLuint program, GLenum pname, GLint* params), (program, pname, params)) \
+    X(void, GetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei* length, char* infoLog), \
+      (program, bufSize, length, infoLog)) \
+    X(void, DeleteProgram, (GLuint program), (program)) \
+    X(void, UseProgram, (GLuint program), (program)) \
+    X(GLint, GetUniformLocation, (GLuint program, const char* name), (program, name)) \
+    X(void, Uniform1i, (GLint location, GLint v0), (location, v0)) \
+    X(void, Uniform1f, (GLint location, GLfloat v0), (location, v0)) \
+    X(void, Uniform3fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+    X(void, Uniform4fv, (GLint location, GLsizei count, const GLfloat* value), (location, count, value)) \
+    X(void, UniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat* value), \
+      (location, count, transpose, value)) \
+    /* Framebuffers */ \
+    X(void, GenFramebuffers, (GLsizei n, GLuint* framebuffers), (n, framebuffers)) \
+    X(void, BindFramebuffer, (GLenum target, GLuint framebuffer), (target, framebuffer)) \
+    X(void, DeleteFramebuffers, (GLsizei n, const GLuint* framebuffers), (n, framebuffers)) \
+    X(void, FramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), \
+      (target, attachment, renderbuffertarget, renderbuffer)) \
+    X(GLenum, CheckFramebufferStatus, (GLenum target), (target)) \
+    X(void, GenRenderbuffers, (GLsizei n, GLuint* renderbuffers), (n, renderbuffers)) \
+    X(void, BindRenderbuffer, (GLenum target, GLuint renderbuffer), (target, renderbuffer)) \
+    X(void, DeleteRenderbuffers, (GLsizei n, const GLuint* renderbuffers), (n, renderbuffers)) \
+    X(void, RenderbufferStorage, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height), \
+      (target, internalformat, width, height)) \
+    /* Sync objects */ \
+    X(void*, FenceSync, (GLenum condition, GLbitfield flags), (condition, flags)) \
+    X(GLenum, ClientWaitSync, (void* sync, GLbitfield flags, uint64_t timeout), (sync, flags, timeout)) \
+    X(void, DeleteSync, (void* sync), (sync))
+
+/**
+ * @brief Entry points beyond GL 3.3 core that the renderer can do without
+ *
+ * Same layout as ASTRALIS_GL_FUNCTIONS. Missing entries stay null in the
+ * dispatch table (the Null backend provides none), so check before calling:
+ * if (gl.ProgramBinary) { ... }
+ */
+#define ASTRALIS_GL_OPTIONAL_FUNCTIONS(X) \
+    /* Program binaries (GL 4.1, ARB_get_program_binary) */ \
+    X(void, GetProgramBinary, (GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary), \
+      (program, bufSize, length, binaryFormat, binary)) \
+    X(void, ProgramBinary, (GLuint program, GLenum binaryFormat, const void* binary, GLsizei length), \
+      (program, binaryFormat, binary, length)) \
+    X(void, ProgramParameteri, (GLuint program, GLenum pname, GLint value), (program, pname, value)) \
+    /* KHR_parallel_shader_compile */ \
+    X(void, MaxShaderCompilerThreadsKHR, (GLuint count), (count))
+
+#define ASTRALIS_GL_ALL_FUNCTIONS(X) \
+    ASTRALIS_GL_FUNCTIONS(X) \
+    ASTRALIS_GL_OPTIONAL_FUNCTIONS(X)
+
+/**
+ * @brief The OpenGL dispatch table
+ *
+ * All renderer GL calls go through the global instance: gl.BindBuffer(...).
+ * GLApi::load() fills it once, with driver entry points, counting thunks or
+ * the null backend.
+ */
+struct GLDispatch {
+#define ASTRALIS_GL_MEMBER(ret, name, params, args) ret (ASTRALIS_GL_APIENTRY* name) params = nullptr;
+    ASTRALIS_GL_ALL_FUNCTIONS(ASTRALIS_GL_MEMBER)
+#undef ASTRALIS_GL_MEMBER
+};
+
+extern GLDispatch gl;
+
+/**
+ * @brief Index of every dispatch table entry, in declaration order
+ */
+enum class GLFunction : size_t {
+#define ASTRALIS_GL_ENUM(ret, name, params, args) name,
+    ASTRALIS_GL_ALL_FUNCTIONS(ASTRALIS_GL_ENUM)
+#undef ASTRALIS_GL_ENUM
+    Count
+};
+
+/**
+ * @brief GL call and upload counters
+ */
+struct GLStats {
+    std::array<uint64_t, static_cast<size_t>(GLFunction::Count)> calls{};
+    uint64_t totalCalls = 0;
+    uint64_t bufferBytes = 0;   // BufferData/BufferSubData payloads and write-mapped ranges
+    uint64_t textureBytes = 0;  // TexImage2D/TexSubImage2D/CompressedTexImage2D payloads from client memory
+
+    uint64_t getCalls(GLFunction function) const { return calls[static_cast<size_t>(function)]; }
+    uint64_t getDrawCalls() const { return getCalls(GLFunction::DrawArrays) + getCalls(GLFunction::DrawElements); }
+    uint64_t getUploadBytes() const { return bufferBytes + textureBytes; }
+};
+
+/**
+ * @brief Loads the OpenGL dispatch table and optionally records call statistics
+ *
+ * The Native backend resolves every entry point through glfwGetProcAddress
+ * and needs a current context. The Null backend needs no context at all:
+ * calls do nothing, object creation hands out increasing names, status
+ * queries report success and maps return scratch memory, so the render paths
+ * can be benchmarked for CPU cost alone.
+ *
+ * With counting enabled every entry is routed through a thunk that bumps a
+ * per-function counter and records upload sizes before forwarding. Counting
+ * is always on for the Null backend and off by default for Native, where the
+ * table holds the driver pointers directly. All GL calls are made on the
+ * render thread, so the counters are plain integers.
+ */
+class GLApi {
+public:
+    enum class Backend {
+        Native,
+        Null
+    };
+
+    /**
+     * @brief Fill the dispatch table; later calls keep the first table
+     * @param backend Where calls go
+     * @param countCalls Record per-function calls and upload bytes
+     * @return true if every entry point was resolved
+     */
+    static bool load(Backend backend, bool countCalls);
+
+    static bool isLoaded();
+    static Backend getBackend();
+    static bool isCounting();
+
+    /**
+     * @brief Check for an OpenGL extension on the current context
+     * @param name Extension name, e.g. GL_EXT_texture_compression_s3tc
+     * @return true if supported; the Null backend supports everything
+     */
+    static bool isExtensionSupported(const char* name);
+
+    /**
+     * @brief Get the counters since load()
+     * @return const GLStats& Running totals
+     */
+    static const GLStats& getTotals();
+
+    /**
+     * @brief Get the counters of the frame so far and start a new frame
+     * @return GLStats Counts since the previous call
+     */
+    static GLStats takeFrame();
+
+    /**
+     * @brief Get the GL name of a dispatch table entry
+     * @param function Entry
+     * @return const char* Name including the gl prefix
+     */
+    static const char* getFunctionName(GLFunction function);
+
+    /**
+     * @brief Log the running totals and the most called functions
+     * @param topCount Number of functions to list
+     */
+    static void logSummary(size_t topCount);
+};
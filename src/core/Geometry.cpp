@@ -1,77 +1,9 @@
 #include "Geometry.hpp"
+#include "GLApi.hpp"
+#include "RenderStats.hpp"
 #include <spdlog/spdlog.h>
-#include <GLFW/glfw3.h>
 
-// OpenGL function pointers (same as in Shader.cpp)
-typedef unsigned int GLuint;
-typedef int GLint;
-typedef int GLsizei;
-typedef unsigned int GLenum;
-typedef float GLfloat;
-typedef void GLvoid;
-
-// OpenGL constants
-#ifndef GL_ARRAY_BUFFER
-#define GL_ARRAY_BUFFER 0x8892
-#endif
-#ifndef GL_ELEMENT_ARRAY_BUFFER
-#define GL_ELEMENT_ARRAY_BUFFER 0x8893
-#endif
-#ifndef GL_STATIC_DRAW
-#define GL_STATIC_DRAW 0x88E4
-#endif
-#ifndef GL_TRIANGLES
-#define GL_TRIANGLES 0x0004
-#endif
-#ifndef GL_FLOAT
-#define GL_FLOAT 0x1406
-#endif
-#ifndef GL_FALSE
-#define GL_FALSE 0
-#endif
-#ifndef GL_UNSIGNED_INT
-#define GL_UNSIGNED_INT 0x1405
-#endif
-
-// OpenGL function pointers
-static void (*glGenVertexArrays)(GLsizei n, GLuint *arrays) = nullptr;
-static void (*glBindVertexArray)(GLuint array) = nullptr;
-static void (*glDeleteVertexArrays)(GLsizei n, const GLuint *arrays) = nullptr;
-static void (*glGenBuffers)(GLsizei n, GLuint *buffers) = nullptr;
-static void (*glBindBuffer)(GLenum target, GLuint buffer) = nullptr;
-static void (*glBufferData)(GLenum target, GLsizei size, const GLvoid *data, GLenum usage) = nullptr;
-static void (*glDeleteBuffers)(GLsizei n, const GLuint *buffers) = nullptr;
-static void (*glVertexAttribPointer)(GLuint index, GLint size, GLenum type, unsigned char normalized, GLsizei stride, const GLvoid *pointer) = nullptr;
-static void (*glEnableVertexAttribArray)(GLuint index) = nullptr;
-
-static bool geometryFunctionsLoaded = false;
-
-static void loadGeometryOpenGLFunctions() {
-    if (geometryFunctionsLoaded) return;
-    
-    glGenVertexArrays = (void(*)(GLsizei, GLuint*))glfwGetProcAddress("glGenVertexArrays");
-    glBindVertexArray = (void(*)(GLuint))glfwGetProcAddress("glBindVertexArray");
-    glDeleteVertexArrays = (void(*)(GLsizei, const GLuint*))glfwGetProcAddress("glDeleteVertexArrays");
-    glGenBuffers = (void(*)(GLsizei, GLuint*))glfwGetProcAddress("glGenBuffers");
-    glBindBuffer = (void(*)(GLenum, GLuint))glfwGetProcAddress("glBindBuffer");
-    glBufferData = (void(*)(GLenum, GLsizei, const GLvoid*, GLenum))glfwGetProcAddress("glBufferData");
-    glDeleteBuffers = (void(*)(GLsizei, const GLuint*))glfwGetProcAddress("glDeleteBuffers");
-    glVertexAttribPointer = (void(*)(GLuint, GLint, GLenum, unsigned char, GLsizei, const GLvoid*))glfwGetProcAddress("glVertexAttribPointer");
-    glEnableVertexAttribArray = (void(*)(GLuint))glfwGetProcAddress("glEnableVertexAttribArray");
-    
-    if (glGenVertexArrays && glBindVertexArray && glDeleteVertexArrays && 
-        glGenBuffers && glBindBuffer && glBufferData && glDeleteBuffers &&
-        glVertexAttribPointer && glEnableVertexAttribArray) {
-        geometryFunctionsLoaded = true;
-        spdlog::info("Geometry OpenGL functions loaded successfully");
-    } else {
-        spdlog::error("Failed to load Geometry OpenGL functions");
-    }
-}
-
-Geometry::Geometry() {
-    loadGeometryOpenGLFunctions();
-}
+Geometry::Geometry() = default;
 
 Geometry::~Geometry() {
     cleanup();
@@ -79,15 +11,15 @@ Geometry::~Geometry() {
 
 void Geometry::cleanup() {
     if (VAO_ != 0) {
-        glDeleteVertexArrays(1, &VAO_);
+        gl.DeleteVertexArrays(1, &VAO_);
         VAO_ = 0;
     }
     if (VBO_ != 0) {
-        glDeleteBuffers(1, &VBO_);
+        gl.DeleteBuffers(1, &VBO_);
         VBO_ = 0;
     }
     if (EBO_ != 0) {
-        glDeleteBuffers(1, &EBO_);
+        gl.DeleteBuffers(1, &EBO_);
         EBO_ = 0;
     }
 }
@@ -101,8 +33,17 @@ void Geometry::setIndices(const std::vector<unsigned int>& indices) {
     useIndices_ = !indices.empty();
 }
 
+void Geometry::setVertices(const Vertex* vertices, size_t count) {
+    vertices_.assign(vertices, vertices + count);
+}
+
+void Geometry::setIndices(const unsigned int* indices, size_t count) {
+    indices_.assign(indices, indices + count);
+    useIndices_ = count > 0;
+}
+
 void Geometry::uploadToGPU() {
-    if (!geometryFunctionsLoaded) {
+    if (!GLApi::isLoaded()) {
         spdlog::error("OpenGL functions not loaded for Geometry");
         return;
     }
@@ -116,48 +57,48 @@ void Geometry::uploadToGPU() {
     cleanup();
     
     // Generate VAO
-    glGenVertexArrays(1, &VAO_);
-    glBindVertexArray(VAO_);
+    gl.GenVertexArrays(1, &VAO_);
+    gl.BindVertexArray(VAO_);
     
     // Generate and bind VBO
-    glGenBuffers(1, &VBO_);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
-    glBufferData(GL_ARRAY_BUFFER, vertices_.size() * sizeof(Vertex), vertices_.data(), GL_STATIC_DRAW);
+    gl.GenBuffers(1, &VBO_);
+    gl.BindBuffer(GL_ARRAY_BUFFER, VBO_);
+    gl.BufferData(GL_ARRAY_BUFFER, vertices_.size() * sizeof(Vertex), vertices_.data(), GL_STATIC_DRAW);
     
     // Generate and bind EBO if using indices
     if (useIndices_) {
-        glGenBuffers(1, &EBO_);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices_.size() * sizeof(unsigned int), indices_.data(), GL_STATIC_DRAW);
+        gl.GenBuffers(1, &EBO_);
+        gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
+        gl.BufferData(GL_ELEMENT_ARRAY_BUFFER, indices_.size() * sizeof(unsigned int), indices_.data(), GL_STATIC_DRAW);
     }
     
     // Set vertex attribute pointers
     // Position attribute (location = 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
-    glEnableVertexAttribArray(0);
+    gl.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    gl.EnableVertexAttribArray(0);
     
     // Normal attribute (location = 1)
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-    glEnableVertexAttribArray(1);
+    gl.VertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    gl.EnableVertexAttribArray(1);
     
     // Texture coordinate attribute (location = 2)
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
-    glEnableVertexAttribArray(2);
+    gl.VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
+    gl.EnableVertexAttribArray(2);
     
     // Unbind VAO
-    glBindVertexArray(0);
+    gl.BindVertexArray(0);
     
     spdlog::info("Geometry uploaded to GPU: {} vertices, {} indices", vertices_.size(), indices_.size());
 }
 
 void Geometry::bind() const {
     if (VAO_ != 0) {
-        glBindVertexArray(VAO_);
+        gl.BindVertexArray(VAO_);
     }
 }
 
 void Geometry::unbind() const {
-    glBindVertexArray(0);
+    gl.BindVertexArray(0);
 }
 
 void Geometry::draw() const {
@@ -169,9 +110,11 @@ void Geometry::draw() const {
     bind();
     
     if (useIndices_ && !indices_.empty()) {
-        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices_.size()), GL_UNSIGNED_INT, 0);
+        gl.DrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices_.size()), GL_UNSIGNED_INT, 0);
+        RenderStats::addDraw(indices_.size() / 3);
     } else {
-        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices_.size()));
+        gl.DrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(vertices_.size()));
+        RenderStats::addDraw(vertices_.size() / 3);
     }
     
     unbind();
@@ -2,17 +2,11 @@
 
 #include <vector>
 #include <glm/glm.hpp>
+#include "SceneRecords.hpp"
 
 class Geometry {
 public:
-    struct Vertex {
-        glm::vec3 position;
-        glm::vec3 normal;
-        glm::vec2 texCoords;
-        
-        Vertex(const glm::vec3& pos, const glm::vec3& norm = glm::vec3(0.0f), const glm::vec2& tex = glm::vec2(0.0f))
-            : position(pos), normal(norm), texCoords(tex) {}
-    };
+    using Vertex = ::Vertex;
 
     Geometry();
     ~Geometry();
@@ -26,6 +20,8 @@ public:
     // Setup geometry data
     void setVertices(const std::vector<Vertex>& vertices);
     void setIndices(const std::vector<unsigned int>& indices);
+    void setVertices(const Vertex* vertices, size_t count);
+    void setIndices(const unsigned int* indices, size_t count);
     void uploadToGPU();
 
     // Rendering
@@ -50,6 +46,8 @@ public:
     bool isValid() const { return VAO_ != 0; }
     size_t getVertexCount() const { return vertices_.size(); }
     size_t getIndexCount() const { return indices_.size(); }
+    const std::vector<Vertex>& getVertices() const { return vertices_; }
+    const std::vector<unsigned int>& getIndices() const { return indices_; }
 
 private:
     void cleanup();
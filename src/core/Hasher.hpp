@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/**
+ * @brief Incremental 64-bit FNV-1a hasher used to build cache keys
+ *
+ * Values are hashed by their in-memory representation, so keys are only
+ * stable between builds that share the same platform and struct layout.
+ * That is sufficient for the on-disk caches, which are regenerated on mismatch.
+ */
+class Hasher {
+public:
+    static constexpr uint64_t OFFSET_BASIS = 0xcbf29ce484222325ULL;
+    static constexpr uint64_t PRIME = 0x100000001b3ULL;
+
+    explicit Hasher(uint64_t seed = OFFSET_BASIS) : hash_(seed) {}
+
+    /**
+     * @brief Feed raw bytes into the hash
+     * @param data Pointer to the bytes
+     * @param size Number of bytes
+     * @return Hasher& Reference for chaining
+     */
+    Hasher& add(const void* data, size_t size) {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash_ ^= bytes[i];
+            hash_ *= PRIME;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Feed a trivially copyable value into the hash
+     * @param value Value to hash
+     * @return Hasher& Reference for chaining
+     */
+    template<typename T>
+    Hasher& add(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Hasher::add requires a trivially copyable type");
+        return add(&value, sizeof(T));
+    }
+
+    /**
+     * @brief Feed a string (length-prefixed) into the hash
+     * @param value String to hash
+     * @return Hasher& Reference for chaining
+     */
+    Hasher& add(const std::string& value) {
+        add(static_cast<uint64_t>(value.size()));
+        return add(value.data(), value.size());
+    }
+
+    /**
+     * @brief Get the current hash value
+     * @return uint64_t Hash of everything added so far
+     */
+    uint64_t get() const { return hash_; }
+
+    /**
+     * @brief Hash a block of memory in one call
+     * @param data Pointer to the bytes
+     * @param size Number of bytes
+     * @return uint64_t FNV-1a hash
+     */
+    static uint64_t hash(const void* data, size_t size) {
+        return Hasher().add(data, size).get();
+    }
+
+private:
+    uint64_t hash_;
+};
@@ -211,6 +211,44 @@ void InputManager::clearScrollCallback() {
     m_scrollCallback = nullptr;
 }
 
+// Session recording and replay
+InputSnapshot InputManager::captureSnapshot() const {
+    InputSnapshot snapshot;
+    
+    for (const auto& [key, state] : m_keyStates) {
+        if (state != KeyState::Released) {
+            snapshot.keys.emplace_back(key, state);
+        }
+    }
+    for (const auto& [button, state] : m_mouseButtonStates) {
+        if (state != KeyState::Released) {
+            snapshot.mouseButtons.emplace_back(button, state);
+        }
+    }
+    std::sort(snapshot.keys.begin(), snapshot.keys.end());
+    std::sort(snapshot.mouseButtons.begin(), snapshot.mouseButtons.end());
+    
+    snapshot.mousePosition = m_mousePosition;
+    return snapshot;
+}
+
+void InputManager::applySnapshot(const InputSnapshot& snapshot) {
+    // update() has already rolled the previous state forward; only replace the current one
+    m_keyStates.clear();
+    for (const auto& [key, state] : snapshot.keys) {
+        m_keyStates[key] = state;
+    }
+    
+    m_mouseButtonStates.clear();
+    for (const auto& [button, state] : snapshot.mouseButtons) {
+        m_mouseButtonStates[button] = state;
+    }
+    
+    m_mousePosition = snapshot.mousePosition;
+    m_mouseDelta.deltaX = m_mousePosition.x - m_previousMousePosition.x;
+    m_mouseDelta.deltaY = m_mousePosition.y - m_previousMousePosition.y;
+}
+
 // GLFW callbacks (static functions)
 void InputManager::keyCallbackGLFW(GLFWwindow* window, int key, int scancode, int action, int mods) {
     InputManager& inputManager = getInstance();
@@ -258,7 +296,9 @@ void InputManager::updateKeyState(int key, int action) {
             return;
     }
     
-    m_keyStates[key] = newState;
+    if (!m_playbackMode) {
+        m_keyStates[key] = newState;
+    }
     
     // Call user callback if set
     if (m_keyCallback) {
@@ -280,7 +320,9 @@ void InputManager::updateMouseButtonState(int button, int action) {
             return;
     }
     
-    m_mouseButtonStates[button] = newState;
+    if (!m_playbackMode) {
+        m_mouseButtonStates[button] = newState;
+    }
     
     // Call user callback if set
     if (m_mouseButtonCallback) {
@@ -290,6 +332,10 @@ void InputManager::updateMouseButtonState(int button, int action) {
 }
 
 void InputManager::updateMousePosition(double x, double y) {
+    if (m_playbackMode) {
+        return;
+    }
+    
     MousePosition oldPosition = m_mousePosition;
     m_mousePosition = {x, y};
     
@@ -3,6 +3,7 @@
 #include <GLFW/glfw3.h>
 #include <unordered_map>
 #include <functional>
+#include <utility>
 #include <vector>
 
 namespace Core {
@@ -27,6 +28,14 @@ struct MouseDelta {
     double deltaX, deltaY;
 };
 
+// Complete input state of one frame, used for session recording and replay.
+// Entries are sorted by key/button; released keys and buttons are omitted.
+struct InputSnapshot {
+    std::vector<std::pair<int, KeyState>> keys;
+    std::vector<std::pair<int, KeyState>> mouseButtons;
+    MousePosition mousePosition{0.0, 0.0};
+};
+
 // Input event callbacks
 using KeyCallback = std::function<void(int key, KeyState state)>;
 using MouseButtonCallback = std::function<void(MouseButton button, KeyState state)>;
@@ -76,6 +85,14 @@ public:
     void clearMouseButtonCallback();
     void clearMouseMoveCallback();
     void clearScrollCallback();
+    
+    // Session recording and replay
+    InputSnapshot captureSnapshot() const;
+    // Replace the current state (call after update() in place of live input)
+    void applySnapshot(const InputSnapshot& snapshot);
+    // While enabled, window events no longer change key/mouse state; callbacks still fire
+    void setPlaybackMode(bool enabled) { m_playbackMode = enabled; }
+    bool isPlaybackMode() const { return m_playbackMode; }
 
 private:
     InputManager() = default;
@@ -118,6 +135,7 @@ private:
     
     // Initialization state
     bool m_initialized = false;
+    bool m_playbackMode = false;
 };
 
 } // namespace Core
\ No newline at end of file
@@ -0,0 +1,506 @@
+#include "Json.hpp"
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+class Parser {
+public:
+    Parser(std::string_view text, JsonHandler& handler, std::string& error)
+        : text_(text)
+        , handler_(handler)
+        , error_(error)
+        , pos_(0)
+        , depth_(0) {
+    }
+
+    bool run();
+
+private:
+    enum class Expect {
+        Value,
+        ValueOrArrayEnd,
+        KeyOrObjectEnd,
+        Key,
+        CommaOrEnd
+    };
+
+    bool fail(const char* message);
+    bool parseValue(Expect& expect);
+    bool parseKey();
+    bool parseString(std::string_view& out);
+    bool parseNumber();
+    bool parseLiteral(std::string_view literal);
+    bool closeContainer(char open);
+    bool appendCodePoint(uint32_t codePoint);
+    bool parseHex4(uint32_t& value);
+
+    void skipWhitespace() {
+        while (pos_ < text_.size()) {
+            char c = text_[pos_];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                break;
+            }
+            ++pos_;
+        }
+    }
+
+    std::string_view text_;
+    JsonHandler& handler_;
+    std::string& error_;
+    size_t pos_;
+    size_t depth_;
+    std::array<char, JsonReader::MAX_DEPTH> stack_;
+    std::string scratch_;
+};
+
+bool Parser::run() {
+    Expect expect = Expect::Value;
+
+    while (true) {
+        skipWhitespace();
+        if (pos_ >= text_.size()) {
+            if (depth_ == 0 && expect == Expect::CommaOrEnd) {
+                return true;
+            }
+            return fail("Unexpected end of input");
+        }
+
+        char c = text_[pos_];
+        switch (expect) {
+            case Expect::KeyOrObjectEnd:
+                if (c == '}') {
+                    if (!closeContainer('{')) return false;
+                    expect = Expect::CommaOrEnd;
+                    break;
+                }
+                [[fallthrough]];
+            case Expect::Key:
+                if (!parseKey()) return false;
+                expect = Expect::Value;
+                break;
+
+            case Expect::ValueOrArrayEnd:
+                if (c == ']') {
+                    if (!closeContainer('[')) return false;
+                    expect = Expect::CommaOrEnd;
+                    break;
+                }
+                [[fallthrough]];
+            case Expect::Value:
+                if (!parseValue(expect)) return false;
+                break;
+
+            case Expect::CommaOrEnd:
+                if (depth_ == 0) {
+                    return fail("Unexpected characters after document");
+                }
+                if (c == ',') {
+                    ++pos_;
+                    expect = stack_[depth_ - 1] == '{' ? Expect::Key : Expect::Value;
+                } else if (c == '}' || c == ']') {
+                    if (!closeContainer(c == '}' ? '{' : '[')) return false;
+                } else {
+                    return fail("Expected ',' or closing bracket");
+                }
+                break;
+        }
+    }
+}
+
+bool Parser::fail(const char* message) {
+    // Line and column are only worked out on the error path
+    size_t line = 1;
+    size_t column = 1;
+    for (size_t i = 0; i < pos_ && i < text_.size(); ++i) {
+        if (text_[i] == '\n') {
+            ++line;
+            column = 1;
+        } else {
+            ++column;
+        }
+    }
+    error_ = std::string(message) + " at line " + std::to_string(line) + ", column " + std::to_string(column);
+    return false;
+}
+
+bool Parser::parseValue(Expect& expect) {
+    char c = text_[pos_];
+    switch (c) {
+        case '{':
+        case '[':
+            if (depth_ >= JsonReader::MAX_DEPTH) {
+                return fail("Nesting too deep");
+            }
+            stack_[depth_++] = c;
+            ++pos_;
+            if (c == '{') {
+                if (!handler_.startObject()) return fail("Rejected by handler");
+                expect = Expect::KeyOrObjectEnd;
+            } else {
+                if (!handler_.startArray()) return fail("Rejected by handler");
+                expect = Expect::ValueOrArrayEnd;
+            }
+            return true;
+
+        case '"': {
+            std::string_view value;
+            if (!parseString(value)) return false;
+            if (!handler_.string(value)) return fail("Rejected by handler");
+            break;
+        }
+
+        case 't':
+            if (!parseLiteral("true")) return false;
+            if (!handler_.boolean(true)) return fail("Rejected by handler");
+            break;
+
+        case 'f':
+            if (!parseLiteral("false")) return false;
+            if (!handler_.boolean(false)) return fail("Rejected by handler");
+            break;
+
+        case 'n':
+            if (!parseLiteral("null")) return false;
+            if (!handler_.null()) return fail("Rejected by handler");
+            break;
+
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                if (!parseNumber()) return false;
+                break;
+            }
+            return fail("Unexpected character");
+    }
+
+    expect = Expect::CommaOrEnd;
+    return true;
+}
+
+bool Parser::parseKey() {
+    if (text_[pos_] != '"') {
+        return fail("Expected object key");
+    }
+
+    std::string_view name;
+    if (!parseString(name)) return false;
+    if (!handler_.key(name)) return fail("Rejected by handler");
+
+    skipWhitespace();
+    if (pos_ >= text_.size() || text_[pos_] != ':') {
+        return fail("Expected ':' after object key");
+    }
+    ++pos_;
+    return true;
+}
+
+bool Parser::parseString(std::string_view& out) {
+    const size_t start = ++pos_;
+
+    // Fast path: no escapes, hand out a view into the input
+    size_t end = start;
+    while (end < text_.size()) {
+        unsigned char c = static_cast<unsigned char>(text_[end]);
+        if (c == '"' || c == '\\' || c < 0x20) {
+            break;
+        }
+        ++end;
+    }
+    if (end < text_.size() && text_[end] == '"') {
+        out = text_.substr(start, end - start);
+        pos_ = end + 1;
+        return true;
+    }
+
+    // Slow path: decode into the scratch buffer
+    scratch_.assign(text_.data() + start, end - start);
+    pos_ = end;
+    while (pos_ < text_.size()) {
+        char c = text_[pos_];
+        if (c == '"') {
+            ++pos_;
+            out = scratch_;
+            return true;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            return fail("Control character in string");
+        }
+        if (c != '\\') {
+            scratch_ += c;
+            ++pos_;
+            continue;
+        }
+
+        if (++pos_ >= text_.size()) {
+            break;
+        }
+        char escape = text_[pos_++];
+        switch (escape) {
+            case '"': scratch_ += '"'; break;
+            case '\\': scratch_ += '\\'; break;
+            case '/': scratch_ += '/'; break;
+            case 'b': scratch_ += '\b'; break;
+            case 'f': scratch_ += '\f'; break;
+            case 'n': scratch_ += '\n'; break;
+            case 'r': scratch_ += '\r'; break;
+            case 't': scratch_ += '\t'; break;
+            case 'u': {
+                uint32_t codePoint;
+                if (!parseHex4(codePoint)) return false;
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                    // Surrogate pair
+                    uint32_t low;
+                    if (pos_ + 1 >= text_.size() || text_[pos_] != '\\' || text_[pos_ + 1] != 'u') {
+                        return fail("Unpaired surrogate in string");
+                    }
+                    pos_ += 2;
+                    if (!parseHex4(low)) return false;
+                    if (low < 0xDC00 || low > 0xDFFF) {
+                        return fail("Invalid surrogate pair in string");
+                    }
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                if (!appendCodePoint(codePoint)) return false;
+                break;
+            }
+            default:
+                return fail("Invalid escape sequence");
+        }
+    }
+
+    return fail("Unterminated string");
+}
+
+bool Parser::parseHex4(uint32_t& value) {
+    if (pos_ + 4 > text_.size()) {
+        return fail("Truncated unicode escape");
+    }
+    auto result = std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, value, 16);
+    if (result.ec != std::errc() || result.ptr != text_.data() + pos_ + 4) {
+        return fail("Invalid unicode escape");
+    }
+    pos_ += 4;
+    return true;
+}
+
+bool Parser::appendCodePoint(uint32_t codePoint) {
+    if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+        return fail("Unpaired surrogate in string");
+    }
+    if (codePoint < 0x80) {
+        scratch_ += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        scratch_ += static_cast<char>(0xC0 | (codePoint >> 6));
+        scratch_ += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        scratch_ += static_cast<char>(0xE0 | (codePoint >> 12));
+        scratch_ += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        scratch_ += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        scratch_ += static_cast<char>(0xF0 | (codePoint >> 18));
+        scratch_ += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        scratch_ += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        scratch_ += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    return true;
+}
+
+bool Parser::parseNumber() {
+    const char* begin = text_.data() + pos_;
+    const char* end = text_.data() + text_.size();
+
+    // from_chars also accepts "inf" and "nan", which JSON does not
+    const char* digits = (*begin == '-') ? begin + 1 : begin;
+    if (digits >= end || *digits < '0' || *digits > '9') {
+        return fail("Invalid number");
+    }
+
+    double value;
+    auto result = std::from_chars(begin, end, value);
+    if (result.ec == std::errc::result_out_of_range) {
+        return fail("Number out of range");
+    }
+    if (result.ec != std::errc()) {
+        return fail("Invalid number");
+    }
+
+    pos_ += static_cast<size_t>(result.ptr - begin);
+    if (!handler_.number(value)) return fail("Rejected by handler");
+    return true;
+}
+
+bool Parser::parseLiteral(std::string_view literal) {
+    if (text_.substr(pos_, literal.size()) != literal) {
+        return fail("Invalid literal");
+    }
+    pos_ += literal.size();
+    return true;
+}
+
+bool Parser::closeContainer(char open) {
+    if (depth_ == 0 || stack_[depth_ - 1] != open) {
+        return fail("Mismatched closing bracket");
+    }
+    --depth_;
+    ++pos_;
+    bool accepted = (open == '{') ? handler_.endObject() : handler_.endArray();
+    if (!accepted) return fail("Rejected by handler");
+    return true;
+}
+
+} // namespace
+
+bool JsonReader::parse(std::string_view text, JsonHandler& handler, std::string& error) {
+    Parser parser(text, handler, error);
+    return parser.run();
+}
+
+JsonWriter::JsonWriter(int indent)
+    : indent_(indent)
+    , afterKey_(false) {
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    beginValue();
+    output_ += '{';
+    bool compact = !scopes_.empty() && scopes_.back().compact;
+    scopes_.push_back({compact, true});
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    Scope scope = scopes_.back();
+    scopes_.pop_back();
+    if (!scope.empty && !scope.compact) {
+        newline();
+    }
+    output_ += '}';
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray(bool compact) {
+    beginValue();
+    output_ += '[';
+    compact = compact || (!scopes_.empty() && scopes_.back().compact);
+    scopes_.push_back({compact, true});
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    Scope scope = scopes_.back();
+    scopes_.pop_back();
+    if (!scope.empty && !scope.compact) {
+        newline();
+    }
+    output_ += ']';
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    beginValue();
+    writeString(name);
+    output_ += ": ";
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(float value) {
+    beginValue();
+    if (!std::isfinite(value)) {
+        output_ += "null";
+        return *this;
+    }
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    output_.append(buffer, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double value) {
+    beginValue();
+    if (!std::isfinite(value)) {
+        output_ += "null";
+        return *this;
+    }
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    output_.append(buffer, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(int value) {
+    return this->value(static_cast<long long>(value));
+}
+
+JsonWriter& JsonWriter::value(long long value) {
+    beginValue();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    output_.append(buffer, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool value) {
+    beginValue();
+    output_ += value ? "true" : "false";
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view value) {
+    beginValue();
+    writeString(value);
+    return *this;
+}
+
+void JsonWriter::beginValue() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+    if (scopes_.empty()) {
+        return;
+    }
+
+    Scope& scope = scopes_.back();
+    if (!scope.empty) {
+        output_ += scope.compact ? ", " : ",";
+    }
+    if (!scope.compact) {
+        newline();
+    }
+    scope.empty = false;
+}
+
+void JsonWriter::newline() {
+    output_ += '\n';
+    output_.append(scopes_.size() * static_cast<size_t>(indent_), ' ');
+}
+
+void JsonWriter::writeString(std::string_view value) {
+    static const char HEX[] = "0123456789abcdef";
+
+    output_ += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': output_ += "\\\""; break;
+            case '\\': output_ += "\\\\"; break;
+            case '\b': output_ += "\\b"; break;
+            case '\f': output_ += "\\f"; break;
+            case '\n': output_ += "\\n"; break;
+            case '\r': output_ += "\\r"; break;
+            case '\t': output_ += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    output_ += "\\u00";
+                    output_ += HEX[(c >> 4) & 0xF];
+                    output_ += HEX[c & 0xF];
+                } else {
+                    output_ += c;
+                }
+                break;
+        }
+    }
+    output_ += '"';
+}
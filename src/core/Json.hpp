@@ -0,0 +1,121 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Event callbacks for JsonReader
+ *
+ * Every callback returns true to continue parsing or false to abort.
+ * String views passed to key() and string() are only valid for the
+ * duration of the call.
+ */
+class JsonHandler {
+public:
+    virtual ~JsonHandler() = default;
+
+    virtual bool startObject() { return true; }
+    virtual bool endObject() { return true; }
+    virtual bool startArray() { return true; }
+    virtual bool endArray() { return true; }
+    virtual bool key(std::string_view name) { (void)name; return true; }
+    virtual bool string(std::string_view value) { (void)value; return true; }
+    virtual bool number(double value) { (void)value; return true; }
+    virtual bool boolean(bool value) { (void)value; return true; }
+    virtual bool null() { return true; }
+};
+
+/**
+ * @brief Single-pass, non-recursive JSON parser
+ *
+ * Walks the input once and reports each token to a JsonHandler. No document
+ * tree is built: strings without escape sequences are handed out as views
+ * into the input, and escaped strings are decoded into a reused scratch
+ * buffer, so parsing allocates next to nothing regardless of document size.
+ */
+class JsonReader {
+public:
+    static constexpr size_t MAX_DEPTH = 256;
+
+    /**
+     * @brief Parse a JSON document
+     * @param text JSON text
+     * @param handler Receives parse events
+     * @param error Filled with a description (including line and column) on failure
+     * @return true if the whole document was parsed and accepted by the handler
+     */
+    static bool parse(std::string_view text, JsonHandler& handler, std::string& error);
+};
+
+/**
+ * @brief Streaming JSON writer producing indented output
+ *
+ * Commas, indentation and string escaping are handled by the writer, so
+ * callers only describe structure. Floating point values use the shortest
+ * representation that round-trips exactly.
+ */
+class JsonWriter {
+public:
+    /**
+     * @brief Construct a writer
+     * @param indent Spaces per nesting level
+     */
+    explicit JsonWriter(int indent = 2);
+
+    /**
+     * @brief Open an object
+     */
+    JsonWriter& beginObject();
+
+    /**
+     * @brief Close the innermost object
+     */
+    JsonWriter& endObject();
+
+    /**
+     * @brief Open an array
+     * @param compact Write all elements on one line (for short numeric tuples)
+     */
+    JsonWriter& beginArray(bool compact = false);
+
+    /**
+     * @brief Close the innermost array
+     */
+    JsonWriter& endArray();
+
+    /**
+     * @brief Write an object key; must be followed by a value or container
+     * @param name Key name
+     */
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(float value);
+    JsonWriter& value(double value);
+    JsonWriter& value(int value);
+    JsonWriter& value(long long value);
+    JsonWriter& value(bool value);
+    JsonWriter& value(std::string_view value);
+    JsonWriter& value(const char* value) { return this->value(std::string_view(value)); }
+
+    /**
+     * @brief Get the document written so far
+     * @return const std::string& JSON text
+     */
+    const std::string& str() const { return output_; }
+
+private:
+    struct Scope {
+        bool compact;
+        bool empty;
+    };
+
+    void beginValue();
+    void newline();
+    void writeString(std::string_view value);
+
+    std::string output_;
+    std::vector<Scope> scopes_;
+    int indent_;
+    bool afterKey_;
+};
@@ -0,0 +1,116 @@
+#include "LightClusters.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+bool sphereIntersectsBounds(const glm::vec3& center, float radius, const glm::vec3& min, const glm::vec3& max) {
+    glm::vec3 closest = glm::clamp(center, min, max);
+    glm::vec3 offset = center - closest;
+    return glm::dot(offset, offset) <= radius * radius;
+}
+
+} // namespace
+
+void LightClusters::build(const std::vector<PointLight>& lights, const glm::mat4& view, const glm::mat4& projection) {
+    if (projection != boundsProjection_) {
+        updateClusterBounds(projection);
+    }
+
+    lightData_.clear();
+    clusterLights_.clear();
+    clusters_.assign(static_cast<size_t>(CLUSTER_COUNT) * 2, 0u);
+
+    const size_t lightCount = std::min(lights.size(), MAX_LIGHTS);
+    for (size_t i = 0; i < lightCount; ++i) {
+        const PointLight& light = lights[i];
+        glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+        float depth = -center.z;
+        if (light.radius <= 0.0f || depth + light.radius < nearPlane_ || depth - light.radius > farPlane_) {
+            continue;
+        }
+
+        // Lights are renumbered so culled ones leave no holes in the light data
+        const uint32_t index = static_cast<uint32_t>(lightData_.size() / 2);
+        lightData_.emplace_back(light.position, light.radius);
+        lightData_.emplace_back(light.color, 0.0f);
+
+        auto toSlice = [this](float z) {
+            int slice = static_cast<int>(std::log(z / nearPlane_) * sliceScale_);
+            return std::clamp(slice, 0, SLICES - 1);
+        };
+        int firstSlice = toSlice(std::max(depth - light.radius, nearPlane_));
+        int lastSlice = toSlice(std::min(depth + light.radius, farPlane_));
+
+        for (int slice = firstSlice; slice <= lastSlice; ++slice) {
+            for (int tile = 0; tile < TILES_X * TILES_Y; ++tile) {
+                const uint32_t cluster = static_cast<uint32_t>(slice * TILES_X * TILES_Y + tile);
+                const Bounds& bounds = bounds_[cluster];
+                if (clusterLights_.size() < MAX_INDICES * 2 &&
+                    sphereIntersectsBounds(center, light.radius, bounds.min, bounds.max)) {
+                    clusterLights_.push_back(cluster);
+                    clusterLights_.push_back(index);
+                    ++clusters_[cluster * 2 + 1];
+                }
+            }
+        }
+    }
+
+    // Counting sort of the (cluster, light) pairs; lights keep their order within a cluster
+    uint32_t first = 0;
+    for (int cluster = 0; cluster < CLUSTER_COUNT; ++cluster) {
+        clusters_[static_cast<size_t>(cluster) * 2] = first;
+        first += clusters_[static_cast<size_t>(cluster) * 2 + 1];
+    }
+    indices_.assign(first, 0u);
+    cursors_.assign(CLUSTER_COUNT, 0u);
+    for (size_t i = 0; i < clusterLights_.size(); i += 2) {
+        const uint32_t cluster = clusterLights_[i];
+        indices_[clusters_[cluster * 2] + cursors_[cluster]++] = clusterLights_[i + 1];
+    }
+}
+
+void LightClusters::updateClusterBounds(const glm::mat4& projection) {
+    boundsProjection_ = projection;
+
+    // Planes of a standard OpenGL perspective matrix
+    nearPlane_ = projection[3][2] / (projection[2][2] - 1.0f);
+    farPlane_ = projection[3][2] / (projection[2][2] + 1.0f);
+    sliceScale_ = SLICES / std::log(farPlane_ / nearPlane_);
+
+    // Directions through the tile corners, scaled to unit view depth
+    const glm::mat4 inverseProjection = glm::inverse(projection);
+    std::vector<glm::vec3> corners(static_cast<size_t>(TILES_X + 1) * (TILES_Y + 1));
+    for (int y = 0; y <= TILES_Y; ++y) {
+        for (int x = 0; x <= TILES_X; ++x) {
+            glm::vec4 ndc(2.0f * x / TILES_X - 1.0f, 2.0f * y / TILES_Y - 1.0f, -1.0f, 1.0f);
+            glm::vec4 point = inverseProjection * ndc;
+            glm::vec3 direction = glm::vec3(point) / point.w;
+            corners[static_cast<size_t>(y) * (TILES_X + 1) + static_cast<size_t>(x)] = direction / -direction.z;
+        }
+    }
+
+    bounds_.resize(CLUSTER_COUNT);
+    for (int slice = 0; slice < SLICES; ++slice) {
+        const float sliceNear = getSliceDepth(slice);
+        const float sliceFar = getSliceDepth(slice + 1);
+        for (int y = 0; y < TILES_Y; ++y) {
+            for (int x = 0; x < TILES_X; ++x) {
+                Bounds bounds{glm::vec3(INFINITY), glm::vec3(-INFINITY)};
+                for (int corner = 0; corner < 4; ++corner) {
+                    const glm::vec3& direction =
+                        corners[static_cast<size_t>(y + corner / 2) * (TILES_X + 1) + static_cast<size_t>(x + corner % 2)];
+                    for (float depth : {sliceNear, sliceFar}) {
+                        bounds.min = glm::min(bounds.min, direction * depth);
+                        bounds.max = glm::max(bounds.max, direction * depth);
+                    }
+                }
+                bounds_[static_cast<size_t>((slice * TILES_Y + y) * TILES_X + x)] = bounds;
+            }
+        }
+    }
+}
+
+float LightClusters::getSliceDepth(int slice) const {
+    return nearPlane_ * std::pow(farPlane_ / nearPlane_, static_cast<float>(slice) / SLICES);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Point light with a finite range
+ */
+struct PointLight {
+    glm::vec3 position; // World space
+    float radius;       // No contribution beyond this distance
+    glm::vec3 color;    // Color times intensity
+};
+
+/**
+ * @brief Per-frame light lists of view-space clusters for clustered forward shading
+ *
+ * The view frustum is split into TILES_X x TILES_Y screen tiles and SLICES
+ * depth slices, exponentially spaced between the near and far planes. Each
+ * cluster gets the lights whose range overlaps it, so a fragment only loops
+ * over the few lights that can reach it no matter how many exist. Built on
+ * the CPU every frame; the GPU side lives in ClusteredLighting.
+ *
+ * Output layout, mirrored in lights.glsl:
+ *  - light data: two vec4 per light, (position, radius) and (color, 0)
+ *  - clusters: (first index, light count) per cluster, x fastest, then y, then slice
+ *  - indices: light indices of every cluster, back to back
+ */
+class LightClusters {
+public:
+    static constexpr int TILES_X = 16;
+    static constexpr int TILES_Y = 9;
+    static constexpr int SLICES = 24;
+    static constexpr int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+    static constexpr size_t MAX_LIGHTS = 1024;
+    static constexpr size_t MAX_INDICES = 65536; // Smallest texture buffer size GL 3.3 guarantees
+
+    LightClusters() = default;
+
+    /**
+     * @brief Assign lights to the clusters of a camera
+     * @param lights Lights in world space; at most MAX_LIGHTS are used, and clusters past
+     *        MAX_INDICES light references in total lose their excess lights
+     * @param view View matrix
+     * @param projection Perspective projection matrix
+     */
+    void build(const std::vector<PointLight>& lights, const glm::mat4& view, const glm::mat4& projection);
+
+    const std::vector<glm::vec4>& getLightData() const { return lightData_; }
+    const std::vector<uint32_t>& getClusters() const { return clusters_; }
+    const std::vector<uint32_t>& getIndices() const { return indices_; }
+
+    size_t getLightCount() const { return lightData_.size() / 2; }
+    float getNearPlane() const { return nearPlane_; }
+
+    /**
+     * @brief Get the factor turning log(view depth / near plane) into a slice index
+     * @return float SLICES / log(far / near)
+     */
+    float getSliceScale() const { return sliceScale_; }
+
+private:
+    struct Bounds {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    void updateClusterBounds(const glm::mat4& projection);
+    float getSliceDepth(int slice) const;
+
+    glm::mat4 boundsProjection_{0.0f}; // Projection the cluster bounds were computed for
+    std::vector<Bounds> bounds_;       // View-space bounds of every cluster
+    float nearPlane_ = 0.1f;
+    float farPlane_ = 1.0f;
+    float sliceScale_ = 0.0f;
+
+    std::vector<glm::vec4> lightData_;
+    std::vector<uint32_t> clusters_;
+    std::vector<uint32_t> indices_;
+    std::vector<uint32_t> clusterLights_; // Scratch: (cluster, light) pairs before sorting
+    std::vector<uint32_t> cursors_;       // Scratch: indices written per cluster
+};
@@ -3,6 +3,7 @@
 #include "Geometry.hpp"
 #include "Shader.hpp"
 #include "Camera.hpp"
+#include "RenderStats.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <cmath>
@@ -52,6 +53,19 @@ void Moon::update(float deltaTime, const glm::vec3& planetPosition) {
     position_ = planetPosition + glm::vec3(x, y, z);
 }
 
+int Moon::getResolution() const {
+    return planet_ ? planet_->getResolution() : 0;
+}
+
+void Moon::setResolution(int resolution) {
+    if (!planet_ || planet_->getResolution() == resolution) {
+        return;
+    }
+    planet_->setResolution(resolution);
+    planet_->generate();
+    RenderStats::addLODRebuild();
+}
+
 void Moon::render(Shader* shader, const Camera* camera, const glm::mat4& view, 
                   const glm::mat4& projection, const glm::vec3& lightPos, 
                   const glm::vec3& lightColor, const glm::vec3& viewPos) {
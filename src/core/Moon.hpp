@@ -80,6 +80,54 @@ public:
      */
     void setColor(const glm::vec3& color) { color_ = color; }
 
+    /**
+     * @brief Get distance from the planet center
+     * @return Orbit radius
+     */
+    float getOrbitRadius() const { return orbitRadius_; }
+
+    /**
+     * @brief Get angular velocity around the planet
+     * @return Orbit speed in radians per second
+     */
+    float getOrbitSpeed() const { return orbitSpeed_; }
+
+    /**
+     * @brief Get orbital plane inclination
+     * @return Inclination in radians
+     */
+    float getOrbitInclination() const { return orbitInclination_; }
+
+    /**
+     * @brief Set orbital plane inclination
+     * @param inclination Inclination in radians
+     */
+    void setOrbitInclination(float inclination) { orbitInclination_ = inclination; }
+
+    /**
+     * @brief Get current orbital angle
+     * @return Orbit angle in radians
+     */
+    float getOrbitAngle() const { return currentOrbitAngle_; }
+
+    /**
+     * @brief Set current orbital angle
+     * @param angle Orbit angle in radians
+     */
+    void setOrbitAngle(float angle) { currentOrbitAngle_ = angle; }
+
+    /**
+     * @brief Get the mesh resolution
+     * @return Resolution per face
+     */
+    int getResolution() const;
+
+    /**
+     * @brief Rebuild the mesh at another resolution if it differs from the current one
+     * @param resolution Resolution per face
+     */
+    void setResolution(int resolution);
+
 private:
     std::unique_ptr<Planet> planet_;    ///< Moon geometry (using Planet class for sphere)
     glm::vec3 position_;                ///< Current world position
@@ -1,7 +1,270 @@
 #include "Noise.hpp"
+#include "Hasher.hpp"
+#include <spdlog/spdlog.h>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <utility>
 
-Noise::Noise(int seed) : noise_(std::make_unique<FastNoiseLite>()) {
+namespace {
+
+/*
+ * FastNoiseLite v1.1.1 OpenSimplex2 (3D) and FBm, transcribed so the noise type,
+ * fractal type and fractal octave count are template parameters instead of
+ * switches and a loop inside every GetNoise call. Every float operation is kept
+ * in the library's order; Noise::selectKernel() compares a kernel against
+ * GetNoise before using it. Weighted strength is left at the library default
+ * of 0, which makes its amplitude factor exactly 1, so it is omitted.
+ */
+
+constexpr uint32_t PRIME_X = 501125321;
+constexpr uint32_t PRIME_Y = 1136930381;
+constexpr uint32_t PRIME_Z = 1720413743;
+
+constexpr float GRADIENTS_3D[256] = {
+    0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+    1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+    1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+    0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+    1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+    1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+    0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+    1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+    1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+    0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+    1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+    1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+    0, 1, 1, 0,  0,-1, 1, 0,  0, 1,-1, 0,  0,-1,-1, 0,
+    1, 0, 1, 0, -1, 0, 1, 0,  1, 0,-1, 0, -1, 0,-1, 0,
+    1, 1, 0, 0, -1, 1, 0, 0,  1,-1, 0, 0, -1,-1, 0, 0,
+    1, 1, 0, 0,  0,-1, 1, 0, -1, 1, 0, 0,  0,-1,-1, 0
+};
+
+// Primed lattice coordinates wrap like the library's int arithmetic, without the overflow
+float gradCoord(int seed, uint32_t xPrimed, uint32_t yPrimed, uint32_t zPrimed, float xd, float yd, float zd) {
+    uint32_t hash = static_cast<uint32_t>(seed) ^ xPrimed ^ yPrimed ^ zPrimed;
+    hash *= 0x27d4eb2du;
+    hash ^= hash >> 15;
+    hash &= 63 << 2;
+    return xd * GRADIENTS_3D[hash] + yd * GRADIENTS_3D[hash | 1] + zd * GRADIENTS_3D[hash | 2];
+}
+
+int fastRound(float f) {
+    return f >= 0 ? static_cast<int>(f + 0.5f) : static_cast<int>(f - 0.5f);
+}
+
+// Two offset cube lattices; expects coordinates already rotated by transformCoordinate
+float singleOpenSimplex2(int seed, float x, float y, float z) {
+    const int ri = fastRound(x);
+    const int rj = fastRound(y);
+    const int rk = fastRound(z);
+    float x0 = x - static_cast<float>(ri);
+    float y0 = y - static_cast<float>(rj);
+    float z0 = z - static_cast<float>(rk);
+
+    int xNSign = static_cast<int>(-1.0f - x0) | 1;
+    int yNSign = static_cast<int>(-1.0f - y0) | 1;
+    int zNSign = static_cast<int>(-1.0f - z0) | 1;
+
+    float ax0 = static_cast<float>(xNSign) * -x0;
+    float ay0 = static_cast<float>(yNSign) * -y0;
+    float az0 = static_cast<float>(zNSign) * -z0;
+
+    uint32_t i = static_cast<uint32_t>(ri) * PRIME_X;
+    uint32_t j = static_cast<uint32_t>(rj) * PRIME_Y;
+    uint32_t k = static_cast<uint32_t>(rk) * PRIME_Z;
+
+    float value = 0;
+    float a = (0.6f - x0 * x0) - (y0 * y0 + z0 * z0);
+
+    for (int l = 0; ; l++) {
+        if (a > 0) {
+            value += (a * a) * (a * a) * gradCoord(seed, i, j, k, x0, y0, z0);
+        }
+
+        if (ax0 >= ay0 && ax0 >= az0) {
+            float b = a + ax0 + ax0;
+            if (b > 1) {
+                b -= 1;
+                value += (b * b) * (b * b) * gradCoord(seed, i - static_cast<uint32_t>(xNSign) * PRIME_X, j, k,
+                                                       x0 + static_cast<float>(xNSign), y0, z0);
+            }
+        } else if (ay0 > ax0 && ay0 >= az0) {
+            float b = a + ay0 + ay0;
+            if (b > 1) {
+                b -= 1;
+                value += (b * b) * (b * b) * gradCoord(seed, i, j - static_cast<uint32_t>(yNSign) * PRIME_Y, k,
+                                                       x0, y0 + static_cast<float>(yNSign), z0);
+            }
+        } else {
+            float b = a + az0 + az0;
+            if (b > 1) {
+                b -= 1;
+                value += (b * b) * (b * b) * gradCoord(seed, i, j, k - static_cast<uint32_t>(zNSign) * PRIME_Z,
+                                                       x0, y0, z0 + static_cast<float>(zNSign));
+            }
+        }
+
+        if (l == 1) {
+            break;
+        }
+
+        ax0 = 0.5f - ax0;
+        ay0 = 0.5f - ay0;
+        az0 = 0.5f - az0;
+
+        x0 = static_cast<float>(xNSign) * ax0;
+        y0 = static_cast<float>(yNSign) * ay0;
+        z0 = static_cast<float>(zNSign) * az0;
+
+        a += (0.75f - ax0) - (ay0 + az0);
+
+        i += static_cast<uint32_t>(xNSign >> 1) & PRIME_X;
+        j += static_cast<uint32_t>(yNSign >> 1) & PRIME_Y;
+        k += static_cast<uint32_t>(zNSign >> 1) & PRIME_Z;
+
+        xNSign = -xNSign;
+        yNSign = -yNSign;
+        zNSign = -zNSign;
+
+        seed = ~seed;
+    }
+
+    return value * 32.69428253173828125f;
+}
+
+// The library's default 3D domain rotation for the OpenSimplex2 types
+template <Noise::NoiseType Type>
+void transformCoordinate(float& x, float& y, float& z) {
+    static_assert(Type == Noise::NoiseType::OpenSimplex2, "No kernel for this noise type");
+    const float R3 = static_cast<float>(2.0 / 3.0);
+    const float r = (x + y + z) * R3;
+    x = r - x;
+    y = r - y;
+    z = r - z;
+}
+
+template <Noise::NoiseType Type>
+float single(int seed, float x, float y, float z) {
+    static_assert(Type == Noise::NoiseType::OpenSimplex2, "No kernel for this noise type");
+    return singleOpenSimplex2(seed, x, y, z);
+}
+
+// GetNoise for one configuration; the octave loop has a constant trip count and unrolls
+template <Noise::NoiseType Type, Noise::FractalType Fractal, int Octaves>
+float sample(const Noise::KernelSettings& settings, float x, float y, float z) {
+    x *= settings.frequency;
+    y *= settings.frequency;
+    z *= settings.frequency;
+    transformCoordinate<Type>(x, y, z);
+
+    if constexpr (Fractal == Noise::FractalType::None) {
+        return single<Type>(settings.seed, x, y, z);
+    } else {
+        static_assert(Fractal == Noise::FractalType::FBm, "No kernel for this fractal type");
+        int seed = settings.seed;
+        float sum = 0;
+        float amp = settings.fractalBounding;
+        for (int i = 0; i < Octaves; i++) {
+            const float noise = single<Type>(seed++, x, y, z);
+            sum += noise * amp;
+
+            x *= settings.lacunarity;
+            y *= settings.lacunarity;
+            z *= settings.lacunarity;
+            amp *= settings.gain;
+        }
+        return sum;
+    }
+}
+
+// Octave i samples at frequency * 2^i with amplitude 0.5^i, normalized by the total amplitude
+template <typename Sample>
+void sumOctaves(const Sample& sampleNoise, const glm::vec3* points, size_t count, int octaves, float frequency,
+                float* out) {
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec3& point = points[i];
+        float sum = 0.0f;
+        float amplitude = 1.0f;
+        float octaveFrequency = frequency;
+        float totalAmplitude = 0.0f;
+        for (int octave = 0; octave < octaves; ++octave) {
+            sum += sampleNoise(point.x * octaveFrequency, point.y * octaveFrequency, point.z * octaveFrequency) *
+                   amplitude;
+            totalAmplitude += amplitude;
+            amplitude *= 0.5f;
+            octaveFrequency *= 2.0f;
+        }
+        out[i] = sum / totalAmplitude;
+    }
+}
+
+template <Noise::NoiseType Type, Noise::FractalType Fractal, int Octaves>
+void sumKernelOctaves(const Noise::KernelSettings& settings, const glm::vec3* points, size_t count, int octaves,
+                      float frequency, float* out) {
+    sumOctaves([&settings](float x, float y, float z) { return sample<Type, Fractal, Octaves>(settings, x, y, z); },
+               points, count, octaves, frequency, out);
+}
+
+void sumLibraryOctaves(const FastNoiseLite& noise, const glm::vec3* points, size_t count, int octaves, float frequency,
+                       float* out) {
+    sumOctaves([&noise](float x, float y, float z) { return noise.GetNoise(x, y, z); },
+               points, count, octaves, frequency, out);
+}
+
+template <size_t... Octaves>
+constexpr std::array<Noise::Kernel, sizeof...(Octaves)> makeFBmKernels(std::index_sequence<Octaves...>) {
+    return {&sumKernelOctaves<Noise::NoiseType::OpenSimplex2, Noise::FractalType::FBm, static_cast<int>(Octaves) + 1>...};
+}
+
+// OpenSimplex2 FBm kernel of fractal octave count i + 1 at index i
+constexpr auto FBM_KERNELS = makeFBmKernels(std::make_index_sequence<Noise::MAX_KERNEL_OCTAVES>());
+
+Noise::Kernel findKernel(Noise::NoiseType type, Noise::FractalType fractalType, int fractalOctaves) {
+    if (type != Noise::NoiseType::OpenSimplex2) {
+        return nullptr;
+    }
+    switch (fractalType) {
+        case Noise::FractalType::None:
+            return &sumKernelOctaves<Noise::NoiseType::OpenSimplex2, Noise::FractalType::None, 1>;
+        case Noise::FractalType::FBm:
+            if (fractalOctaves >= 1 && fractalOctaves <= Noise::MAX_KERNEL_OCTAVES) {
+                return FBM_KERNELS[static_cast<size_t>(fractalOctaves - 1)];
+            }
+            return nullptr;
+        default:
+            return nullptr;
+    }
+}
+
+// FastNoiseLite's CalculateFractalBounding
+float getFractalBounding(int octaves, float gain) {
+    gain = std::abs(gain);
+    float amp = gain;
+    float ampFractal = 1.0f;
+    for (int i = 1; i < octaves; i++) {
+        ampFractal += amp;
+        amp *= gain;
+    }
+    return 1 / ampFractal;
+}
+
+} // namespace
+
+Noise::Noise(int seed)
+    : noise_(std::make_unique<FastNoiseLite>())
+    , seed_(seed)
+    , noiseType_(NoiseType::OpenSimplex2)
+    , frequency_(0.01f)
+    , fractalType_(FractalType::FBm)
+    , fractalOctaves_(4)
+    , fractalLacunarity_(2.0f)
+    , fractalGain_(0.5f)
+    , cellularDistanceFunction_(CellularDistanceFunction::EuclideanSq)
+    , cellularReturnType_(CellularReturnType::Distance)
+    , cellularJitter_(1.0f) {
     noise_->SetSeed(seed);
     noise_->SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
     noise_->SetFrequency(0.01f);
@@ -16,6 +279,8 @@ Noise::Noise(int seed) : noise_(std::make_unique<FastNoiseLite>()) {
     noise_->SetCellularDistanceFunction(FastNoiseLite::CellularDistanceFunction_EuclideanSq);
     noise_->SetCellularReturnType(FastNoiseLite::CellularReturnType_Distance);
     noise_->SetCellularJitter(1.0f);
+
+    selectKernel();
 }
 
 float Noise::get2D(float x, float y) const {
@@ -27,6 +292,7 @@ float Noise::get3D(float x, float y, float z) const {
 }
 
 void Noise::setNoiseType(NoiseType type) {
+    noiseType_ = type;
     switch (type) {
         case NoiseType::OpenSimplex2:
             noise_->SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
@@ -47,17 +313,23 @@ void Noise::setNoiseType(NoiseType type) {
             noise_->SetNoiseType(FastNoiseLite::NoiseType_Value);
             break;
     }
+    selectKernel();
 }
 
 void Noise::setSeed(int seed) {
+    seed_ = seed;
     noise_->SetSeed(seed);
+    selectKernel();
 }
 
 void Noise::setFrequency(float frequency) {
+    frequency_ = frequency;
     noise_->SetFrequency(frequency);
+    selectKernel();
 }
 
 void Noise::setFractalType(FractalType type) {
+    fractalType_ = type;
     switch (type) {
         case FractalType::None:
             noise_->SetFractalType(FastNoiseLite::FractalType_None);
@@ -78,21 +350,29 @@ void Noise::setFractalType(FractalType type) {
             noise_->SetFractalType(FastNoiseLite::FractalType_DomainWarpIndependent);
             break;
     }
+    selectKernel();
 }
 
 void Noise::setFractalOctaves(int octaves) {
+    fractalOctaves_ = octaves;
     noise_->SetFractalOctaves(octaves);
+    selectKernel();
 }
 
 void Noise::setFractalLacunarity(float lacunarity) {
+    fractalLacunarity_ = lacunarity;
     noise_->SetFractalLacunarity(lacunarity);
+    selectKernel();
 }
 
 void Noise::setFractalGain(float gain) {
+    fractalGain_ = gain;
     noise_->SetFractalGain(gain);
+    selectKernel();
 }
 
 void Noise::setCellularDistanceFunction(CellularDistanceFunction function) {
+    cellularDistanceFunction_ = function;
     switch (function) {
         case CellularDistanceFunction::Euclidean:
             noise_->SetCellularDistanceFunction(FastNoiseLite::CellularDistanceFunction_Euclidean);
@@ -110,6 +390,7 @@ void Noise::setCellularDistanceFunction(CellularDistanceFunction function) {
 }
 
 void Noise::setCellularReturnType(CellularReturnType returnType) {
+    cellularReturnType_ = returnType;
     switch (returnType) {
         case CellularReturnType::CellValue:
             noise_->SetCellularReturnType(FastNoiseLite::CellularReturnType_CellValue);
@@ -136,6 +417,7 @@ void Noise::setCellularReturnType(CellularReturnType returnType) {
 }
 
 void Noise::setCellularJitter(float jitter) {
+    cellularJitter_ = jitter;
     noise_->SetCellularJitter(jitter);
 }
 
@@ -181,4 +463,57 @@ float Noise::getFBm3D(float x, float y, float z, int octaves, float frequency,
     }
     
     return result / maxValue;
+}
+
+void Noise::getOctaves3D(const glm::vec3* points, size_t count, int octaves, float frequency, float* out) const {
+    if (kernel_) {
+        kernel_(kernelSettings_, points, count, octaves, frequency, out);
+    } else {
+        sumLibraryOctaves(*noise_, points, count, octaves, frequency, out);
+    }
+}
+
+void Noise::selectKernel() {
+    kernel_ = findKernel(noiseType_, fractalType_, fractalOctaves_);
+    if (!kernel_) {
+        return;
+    }
+    kernelSettings_ = {seed_, frequency_, fractalLacunarity_, fractalGain_,
+                       getFractalBounding(fractalOctaves_, fractalGain_)};
+
+    // A kernel is only used while it matches GetNoise bit for bit on a fixed point set
+    constexpr int CHECK_POINTS = 64;
+    constexpr int CHECK_OCTAVES = 3;
+    std::array<glm::vec3, CHECK_POINTS> points;
+    for (int i = 0; i < CHECK_POINTS; ++i) {
+        const float t = static_cast<float>(i);
+        points[static_cast<size_t>(i)] = glm::vec3(std::sin(t * 12.9898f), std::sin(t * 78.233f), std::sin(t * 37.719f)) *
+                                         (0.5f + 8.0f * t) / std::max(frequency_, 1e-6f);
+    }
+    std::array<float, CHECK_POINTS> expected;
+    std::array<float, CHECK_POINTS> actual;
+    sumLibraryOctaves(*noise_, points.data(), points.size(), CHECK_OCTAVES, 1.0f, expected.data());
+    kernel_(kernelSettings_, points.data(), points.size(), CHECK_OCTAVES, 1.0f, actual.data());
+    if (std::memcmp(expected.data(), actual.data(), sizeof(expected)) != 0) {
+        static std::atomic<bool> warned{false};
+        if (!warned.exchange(true)) {
+            spdlog::warn("Noise kernel does not match FastNoiseLite, using GetNoise for terrain octaves");
+        }
+        kernel_ = nullptr;
+    }
+}
+
+uint64_t Noise::getSettingsHash() const {
+    return Hasher()
+        .add(seed_)
+        .add(noiseType_)
+        .add(frequency_)
+        .add(fractalType_)
+        .add(fractalOctaves_)
+        .add(fractalLacunarity_)
+        .add(fractalGain_)
+        .add(cellularDistanceFunction_)
+        .add(cellularReturnType_)
+        .add(cellularJitter_)
+        .get();
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "FastNoiseLite.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <glm/glm.hpp>
 
 /**
  * @brief Wrapper class for FastNoiseLite providing easy-to-use noise generation
@@ -11,6 +14,8 @@
  */
 class Noise {
 public:
+    static constexpr int MAX_KERNEL_OCTAVES = 8; ///< FBm octave counts up to this have a kernel in getOctaves3D
+
     enum class NoiseType {
         OpenSimplex2,
         OpenSimplex2S,
@@ -186,6 +191,63 @@ public:
     float getFBm3D(float x, float y, float z, int octaves = 4, float frequency = 0.01f, 
                    float amplitude = 1.0f, float lacunarity = 2.0f, float persistence = 0.5f);
 
+    /**
+     * @brief Sum octaves of 3D noise at a batch of points
+     *
+     * Octave i samples at frequency * 2^i with amplitude 0.5^i, and the sum is
+     * normalized by the total amplitude. Each sample equals get3D(). OpenSimplex2
+     * noise with no fractal or FBm with up to MAX_KERNEL_OCTAVES octaves runs a
+     * kernel compiled for that noise type, fractal type and octave count, chosen
+     * when the settings change; the per-sample type switches and fractal loop of
+     * FastNoiseLite are gone. A kernel is only used after it matched GetNoise bit
+     * for bit on a fixed point set; other settings call GetNoise.
+     *
+     * @param points Sample points
+     * @param count Number of points
+     * @param octaves Number of octaves
+     * @param frequency Frequency of the first octave, on top of the configured frequency
+     * @param out Receives one value per point, typically in [-1, 1]
+     */
+    void getOctaves3D(const glm::vec3* points, size_t count, int octaves, float frequency, float* out) const;
+
+    /**
+     * @brief Get a fingerprint of every setting that affects generated values
+     * @return uint64_t Hash of seed, noise type, frequency, fractal and cellular settings
+     */
+    uint64_t getSettingsHash() const;
+
+    /**
+     * @brief FastNoiseLite settings a getOctaves3D kernel reads
+     */
+    struct KernelSettings {
+        int seed = 0;
+        float frequency = 0.0f;
+        float lacunarity = 0.0f;
+        float gain = 0.0f;
+        float fractalBounding = 0.0f;  // Inverse of the summed FBm octave amplitudes
+    };
+
+    using Kernel = void (*)(const KernelSettings& settings, const glm::vec3* points, size_t count, int octaves,
+                            float frequency, float* out);
+
 private:
+    // Pick and verify the getOctaves3D kernel for the current settings
+    void selectKernel();
+
     std::unique_ptr<FastNoiseLite> noise_;
+
+    // Mirror of the FastNoiseLite configuration (it has no getters)
+    int seed_;
+    NoiseType noiseType_;
+    float frequency_;
+    FractalType fractalType_;
+    int fractalOctaves_;
+    float fractalLacunarity_;
+    float fractalGain_;
+    CellularDistanceFunction cellularDistanceFunction_;
+    CellularReturnType cellularReturnType_;
+    float cellularJitter_;
+
+    Kernel kernel_ = nullptr;
+    KernelSettings kernelSettings_;
 };
\ No newline at end of file
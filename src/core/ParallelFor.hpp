@@ -0,0 +1,27 @@
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Run rowFunction(first, end) over [0, rows) split across every core
+ *
+ * The calling thread takes the first range. Meant for CPU bakes whose rows
+ * are independent; rowFunction must be safe to call concurrently.
+ */
+template <typename Function>
+void forEachRowRange(int rows, Function rowFunction) {
+    int threadCount = static_cast<int>(std::clamp(std::thread::hardware_concurrency(), 1u, 16u));
+    threadCount = std::max(std::min(threadCount, rows), 1);
+    const int rowsPerThread = (rows + threadCount - 1) / threadCount;
+
+    std::vector<std::thread> threads;
+    for (int first = rowsPerThread; first < rows; first += rowsPerThread) {
+        threads.emplace_back(rowFunction, first, std::min(first + rowsPerThread, rows));
+    }
+    rowFunction(0, std::min(rowsPerThread, rows));
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
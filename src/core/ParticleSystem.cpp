@@ -1,99 +1,22 @@
 #include "ParticleSystem.hpp"
 #include "Shader.hpp"
 #include "Camera.hpp"
-#include <GLFW/glfw3.h>
+#include "RenderStats.hpp"
+#include "GLApi.hpp"
 #include <random>
 #include <algorithm>
 #include <cmath>
 #include <spdlog/spdlog.h>
 
-// OpenGL type definitions
-typedef unsigned int GLuint;
-typedef int GLint;
-typedef int GLsizei;
-typedef unsigned int GLenum;
-typedef float GLfloat;
-typedef void GLvoid;
-
-// OpenGL constants
-#ifndef GL_ARRAY_BUFFER
-#define GL_ARRAY_BUFFER 0x8892
-#endif
-#ifndef GL_ELEMENT_ARRAY_BUFFER
-#define GL_ELEMENT_ARRAY_BUFFER 0x8893
-#endif
-#ifndef GL_STATIC_DRAW
-#define GL_STATIC_DRAW 0x88E4
-#endif
-#ifndef GL_TRIANGLES
-#define GL_TRIANGLES 0x0004
-#endif
-#ifndef GL_FLOAT
-#define GL_FLOAT 0x1406
-#endif
-#ifndef GL_FALSE
-#define GL_FALSE 0
-#endif
-#ifndef GL_TRUE
-#define GL_TRUE 1
-#endif
-#ifndef GL_UNSIGNED_INT
-#define GL_UNSIGNED_INT 0x1405
-#endif
-#ifndef GL_SRC_ALPHA
-#define GL_SRC_ALPHA 0x0302
-#endif
-#ifndef GL_ONE_MINUS_SRC_ALPHA
-#define GL_ONE_MINUS_SRC_ALPHA 0x0303
-#endif
-#ifndef GL_BLEND
-#define GL_BLEND 0x0BE2
-#endif
-#ifndef GL_DEPTH_TEST
-#define GL_DEPTH_TEST 0x0B71
-#endif
-
-// OpenGL function pointers (only for extension functions)
-static void (*glGenVertexArrays)(GLsizei n, GLuint *arrays) = nullptr;
-static void (*glBindVertexArray)(GLuint array) = nullptr;
-static void (*glDeleteVertexArrays)(GLsizei n, const GLuint *arrays) = nullptr;
-static void (*glGenBuffers)(GLsizei n, GLuint *buffers) = nullptr;
-static void (*glBindBuffer)(GLenum target, GLuint buffer) = nullptr;
-static void (*glBufferData)(GLenum target, GLsizei size, const GLvoid *data, GLenum usage) = nullptr;
-static void (*glDeleteBuffers)(GLsizei n, const GLuint *buffers) = nullptr;
-static void (*glVertexAttribPointer)(GLuint index, GLint size, GLenum type, unsigned char normalized, GLsizei stride, const GLvoid *pointer) = nullptr;
-static void (*glEnableVertexAttribArray)(GLuint index) = nullptr;
-
-static bool particleFunctionsLoaded = false;
-
-static void loadParticleOpenGLFunctions() {
-    if (particleFunctionsLoaded) return;
-    
-    glGenVertexArrays = (void(*)(GLsizei, GLuint*))glfwGetProcAddress("glGenVertexArrays");
-    glBindVertexArray = (void(*)(GLuint))glfwGetProcAddress("glBindVertexArray");
-    glDeleteVertexArrays = (void(*)(GLsizei, const GLuint*))glfwGetProcAddress("glDeleteVertexArrays");
-    glGenBuffers = (void(*)(GLsizei, GLuint*))glfwGetProcAddress("glGenBuffers");
-    glBindBuffer = (void(*)(GLenum, GLuint))glfwGetProcAddress("glBindBuffer");
-    glBufferData = (void(*)(GLenum, GLsizei, const GLvoid*, GLenum))glfwGetProcAddress("glBufferData");
-    glDeleteBuffers = (void(*)(GLsizei, const GLuint*))glfwGetProcAddress("glDeleteBuffers");
-    glVertexAttribPointer = (void(*)(GLuint, GLint, GLenum, unsigned char, GLsizei, const GLvoid*))glfwGetProcAddress("glVertexAttribPointer");
-    glEnableVertexAttribArray = (void(*)(GLuint))glfwGetProcAddress("glEnableVertexAttribArray");
-    
-    if (glGenVertexArrays && glBindVertexArray && glDeleteVertexArrays && 
-        glGenBuffers && glBindBuffer && glBufferData && glDeleteBuffers &&
-        glVertexAttribPointer && glEnableVertexAttribArray) {
-        particleFunctionsLoaded = true;
-        spdlog::info("Particle OpenGL functions loaded successfully");
-    } else {
-        spdlog::error("Failed to load Particle OpenGL functions");
-    }
-}
-
 // Math constants
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+// Flare particles as point lights; color is scaled by particle intensity and alpha
+static constexpr float FLARE_LIGHT_RADIUS = 25.0f;
+static constexpr float FLARE_LIGHT_INTENSITY = 40.0f;
+
 ParticleSystem::ParticleSystem(const glm::vec3& origin, ParticleType type, int maxParticles)
     : origin_(origin)
     , type_(type)
@@ -101,6 +24,8 @@ ParticleSystem::ParticleSystem(const glm::vec3& origin, ParticleType type, int m
     , activeParticles_(0)
     , active_(true)
     , emissionRate_(50.0f)
+    , baseEmissionRate_(50.0f)
+    , emissionRateScale_(1.0f)
     , emissionTimer_(0.0f)
     , gravityStrength_(0.1f)
     , magneticFieldStrength_(0.05f)
@@ -139,6 +64,7 @@ ParticleSystem::ParticleSystem(const glm::vec3& origin, ParticleType type, int m
             magneticFieldStrength_ = 0.15f;
             break;
     }
+    baseEmissionRate_ = emissionRate_;
 }
 
 ParticleSystem::~ParticleSystem() {
@@ -146,7 +72,6 @@ ParticleSystem::~ParticleSystem() {
 }
 
 void ParticleSystem::initialize() {
-    loadParticleOpenGLFunctions();
     setupRenderingBuffers();
     spdlog::info("ParticleSystem initialized with {} max particles", maxParticles_);
 }
@@ -520,6 +445,34 @@ void ParticleSystem::removeDeadParticles() {
     activeParticles_ -= removedCount;
 }
 
+void ParticleSystem::collectLights(std::vector<PointLight>& lights, size_t maxLights) const {
+    if (!active_ || type_ != ParticleType::SOLAR_FLARE || maxLights == 0) {
+        return;
+    }
+    
+    const size_t first = lights.size();
+    for (const auto& particle : particles_) {
+        float brightness = particle.intensity * particle.alpha;
+        if (particle.life > 0.0f && brightness > 0.0f) {
+            lights.push_back({particle.position, FLARE_LIGHT_RADIUS * particle.intensity,
+                              particle.color * (brightness * FLARE_LIGHT_INTENSITY)});
+        }
+    }
+    
+    if (lights.size() - first > maxLights) {
+        auto luminance = [](const PointLight& light) { return light.color.r + light.color.g + light.color.b; };
+        std::partial_sort(lights.begin() + static_cast<std::ptrdiff_t>(first),
+                          lights.begin() + static_cast<std::ptrdiff_t>(first + maxLights), lights.end(),
+                          [&](const PointLight& a, const PointLight& b) { return luminance(a) > luminance(b); });
+        lights.resize(first + maxLights);
+    }
+}
+
+std::vector<std::string> ParticleSystem::getShaderVariantSymbols() {
+    // Indexed by ParticleType
+    return {"PARTICLE_SOLAR_FLARE", "PARTICLE_COSMIC_DUST", "PARTICLE_STELLAR_WIND", "PARTICLE_CORONA"};
+}
+
 void ParticleSystem::render(Shader* shader, const Camera* camera, const glm::mat4& view, 
                            const glm::mat4& projection, const glm::vec3& lightPos, 
                            const glm::vec3& lightColor, const glm::vec3& viewPos) {
@@ -533,11 +486,11 @@ void ParticleSystem::render(Shader* shader, const Camera* camera, const glm::mat
     shader->setVec3("viewPos", viewPos);
     
     // Enable blending for particles
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask(GL_FALSE); // Don't write to depth buffer
+    gl.Enable(GL_BLEND);
+    gl.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gl.DepthMask(GL_FALSE); // Don't write to depth buffer
     
-    glBindVertexArray(VAO_);
+    gl.BindVertexArray(VAO_);
     
     int particlesRendered = 0;
     for (const auto& particle : particles_) {
@@ -567,16 +520,17 @@ void ParticleSystem::render(Shader* shader, const Camera* camera, const glm::mat
         shader->setFloat("intensity", particle.intensity);
         
         // Render particle
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        gl.DrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        RenderStats::addDraw(2);
         particlesRendered++;
     }
     
-    glBindVertexArray(0);
+    gl.BindVertexArray(0);
     shader->unuse();
     
     // Restore depth writing
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
+    gl.DepthMask(GL_TRUE);
+    gl.Disable(GL_BLEND);
     
     // Log rendering stats occasionally
     static int frameCount = 0;
@@ -605,28 +559,28 @@ void ParticleSystem::setupRenderingBuffers() {
         2, 3, 0
     };
     
-    glGenVertexArrays(1, &VAO_);
-    glGenBuffers(1, &VBO_);
+    gl.GenVertexArrays(1, &VAO_);
+    gl.GenBuffers(1, &VBO_);
     unsigned int EBO;
-    glGenBuffers(1, &EBO);
+    gl.GenBuffers(1, &EBO);
     
-    glBindVertexArray(VAO_);
+    gl.BindVertexArray(VAO_);
     
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+    gl.BindBuffer(GL_ARRAY_BUFFER, VBO_);
+    gl.BufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
     
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    gl.BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
     
     // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    gl.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    gl.EnableVertexAttribArray(0);
     
     // Texture coordinate attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    gl.VertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+    gl.EnableVertexAttribArray(1);
     
-    glBindVertexArray(0);
+    gl.BindVertexArray(0);
     
     buffersInitialized_ = true;
     spdlog::debug("ParticleSystem rendering buffers initialized");
@@ -634,10 +588,10 @@ void ParticleSystem::setupRenderingBuffers() {
 
 void ParticleSystem::cleanupBuffers() {
     if (buffersInitialized_) {
-        glDeleteVertexArrays(1, &VAO_);
-        glDeleteBuffers(1, &VBO_);
+        gl.DeleteVertexArrays(1, &VAO_);
+        gl.DeleteBuffers(1, &VBO_);
         if (instanceVBO_ != 0) {
-            glDeleteBuffers(1, &instanceVBO_);
+            gl.DeleteBuffers(1, &instanceVBO_);
         }
         buffersInitialized_ = false;
     }
@@ -647,4 +601,10 @@ void ParticleSystem::setPhysicsParameters(float gravity, float magneticField, fl
     gravityStrength_ = gravity;
     magneticFieldStrength_ = magneticField;
     solarWindStrength_ = solarWind;
+}
+
+void ParticleSystem::restoreParticles(const Particle* particles, size_t count) {
+    count = std::min(count, static_cast<size_t>(maxParticles_));
+    particles_.assign(particles, particles + count);
+    activeParticles_ = static_cast<int>(count);
 }
\ No newline at end of file
@@ -1,41 +1,17 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "LightClusters.hpp"
+#include "SceneRecords.hpp"
 
 class Shader;
 class Camera;
 
-enum class ParticleType {
-    SOLAR_FLARE,
-    COSMIC_DUST,
-    STELLAR_WIND,
-    CORONA_PARTICLES
-};
-
-struct Particle {
-    glm::vec3 position;
-    glm::vec3 velocity;
-    glm::vec3 acceleration;
-    glm::vec3 color;
-    float size;
-    float life;
-    float maxLife;
-    float alpha;
-    float temperature;
-    ParticleType type;
-    
-    // Solar flare specific properties
-    float intensity;
-    float magneticField;
-    
-    // Cosmic dust specific properties
-    float density;
-    float reflectivity;
-};
-
 /**
  * @brief Advanced particle system for stellar phenomena
  */
@@ -64,22 +40,37 @@ public:
     void emitCosmicDust(const glm::vec3& center, float radius, int count);
     void emitStellarWind(const glm::vec3& sunPosition, float windSpeed, float density);
 
+    // Append point lights for emissive particles (solar flares), keeping the brightest maxLights
+    void collectLights(std::vector<PointLight>& lights, size_t maxLights) const;
+
     // Getters
     const glm::vec3& getOrigin() const { return origin_; }
     ParticleType getType() const { return type_; }
+
+    // Particle shader variants: bit i of a mask selects symbol i, one variant per particle type
+    static std::vector<std::string> getShaderVariantSymbols();
+    static uint32_t getShaderVariant(ParticleType type) { return 1u << static_cast<int>(type); }
     int getActiveParticleCount() const { return activeParticles_; }
+    int getMaxParticles() const { return maxParticles_; }
+    float getEmissionRate() const { return emissionRate_; }
+    float getBaseEmissionRate() const { return baseEmissionRate_; }
+    const std::vector<Particle>& getParticles() const { return particles_; }
     bool isActive() const { return active_; }
 
     // Setters
     void setOrigin(const glm::vec3& origin) { origin_ = origin; }
     void setActive(bool active) { active_ = active; }
-    void setEmissionRate(float rate) { emissionRate_ = rate; }
+    void setEmissionRate(float rate) { baseEmissionRate_ = rate; emissionRate_ = rate * emissionRateScale_; }
+    void setEmissionRateScale(float scale) { emissionRateScale_ = scale; emissionRate_ = baseEmissionRate_ * scale; }
     void setGravityStrength(float strength) { gravityStrength_ = strength; }
     void setMagneticFieldStrength(float strength) { magneticFieldStrength_ = strength; }
 
     // Physics parameters
     void setPhysicsParameters(float gravity, float magneticField, float solarWind);
 
+    // Replace the live particle pool (e.g. from a snapshot), truncated to maxParticles
+    void restoreParticles(const Particle* particles, size_t count);
+
 private:
     void updateParticlePhysics(Particle& particle, float deltaTime);
     void updateSolarFlareParticle(Particle& particle, float deltaTime);
@@ -110,6 +101,8 @@ private:
     
     // Emission parameters
     float emissionRate_;
+    float baseEmissionRate_;     // Type-specific rate before scaling
+    float emissionRateScale_;
     float emissionTimer_;
     
     // Physics parameters
@@ -1,6 +1,13 @@
 #include "Planet.hpp"
 #include "Geometry.hpp"
 #include "Noise.hpp"
+#include "PlanetMeshCache.hpp"
+#include "PlanetGridCache.hpp"
+#include "CubeFace.hpp"
+#include "ParallelFor.hpp"
+#include "Texture.hpp"
+#include "Hasher.hpp"
+#include <spdlog/spdlog.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
@@ -10,11 +17,16 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+// Bump whenever the terrain octaves or cubeToSphere change their output
+static constexpr uint32_t TERRAIN_VERSION = 1;
+
 Planet::Planet(float radius, int resolution, Noise* noise)
     : radius_(radius)
     , resolution_(resolution)
     , noise_(noise)
+    , meshCache_(nullptr)
     , geometry_(std::make_unique<Geometry>())
+    , gridCache_(nullptr)
     , heightScale_(1.0f)
     , noiseFrequency_(0.01f)
     , noiseOctaves_(4)
@@ -22,57 +34,367 @@ Planet::Planet(float radius, int resolution, Noise* noise)
     , orbitalSpeed_(0.0f)
     , orbitalAngle_(0.0f)
     , orbitalPosition_(0.0f, 0.0f, 0.0f)
-    , needsRegeneration_(true) {
+    , needsRegeneration_(true)
+    , heightMapDirty_(true) {
 }
 
+Planet::~Planet() = default;
+
 void Planet::generate() {
     if (!needsRegeneration_) {
         return;
     }
 
+    // Shader displacement: the shared grid exists already, only terrain changes need a bake
+    if (gridCache_) {
+        if (heightMapDirty_ || !heightMap_) {
+            updateHeightMap();
+        }
+        needsRegeneration_ = false;
+        return;
+    }
+
+    // Upload a prebuilt mesh directly when one exists for this resolution
+    auto prebuilt = prebuiltMeshes_.find(resolution_);
+    if (prebuilt != prebuiltMeshes_.end()) {
+        const PrebuiltMesh& mesh = prebuilt->second;
+        geometry_->setVertices(mesh.vertices, mesh.vertexCount);
+        geometry_->setIndices(mesh.indices, mesh.indexCount);
+        geometry_->uploadToGPU();
+        needsRegeneration_ = false;
+        return;
+    }
+
+    // Meshes of every resolution sample the same post-processed map; bake it once
+    if (terrainPostProcess_.isEnabled() && noise_) {
+        updateTerrainMap();
+    }
+
+    std::vector<Geometry::Vertex> geometryVertices;
+    std::vector<unsigned int> indices;
+    buildMesh(resolution_, geometryVertices, indices);
+
+    // Set geometry data
+    geometry_->setVertices(geometryVertices);
+    geometry_->setIndices(indices);
+    geometry_->uploadToGPU();
+
+    needsRegeneration_ = false;
+}
+
+void Planet::buildMesh(int resolution, std::vector<Geometry::Vertex>& geometryVertices,
+                       std::vector<unsigned int>& indices) const {
+    std::vector<float> heights;
+    buildHeights(resolution, heights);
+    buildFaces(resolution, radius_, heights.data(), geometryVertices, indices);
+}
+
+void Planet::buildGrid(int resolution, std::vector<Geometry::Vertex>& geometryVertices,
+                       std::vector<unsigned int>& indices) {
+    buildFaces(resolution, 1.0f, nullptr, geometryVertices, indices);
+}
+
+void Planet::buildFaces(int resolution, float radius, const float* heights,
+                        std::vector<Geometry::Vertex>& geometryVertices, std::vector<unsigned int>& indices) {
     std::vector<glm::vec3> vertices;
     std::vector<glm::vec3> normals;
     std::vector<glm::vec2> texCoords;
-    std::vector<unsigned int> indices;
 
     // Reserve memory for efficiency
-    const int verticesPerFace = resolution_ * resolution_;
+    const int verticesPerFace = resolution * resolution;
     const int totalVertices = verticesPerFace * 6;
-    const int indicesPerFace = (resolution_ - 1) * (resolution_ - 1) * 6;
+    const int indicesPerFace = (resolution - 1) * (resolution - 1) * 6;
     const int totalIndices = indicesPerFace * 6;
 
     vertices.reserve(totalVertices);
     normals.reserve(totalVertices);
     texCoords.reserve(totalVertices);
+    indices.clear();
     indices.reserve(totalIndices);
 
     // Generate all 6 faces of the cube
     for (int faceIndex = 0; faceIndex < 6; ++faceIndex) {
         Face face = static_cast<Face>(faceIndex);
         unsigned int vertexOffset = faceIndex * verticesPerFace;
-        generateFace(face, vertices, normals, texCoords, indices, vertexOffset);
+        generateFace(face, resolution, radius, heights ? heights + vertexOffset : nullptr,
+                     vertices, normals, texCoords, indices, vertexOffset);
     }
 
     // Convert to Vertex format for Geometry class
-    std::vector<Geometry::Vertex> geometryVertices;
+    geometryVertices.clear();
     geometryVertices.reserve(vertices.size());
 
     for (size_t i = 0; i < vertices.size(); ++i) {
-        Geometry::Vertex vertex(vertices[i], normals[i], texCoords[i]);
-        geometryVertices.push_back(vertex);
+        geometryVertices.emplace_back(vertices[i], normals[i], texCoords[i]);
     }
+}
 
-    // Set geometry data
-    geometry_->setVertices(geometryVertices);
-    geometry_->setIndices(indices);
-    geometry_->uploadToGPU();
+void Planet::buildHeights(int resolution, std::vector<float>& heights) const {
+    const size_t sampleCount = static_cast<size_t>(resolution) * resolution * 6;
 
-    needsRegeneration_ = false;
+    // Without noise the surface is a plain sphere; nothing worth caching
+    const bool useCache = meshCache_ && noise_;
+    uint64_t key = 0;
+    if (useCache) {
+        key = getMeshKey(resolution);
+        if (meshCache_->load(key, sampleCount, heights)) {
+            return;
+        }
+    }
+
+    // Post-processed terrain lives in the height cubemap; sample that instead of the noise
+    std::vector<float> terrainMap;
+    const std::vector<float>* postProcessed = nullptr;
+    if (terrainPostProcess_.isEnabled() && noise_) {
+        if (heightMapDirty_ || terrainMap_.empty()) {
+            buildHeightMap(terrainMap);
+            postProcessed = &terrainMap;
+        } else {
+            postProcessed = &terrainMap_;
+        }
+    }
+
+    if (postProcessed) {
+        heights.clear();
+        heights.reserve(sampleCount);
+        for (int faceIndex = 0; faceIndex < 6; ++faceIndex) {
+            Face face = static_cast<Face>(faceIndex);
+            for (int y = 0; y < resolution; ++y) {
+                for (int x = 0; x < resolution; ++x) {
+                    float u = static_cast<float>(x) / (resolution - 1);
+                    float v = static_cast<float>(y) / (resolution - 1);
+                    const glm::vec3 position = cubeToSphere(face, u, v);
+                    heights.push_back(TerrainPostProcess::sample(*postProcessed, HEIGHT_MAP_SIZE, position) * heightScale_);
+                }
+            }
+        }
+    } else if (!noise_) {
+        heights.assign(sampleCount, 0.0f);
+    } else {
+        const size_t sampled = sampleTerrainGrid(resolution, heights);
+        for (float& height : heights) {
+            height *= heightScale_;
+        }
+        spdlog::debug("Sampled {} of {} terrain heights at resolution {}", sampled, sampleCount, resolution);
+    }
+
+    if (useCache) {
+        meshCache_->store(key, heights);
+    }
+}
+
+size_t Planet::sampleTerrainGrid(int resolution, std::vector<float>& terrain) const {
+    const size_t faceSamples = static_cast<size_t>(resolution) * resolution;
+    terrain.resize(faceSamples * 6);
+
+    const uint64_t noiseKey = getNoiseKey();
+    if (finestTerrain_.noiseKey != noiseKey) {
+        finestTerrain_ = TerrainGrid{noiseKey, 0, {}};
+    }
+
+    // A coarser nested grid is a strided copy of the kept one
+    const int finest = finestTerrain_.resolution;
+    if (finest > 0 && isNestedGrid(resolution, finest)) {
+        const int stride = (finest - 1) / (resolution - 1);
+        const size_t finestFaceSamples = static_cast<size_t>(finest) * finest;
+        for (int face = 0; face < 6; ++face) {
+            for (int y = 0; y < resolution; ++y) {
+                const float* row = finestTerrain_.samples.data() + face * finestFaceSamples +
+                                   static_cast<size_t>(y) * stride * finest;
+                for (int x = 0; x < resolution; ++x) {
+                    terrain[face * faceSamples + static_cast<size_t>(y) * resolution + x] = row[x * stride];
+                }
+            }
+        }
+        return 0;
+    }
+
+    // A finer nested grid keeps the samples it shares with the kept one and samples the rest.
+    // Shared vertices have the same u, v in both grids (x / n == (x * s) / (n * s) exactly in
+    // floating point), so the copied heights match what sampling would give
+    const int stride = finest > 0 && isNestedGrid(finest, resolution) ? (resolution - 1) / (finest - 1) : 0;
+    const size_t finestFaceSamples = static_cast<size_t>(finest) * finest;
+    std::vector<glm::vec3> points;
+    std::vector<size_t> targets;
+    for (int faceIndex = 0; faceIndex < 6; ++faceIndex) {
+        Face face = static_cast<Face>(faceIndex);
+        for (int y = 0; y < resolution; ++y) {
+            for (int x = 0; x < resolution; ++x) {
+                const size_t index = faceIndex * faceSamples + static_cast<size_t>(y) * resolution + x;
+                if (stride > 0 && x % stride == 0 && y % stride == 0) {
+                    terrain[index] = finestTerrain_.samples[faceIndex * finestFaceSamples +
+                                                            static_cast<size_t>(y / stride) * finest + x / stride];
+                    continue;
+                }
+                float u = static_cast<float>(x) / (resolution - 1);
+                float v = static_cast<float>(y) / (resolution - 1);
+                points.push_back(cubeToSphere(face, u, v));
+                targets.push_back(index);
+            }
+        }
+    }
+
+    // Missing samples go through the noise as one batch, split across cores
+    std::vector<float> values(points.size());
+    constexpr int BATCH_SIZE = 256;
+    const int batches = static_cast<int>((points.size() + BATCH_SIZE - 1) / BATCH_SIZE);
+    forEachRowRange(batches, [&](int first, int end) {
+        const size_t begin = static_cast<size_t>(first) * BATCH_SIZE;
+        const size_t count = std::min(static_cast<size_t>(end) * BATCH_SIZE, points.size()) - begin;
+        noise_->getOctaves3D(points.data() + begin, count, noiseOctaves_, noiseFrequency_, values.data() + begin);
+    });
+    for (size_t i = 0; i < targets.size(); ++i) {
+        terrain[targets[i]] = values[i];
+    }
+    const size_t sampled = points.size();
+
+    if (resolution > finest) {
+        finestTerrain_.resolution = resolution;
+        finestTerrain_.samples = terrain;
+    }
+    return sampled;
+}
+
+bool Planet::isNestedGrid(int coarse, int fine) {
+    return coarse >= 2 && fine >= coarse && (fine - 1) % (coarse - 1) == 0;
+}
+
+uint64_t Planet::getNoiseKey() const {
+    return Hasher()
+        .add(TERRAIN_VERSION)
+        .add(noiseFrequency_)
+        .add(noiseOctaves_)
+        .add(noise_ ? noise_->getSettingsHash() : uint64_t(0))
+        .get();
+}
+
+void Planet::buildHeightMap(std::vector<float>& heights) const {
+    const int size = HEIGHT_MAP_SIZE;
+    const size_t sampleCount = static_cast<size_t>(size) * size * 6;
+
+    const bool useCache = meshCache_ && noise_;
+    uint64_t key = 0;
+    if (useCache) {
+        key = getHeightMapKey();
+        if (meshCache_->load(key, sampleCount, heights)) {
+            return;
+        }
+    }
+
+    heights.assign(sampleCount, 0.0f);
+    if (noise_) {
+        // Texel centers of the rows of all six faces; a texel's direction is its cube face point
+        forEachRowRange(size * 6, [this, size, &heights](int first, int end) {
+            std::vector<glm::vec3> points(static_cast<size_t>(size));
+            for (int row = first; row < end; ++row) {
+                const Face face = static_cast<Face>(row / size);
+                const float y = (static_cast<float>(row % size) + 0.5f) * 2.0f / size - 1.0f;
+                for (int x = 0; x < size; ++x) {
+                    const float faceX = (static_cast<float>(x) + 0.5f) * 2.0f / size - 1.0f;
+                    points[x] = glm::normalize(cubeFacePoint(static_cast<int>(face), faceX, y));
+                }
+                noise_->getOctaves3D(points.data(), points.size(), noiseOctaves_, noiseFrequency_,
+                                     heights.data() + static_cast<size_t>(row) * size);
+            }
+        });
+        terrainPostProcess_.apply(heights, size);
+    }
+
+    if (useCache) {
+        meshCache_->store(key, heights);
+    }
+}
+
+uint64_t Planet::getHeightMapKey() const {
+    return Hasher()
+        .add(PlanetMeshCache::FORMAT_VERSION)
+        .add(TERRAIN_VERSION)
+        .add(std::string("height cubemap"))
+        .add(HEIGHT_MAP_SIZE)
+        .add(noiseFrequency_)
+        .add(noiseOctaves_)
+        .add(noise_ ? noise_->getSettingsHash() : uint64_t(0))
+        .add(terrainPostProcess_.getSettingsHash())
+        .get();
+}
+
+Geometry* Planet::getGeometry() const {
+    return gridCache_ ? gridCache_->get(resolution_) : geometry_.get();
+}
+
+void Planet::setGridCache(PlanetGridCache* grids) {
+    if (gridCache_ == grids) {
+        return;
+    }
+    gridCache_ = grids;
+    if (gridCache_) {
+        // The shared grid replaces the own mesh; drop its buffers
+        geometry_ = std::make_unique<Geometry>();
+    } else {
+        heightMap_.reset();
+    }
+    needsRegeneration_ = true;
+}
+
+void Planet::setTerrainPostProcess(const TerrainPostProcess::Settings& settings) {
+    const TerrainPostProcess postProcess(settings);
+    if (postProcess.getSettingsHash() == terrainPostProcess_.getSettingsHash()) {
+        return;
+    }
+    terrainPostProcess_ = postProcess;
+    prebuiltMeshes_.clear();
+    needsRegeneration_ = true;
+    heightMapDirty_ = true;
+}
+
+void Planet::updateTerrainMap() {
+    if (heightMapDirty_ || terrainMap_.empty()) {
+        buildHeightMap(terrainMap_);
+        heightMapDirty_ = false;
+        // Any uploaded cubemap holds the old terrain; generate() re-uploads when it is missing
+        heightMap_.reset();
+    }
+}
+
+const std::vector<float>& Planet::getTerrainMap() {
+    updateTerrainMap();
+    return terrainMap_;
+}
+
+void Planet::updateHeightMap() {
+    updateTerrainMap();
+
+    heightMap_ = std::make_unique<Core::Texture>();
+    if (!heightMap_->loadCubemapFromFloatData(terrainMap_.data(), HEIGHT_MAP_SIZE)) {
+        heightMap_.reset();
+    }
+}
+
+uint64_t Planet::getMeshKey(int resolution) const {
+    return Hasher()
+        .add(PlanetMeshCache::FORMAT_VERSION)
+        .add(TERRAIN_VERSION)
+        .add(resolution)
+        .add(heightScale_)
+        .add(noiseFrequency_)
+        .add(noiseOctaves_)
+        .add(noise_ ? noise_->getSettingsHash() : uint64_t(0))
+        .add(terrainPostProcess_.getSettingsHash())
+        .get();
+}
+
+void Planet::setPrebuiltMesh(int resolution, const Geometry::Vertex* vertices, size_t vertexCount,
+                             const unsigned int* indices, size_t indexCount) {
+    prebuiltMeshes_[resolution] = PrebuiltMesh{vertices, vertexCount, indices, indexCount};
+    if (resolution == resolution_) {
+        needsRegeneration_ = true;
+    }
 }
 
 void Planet::setRadius(float radius) {
     if (radius_ != radius) {
         radius_ = radius;
+        prebuiltMeshes_.clear();
         needsRegeneration_ = true;
     }
 }
@@ -86,37 +408,40 @@ void Planet::setResolution(int resolution) {
 
 void Planet::setNoise(Noise* noise) {
     noise_ = noise;
+    prebuiltMeshes_.clear();
     needsRegeneration_ = true;
+    heightMapDirty_ = true;
 }
 
-glm::vec3 Planet::cubeToSphere(Face face, float u, float v) const {
-    // Convert u, v from [0, 1] to [-1, 1]
-    float x = 2.0f * u - 1.0f;
-    float y = 2.0f * v - 1.0f;
-
-    glm::vec3 cubePos;
-
-    // Map to cube face
-    switch (face) {
-        case Face::PositiveX: // Right face
-            cubePos = glm::vec3(1.0f, -y, -x);
-            break;
-        case Face::NegativeX: // Left face
-            cubePos = glm::vec3(-1.0f, -y, x);
-            break;
-        case Face::PositiveY: // Top face
-            cubePos = glm::vec3(x, 1.0f, y);
-            break;
-        case Face::NegativeY: // Bottom face
-            cubePos = glm::vec3(x, -1.0f, -y);
-            break;
-        case Face::PositiveZ: // Front face
-            cubePos = glm::vec3(x, -y, 1.0f);
-            break;
-        case Face::NegativeZ: // Back face
-            cubePos = glm::vec3(-x, -y, -1.0f);
-            break;
+void Planet::setHeightScale(float scale) {
+    if (heightScale_ != scale) {
+        heightScale_ = scale;
+        prebuiltMeshes_.clear();
+        needsRegeneration_ = true;
     }
+}
+
+void Planet::setNoiseFrequency(float frequency) {
+    if (noiseFrequency_ != frequency) {
+        noiseFrequency_ = frequency;
+        prebuiltMeshes_.clear();
+        needsRegeneration_ = true;
+        heightMapDirty_ = true;
+    }
+}
+
+void Planet::setNoiseOctaves(int octaves) {
+    if (noiseOctaves_ != octaves) {
+        noiseOctaves_ = octaves;
+        prebuiltMeshes_.clear();
+        needsRegeneration_ = true;
+        heightMapDirty_ = true;
+    }
+}
+
+glm::vec3 Planet::cubeToSphere(Face face, float u, float v) {
+    // Convert u, v from [0, 1] to [-1, 1]
+    glm::vec3 cubePos = cubeFacePoint(static_cast<int>(face), 2.0f * u - 1.0f, 2.0f * v - 1.0f);
 
     // Project cube position to sphere
     // This is the key cube-to-sphere projection formula
@@ -132,56 +457,26 @@ glm::vec3 Planet::cubeToSphere(Face face, float u, float v) const {
     return glm::normalize(spherePos);
 }
 
-float Planet::generateHeight(const glm::vec3& position) const {
-    if (!noise_) {
-        return 0.0f;
-    }
-
-    // Use multiple octaves of noise for realistic terrain
-    float height = 0.0f;
-    float amplitude = 1.0f;
-    float frequency = noiseFrequency_;
-    float maxValue = 0.0f;
-
-    for (int i = 0; i < noiseOctaves_; ++i) {
-        // Sample noise at the sphere position
-        float noiseValue = noise_->get3D(
-            position.x * frequency,
-            position.y * frequency,
-            position.z * frequency
-        );
-
-        height += noiseValue * amplitude;
-        maxValue += amplitude;
-
-        amplitude *= 0.5f;  // Reduce amplitude for each octave
-        frequency *= 2.0f;  // Increase frequency for each octave
-    }
-
-    // Normalize and scale
-    height /= maxValue;
-    return height * heightScale_;
-}
-
-void Planet::generateFace(Face face, std::vector<glm::vec3>& vertices,
-                         std::vector<glm::vec3>& normals, std::vector<glm::vec2>& texCoords,
-                         std::vector<unsigned int>& indices, unsigned int vertexOffset) {
+void Planet::generateFace(Face face, int resolution, float radius, const float* heights,
+                          std::vector<glm::vec3>& vertices, std::vector<glm::vec3>& normals,
+                          std::vector<glm::vec2>& texCoords, std::vector<unsigned int>& indices,
+                          unsigned int vertexOffset) {
     
     // Generate vertices for this face
-    for (int y = 0; y < resolution_; ++y) {
-        for (int x = 0; x < resolution_; ++x) {
+    for (int y = 0; y < resolution; ++y) {
+        for (int x = 0; x < resolution; ++x) {
             // Calculate UV coordinates
-            float u = static_cast<float>(x) / (resolution_ - 1);
-            float v = static_cast<float>(y) / (resolution_ - 1);
+            float u = static_cast<float>(x) / (resolution - 1);
+            float v = static_cast<float>(y) / (resolution - 1);
 
             // Convert to sphere position
             glm::vec3 spherePos = cubeToSphere(face, u, v);
 
-            // Generate height displacement
-            float height = generateHeight(spherePos);
+            // Height displacement from the precomputed grid
+            float height = heights ? heights[y * resolution + x] : 0.0f;
 
             // Apply height displacement
-            glm::vec3 finalPos = spherePos * (radius_ + height);
+            glm::vec3 finalPos = spherePos * (radius + height);
 
             // Calculate normal (for now, use the sphere normal)
             glm::vec3 normal = calculateNormal(spherePos);
@@ -194,12 +489,12 @@ void Planet::generateFace(Face face, std::vector<glm::vec3>& vertices,
     }
 
     // Generate indices for this face
-    for (int y = 0; y < resolution_ - 1; ++y) {
-        for (int x = 0; x < resolution_ - 1; ++x) {
+    for (int y = 0; y < resolution - 1; ++y) {
+        for (int x = 0; x < resolution - 1; ++x) {
             // Calculate vertex indices for the quad
-            unsigned int topLeft = vertexOffset + y * resolution_ + x;
+            unsigned int topLeft = vertexOffset + y * resolution + x;
             unsigned int topRight = topLeft + 1;
-            unsigned int bottomLeft = topLeft + resolution_;
+            unsigned int bottomLeft = topLeft + resolution;
             unsigned int bottomRight = bottomLeft + 1;
 
             // First triangle (top-left, bottom-left, top-right)
@@ -215,28 +510,11 @@ void Planet::generateFace(Face face, std::vector<glm::vec3>& vertices,
     }
 }
 
-glm::vec3 Planet::calculateNormal(const glm::vec3& position) const {
-    if (!noise_) {
-        return glm::normalize(position);
-    }
-
-    // Calculate normal using finite differences
-    const float epsilon = 0.001f;
-    
-    glm::vec3 pos = glm::normalize(position);
-    
-    // Sample height at current position and nearby positions
-    float heightCenter = generateHeight(pos);
-    
-    // Calculate tangent vectors by sampling nearby points
-    glm::vec3 tangentU = glm::vec3(1, 0, 0);
-    glm::vec3 tangentV = glm::vec3(0, 1, 0);
-    
+glm::vec3 Planet::calculateNormal(const glm::vec3& position) {
     // For simplicity, use the sphere normal for now
     // In a more advanced implementation, you would calculate the actual surface normal
-    // by taking the cross product of tangent vectors derived from height samples
-    
-    return glm::normalize(pos);
+    // from neighbouring samples of the height grid
+    return glm::normalize(position);
 }
 
 void Planet::setOrbitalParameters(float radius, float speed) {
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <vector>
+#include <unordered_map>
 #include <glm/glm.hpp>
+#include "Geometry.hpp"
+#include "TerrainPostProcess.hpp"
 
 // Forward declarations
-class Geometry;
 class Noise;
+class PlanetMeshCache;
+class PlanetGridCache;
+namespace Core { class Texture; }
 
 /**
  * @brief Planet class implementing cube-to-sphere projection for procedural planet generation
@@ -14,9 +20,24 @@ class Noise;
  * This class generates a planet using cube-to-sphere projection technique where each face
  * of a cube is subdivided and projected onto a sphere surface. Height displacement is
  * applied using noise functions to create realistic terrain.
+ *
+ * With a grid cache set (see setGridCache) the displacement moves to planet.vert:
+ * the planet draws the undisplaced grid shared by every planet at its resolution
+ * and samples a baked height cubemap, so terrain edits re-bake only that map.
+ *
+ * An optional TerrainPostProcess (craters, erosion) runs on that height
+ * cubemap; meshes then sample the processed map instead of the noise, so every
+ * resolution shows the same craters and channels.
+ *
+ * Noise samples of the finest mesh grid built so far are kept. Grids whose
+ * edge count divides the kept one (17 and 33 in 65, 2^n + 1 in general) share
+ * its samples exactly, so LOD switches down sample no noise and switches up
+ * sample only the new vertices.
  */
 class Planet {
 public:
+    static constexpr int HEIGHT_MAP_SIZE = 128; ///< Texels per edge of each height cubemap face
+
     /**
      * @brief Planet face enumeration for cube-to-sphere projection
      */
@@ -35,12 +56,12 @@ public:
      * @param resolution Resolution per face (vertices per edge)
      * @param noise Noise generator for height displacement
      */
-    Planet(float radius = 100.0f, int resolution = 64, Noise* noise = nullptr);
+    Planet(float radius = 100.0f, int resolution = 65, Noise* noise = nullptr);
 
     /**
      * @brief Destroy the Planet object
      */
-    ~Planet() = default;
+    ~Planet();
 
     // Non-copyable, non-movable for now
     Planet(const Planet&) = delete;
@@ -53,11 +74,127 @@ public:
      */
     void generate();
 
+    /**
+     * @brief Build the mesh for a given resolution on the CPU without touching the GPU
+     * @param resolution Resolution per face (vertices per edge)
+     * @param vertices Output vertex array
+     * @param indices Output index array
+     */
+    void buildMesh(int resolution, std::vector<Geometry::Vertex>& vertices,
+                   std::vector<unsigned int>& indices) const;
+
+    /**
+     * @brief Build the undisplaced unit-radius mesh used for shader displacement
+     *
+     * Same layout, winding and texture coordinates as buildMesh at zero height.
+     *
+     * @param resolution Resolution per face (vertices per edge)
+     * @param vertices Output vertex array
+     * @param indices Output index array
+     */
+    static void buildGrid(int resolution, std::vector<Geometry::Vertex>& vertices,
+                          std::vector<unsigned int>& indices);
+
+    /**
+     * @brief Bake the terrain into a height cubemap on the CPU, from the mesh cache when possible
+     *
+     * Heights include the terrain post-process but not heightScale, which
+     * planet.vert applies, so the map survives height scale edits.
+     *
+     * @param heights Output heights, HEIGHT_MAP_SIZE^2 per face in GL face order, first row first
+     */
+    void buildHeightMap(std::vector<float>& heights) const;
+
+    /**
+     * @brief Get the height cubemap, baking it first if the terrain changed
+     * @return const std::vector<float>& Heights as written by buildHeightMap, valid until the terrain changes
+     */
+    const std::vector<float>& getTerrainMap();
+
+    /**
+     * @brief Set the crater and erosion stage run on the terrain
+     * @param settings Post-process settings; all counts zero disables it
+     */
+    void setTerrainPostProcess(const TerrainPostProcess::Settings& settings);
+
+    /**
+     * @brief Get the crater and erosion stage run on the terrain
+     * @return const TerrainPostProcess& Post-process and its settings
+     */
+    const TerrainPostProcess& getTerrainPostProcess() const { return terrainPostProcess_; }
+
+    /**
+     * @brief Switch between CPU-displaced meshes and shader displacement
+     * @param grids Shared grids to draw with a height cubemap, or nullptr for a per-planet mesh
+     */
+    void setGridCache(PlanetGridCache* grids);
+
+    /**
+     * @brief Check if the terrain is displaced in the vertex shader
+     * @return true if the planet draws a shared grid with its height map
+     */
+    bool usesShaderDisplacement() const { return gridCache_ != nullptr; }
+
+    /**
+     * @brief Get the height cubemap used for shader displacement
+     * @return const Core::Texture* Height map, or nullptr when not baked
+     */
+    const Core::Texture* getHeightMap() const { return heightMap_.get(); }
+
+    /**
+     * @brief Check if generate() has work to do
+     * @return true after a resolution, radius or terrain change
+     */
+    bool needsRegeneration() const { return needsRegeneration_; }
+
+    /**
+     * @brief Register an already generated mesh for a resolution
+     *
+     * generate() uploads a registered mesh directly instead of evaluating noise.
+     * The memory is not copied and must outlive this planet (e.g. a mapped snapshot).
+     * Any change to radius or noise drops the registered meshes.
+     *
+     * @param resolution Resolution the mesh was built at
+     * @param vertices Vertex data
+     * @param vertexCount Number of vertices
+     * @param indices Index data
+     * @param indexCount Number of indices
+     */
+    void setPrebuiltMesh(int resolution, const Geometry::Vertex* vertices, size_t vertexCount,
+                         const unsigned int* indices, size_t indexCount);
+
+    /**
+     * @brief Set the on-disk height cache consulted before evaluating noise
+     * @param cache Mesh cache, or nullptr to always evaluate noise
+     */
+    void setMeshCache(PlanetMeshCache* cache) { meshCache_ = cache; }
+
+    /**
+     * @brief Compute the content key of the height grid for a resolution
+     *
+     * Covers every input of the displacement: resolution, height scale, noise
+     * frequency, octave count, the noise generator and post-process settings. The radius only
+     * scales the final positions and is applied after the cache lookup.
+     *
+     * @param resolution Resolution per face
+     * @return uint64_t Mesh cache key
+     */
+    uint64_t getMeshKey(int resolution) const;
+
+    /**
+     * @brief Compute the content key of the height cubemap
+     *
+     * Like getMeshKey, minus the height scale.
+     *
+     * @return uint64_t Mesh cache key
+     */
+    uint64_t getHeightMapKey() const;
+
     /**
      * @brief Get the planet geometry for rendering
-     * @return std::shared_ptr<Geometry> Planet geometry
+     * @return Geometry* Own mesh, or the shared grid of the current resolution with shader displacement
      */
-    Geometry* getGeometry() const { return geometry_.get(); }
+    Geometry* getGeometry() const;
 
     /**
      * @brief Set planet radius
@@ -93,7 +230,7 @@ public:
      * @brief Set height scale for noise displacement
      * @param scale Height scale multiplier
      */
-    void setHeightScale(float scale) { heightScale_ = scale; }
+    void setHeightScale(float scale);
 
     /**
      * @brief Get height scale
@@ -105,7 +242,7 @@ public:
      * @brief Set noise frequency for terrain generation
      * @param frequency Noise frequency
      */
-    void setNoiseFrequency(float frequency) { noiseFrequency_ = frequency; }
+    void setNoiseFrequency(float frequency);
 
     /**
      * @brief Get noise frequency
@@ -117,7 +254,7 @@ public:
      * @brief Set noise octaves for terrain generation
      * @param octaves Number of noise octaves
      */
-    void setNoiseOctaves(int octaves) { noiseOctaves_ = octaves; }
+    void setNoiseOctaves(int octaves);
 
     /**
      * @brief Get noise octaves
@@ -165,38 +302,90 @@ private:
      * @param v V coordinate on face [0, 1]
      * @return glm::vec3 Normalized sphere position
      */
-    glm::vec3 cubeToSphere(Face face, float u, float v) const;
+    static glm::vec3 cubeToSphere(Face face, float u, float v);
+
+    /**
+     * @brief Fill the per-vertex height grid, from the mesh cache when possible
+     * @param resolution Resolution per face
+     * @param heights Output heights, face by face in row-major order
+     */
+    void buildHeights(int resolution, std::vector<float>& heights) const;
+
+    /**
+     * @brief Sample the unscaled terrain of a grid, reusing the nested samples of finestTerrain_
+     * @param resolution Resolution per face
+     * @param terrain Output terrain samples, face by face in row-major order
+     * @return size_t Number of noise samples taken
+     */
+    size_t sampleTerrainGrid(int resolution, std::vector<float>& terrain) const;
+
+    /**
+     * @brief Check if every vertex of one grid is also a vertex of another
+     * @param coarse Resolution of the smaller grid
+     * @param fine Resolution of the larger grid
+     * @return true if the edge count of fine is a multiple of that of coarse
+     */
+    static bool isNestedGrid(int coarse, int fine);
 
     /**
-     * @brief Generate height displacement using noise
-     * @param position Normalized sphere position
-     * @return float Height displacement value
+     * @brief Hash every input of the terrain noise
+     * @return uint64_t Key of the noise terrain, independent of resolution and height scale
+     */
+    uint64_t getNoiseKey() const;
+
+    /**
+     * @brief Build a mesh of every face from a height grid
+     * @param resolution Resolution per face
+     * @param radius Sphere radius
+     * @param heights Height samples, face by face (6 * resolution^2), or nullptr for a plain sphere
+     * @param geometryVertices Output vertex array
+     * @param indices Output index array
      */
-    float generateHeight(const glm::vec3& position) const;
+    static void buildFaces(int resolution, float radius, const float* heights,
+                           std::vector<Geometry::Vertex>& geometryVertices, std::vector<unsigned int>& indices);
 
     /**
      * @brief Generate vertices for a single face
      * @param face Face to generate
+     * @param resolution Resolution per face
+     * @param radius Sphere radius
+     * @param heights Height samples of this face (resolution^2), or nullptr for zero height
      * @param vertices Output vertex array
      * @param indices Output index array
      * @param vertexOffset Starting vertex index offset
      */
-    void generateFace(Face face, std::vector<glm::vec3>& vertices, 
-                     std::vector<glm::vec3>& normals, std::vector<glm::vec2>& texCoords,
-                     std::vector<unsigned int>& indices, unsigned int vertexOffset);
+    static void generateFace(Face face, int resolution, float radius, const float* heights,
+                             std::vector<glm::vec3>& vertices, std::vector<glm::vec3>& normals,
+                             std::vector<glm::vec2>& texCoords, std::vector<unsigned int>& indices,
+                             unsigned int vertexOffset);
 
     /**
      * @brief Calculate normal vector for a vertex
      * @param position Vertex position
      * @return glm::vec3 Normal vector
      */
-    glm::vec3 calculateNormal(const glm::vec3& position) const;
+    static glm::vec3 calculateNormal(const glm::vec3& position);
+
+    /**
+     * @brief Bake the CPU height cubemap if the terrain changed
+     */
+    void updateTerrainMap();
+
+    /**
+     * @brief Bake and upload the height cubemap
+     */
+    void updateHeightMap();
 
 private:
     float radius_;                          ///< Planet radius
     int resolution_;                        ///< Resolution per face
     Noise* noise_;                          ///< Noise generator
+    PlanetMeshCache* meshCache_;            ///< On-disk height cache (optional)
     std::unique_ptr<Geometry> geometry_;   ///< Planet geometry
+    PlanetGridCache* gridCache_;            ///< Shared grids for shader displacement (optional)
+    std::unique_ptr<Core::Texture> heightMap_; ///< Height cubemap for shader displacement
+    std::vector<float> terrainMap_;         ///< CPU copy of the height cubemap, post-processed
+    TerrainPostProcess terrainPostProcess_; ///< Craters and erosion (optional)
     
     // Terrain generation parameters
     float heightScale_;                     ///< Height displacement scale
@@ -210,4 +399,26 @@ private:
     glm::vec3 orbitalPosition_;             ///< Current position in space
     
     bool needsRegeneration_;                ///< Flag indicating if geometry needs regeneration
+    bool heightMapDirty_;                   ///< Terrain changed since terrainMap_ was baked
+
+    /**
+     * @brief Non-owning view of a mesh generated ahead of time
+     */
+    struct PrebuiltMesh {
+        const Geometry::Vertex* vertices;
+        size_t vertexCount;
+        const unsigned int* indices;
+        size_t indexCount;
+    };
+    std::unordered_map<int, PrebuiltMesh> prebuiltMeshes_; ///< Prebuilt meshes by resolution
+
+    /**
+     * @brief Unscaled terrain samples of the finest grid built so far
+     */
+    struct TerrainGrid {
+        uint64_t noiseKey = 0;  ///< getNoiseKey() the samples were taken with
+        int resolution = 0;     ///< Resolution per face, 0 when empty
+        std::vector<float> samples;
+    };
+    mutable TerrainGrid finestTerrain_; ///< Filled by buildHeights, which is logically const
 };
\ No newline at end of file
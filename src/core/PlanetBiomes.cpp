@@ -0,0 +1,222 @@
+#include "PlanetBiomes.hpp"
+#include "CacheEntry.hpp"
+#include "CubeFace.hpp"
+#include "Hasher.hpp"
+#include "Noise.hpp"
+#include "ParallelFor.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Bump whenever the climate model or the biome table change
+static constexpr uint32_t BIOME_VERSION = 2;
+
+static_assert(PlanetBiomes::BiomeCount <= PlanetBiomes::MAX_BIOMES, "planet.frag reserves MAX_BIOMES palette entries");
+
+namespace {
+
+constexpr CacheEntry::Format BIOME_ENTRY = {
+    "biome", "biomes", {'A', 'S', 'T', 'R', 'B', 'I', 'O', 'M'}, PlanetBiomes::FORMAT_VERSION
+};
+constexpr int MAX_SIZE = 1024;
+
+// Climate noise: continent-sized blobs on the unit sphere
+constexpr float CLIMATE_NOISE_FREQUENCY = 1.5f;
+constexpr float CONTINENT_NOISE = 0.25f; // In terrain height units, before the height scale
+constexpr float TEMPERATURE_NOISE = 0.12f;
+constexpr float MOISTURE_NOISE = 0.35f;
+constexpr float HIGHLAND_DRYING = 0.3f; // Moisture lost from sea level to the highest peak
+
+// Biome table thresholds; elevations are fractions of the land or ocean depth range
+constexpr float FREEZING = 0.2f;
+constexpr float COLD = 0.35f;
+constexpr float TEMPERATE = 0.6f;
+constexpr float DEEP_OCEAN = 0.35f;
+constexpr float BEACH = 0.03f;
+constexpr float MOUNTAIN = 0.7f;
+
+PlanetBiomes::Biome classify(float elevation, bool underwater, bool hasSea, float temperature, float moisture) {
+    using Biome = PlanetBiomes::Biome;
+    if (underwater) {
+        if (temperature < FREEZING) {
+            return Biome::SeaIce;
+        }
+        return elevation > DEEP_OCEAN ? Biome::DeepOcean : Biome::Ocean;
+    }
+    if (temperature < FREEZING) {
+        return Biome::Snow;
+    }
+    if (elevation > MOUNTAIN) {
+        return Biome::Rock;
+    }
+    // Without a sea the lowest land is a basin floor, not a shore
+    if (hasSea && elevation < BEACH && moisture > 0.0f) {
+        return Biome::Beach;
+    }
+    if (temperature < COLD) {
+        return moisture > 0.4f ? Biome::Taiga : Biome::Tundra;
+    }
+    if (temperature < TEMPERATE) {
+        if (moisture < 0.2f) {
+            return Biome::Desert;
+        }
+        return moisture < 0.45f ? Biome::Grassland : Biome::TemperateForest;
+    }
+    if (moisture < 0.25f) {
+        return Biome::Desert;
+    }
+    return moisture < 0.55f ? Biome::Savanna : Biome::Rainforest;
+}
+
+} // namespace
+
+bool PlanetBiomes::hasBiomes(int type) {
+    return type != 1;
+}
+
+PlanetBiomes::Climate PlanetBiomes::getClimate(int type) {
+    switch (type) {
+        case 0: return {0.55f, 0.85f, 0.05f, 0.5f, 0.1f};   // Rocky - oceans, temperate belt, ice caps
+        case 2: return {0.3f, 0.3f, 0.0f, 0.3f, -0.15f};    // Ice - frozen seas, tundra at the equator
+        case 3: return {0.0f, 0.95f, 0.45f, 0.4f, -0.35f};  // Desert - no seas, dry everywhere
+        default: return {0.0f, 0.5f, 0.5f, 0.0f, 0.0f};     // Gas - unused
+    }
+}
+
+const std::array<glm::vec4, PlanetBiomes::BiomeCount>& PlanetBiomes::getPalette() {
+    static const std::array<glm::vec4, BiomeCount> palette = {
+        glm::vec4(0.05f, 0.15f, 0.45f, 0.15f),  // Deep ocean
+        glm::vec4(0.1f, 0.3f, 0.7f, 0.2f),      // Ocean
+        glm::vec4(0.75f, 0.85f, 0.95f, 0.25f),  // Sea ice
+        glm::vec4(0.76f, 0.7f, 0.5f, 0.6f),     // Beach
+        glm::vec4(0.85f, 0.72f, 0.45f, 0.8f),   // Desert
+        glm::vec4(0.65f, 0.6f, 0.3f, 0.75f),    // Savanna
+        glm::vec4(0.4f, 0.6f, 0.2f, 0.7f),      // Grassland
+        glm::vec4(0.2f, 0.45f, 0.15f, 0.75f),   // Temperate forest
+        glm::vec4(0.1f, 0.35f, 0.1f, 0.7f),     // Rainforest
+        glm::vec4(0.2f, 0.35f, 0.25f, 0.75f),   // Taiga
+        glm::vec4(0.55f, 0.55f, 0.45f, 0.8f),   // Tundra
+        glm::vec4(0.45f, 0.4f, 0.35f, 0.85f),   // Rock
+        glm::vec4(0.92f, 0.93f, 0.97f, 0.35f),  // Snow
+    };
+    return palette;
+}
+
+void PlanetBiomes::bake(const std::vector<float>& heights, int size, int seed, int type) {
+    seed_ = seed;
+    type_ = type;
+    size_ = std::clamp(size, 1, MAX_SIZE);
+    const size_t texels = static_cast<size_t>(size_) * size_ * 6;
+    biomes_.assign(texels, Biome::Rock);
+    if (heights.size() != texels) {
+        spdlog::error("Biome bake expects {} heights, got {}", texels, heights.size());
+        return;
+    }
+
+    Noise noise(seed);
+    noise.setFrequency(CLIMATE_NOISE_FREQUENCY);
+    noise.setFractalType(Noise::FractalType::FBm);
+    noise.setFractalOctaves(4);
+
+    auto getDirection = [this](int row, int x) {
+        const int face = row / size_;
+        const float faceX = (static_cast<float>(x) + 0.5f) * 2.0f / size_ - 1.0f;
+        const float faceY = (static_cast<float>(row % size_) + 0.5f) * 2.0f / size_ - 1.0f;
+        return glm::normalize(cubeFacePoint(face, faceX, faceY));
+    };
+
+    // Relief is the terrain plus continent-sized noise, so smooth terrain still gets coasts
+    std::vector<float> relief(texels);
+    forEachRowRange(size_ * 6, [&](int first, int end) {
+        for (int row = first; row < end; ++row) {
+            for (int x = 0; x < size_; ++x) {
+                const glm::vec3 direction = getDirection(row, x);
+                const size_t texel = static_cast<size_t>(row) * size_ + x;
+                relief[texel] = heights[texel] +
+                                CONTINENT_NOISE * noise.get3D(direction.x, direction.y, direction.z + 100.0f);
+            }
+        }
+    });
+
+    // Sea level from the relief distribution, so the ocean share does not depend on the height range
+    const Climate climate = getClimate(type);
+    const auto [lowest, highest] = std::minmax_element(relief.begin(), relief.end());
+    float seaLevel = -std::numeric_limits<float>::infinity();
+    if (climate.oceanFraction > 0.0f) {
+        std::vector<float> sorted(relief);
+        auto sea = sorted.begin() + static_cast<std::ptrdiff_t>(
+            std::min(static_cast<size_t>(climate.oceanFraction * texels), texels - 1));
+        std::nth_element(sorted.begin(), sea, sorted.end());
+        seaLevel = *sea;
+    }
+    const bool hasSea = std::isfinite(seaLevel);
+    const float landBase = std::max(seaLevel, *lowest);
+    const float landRange = std::max(*highest - landBase, 1e-6f);
+    const float oceanRange = std::max(seaLevel - *lowest, 1e-6f);
+
+    forEachRowRange(size_ * 6, [&](int first, int end) {
+        for (int row = first; row < end; ++row) {
+            for (int x = 0; x < size_; ++x) {
+                const glm::vec3 direction = getDirection(row, x);
+                const size_t texel = static_cast<size_t>(row) * size_ + x;
+
+                const bool underwater = relief[texel] < seaLevel;
+                const float elevation = underwater ? (seaLevel - relief[texel]) / oceanRange
+                                                   : (relief[texel] - landBase) / landRange;
+                const float land = underwater ? 0.0f : elevation;
+
+                // Planets spin about +Y, so latitude is the angle from the XZ plane
+                const float latitude = std::abs(direction.y);
+                float temperature = climate.equatorTemperature +
+                                    (climate.poleTemperature - climate.equatorTemperature) * latitude * latitude;
+                temperature += TEMPERATURE_NOISE * noise.get3D(direction.x + 100.0f, direction.y, direction.z) -
+                               climate.lapseRate * land;
+                const float moisture = 0.5f + climate.moisture +
+                                       MOISTURE_NOISE * noise.get3D(direction.x, direction.y, direction.z) -
+                                       HIGHLAND_DRYING * land;
+
+                biomes_[texel] = classify(elevation, underwater, hasSea, temperature, moisture);
+            }
+        }
+    });
+}
+
+uint64_t PlanetBiomes::getKey(uint64_t terrainKey, int seed, int type, int size) {
+    return Hasher()
+        .add(FORMAT_VERSION)
+        .add(BIOME_VERSION)
+        .add(terrainKey)
+        .add(seed)
+        .add(type)
+        .add(size)
+        .get();
+}
+
+bool PlanetBiomes::load(const std::string& directory, uint64_t terrainKey, int seed, int type, int size) {
+    const size_t mapBytes = static_cast<size_t>(size) * static_cast<size_t>(size) * 6;
+    std::vector<uint8_t> payload;
+    if (!CacheEntry(BIOME_ENTRY, directory, getKey(terrainKey, seed, type, size)).read(static_cast<uint32_t>(size), mapBytes, mapBytes, payload)) {
+        return false;
+    }
+
+    seed_ = seed;
+    type_ = type;
+    size_ = size;
+    biomes_ = std::move(payload);
+    return true;
+}
+
+bool PlanetBiomes::save(const std::string& directory, uint64_t terrainKey) const {
+    if (isEmpty()) {
+        return false;
+    }
+
+    const uint64_t key = getKey(terrainKey, seed_, type_, size_);
+    if (!CacheEntry(BIOME_ENTRY, directory, key).write(static_cast<uint32_t>(size_), {{biomes_.data(), biomes_.size()}})) {
+        return false;
+    }
+
+    spdlog::debug("Stored biome cache entry {:016x}: 6x{}x{}", key, size_, size_);
+    return true;
+}
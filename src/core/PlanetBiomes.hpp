@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Biome map of a planet, derived from its terrain and a simple climate model
+ *
+ * Works on the planet's height cubemap (see Planet::getTerrainMap): six faces
+ * of size x size texel-centered samples in GL face order. For every texel a
+ * temperature follows from latitude, elevation and seeded noise, and a
+ * moisture from seeded noise and elevation; the two pick a biome from a
+ * Whittaker-style table. Continent-sized noise is added to the heights so that
+ * smooth terrain still gets coastlines, and sea level is set so that a
+ * per-type fraction of the surface lies below it, which keeps the result
+ * independent of the terrain's absolute height range.
+ *
+ * The output is one biome index per texel, uploaded as an R8 cubemap that
+ * planet.frag turns into albedo and roughness through getPalette(). Baking
+ * runs on the CPU, spread over every core, and can be cached on disk keyed by
+ * getKey().
+ */
+class PlanetBiomes {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+    static constexpr int MAX_BIOMES = 16; ///< Palette entries planet.frag reserves
+
+    enum Biome : uint8_t {
+        DeepOcean = 0,
+        Ocean,
+        SeaIce,
+        Beach,
+        Desert,
+        Savanna,
+        Grassland,
+        TemperateForest,
+        Rainforest,
+        Taiga,
+        Tundra,
+        Rock,
+        Snow,
+        BiomeCount
+    };
+
+    /**
+     * @brief Climate of a planet type; temperatures are unitless, 0 freezing cold to 1 hot
+     */
+    struct Climate {
+        float oceanFraction;       // Share of the surface below sea level
+        float equatorTemperature;
+        float poleTemperature;
+        float lapseRate;           // Cooling from sea level to the highest peak
+        float moisture;            // Added to the moisture of every texel
+    };
+
+    PlanetBiomes() = default;
+
+    /**
+     * @brief Check if a planet type has a solid surface with biomes
+     * @param type Planet type (0=rocky, 1=gas, 2=ice, 3=desert)
+     * @return bool False for gas giants
+     */
+    static bool hasBiomes(int type);
+
+    /**
+     * @brief Get the climate of a planet type
+     * @param type Planet type
+     * @return Climate Climate parameters
+     */
+    static Climate getClimate(int type);
+
+    /**
+     * @brief Get the surface of every biome
+     * @return const std::array<glm::vec4, BiomeCount>& Albedo in rgb, roughness in a, indexed by Biome
+     */
+    static const std::array<glm::vec4, BiomeCount>& getPalette();
+
+    /**
+     * @brief Classify the biomes of a height cubemap
+     * @param heights Terrain heights, size^2 per face in GL face order
+     * @param size Texels per face edge
+     * @param seed Planet seed
+     * @param type Planet type
+     */
+    void bake(const std::vector<float>& heights, int size, int seed, int type);
+
+    /**
+     * @brief Read a baked biome map from a cache directory
+     * @param directory Cache directory
+     * @param terrainKey Content key of the heights (see Planet::getHeightMapKey)
+     * @param seed Planet seed
+     * @param type Planet type
+     * @param size Texels per face edge
+     * @return true if a valid entry was found
+     */
+    bool load(const std::string& directory, uint64_t terrainKey, int seed, int type, int size);
+
+    /**
+     * @brief Write the baked biome map to a cache directory
+     * @param directory Cache directory (created if missing)
+     * @param terrainKey Content key of the heights the map was baked from
+     * @return true if successful
+     */
+    bool save(const std::string& directory, uint64_t terrainKey) const;
+
+    /**
+     * @brief Compute the cache key of a biome map
+     * @param terrainKey Content key of the heights
+     * @param seed Planet seed
+     * @param type Planet type
+     * @param size Texels per face edge
+     * @return uint64_t Cache key, changes with FORMAT_VERSION and the climate code version
+     */
+    static uint64_t getKey(uint64_t terrainKey, int seed, int type, int size);
+
+    int getSize() const { return size_; }
+    bool isEmpty() const { return size_ == 0; }
+
+    /**
+     * @brief Get the biome indices
+     * @return const std::vector<uint8_t>& size^2 indices per face in GL face order, first row first
+     */
+    const std::vector<uint8_t>& getBiomes() const { return biomes_; }
+
+private:
+    int seed_ = 0;
+    int type_ = 0;
+    int size_ = 0;
+    std::vector<uint8_t> biomes_;
+};
@@ -0,0 +1,29 @@
+#include "PlanetGridCache.hpp"
+#include "Geometry.hpp"
+#include "Planet.hpp"
+#include <spdlog/spdlog.h>
+
+PlanetGridCache::PlanetGridCache() = default;
+
+PlanetGridCache::~PlanetGridCache() = default;
+
+Geometry* PlanetGridCache::get(int resolution) {
+    auto it = grids_.find(resolution);
+    if (it != grids_.end()) {
+        return it->second.get();
+    }
+
+    std::vector<Geometry::Vertex> vertices;
+    std::vector<unsigned int> indices;
+    Planet::buildGrid(resolution, vertices, indices);
+
+    auto grid = std::make_unique<Geometry>();
+    grid->setVertices(vertices);
+    grid->setIndices(indices);
+    grid->uploadToGPU();
+    spdlog::debug("Built shared planet grid at resolution {} ({} vertices)", resolution, vertices.size());
+
+    Geometry* result = grid.get();
+    grids_.emplace(resolution, std::move(grid));
+    return result;
+}
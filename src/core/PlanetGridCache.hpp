@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+class Geometry;
+
+/**
+ * @brief Undisplaced unit cube-sphere meshes, one per resolution, shared by every planet
+ *
+ * Planets with shader displacement draw these grids and let planet.vert move
+ * each vertex along its normal by the planet's height cubemap, so all planets
+ * at the same LOD share one vertex and index buffer. Grids are built on first
+ * use (see Planet::buildGrid).
+ */
+class PlanetGridCache {
+public:
+    PlanetGridCache();
+    ~PlanetGridCache();
+
+    // Non-copyable, non-movable
+    PlanetGridCache(const PlanetGridCache&) = delete;
+    PlanetGridCache& operator=(const PlanetGridCache&) = delete;
+    PlanetGridCache(PlanetGridCache&&) = delete;
+    PlanetGridCache& operator=(PlanetGridCache&&) = delete;
+
+    /**
+     * @brief Get the grid of a resolution, building and uploading it on first use
+     * @param resolution Resolution per face (vertices per edge)
+     * @return Geometry* Shared grid
+     */
+    Geometry* get(int resolution);
+
+    /**
+     * @brief Get the number of grids built so far
+     * @return size_t Grid count
+     */
+    size_t getGridCount() const { return grids_.size(); }
+
+private:
+    std::unordered_map<int, std::unique_ptr<Geometry>> grids_;
+};
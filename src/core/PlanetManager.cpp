@@ -1,95 +1,115 @@
 #include "PlanetManager.hpp"
+#include "AtmosphereTables.hpp"
+#include "ClusteredLighting.hpp"
 #include "Planet.hpp"
+#include "PlanetGridCache.hpp"
 #include "Moon.hpp"
 #include "Noise.hpp"
 #include "Shader.hpp"
+#include "ShaderVariants.hpp"
 #include "Camera.hpp"
 #include "Geometry.hpp"
+#include "GLApi.hpp"
+#include "PlanetBiomes.hpp"
+#include "PlanetSurface.hpp"
+#include "RenderStats.hpp"
+#include "SystemGenerator.hpp"
 #include <random>
 #include <algorithm>
+#include <chrono>
 #include <spdlog/spdlog.h>
 #include <glm/gtc/matrix_transform.hpp>
 
+namespace {
+
+int findLevel(const std::vector<ScreenSpaceLOD::Level>& levels, int resolution) {
+    for (size_t i = 0; i < levels.size(); ++i) {
+        if (levels[i].resolution == resolution) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Resolution chosen for a request, or the current one when there is no choice to apply
+int getRequestedResolution(const ScreenSpaceLOD* lod, const std::vector<size_t>& requests, size_t index,
+                           const std::vector<ScreenSpaceLOD::Level>& levels, int currentResolution) {
+    if (!lod || index >= requests.size() || requests[index] == ScreenSpaceLOD::NO_REQUEST) {
+        return currentResolution;
+    }
+    int level = lod->getLevel(requests[index]);
+    return level >= 0 ? levels[static_cast<size_t>(level)].resolution : currentResolution;
+}
+
+// Texture units of the height and biome cubemaps; units 4-6 hold the clustered light buffers
+constexpr int HEIGHT_MAP_UNIT = 7;
+constexpr int BIOME_MAP_UNIT = 8;
+
+} // namespace
+
 PlanetManager::PlanetManager()
-    : noise_(nullptr)
+    : gridCache_(std::make_unique<PlanetGridCache>())
+    , shaderDisplacement_(false)
+    , noise_(nullptr)
     , maxRenderDistance_(1000000000.0f)  // Increased from 1000 to 10000 for better visibility
-    , highLOD_(64)
-    , mediumLOD_(32)
-    , lowLOD_(16)
-    , lodDistance1_(100.0f)  // Increased LOD distances as well
-    , lodDistance2_(500.0f)
+    , highLOD_(65)     // 2^n + 1 vertices per edge, so each level nests in the next (see Planet)
+    , mediumLOD_(33)
+    , lowLOD_(17)
 {
+    for (int resolution : getLODResolutions()) {
+        lodLevels_.push_back(ScreenSpaceLOD::cubeSphereLevel(resolution));
+    }
+    for (int resolution : {MOON_RESOLUTION / 2, MOON_RESOLUTION, MOON_RESOLUTION * 2}) {
+        moonLODLevels_.push_back(ScreenSpaceLOD::cubeSphereLevel(resolution));
+    }
 }
 
+PlanetManager::~PlanetManager() = default;
+
 void PlanetManager::initialize(Noise* noise) {
     noise_ = noise;
     spdlog::info("PlanetManager initialized with noise generator");
 }
 
+void PlanetManager::setMeshCacheDirectory(const std::string& directory) {
+    if (directory.empty()) {
+        meshCache_.reset();
+    } else {
+        meshCache_ = std::make_unique<PlanetMeshCache>(directory);
+        spdlog::info("Planet mesh cache: {}", directory);
+    }
+
+    for (auto& instance : planets_) {
+        instance->planet->setMeshCache(meshCache_.get());
+    }
+}
+
+void PlanetManager::setShaderDisplacement(bool enabled) {
+    shaderDisplacement_ = enabled;
+    for (auto& instance : planets_) {
+        instance->planet->setGridCache(enabled ? gridCache_.get() : nullptr);
+        instance->planet->generate();
+    }
+    spdlog::info("Planet terrain displacement: {}", enabled ? "vertex shader" : "per-planet meshes");
+}
+
 void PlanetManager::generateSolarSystem(int systemSeed, int planetCount) {
     clear();
     
-    std::mt19937 rng(systemSeed);
-    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159f);
-    std::uniform_real_distribution<float> distanceDist(25.0f, 120.0f);
-    std::uniform_real_distribution<float> heightDist(-10.0f, 10.0f);
-    
     spdlog::info("Generating solar system with {} planets (seed: {})", planetCount, systemSeed);
     
-    std::vector<std::pair<glm::vec3, float>> planetPositions; // Store positions and radii for collision detection
+    std::vector<PlanetLayout> layouts;
+    int failures = SystemGenerator::generatePlanets(systemSeed, planetCount, layouts);
     
-    for (int i = 0; i < planetCount; ++i) {
-        glm::vec3 position;
-        float radius;
-        bool validPosition = false;
-        int attempts = 0;
-        const int maxAttempts = 50;
+    for (const auto& layout : layouts) {
+        addPlanet(layout.position, layout.radius, layout.color, layout.rotationSpeed, layout.seed, layout.type);
         
-        do {
-            // Generate orbital position
-            float angle = angleDist(rng);
-            float distance = distanceDist(rng);
-            float height = heightDist(rng);
-            
-            position = glm::vec3(
-                distance * cos(angle),
-                height,
-                distance * sin(angle)
-            );
-            
-            // Generate planet properties based on distance and seed
-            int planetSeed = systemSeed + i * 1000 + attempts;
-            auto [tempRadius, color, rotationSpeed, planetType] = generatePlanetProperties(planetSeed, distance);
-            radius = tempRadius;
-            
-            // Check for collisions with existing planets
-            validPosition = true;
-            for (const auto& [existingPos, existingRadius] : planetPositions) {
-                float minDistance = radius + existingRadius + 5.0f; // 5 unit buffer
-                float actualDistance = glm::length(position - existingPos);
-                
-                if (actualDistance < minDistance) {
-                    validPosition = false;
-                    break;
-                }
-            }
-            
-            attempts++;
-        } while (!validPosition && attempts < maxAttempts);
-        
-        if (validPosition) {
-            // Generate final planet properties
-            int planetSeed = systemSeed + i * 1000;
-            auto [finalRadius, color, rotationSpeed, planetType] = generatePlanetProperties(planetSeed, glm::length(position));
-            
-            addPlanet(position, finalRadius, color, rotationSpeed, planetSeed, planetType);
-            planetPositions.emplace_back(position, finalRadius);
-            
-            spdlog::info("Generated planet {}: pos({:.1f}, {:.1f}, {:.1f}), radius={:.1f}, seed={}", 
-                         i, position.x, position.y, position.z, finalRadius, planetSeed);
-        } else {
-            spdlog::warn("Could not find valid position for planet {} after {} attempts", i, maxAttempts);
-        }
+        spdlog::info("Generated planet {}: pos({:.1f}, {:.1f}, {:.1f}), radius={:.1f}, seed={}", 
+                     layout.index, layout.position.x, layout.position.y, layout.position.z,
+                     layout.radius, layout.seed);
+    }
+    if (failures > 0) {
+        spdlog::warn("Could not find valid positions for {} of {} planets", failures, planetCount);
     }
     
     spdlog::info("Solar system generation complete: {} planets created", planets_.size());
@@ -104,6 +124,7 @@ void PlanetManager::addPlanet(const glm::vec3& position, float radius, const glm
     
     // Create planet with initial resolution
     auto planet = std::make_unique<Planet>(radius, resolution, noise_);
+    planet->setMeshCache(meshCache_.get());
     
     // Set planet-specific noise parameters based on seed
     std::mt19937 rng(seed);
@@ -114,12 +135,14 @@ void PlanetManager::addPlanet(const glm::vec3& position, float radius, const glm
     planet->setHeightScale(heightDist(rng));
     planet->setNoiseFrequency(freqDist(rng));
     planet->setNoiseOctaves(octaveDist(rng));
+    planet->setTerrainPostProcess(SystemGenerator::generateTerrainFeatures(type, seed));
     
     // Set orbital parameters for the planet
     float distance = glm::length(position);
     float orbitalSpeed = 0.5f / sqrt(distance * 0.1f + 1.0f);
     planet->setOrbitalParameters(distance, orbitalSpeed);
     
+    planet->setGridCache(shaderDisplacement_ ? gridCache_.get() : nullptr);
     planet->generate();
     
     // Create planet instance
@@ -148,6 +171,9 @@ void PlanetManager::addPlanet(const glm::vec3& position, float radius, const glm
     
     // Generate moons for this planet
     generateMoonsForPlanet(*instance, seed);
+    createSurfaceMaps(*instance);
+    createBiomeMap(*instance);
+    createAtmosphereTables(type);
     
     planets_.push_back(std::move(instance));
     
@@ -155,6 +181,27 @@ void PlanetManager::addPlanet(const glm::vec3& position, float radius, const glm
                  position.x, position.y, position.z, radius, type, planets_.size());
 }
 
+void PlanetManager::addPlanetInstance(std::unique_ptr<PlanetInstance> instance) {
+    if (!instance || !instance->planet) {
+        spdlog::error("Cannot add planet instance: planet is null");
+        return;
+    }
+    if (shaderDisplacement_) {
+        instance->planet->setGridCache(gridCache_.get());
+        instance->planet->generate();
+    }
+    createSurfaceMaps(*instance);
+    createBiomeMap(*instance);
+    createAtmosphereTables(instance->type);
+    planets_.push_back(std::move(instance));
+}
+
+void PlanetManager::refreshBiomeMap(PlanetInstance& planet) {
+    if (planet.biomeMap && planet.planet && planet.planet->getHeightMapKey() != planet.biomeTerrainKey) {
+        createBiomeMap(planet);
+    }
+}
+
 void PlanetManager::update(float deltaTime) {
     for (auto& planetInstance : planets_) {
         // Update planet rotation
@@ -210,26 +257,84 @@ void PlanetManager::update(float deltaTime) {
     }
 }
 
-void PlanetManager::render(Shader* shader, const Camera* camera, const glm::mat4& view, 
+std::vector<std::string> PlanetManager::getShaderVariantSymbols() {
+    return {"PLANET_ATMOSPHERE", "PLANET_HEIGHTMAP", "PLANET_BIOMES"};
+}
+
+void PlanetManager::requestLOD(ScreenSpaceLOD& lod, const glm::vec3& cameraPos) {
+    // Same traversal and distance cut as render()
+    lodRequests_.clear();
+    for (auto& planetInstance : planets_) {
+        if (glm::length(planetInstance->position - cameraPos) > maxRenderDistance_) {
+            lodRequests_.push_back(ScreenSpaceLOD::NO_REQUEST);
+        } else {
+            const Planet* planet = planetInstance->planet.get();
+            lodRequests_.push_back(lod.request(planetInstance->position, planet->getRadius() * planetInstance->scale,
+                                               lodLevels_, findLevel(lodLevels_, planet->getResolution())));
+        }
+        
+        for (auto& moon : planetInstance->moons) {
+            if (glm::length(moon->getPosition() - cameraPos) > maxRenderDistance_) {
+                lodRequests_.push_back(ScreenSpaceLOD::NO_REQUEST);
+            } else {
+                lodRequests_.push_back(lod.request(moon->getPosition(), moon->getRadius(), moonLODLevels_,
+                                                   findLevel(moonLODLevels_, moon->getResolution())));
+            }
+        }
+    }
+}
+
+void PlanetManager::render(ShaderVariants* shaders, const Camera* camera, const glm::mat4& view, 
                           const glm::mat4& projection, const glm::vec3& lightPos, 
                           const glm::vec3& lightColor, const glm::vec3& viewPos, 
-                          float lightIntensity) {
-    if (!shader || !camera) {
+                          float lightIntensity, const ScreenSpaceLOD* lod, const ClusteredLighting* lights) {
+    if (!shaders || !camera) {
         return;
     }
     
-    shader->use();
-    shader->setMat4("view", view);
-    shader->setMat4("projection", projection);
-    shader->setVec3("lightPos", lightPos);
-    shader->setVec3("lightColor", lightColor);
-    shader->setVec3("viewPos", viewPos);
-    shader->setFloat("lightIntensity", lightIntensity);
+    Shader* planetShader = shaders->get(getShaderVariant(true, shaderDisplacement_));
+    Shader* biomeShader = shaders->get(getShaderVariant(true, shaderDisplacement_, true));
+    Shader* moonShader = shaders->get(getShaderVariant(false));
+    Shader* shader = nullptr; // Variant currently bound
+    auto bindVariant = [&](Shader* variant) {
+        // Per-frame uniforms are set whenever the bound variant changes
+        if (variant == shader) {
+            return;
+        }
+        shader = variant;
+        shader->use();
+        shader->setMat4("view", view);
+        shader->setMat4("projection", projection);
+        shader->setVec3("lightPos", lightPos);
+        shader->setVec3("lightColor", lightColor);
+        shader->setVec3("viewPos", viewPos);
+        shader->setFloat("lightIntensity", lightIntensity);
+        shader->setInt("albedoMap", 0);
+        shader->setInt("normalMap", 1);
+        shader->setInt("transmittanceTable", 2);
+        shader->setInt("scatteringTable", 3);
+        shader->setInt("heightMap", HEIGHT_MAP_UNIT);
+        if (shader == biomeShader) {
+            shader->setInt("biomeMap", BIOME_MAP_UNIT);
+            shader->setFloat("biomeMapSize", static_cast<float>(Planet::HEIGHT_MAP_SIZE));
+            const auto& palette = PlanetBiomes::getPalette();
+            for (size_t i = 0; i < palette.size(); ++i) {
+                shader->setVec4("biomePalette[" + std::to_string(i) + "]", palette[i]);
+            }
+        }
+        if (lights) {
+            lights->setUniforms(shader);
+        }
+    };
     
     glm::vec3 cameraPos = camera->getPosition();
     int planetsRendered = 0;
+    size_t nextRequest = 0;
     
     for (auto& planetInstance : planets_) {
+        const size_t planetRequest = nextRequest;
+        nextRequest += 1 + planetInstance->moons.size();
+        
         float distance = glm::length(planetInstance->position - cameraPos);
         
         // Skip planets that are too far away
@@ -237,42 +342,82 @@ void PlanetManager::render(Shader* shader, const Camera* camera, const glm::mat4
             continue;
         }
         
-        // Calculate appropriate LOD
-        int targetLOD = calculateLOD(distance, planetInstance->planet->getRadius());
+        // Mesh level from the frame's screen-space error selection
+        int targetLOD = getRequestedResolution(lod, lodRequests_, planetRequest, lodLevels_,
+                                               planetInstance->planet->getResolution());
         
-        // Update planet resolution if needed (expensive operation)
+        // Update planet resolution if needed (expensive unless the shared grids are used)
         if (planetInstance->planet->getResolution() != targetLOD) {
             planetInstance->planet->setResolution(targetLOD);
-            planetInstance->planet->generate();
+            if (!planetInstance->planet->usesShaderDisplacement()) {
+                RenderStats::addLODRebuild();
+            }
             spdlog::debug("Updated planet LOD to {} (distance: {:.1f})", targetLOD, distance);
         }
         
+        // Applies LOD switches and terrain edits; returns right away otherwise
+        planetInstance->planet->generate();
+        
         // Set up model matrix with position, scale, and rotation
         glm::mat4 model = glm::translate(glm::mat4(1.0f), planetInstance->position);
         model = glm::rotate(model, planetInstance->currentRotation, glm::vec3(0.0f, 1.0f, 0.0f));
         model = glm::scale(model, glm::vec3(planetInstance->scale));
         
-        shader->setMat4("model", model);
-        shader->setVec3("planetColor", planetInstance->color);
-        shader->setFloat("planetSeed", static_cast<float>(planetInstance->seed));
-        shader->setInt("planetType", planetInstance->type);
+        if (planetInstance->albedoMap && planetInstance->normalMap) {
+            planetInstance->albedoMap->bind(0);
+            planetInstance->normalMap->bind(1);
+        }
         
         // Render planet if it has valid geometry
-        if (planetInstance->planet->getGeometry() && planetInstance->planet->getGeometry()->isValid()) {
-            planetInstance->planet->getGeometry()->draw();
+        const Atmosphere& atmosphere = atmospheres_[static_cast<size_t>(planetInstance->type) % atmospheres_.size()];
+        const Planet* planet = planetInstance->planet.get();
+        const bool heightMapped = planet->usesShaderDisplacement();
+        Shader* surfaceShader = planetInstance->biomeMap ? biomeShader : planetShader;
+        if (surfaceShader && atmosphere.transmittance && atmosphere.scattering &&
+            planet->getGeometry() && planet->getGeometry()->isValid() && (!heightMapped || planet->getHeightMap())) {
+            bindVariant(surfaceShader);
+            shader->setMat4("model", model);
+            shader->setVec3("planetColor", planetInstance->color);
+            shader->setVec3("planetCenter", planetInstance->position);
+            shader->setFloat("planetRadius", planetInstance->planet->getRadius() * planetInstance->scale);
+            shader->setFloat("atmosphereTop", 1.0f + atmosphere.profile.thickness);
+            shader->setVec3("rayleighScattering", glm::vec3(atmosphere.profile.rayleighScattering[0],
+                                                            atmosphere.profile.rayleighScattering[1],
+                                                            atmosphere.profile.rayleighScattering[2]));
+            shader->setFloat("mieG", atmosphere.profile.mieG);
+            atmosphere.transmittance->bind(2);
+            atmosphere.scattering->bind(3);
+            if (heightMapped) {
+                shader->setFloat("terrainRadius", planet->getRadius());
+                shader->setFloat("heightScale", planet->getHeightScale());
+                planet->getHeightMap()->bind(HEIGHT_MAP_UNIT);
+            }
+            if (planetInstance->biomeMap) {
+                planetInstance->biomeMap->bind(BIOME_MAP_UNIT);
+            }
+            planet->getGeometry()->draw();
             planetsRendered++;
         }
         
-        // Render moons
-        for (auto& moon : planetInstance->moons) {
+        // Render moons; they have no atmosphere of their own
+        if (!moonShader) {
+            continue;
+        }
+        for (size_t i = 0; i < planetInstance->moons.size(); ++i) {
+            Moon* moon = planetInstance->moons[i].get();
             float moonDistance = glm::length(moon->getPosition() - cameraPos);
             if (moonDistance <= maxRenderDistance_) {
+                moon->setResolution(getRequestedResolution(lod, lodRequests_, planetRequest + 1 + i,
+                                                           moonLODLevels_, moon->getResolution()));
+                bindVariant(moonShader);
                 moon->render(shader, camera, view, projection, lightPos, lightColor, viewPos);
             }
         }
     }
     
-    shader->unuse();
+    if (shader) {
+        shader->unuse();
+    }
     
     // Log rendering stats occasionally
     static int frameCount = 0;
@@ -296,150 +441,122 @@ void PlanetManager::clear() {
     spdlog::info("Cleared all planets from manager");
 }
 
-int PlanetManager::calculateLOD(float distance, float planetRadius) const {
-    // Adjust LOD based on both distance and planet size
-    float effectiveDistance = distance / (planetRadius + 1.0f);
+void PlanetManager::generateMoonsForPlanet(PlanetInstance& planet, int seed) {
+    spdlog::debug("Generating moons for planet at ({:.1f}, {:.1f}, {:.1f}), type={}, scale={:.1f}", 
+                  planet.position.x, planet.position.y, planet.position.z, planet.type, planet.scale);
     
-    if (effectiveDistance < lodDistance1_) {
-        return highLOD_;
-    } else if (effectiveDistance < lodDistance2_) {
-        return mediumLOD_;
-    } else {
-        return lowLOD_;
+    std::vector<MoonLayout> moons = SystemGenerator::generateMoons(planet.type, planet.scale, seed);
+    if (moons.empty()) {
+        spdlog::debug("No moons generated for this planet");
+        return; // No moons for this planet
     }
-}
-
-std::tuple<float, glm::vec3, float, int> PlanetManager::generatePlanetProperties(int seed, float distance) const {
-    std::mt19937 rng(seed);
     
-    // Determine planet type based on distance from center
-    int planetType = 0; // Default to rocky
-    if (distance < 50.0f) {
-        // Inner system: rocky or desert planets
-        std::uniform_int_distribution<int> innerTypeDist(0, 3);
-        int typeChoice = innerTypeDist(rng);
-        planetType = (typeChoice <= 1) ? 0 : 3; // 50% rocky, 50% desert
-    } else if (distance < 150.0f) {
-        // Middle system: rocky, ice, or desert
-        std::uniform_int_distribution<int> midTypeDist(0, 2);
-        planetType = midTypeDist(rng); // rocky, gas, or ice
-    } else {
-        // Outer system: gas giants and ice planets
-        std::uniform_int_distribution<int> outerTypeDist(0, 1);
-        planetType = (outerTypeDist(rng) == 0) ? 1 : 2; // gas or ice
+    for (const auto& moon : moons) {
+        planet.moons.push_back(std::make_unique<Moon>(moon.radius, moon.orbitRadius, moon.orbitSpeed, moon.color, MOON_RESOLUTION));
     }
     
-    // Planet radius based on distance and type - more realistic distribution
-    float radius;
-    if (distance < 50.0f) {
-        // Inner planets: smaller, rocky worlds
-        std::uniform_real_distribution<float> innerRadiusDist(0.8f, 2.5f);
-        radius = innerRadiusDist(rng);
-    } else if (distance < 100.0f) {
-        // Middle system: medium-sized planets
-        std::uniform_real_distribution<float> midRadiusDist(1.5f, 4.0f);
-        radius = midRadiusDist(rng);
-    } else {
-        // Outer system: larger planets, especially gas giants
-        std::uniform_real_distribution<float> outerRadiusDist(2.0f, 8.0f);
-        radius = outerRadiusDist(rng);
+    spdlog::info("Generated {} moons for planet at ({:.1f}, {:.1f}, {:.1f})", 
+                 moons.size(), planet.position.x, planet.position.y, planet.position.z);
+}
+
+void PlanetManager::createSurfaceMaps(PlanetInstance& planet) {
+    auto startTime = std::chrono::steady_clock::now();
+
+    PlanetSurface surface;
+    bool cached = !surfaceCacheDirectory_.empty() &&
+                  surface.load(surfaceCacheDirectory_, planet.seed, planet.type, SURFACE_MAP_SIZE);
+    if (!cached) {
+        surface.bake(planet.seed, planet.type, SURFACE_MAP_SIZE);
+        if (!surfaceCacheDirectory_.empty()) {
+            surface.save(surfaceCacheDirectory_);
+        }
     }
-    
-    // Adjust radius based on type
-    if (planetType == 1) { // Gas giants are much larger
-        radius *= 2.2f;
-    } else if (planetType == 2) { // Ice planets are medium-large
-        radius *= 1.4f;
+
+    if (!GLApi::isLoaded()) {
+        return;
     }
-    
-    // Generate planet color based on type (will be overridden by shader)
-    glm::vec3 color;
-    switch(planetType) {
-        case 0: // Rocky
-            color = glm::vec3(0.6f, 0.5f, 0.4f);
-            break;
-        case 1: // Gas giant
-            color = glm::vec3(0.8f, 0.6f, 0.3f);
-            break;
-        case 2: // Ice
-            color = glm::vec3(0.7f, 0.8f, 0.9f);
-            break;
-        case 3: // Desert
-            color = glm::vec3(0.8f, 0.7f, 0.4f);
-            break;
-        default:
-            color = glm::vec3(0.5f, 0.5f, 0.5f);
+
+    // The maps are not periodic in UV, so repeating would bleed across face edges
+    planet.albedoMap = std::make_unique<Core::Texture>();
+    planet.normalMap = std::make_unique<Core::Texture>();
+    planet.albedoMap->loadFromMemory(surface.getAlbedo().data(), SURFACE_MAP_SIZE, SURFACE_MAP_SIZE, 4);
+    planet.albedoMap->setWrapMode(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+    planet.normalMap->loadFromMemory(surface.getNormal().data(), SURFACE_MAP_SIZE, SURFACE_MAP_SIZE, 4);
+    planet.normalMap->setWrapMode(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    spdlog::debug("{} surface maps for planet seed {} in {:.1f} ms", cached ? "Loaded" : "Baked", planet.seed, elapsedMs);
+}
+
+void PlanetManager::createBiomeMap(PlanetInstance& planet) {
+    if (!PlanetBiomes::hasBiomes(planet.type) || !planet.planet) {
+        return;
     }
-    
-    // Add some variation to color
-    std::uniform_real_distribution<float> colorVariation(-0.1f, 0.1f);
-    color.r = std::clamp(color.r + colorVariation(rng), 0.2f, 1.0f);
-    color.g = std::clamp(color.g + colorVariation(rng), 0.2f, 1.0f);
-    color.b = std::clamp(color.b + colorVariation(rng), 0.2f, 1.0f);
-    
-    // Rotation speed (smaller planets rotate faster, gas giants slower)
-    std::uniform_real_distribution<float> rotationDist(0.1f, 2.0f);
-    float rotationSpeed = rotationDist(rng) / radius;
-    if (planetType == 1) { // Gas giants rotate slower
-        rotationSpeed *= 0.5f;
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Snapshot biomes of the same terrain skip the height cubemap and the bake
+    const uint64_t terrainKey = planet.planet->getHeightMapKey();
+    const char* source = "Restored";
+    if (planet.biomes.empty() || planet.biomeTerrainKey != terrainKey) {
+        PlanetBiomes biomes;
+        bool cached = !surfaceCacheDirectory_.empty() &&
+                      biomes.load(surfaceCacheDirectory_, terrainKey, planet.seed, planet.type, Planet::HEIGHT_MAP_SIZE);
+        if (!cached) {
+            biomes.bake(planet.planet->getTerrainMap(), Planet::HEIGHT_MAP_SIZE, planet.seed, planet.type);
+            if (!surfaceCacheDirectory_.empty()) {
+                biomes.save(surfaceCacheDirectory_, terrainKey);
+            }
+        }
+        planet.biomes = biomes.getBiomes();
+        source = cached ? "Loaded" : "Baked";
     }
-    
-    return std::make_tuple(radius, color, rotationSpeed, planetType);
+    planet.biomeTerrainKey = terrainKey;
+
+    if (!GLApi::isLoaded()) {
+        return;
+    }
+
+    planet.biomeMap = std::make_unique<Core::Texture>();
+    if (!planet.biomeMap->loadCubemapFromByteData(planet.biomes.data(), Planet::HEIGHT_MAP_SIZE)) {
+        planet.biomeMap.reset();
+        return;
+    }
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    spdlog::debug("{} biome map for planet seed {} in {:.1f} ms", source, planet.seed, elapsedMs);
 }
 
-void PlanetManager::generateMoonsForPlanet(PlanetInstance& planet, int seed) {
-    std::mt19937 rng(seed + 54321); // Different seed offset for moons
-    
-    spdlog::debug("Generating moons for planet at ({:.1f}, {:.1f}, {:.1f}), type={}, scale={:.1f}", 
-                  planet.position.x, planet.position.y, planet.position.z, planet.type, planet.scale);
-    
-    // Determine number of moons based on planet type and size
-    int maxMoons = 0;
-    if (planet.type == 1) { // Gas giants
-        maxMoons = 4; // Gas giants can have more moons
-    } else if (planet.scale > 8.0f) { // Large planets
-        maxMoons = 3;
-    } else if (planet.scale > 5.0f) { // Medium planets
-        maxMoons = 2;
-    } else { // Small planets
-        maxMoons = 1;
+void PlanetManager::createAtmosphereTables(int type) {
+    Atmosphere& atmosphere = atmospheres_[static_cast<size_t>(type) % atmospheres_.size()];
+    if (atmosphere.transmittance || !GLApi::isLoaded()) {
+        return;
     }
-    
-    std::uniform_int_distribution<int> moonCountDist(0, maxMoons);
-    int moonCount = moonCountDist(rng);
-    
-    spdlog::debug("Planet type={}, scale={:.1f}, maxMoons={}, generated moonCount={}", 
-                  planet.type, planet.scale, maxMoons, moonCount);
-    
-    if (moonCount == 0) {
-        spdlog::debug("No moons generated for this planet");
-        return; // No moons for this planet
+    auto startTime = std::chrono::steady_clock::now();
+
+    AtmosphereTables tables;
+    bool cached = !surfaceCacheDirectory_.empty() && tables.load(surfaceCacheDirectory_, type);
+    if (!cached) {
+        tables.bake(type);
+        if (!surfaceCacheDirectory_.empty()) {
+            tables.save(surfaceCacheDirectory_);
+        }
     }
-    
-    // Generate moons
-    for (int i = 0; i < moonCount; ++i) {
-        // Moon properties
-        std::uniform_real_distribution<float> radiusDist(1.0f, planet.scale * 0.3f); // Moon size relative to planet
-        std::uniform_real_distribution<float> orbitDist(planet.scale * 2.0f, planet.scale * 6.0f); // Orbit distance
-        std::uniform_real_distribution<float> speedDist(0.5f, 2.0f); // Orbital speed
-        std::uniform_real_distribution<float> colorVariation(0.6f, 1.0f);
-        
-        float moonRadius = radiusDist(rng);
-        float orbitRadius = orbitDist(rng);
-        float orbitSpeed = speedDist(rng);
-        
-        // Moon color (grayish with some variation)
-        glm::vec3 moonColor = glm::vec3(
-            colorVariation(rng) * 0.8f,
-            colorVariation(rng) * 0.8f,
-            colorVariation(rng) * 0.8f
-        );
-        
-        // Create moon
-        auto moon = std::make_unique<Moon>(moonRadius, orbitRadius, orbitSpeed, moonColor, 16);
-        planet.moons.push_back(std::move(moon));
+
+    atmosphere.profile = tables.getProfileData();
+    atmosphere.transmittance = std::make_unique<Core::Texture>();
+    atmosphere.scattering = std::make_unique<Core::Texture>();
+    if (!atmosphere.transmittance->loadFromFloatData(tables.getTransmittance().data(),
+                                                     AtmosphereTables::TRANSMITTANCE_WIDTH,
+                                                     AtmosphereTables::TRANSMITTANCE_HEIGHT) ||
+        !atmosphere.scattering->loadFromFloatData(tables.getScattering().data(),
+                                                  AtmosphereTables::SCATTERING_WIDTH,
+                                                  AtmosphereTables::SCATTERING_HEIGHT)) {
+        spdlog::error("Failed to upload atmosphere tables for planet type {}", type);
+        atmosphere.transmittance.reset();
+        atmosphere.scattering.reset();
+        return;
     }
-    
-    spdlog::info("Generated {} moons for planet at ({:.1f}, {:.1f}, {:.1f})", 
-                 moonCount, planet.position.x, planet.position.y, planet.position.z);
-}
\ No newline at end of file
+
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    spdlog::info("{} atmosphere tables for planet type {} in {:.1f} ms", cached ? "Loaded" : "Baked", type, elapsedMs);
+}
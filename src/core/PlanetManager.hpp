@@ -1,15 +1,25 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 #include <glm/glm.hpp>
+#include "AtmosphereTables.hpp"
 #include "Moon.hpp"
+#include "PlanetMeshCache.hpp"
+#include "ScreenSpaceLOD.hpp"
+#include "Texture.hpp"
 
 // Forward declarations
 class Planet;
 class Noise;
 class Shader;
+class ShaderVariants;
 class Camera;
+class ClusteredLighting;
+class PlanetGridCache;
 
 /**
  * @brief Structure to hold planet instance data with orbital mechanics
@@ -35,6 +45,15 @@ struct PlanetInstance {
     // Moon system
     std::vector<std::unique_ptr<Moon>> moons;  // Moons orbiting this planet
     
+    // Baked surface maps (see PlanetSurface), shared UV space of every cube face
+    std::unique_ptr<Core::Texture> albedoMap;  // RGB albedo, A roughness
+    std::unique_ptr<Core::Texture> normalMap;  // RGB tangent-space normal, A height
+    
+    // Biome indices on the height cubemap grid (see PlanetBiomes); none for gas giants
+    std::unique_ptr<Core::Texture> biomeMap;
+    std::vector<uint8_t> biomes;               // Indices uploaded to biomeMap, kept for snapshots
+    uint64_t biomeTerrainKey = 0;              // Planet::getHeightMapKey() the biomes were baked from
+    
     PlanetInstance(std::unique_ptr<Planet> p, glm::vec3 pos, float s, glm::vec3 col, float rotSpeed, int planetSeed, int planetType = 0)
         : planet(std::move(p)), position(pos), scale(s), color(col), 
           rotationSpeed(rotSpeed), currentRotation(0.0f), seed(planetSeed), type(planetType),
@@ -47,6 +66,9 @@ struct PlanetInstance {
  */
 class PlanetManager {
 public:
+    static constexpr int MOON_RESOLUTION = 16; ///< Mesh resolution used for every moon
+    static constexpr int SURFACE_MAP_SIZE = 512; ///< Width and height of the baked surface maps
+
     /**
      * @brief Construct a new Planet Manager object
      */
@@ -55,7 +77,7 @@ public:
     /**
      * @brief Destroy the Planet Manager object
      */
-    ~PlanetManager() = default;
+    ~PlanetManager();
 
     // Non-copyable, non-movable for now
     PlanetManager(const PlanetManager&) = delete;
@@ -87,7 +109,63 @@ public:
      * @param resolution Mesh resolution (LOD)
      */
     void addPlanet(const glm::vec3& position, float radius, const glm::vec3& color, 
-                   float rotationSpeed, int seed, int type = 0, int resolution = 32);
+                   float rotationSpeed, int seed, int type = 0, int resolution = 33);
+
+    /**
+     * @brief Add a fully constructed planet instance (e.g. restored from a snapshot)
+     * @param instance Planet instance with generated planet and moons
+     */
+    void addPlanetInstance(std::unique_ptr<PlanetInstance> instance);
+
+    /**
+     * @brief Re-bake a planet's biome map after a terrain edit
+     *
+     * Does nothing while the terrain key still matches the baked biomes. A bake
+     * builds the height cubemap and runs the climate model, so the UI calls this
+     * once an edit is finished instead of on every slider step.
+     * @param planet Edited planet
+     */
+    void refreshBiomeMap(PlanetInstance& planet);
+
+    /**
+     * @brief Get every mesh resolution the LOD selection can request
+     * @return std::vector<int> Resolutions from lowest to highest
+     */
+    std::vector<int> getLODResolutions() const { return {lowLOD_, mediumLOD_, highLOD_}; }
+
+    /**
+     * @brief Enable the on-disk planet height cache
+     * @param directory Cache directory, or empty to disable the cache
+     */
+    void setMeshCacheDirectory(const std::string& directory);
+
+    /**
+     * @brief Enable the on-disk cache of baked surface maps and atmosphere tables
+     * @param directory Cache directory, or empty to bake every planet on load
+     */
+    void setSurfaceCacheDirectory(const std::string& directory) { surfaceCacheDirectory_ = directory; }
+
+    /**
+     * @brief Get the planet height cache
+     * @return PlanetMeshCache* Mesh cache or nullptr if disabled
+     */
+    PlanetMeshCache* getMeshCache() const { return meshCache_.get(); }
+
+    /**
+     * @brief Displace planet terrain in the vertex shader instead of baking it into per-planet meshes
+     *
+     * Planets then share one grid per LOD resolution and each keeps a height
+     * cubemap, so terrain edits re-bake only that map. Moons keep their meshes.
+     *
+     * @param enabled True for shader displacement
+     */
+    void setShaderDisplacement(bool enabled);
+
+    /**
+     * @brief Check if planets are displaced in the vertex shader
+     * @return true if shader displacement is enabled
+     */
+    bool isShaderDisplacement() const { return shaderDisplacement_; }
 
     /**
      * @brief Update all planets (rotation, etc.)
@@ -96,8 +174,15 @@ public:
     void update(float deltaTime);
 
     /**
-     * @brief Render all planets with distance-based LOD
-     * @param shader Planet shader to use
+     * @brief Request a mesh level for every planet and moon within the render distance
+     * @param lod Level selector of the frame; render() reads the results after it is resolved
+     * @param cameraPos Camera position
+     */
+    void requestLOD(ScreenSpaceLOD& lod, const glm::vec3& cameraPos);
+
+    /**
+     * @brief Render all planets and their moons
+     * @param shaders Planet shader variants (see getShaderVariant)
      * @param camera Camera for distance calculations
      * @param view View matrix
      * @param projection Projection matrix
@@ -105,11 +190,31 @@ public:
      * @param lightColor Light color
      * @param viewPos Camera position
      * @param lightIntensity Dynamic light intensity from sun
+     * @param lod Resolved level selector passed to requestLOD() this frame, or nullptr to keep the current meshes
+     * @param lights Clustered point lights of this frame, or nullptr
      */
-    void render(Shader* shader, const Camera* camera, const glm::mat4& view, 
+    void render(ShaderVariants* shaders, const Camera* camera, const glm::mat4& view, 
                 const glm::mat4& projection, const glm::vec3& lightPos, 
                 const glm::vec3& lightColor, const glm::vec3& viewPos, 
-                float lightIntensity = 1.0f);
+                float lightIntensity = 1.0f, const ScreenSpaceLOD* lod = nullptr,
+                const ClusteredLighting* lights = nullptr);
+
+    /**
+     * @brief Define symbols of the planet shader variants
+     * @return std::vector<std::string> Symbols, bit i selects symbol i
+     */
+    static std::vector<std::string> getShaderVariantSymbols();
+
+    /**
+     * @brief Get the planet shader variant for bodies with or without an atmosphere
+     * @param atmosphere True for planets, false for moons
+     * @param heightMap True for shader displacement with a height cubemap
+     * @param biomes True for surfaces colored from a biome cubemap
+     * @return uint32_t Variant mask
+     */
+    static uint32_t getShaderVariant(bool atmosphere, bool heightMap = false, bool biomes = false) {
+        return (atmosphere ? 1u : 0u) | (heightMap ? 2u : 0u) | (biomes ? 4u : 0u);
+    }
 
     /**
      * @brief Get the number of planets in the system
@@ -143,30 +248,49 @@ public:
 
 private:
     /**
-     * @brief Calculate appropriate LOD resolution based on distance
-     * @param distance Distance from camera to planet
-     * @param planetRadius Planet radius
-     * @return int Appropriate mesh resolution
+     * @brief Generate moons for a planet
+     * @param planet Planet instance to add moons to
+     * @param seed Random seed for moon generation
      */
-    int calculateLOD(float distance, float planetRadius) const;
+    void generateMoonsForPlanet(PlanetInstance& planet, int seed);
 
     /**
-     * @brief Generate random planet properties based on seed
-     * @param seed Planet seed
-     * @param distance Distance from system center
-     * @return Tuple of (radius, color, rotationSpeed, planetType)
+     * @brief Load or bake the surface maps of a planet and upload them
+     * @param planet Planet instance receiving the maps
      */
-    std::tuple<float, glm::vec3, float, int> generatePlanetProperties(int seed, float distance) const;
+    void createSurfaceMaps(PlanetInstance& planet);
 
     /**
-     * @brief Generate moons for a planet
-     * @param planet Planet instance to add moons to
-     * @param seed Random seed for moon generation
+     * @brief Load or bake the biome map of a planet from its current terrain and upload it
+     *
+     * Biomes already on the instance (restored from a snapshot) are uploaded as
+     * they are while they were baked from the current terrain.
+     * @param planet Planet instance receiving the map; gas giants get none
      */
-    void generateMoonsForPlanet(PlanetInstance& planet, int seed);
+    void createBiomeMap(PlanetInstance& planet);
+
+    /**
+     * @brief Load or bake the atmosphere tables of a planet type on first use and upload them
+     * @param type Planet type
+     */
+    void createAtmosphereTables(int type);
 
 private:
+    /**
+     * @brief Uploaded scattering tables of one planet type, shared by every planet of that type
+     */
+    struct Atmosphere {
+        AtmosphereTables::Profile profile{};
+        std::unique_ptr<Core::Texture> transmittance;
+        std::unique_ptr<Core::Texture> scattering;
+    };
+
+    std::unique_ptr<PlanetMeshCache> meshCache_;
+    std::unique_ptr<PlanetGridCache> gridCache_;
+    bool shaderDisplacement_;
+    std::string surfaceCacheDirectory_;
     std::vector<std::unique_ptr<PlanetInstance>> planets_;
+    std::array<Atmosphere, 4> atmospheres_; // Indexed by planet type
     Noise* noise_;
     float maxRenderDistance_;
     
@@ -175,6 +299,7 @@ private:
     int mediumLOD_;  // Medium distance planets
     int lowLOD_;     // Far planets
     
-    float lodDistance1_; // Distance threshold for high->medium LOD
-    float lodDistance2_; // Distance threshold for medium->low LOD
+    std::vector<ScreenSpaceLOD::Level> lodLevels_;     // Planet meshes, coarsest first
+    std::vector<ScreenSpaceLOD::Level> moonLODLevels_; // Moon meshes, coarsest first
+    std::vector<size_t> lodRequests_; // Per planet, then each of its moons, from requestLOD()
 };
\ No newline at end of file
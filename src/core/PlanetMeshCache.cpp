@@ -0,0 +1,89 @@
+#include "PlanetMeshCache.hpp"
+#include "CacheEntry.hpp"
+#include <spdlog/spdlog.h>
+#include <cstring>
+
+namespace {
+
+constexpr CacheEntry::Format MESH_ENTRY = {
+    "mesh", "heights", {'A', 'S', 'T', 'R', 'H', 'G', 'T', 'S'}, PlanetMeshCache::FORMAT_VERSION
+};
+
+void encodeHeights(const std::vector<float>& heights, std::vector<uint8_t>& out) {
+    out.clear();
+    out.reserve(heights.size() * 3);
+
+    uint32_t previous = 0;
+    for (float height : heights) {
+        uint32_t bits;
+        std::memcpy(&bits, &height, sizeof(bits));
+        uint32_t delta = bits ^ previous;
+        previous = bits;
+
+        while (delta >= 0x80) {
+            out.push_back(static_cast<uint8_t>(delta | 0x80));
+            delta >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(delta));
+    }
+}
+
+bool decodeHeights(const std::vector<uint8_t>& in, size_t sampleCount, std::vector<float>& heights) {
+    heights.resize(sampleCount);
+
+    size_t pos = 0;
+    uint32_t previous = 0;
+    for (size_t i = 0; i < sampleCount; ++i) {
+        uint32_t delta = 0;
+        int shift = 0;
+        while (true) {
+            if (pos >= in.size() || shift > 28) {
+                return false;
+            }
+            uint8_t byte = in[pos++];
+            delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+            shift += 7;
+        }
+
+        uint32_t bits = delta ^ previous;
+        previous = bits;
+        std::memcpy(&heights[i], &bits, sizeof(bits));
+    }
+
+    return pos == in.size();
+}
+
+} // namespace
+
+PlanetMeshCache::PlanetMeshCache(const std::string& directory)
+    : directory_(directory) {
+}
+
+bool PlanetMeshCache::load(uint64_t key, size_t sampleCount, std::vector<float>& heights) const {
+    std::vector<uint8_t> payload;
+    if (!CacheEntry(MESH_ENTRY, directory_, key).read(static_cast<uint32_t>(sampleCount), sampleCount, sampleCount * 5, payload)) {
+        return false;
+    }
+
+    if (!decodeHeights(payload, sampleCount, heights)) {
+        spdlog::warn("Ignoring corrupt mesh cache entry {:016x}", key);
+        return false;
+    }
+
+    return true;
+}
+
+bool PlanetMeshCache::store(uint64_t key, const std::vector<float>& heights) const {
+    std::vector<uint8_t> payload;
+    encodeHeights(heights, payload);
+
+    if (!CacheEntry(MESH_ENTRY, directory_, key).write(static_cast<uint32_t>(heights.size()), {{payload.data(), payload.size()}})) {
+        return false;
+    }
+
+    spdlog::debug("Stored mesh cache entry {:016x}: {} samples, {} bytes", key, heights.size(), payload.size());
+    return true;
+}
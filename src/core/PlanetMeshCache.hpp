@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Content-addressed on-disk cache of planet terrain
+ *
+ * A planet mesh is a pure function of its radius, resolution, terrain
+ * parameters and noise settings. Everything except the displacement can be
+ * rebuilt analytically, so the cache stores only the per-vertex height grid
+ * (6 faces x resolution^2 samples), keyed by the inputs of the displacement
+ * (see Planet::getMeshKey). Planets that differ only in radius share entries.
+ *
+ * Heights are compressed losslessly by XOR-ing each float with its neighbour
+ * and writing the result as a varint; adjacent samples share sign, exponent
+ * and high mantissa bits, so most samples shrink to two or three bytes.
+ * Entries are stored as CacheEntry files tagged with their sample count.
+ */
+class PlanetMeshCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    /**
+     * @brief Construct a cache rooted at a directory
+     * @param directory Directory holding cache entries (created on first store)
+     */
+    explicit PlanetMeshCache(const std::string& directory);
+    ~PlanetMeshCache() = default;
+
+    // Non-copyable, non-movable
+    PlanetMeshCache(const PlanetMeshCache&) = delete;
+    PlanetMeshCache& operator=(const PlanetMeshCache&) = delete;
+    PlanetMeshCache(PlanetMeshCache&&) = delete;
+    PlanetMeshCache& operator=(PlanetMeshCache&&) = delete;
+
+    /**
+     * @brief Load a height grid
+     * @param key Content key (see Planet::getMeshKey)
+     * @param sampleCount Expected number of height samples
+     * @param heights Output height samples
+     * @return true if a valid entry was found
+     */
+    bool load(uint64_t key, size_t sampleCount, std::vector<float>& heights) const;
+
+    /**
+     * @brief Store a height grid
+     * @param key Content key (see Planet::getMeshKey)
+     * @param heights Height samples to store
+     * @return true if successful
+     */
+    bool store(uint64_t key, const std::vector<float>& heights) const;
+
+    /**
+     * @brief Get the cache directory
+     * @return const std::string& Cache directory
+     */
+    const std::string& getDirectory() const { return directory_; }
+
+private:
+    std::string directory_;
+};
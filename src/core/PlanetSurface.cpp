@@ -0,0 +1,254 @@
+#include "PlanetSurface.hpp"
+#include "CacheEntry.hpp"
+#include "Hasher.hpp"
+#include "ParallelFor.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+
+// Bump whenever the surface pattern, the roughness or the normal derivation change
+static constexpr uint32_t SURFACE_VERSION = 1;
+
+namespace {
+
+constexpr CacheEntry::Format SURFACE_ENTRY = {
+    "surface", "surface", {'A', 'S', 'T', 'R', 'S', 'U', 'R', 'F'}, PlanetSurface::FORMAT_VERSION
+};
+constexpr int MAX_SIZE = 4096;
+
+// The value noise formerly evaluated in planet.frag. Lattice values come from
+// an integer hash rather than the GLSL fract(sin()) trick, which is slow on the
+// CPU for large arguments; positions are doubles so large seeds keep their detail.
+double hash(int64_t x, int64_t y) {
+    uint64_t h = static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ULL ^ static_cast<uint64_t>(y) * 0xC2B2AE3D27D4EB4FULL;
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 29;
+    return static_cast<double>(h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double valueNoise(double x, double y) {
+    double fx = x - std::floor(x);
+    double fy = y - std::floor(y);
+    int64_t ix = static_cast<int64_t>(std::floor(x));
+    int64_t iy = static_cast<int64_t>(std::floor(y));
+    fx = fx * fx * (3.0 - 2.0 * fx);
+    fy = fy * fy * (3.0 - 2.0 * fy);
+
+    double a = hash(ix, iy);
+    double b = hash(ix + 1, iy);
+    double c = hash(ix, iy + 1);
+    double d = hash(ix + 1, iy + 1);
+
+    double bottom = a + (b - a) * fx;
+    double top = c + (d - c) * fx;
+    return bottom + (top - bottom) * fy;
+}
+
+float fbm(double x, double y) {
+    double value = 0.0;
+    double amplitude = 0.5;
+    double frequency = 1.0;
+    for (int i = 0; i < 6; ++i) {
+        value += amplitude * valueNoise(x * frequency, y * frequency);
+        amplitude *= 0.5;
+        frequency *= 2.0;
+    }
+    return static_cast<float>(value);
+}
+
+float smoothstep(float edge0, float edge1, float x) {
+    float t = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+/**
+ * @brief Color (rgb) and roughness (a) being blended together
+ */
+struct Material {
+    float r, g, b, roughness;
+};
+
+Material mix(const Material& a, const Material& b, float t) {
+    return {a.r + (b.r - a.r) * t, a.g + (b.g - a.g) * t, a.b + (b.b - a.b) * t,
+            a.roughness + (b.roughness - a.roughness) * t};
+}
+
+/**
+ * @brief Surface material at a face UV; same layers as the old generatePlanetTexture
+ */
+Material evaluateMaterial(double u, double v, double seed, int type) {
+    const double px = u * 8.0 + seed;
+    const double py = v * 8.0 + seed;
+
+    if (type == 0) { // Rocky planet
+        float continents = fbm(px * 0.5, py * 0.5);
+        float mountains = fbm(px * 2.0, py * 2.0) * 0.3f;
+        float detail = fbm(px * 8.0, py * 8.0) * 0.1f;
+        float height = continents + mountains + detail;
+
+        const Material ocean{0.1f, 0.3f, 0.8f, 0.2f};
+        const Material land{0.4f, 0.6f, 0.2f, 0.7f};
+        const Material mountain{0.6f, 0.5f, 0.4f, 0.8f};
+        const Material snow{0.9f, 0.9f, 0.95f, 0.4f};
+
+        Material material = mix(ocean, land, smoothstep(0.3f, 0.4f, height));
+        material = mix(material, mountain, smoothstep(0.6f, 0.7f, height));
+        return mix(material, snow, smoothstep(0.8f, 0.9f, height));
+    }
+    if (type == 1) { // Gas giant
+        float bands = static_cast<float>(std::sin(v * 20.0 + fbm(px, py) * 2.0)) * 0.5f + 0.5f;
+        float storms = fbm(px * 3.0, py * 3.0);
+
+        const Material color1{0.8f, 0.6f, 0.3f, 0.5f};
+        const Material color2{0.9f, 0.7f, 0.4f, 0.5f};
+        const Material storm{0.9f, 0.4f, 0.2f, 0.6f};
+
+        Material material = mix(color1, color2, bands);
+        return mix(material, storm, smoothstep(0.7f, 0.8f, storms));
+    }
+    if (type == 2) { // Ice planet
+        float cracks = fbm(px * 4.0, py * 4.0);
+        float ice = fbm(px, py);
+
+        const Material iceColor{0.8f, 0.9f, 1.0f, 0.25f};
+        const Material deepIce{0.6f, 0.8f, 0.9f, 0.3f};
+        const Material crackColor{0.3f, 0.4f, 0.6f, 0.6f};
+
+        Material material = mix(deepIce, iceColor, ice);
+        return mix(material, crackColor, smoothstep(0.6f, 0.7f, cracks));
+    }
+
+    // Desert planet
+    float dunes = fbm(px * 2.0, py * 2.0);
+    float rocks = fbm(px * 6.0, py * 6.0);
+
+    const Material sand{0.8f, 0.7f, 0.4f, 0.75f};
+    const Material darkSand{0.6f, 0.5f, 0.3f, 0.75f};
+    const Material rock{0.5f, 0.4f, 0.3f, 0.85f};
+
+    Material material = mix(darkSand, sand, dunes);
+    return mix(material, rock, smoothstep(0.7f, 0.8f, rocks));
+}
+
+float getNormalStrength(int type) {
+    switch (type) {
+        case 0: return 2.0f;  // Rocky - strong normals
+        case 1: return 0.5f;  // Gas - smooth normals
+        case 2: return 1.5f;  // Ice - medium normals
+        default: return 1.8f; // Desert - strong normals
+    }
+}
+
+uint8_t toByte(float value) {
+    return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+}
+
+} // namespace
+
+void PlanetSurface::bake(int seed, int type, int size) {
+    seed_ = seed;
+    type_ = type;
+    size_ = std::clamp(size, 1, MAX_SIZE);
+
+    const size_t texels = static_cast<size_t>(size_) * static_cast<size_t>(size_);
+    albedo_.assign(texels * 4, 0);
+    normal_.assign(texels * 4, 0);
+
+    // Normals need the neighbouring heights, so they are derived in a second pass
+    std::vector<float> heights(texels);
+    forEachRowRange(size_, [this, &heights](int first, int end) { bakeRows(first, end, heights); });
+    forEachRowRange(size_, [this, &heights](int first, int end) { bakeNormals(first, end, heights); });
+}
+
+void PlanetSurface::bakeRows(int firstRow, int endRow, std::vector<float>& heights) {
+    const double seed = static_cast<double>(seed_);
+    for (int y = firstRow; y < endRow; ++y) {
+        const double v = (y + 0.5) / size_;
+        for (int x = 0; x < size_; ++x) {
+            const double u = (x + 0.5) / size_;
+            const size_t texel = static_cast<size_t>(y) * static_cast<size_t>(size_) + static_cast<size_t>(x);
+
+            Material material = evaluateMaterial(u, v, seed, type_);
+            albedo_[texel * 4 + 0] = toByte(material.r);
+            albedo_[texel * 4 + 1] = toByte(material.g);
+            albedo_[texel * 4 + 2] = toByte(material.b);
+            albedo_[texel * 4 + 3] = toByte(material.roughness);
+
+            heights[texel] = fbm(u * 16.0 + seed, v * 16.0 + seed);
+        }
+    }
+}
+
+void PlanetSurface::bakeNormals(int firstRow, int endRow, const std::vector<float>& heights) {
+    // Heights are sampled at uv * 16, so one texel spans 16 / size in noise space
+    const float texelSpacing = 16.0f / static_cast<float>(size_);
+    const float strength = getNormalStrength(type_);
+    auto height = [&](int x, int y) {
+        x = std::clamp(x, 0, size_ - 1);
+        y = std::clamp(y, 0, size_ - 1);
+        return heights[static_cast<size_t>(y) * static_cast<size_t>(size_) + static_cast<size_t>(x)];
+    };
+
+    for (int y = firstRow; y < endRow; ++y) {
+        for (int x = 0; x < size_; ++x) {
+            // Central differences, one-sided at the borders
+            int left = std::max(x - 1, 0);
+            int right = std::min(x + 1, size_ - 1);
+            int down = std::max(y - 1, 0);
+            int up = std::min(y + 1, size_ - 1);
+            float dx = (height(right, y) - height(left, y)) / (static_cast<float>(std::max(right - left, 1)) * texelSpacing);
+            float dy = (height(x, up) - height(x, down)) / (static_cast<float>(std::max(up - down, 1)) * texelSpacing);
+
+            float nx = -dx * strength;
+            float ny = -dy * strength;
+            float length = std::sqrt(nx * nx + ny * ny + 1.0f);
+
+            const size_t texel = static_cast<size_t>(y) * static_cast<size_t>(size_) + static_cast<size_t>(x);
+            normal_[texel * 4 + 0] = toByte(nx / length * 0.5f + 0.5f);
+            normal_[texel * 4 + 1] = toByte(ny / length * 0.5f + 0.5f);
+            normal_[texel * 4 + 2] = toByte(1.0f / length * 0.5f + 0.5f);
+            normal_[texel * 4 + 3] = toByte(height(x, y));
+        }
+    }
+}
+
+uint64_t PlanetSurface::getKey(int seed, int type, int size) {
+    return Hasher()
+        .add(FORMAT_VERSION)
+        .add(SURFACE_VERSION)
+        .add(seed)
+        .add(type)
+        .add(size)
+        .get();
+}
+
+bool PlanetSurface::load(const std::string& directory, int seed, int type, int size) {
+    const size_t mapBytes = static_cast<size_t>(size) * static_cast<size_t>(size) * 4;
+    std::vector<uint8_t> payload;
+    if (!CacheEntry(SURFACE_ENTRY, directory, getKey(seed, type, size)).read(static_cast<uint32_t>(size), mapBytes * 2, mapBytes * 2, payload)) {
+        return false;
+    }
+
+    seed_ = seed;
+    type_ = type;
+    size_ = size;
+    albedo_.assign(payload.begin(), payload.begin() + static_cast<std::ptrdiff_t>(mapBytes));
+    normal_.assign(payload.begin() + static_cast<std::ptrdiff_t>(mapBytes), payload.end());
+    return true;
+}
+
+bool PlanetSurface::save(const std::string& directory) const {
+    if (isEmpty()) {
+        return false;
+    }
+
+    const uint64_t key = getKey(seed_, type_, size_);
+    const std::initializer_list<CacheEntry::Part> parts = {{albedo_.data(), albedo_.size()}, {normal_.data(), normal_.size()}};
+    if (!CacheEntry(SURFACE_ENTRY, directory, key).write(static_cast<uint32_t>(size_), parts)) {
+        return false;
+    }
+
+    spdlog::debug("Stored surface cache entry {:016x}: {}x{}", key, size_, size_);
+    return true;
+}
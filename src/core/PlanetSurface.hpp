@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Baked surface maps of a planet: albedo, roughness and normals
+ *
+ * The planet surface pattern depends only on the planet seed, its type and
+ * the face UV (every cube face shares the same UV square), so it is baked once
+ * into two RGBA8 maps instead of evaluating fbm per fragment every frame:
+ *  - albedo map: surface color in RGB, roughness in A
+ *  - normal map: tangent-space normal packed to [0, 1] in RGB, height in A
+ *
+ * Baking runs on the CPU, spread over every core. Baked maps can be written to
+ * a cache directory keyed by getKey() so later runs skip the noise entirely.
+ */
+class PlanetSurface {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    PlanetSurface() = default;
+
+    /**
+     * @brief Evaluate the surface pattern into both maps
+     * @param seed Planet seed
+     * @param type Planet type (0=rocky, 1=gas, 2=ice, 3=desert)
+     * @param size Map width and height in texels
+     */
+    void bake(int seed, int type, int size);
+
+    /**
+     * @brief Read baked maps from a cache directory
+     * @param directory Cache directory
+     * @param seed Planet seed
+     * @param type Planet type
+     * @param size Map width and height in texels
+     * @return true if a valid entry was found
+     */
+    bool load(const std::string& directory, int seed, int type, int size);
+
+    /**
+     * @brief Write the baked maps to a cache directory
+     * @param directory Cache directory (created if missing)
+     * @return true if successful
+     */
+    bool save(const std::string& directory) const;
+
+    /**
+     * @brief Compute the cache key of a surface
+     * @param seed Planet seed
+     * @param type Planet type
+     * @param size Map width and height in texels
+     * @return uint64_t Cache key, changes with FORMAT_VERSION and the bake code version
+     */
+    static uint64_t getKey(int seed, int type, int size);
+
+    int getSize() const { return size_; }
+    bool isEmpty() const { return size_ == 0; }
+
+    const std::vector<uint8_t>& getAlbedo() const { return albedo_; }
+    const std::vector<uint8_t>& getNormal() const { return normal_; }
+
+private:
+    void bakeRows(int firstRow, int endRow, std::vector<float>& heights);
+    void bakeNormals(int firstRow, int endRow, const std::vector<float>& heights);
+
+    int seed_ = 0;
+    int type_ = 0;
+    int size_ = 0;
+    std::vector<uint8_t> albedo_;  // size_ * size_ RGBA, first row at v = 0
+    std::vector<uint8_t> normal_;  // size_ * size_ RGBA, first row at v = 0
+};
@@ -1,102 +1,13 @@
 #include "PlanetaryRings.hpp"
 #include "Shader.hpp"
+#include "ClusteredLighting.hpp"
 #include "Camera.hpp"
-#include <GLFW/glfw3.h>
+#include "RenderStats.hpp"
+#include "GLApi.hpp"
 #include <random>
 #include <algorithm>
 #include <spdlog/spdlog.h>
 
-// OpenGL type definitions
-typedef unsigned int GLuint;
-typedef int GLint;
-typedef int GLsizei;
-typedef unsigned int GLenum;
-typedef unsigned char GLboolean;
-typedef float GLfloat;
-typedef void GLvoid;
-
-// OpenGL constants
-#ifndef GL_ARRAY_BUFFER
-#define GL_ARRAY_BUFFER 0x8892
-#endif
-#ifndef GL_ELEMENT_ARRAY_BUFFER
-#define GL_ELEMENT_ARRAY_BUFFER 0x8893
-#endif
-#ifndef GL_STATIC_DRAW
-#define GL_STATIC_DRAW 0x88E4
-#endif
-#ifndef GL_TRIANGLES
-#define GL_TRIANGLES 0x0004
-#endif
-#ifndef GL_FLOAT
-#define GL_FLOAT 0x1406
-#endif
-#ifndef GL_FALSE
-#define GL_FALSE 0
-#endif
-#ifndef GL_TRUE
-#define GL_TRUE 1
-#endif
-#ifndef GL_UNSIGNED_INT
-#define GL_UNSIGNED_INT 0x1405
-#endif
-#ifndef GL_BLEND
-#define GL_BLEND 0x0BE2
-#endif
-#ifndef GL_SRC_ALPHA
-#define GL_SRC_ALPHA 0x0302
-#endif
-#ifndef GL_ONE_MINUS_SRC_ALPHA
-#define GL_ONE_MINUS_SRC_ALPHA 0x0303
-#endif
-
-// OpenGL function pointers
-static void (*glGenVertexArrays)(GLsizei n, GLuint *arrays) = nullptr;
-static void (*glBindVertexArray)(GLuint array) = nullptr;
-static void (*glDeleteVertexArrays)(GLsizei n, const GLuint *arrays) = nullptr;
-static void (*glGenBuffers)(GLsizei n, GLuint *buffers) = nullptr;
-static void (*glBindBuffer)(GLenum target, GLuint buffer) = nullptr;
-static void (*glBufferData)(GLenum target, GLsizei size, const GLvoid *data, GLenum usage) = nullptr;
-static void (*glDeleteBuffers)(GLsizei n, const GLuint *buffers) = nullptr;
-static void (*glVertexAttribPointer)(GLuint index, GLint size, GLenum type, unsigned char normalized, GLsizei stride, const GLvoid *pointer) = nullptr;
-static void (*glEnableVertexAttribArray)(GLuint index) = nullptr;
-static void (*glDrawElements_)(GLenum mode, GLsizei count, GLenum type, const GLvoid *indices) = nullptr;
-static void (*glEnable_)(GLenum cap) = nullptr;
-static void (*glDisable_)(GLenum cap) = nullptr;
-static void (*glBlendFunc_)(GLenum sfactor, GLenum dfactor) = nullptr;
-static void (*glDepthMask_)(unsigned char flag) = nullptr;
-
-static bool planetaryRingsFunctionsLoaded = false;
-
-static void loadPlanetaryRingsOpenGLFunctions() {
-    if (planetaryRingsFunctionsLoaded) return;
-
-    glGenVertexArrays = (void(*)(GLsizei, GLuint*))glfwGetProcAddress("glGenVertexArrays");
-    glBindVertexArray = (void(*)(GLuint))glfwGetProcAddress("glBindVertexArray");
-    glDeleteVertexArrays = (void(*)(GLsizei, const GLuint*))glfwGetProcAddress("glDeleteVertexArrays");
-    glGenBuffers = (void(*)(GLsizei, GLuint*))glfwGetProcAddress("glGenBuffers");
-    glBindBuffer = (void(*)(GLenum, GLuint))glfwGetProcAddress("glBindBuffer");
-    glBufferData = (void(*)(GLenum, GLsizei, const GLvoid*, GLenum))glfwGetProcAddress("glBufferData");
-    glDeleteBuffers = (void(*)(GLsizei, const GLuint*))glfwGetProcAddress("glDeleteBuffers");
-    glVertexAttribPointer = (void(*)(GLuint, GLint, GLenum, unsigned char, GLsizei, const GLvoid*))glfwGetProcAddress("glVertexAttribPointer");
-    glEnableVertexAttribArray = (void(*)(GLuint))glfwGetProcAddress("glEnableVertexAttribArray");
-    glDrawElements_ = (void(*)(GLenum, GLsizei, GLenum, const GLvoid*))glfwGetProcAddress("glDrawElements");
-    glEnable_ = (void(*)(GLenum))glfwGetProcAddress("glEnable");
-    glDisable_ = (void(*)(GLenum))glfwGetProcAddress("glDisable");
-    glBlendFunc_ = (void(*)(GLenum, GLenum))glfwGetProcAddress("glBlendFunc");
-    glDepthMask_ = (void(*)(unsigned char))glfwGetProcAddress("glDepthMask");
-
-    if (glGenVertexArrays && glBindVertexArray && glDeleteVertexArrays &&
-        glGenBuffers && glBindBuffer && glBufferData && glDeleteBuffers &&
-        glVertexAttribPointer && glEnableVertexAttribArray && glDrawElements_ &&
-        glEnable_ && glDisable_ && glBlendFunc_ && glDepthMask_) {
-        planetaryRingsFunctionsLoaded = true;
-        spdlog::info("PlanetaryRings OpenGL functions loaded successfully");
-    } else {
-        spdlog::error("Failed to load PlanetaryRings OpenGL functions");
-    }
-}
-
 PlanetaryRings::PlanetaryRings(const glm::vec3& planetPosition, float planetRadius,
                                float innerRadius, float outerRadius, int particleCount, int seed)
     : planetPosition_(planetPosition)
@@ -104,6 +15,7 @@ PlanetaryRings::PlanetaryRings(const glm::vec3& planetPosition, float planetRadi
     , innerRadius_(innerRadius)
     , outerRadius_(outerRadius)
     , particleCount_(particleCount)
+    , baseParticleCount_(particleCount)
     , seed_(seed)
     , visible_(true)
     , orbitSpeedMultiplier_(1.0f)
@@ -114,12 +26,34 @@ PlanetaryRings::PlanetaryRings(const glm::vec3& planetPosition, float planetRadi
     , instanceVBO_(0)
     , buffersInitialized_(false)
 {
-    loadPlanetaryRingsOpenGLFunctions();
     generateRingParticles();
     spdlog::info("Created planetary rings: inner={:.1f}, outer={:.1f}, particles={}", 
                  innerRadius_, outerRadius_, particleCount_);
 }
 
+PlanetaryRings::PlanetaryRings(const glm::vec3& planetPosition, float planetRadius,
+                               float innerRadius, float outerRadius, std::vector<RingParticle> particles, int seed)
+    : planetPosition_(planetPosition)
+    , planetRadius_(planetRadius)
+    , innerRadius_(innerRadius)
+    , outerRadius_(outerRadius)
+    , particleCount_(static_cast<int>(particles.size()))
+    , baseParticleCount_(static_cast<int>(particles.size()))
+    , seed_(seed)
+    , visible_(true)
+    , orbitSpeedMultiplier_(1.0f)
+    , opacityMultiplier_(1.0f)
+    , maxRenderDistance_(2000.0f)
+    , particles_(std::move(particles))
+    , VAO_(0)
+    , VBO_(0)
+    , instanceVBO_(0)
+    , buffersInitialized_(false)
+{
+    spdlog::info("Restored planetary rings: inner={:.1f}, outer={:.1f}, particles={}", 
+                 innerRadius_, outerRadius_, particleCount_);
+}
+
 PlanetaryRings::~PlanetaryRings() {
     cleanupBuffers();
 }
@@ -234,31 +168,31 @@ void PlanetaryRings::setupRenderingBuffers() {
     };
 
     unsigned int EBO;
-    glGenVertexArrays(1, &VAO_);
-    glGenBuffers(1, &VBO_);
-    glGenBuffers(1, &EBO);
-    glGenBuffers(1, &instanceVBO_);
+    gl.GenVertexArrays(1, &VAO_);
+    gl.GenBuffers(1, &VBO_);
+    gl.GenBuffers(1, &EBO);
+    gl.GenBuffers(1, &instanceVBO_);
 
-    glBindVertexArray(VAO_);
+    gl.BindVertexArray(VAO_);
 
     // Vertex buffer
-    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+    gl.BindBuffer(GL_ARRAY_BUFFER, VBO_);
+    gl.BufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
 
     // Element buffer
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    gl.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    gl.BufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
 
     // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    gl.VertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    gl.EnableVertexAttribArray(0);
 
     // Texture coordinate attribute
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    gl.VertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+    gl.EnableVertexAttribArray(1);
 
     // Instance data will be set up during rendering
-    glBindVertexArray(0);
+    gl.BindVertexArray(0);
 
     buffersInitialized_ = true;
     spdlog::debug("Initialized planetary rings rendering buffers");
@@ -266,9 +200,9 @@ void PlanetaryRings::setupRenderingBuffers() {
 
 void PlanetaryRings::cleanupBuffers() {
     if (buffersInitialized_) {
-        glDeleteVertexArrays(1, &VAO_);
-        glDeleteBuffers(1, &VBO_);
-        glDeleteBuffers(1, &instanceVBO_);
+        gl.DeleteVertexArrays(1, &VAO_);
+        gl.DeleteBuffers(1, &VBO_);
+        gl.DeleteBuffers(1, &instanceVBO_);
         VAO_ = VBO_ = instanceVBO_ = 0;
         buffersInitialized_ = false;
     }
@@ -276,7 +210,8 @@ void PlanetaryRings::cleanupBuffers() {
 
 void PlanetaryRings::render(Shader* shader, const Camera* camera, const glm::mat4& view, 
                            const glm::mat4& projection, const glm::vec3& lightPos, 
-                           const glm::vec3& lightColor, const glm::vec3& viewPos) {
+                           const glm::vec3& lightColor, const glm::vec3& viewPos,
+                           const ClusteredLighting* lights) {
     if (!visible_ || !shader || !camera || !buffersInitialized_ || particles_.empty()) {
         return;
     }
@@ -290,9 +225,9 @@ void PlanetaryRings::render(Shader* shader, const Camera* camera, const glm::mat
     }
 
     // Enable blending for transparency
-    glEnable_(GL_BLEND);
-    glBlendFunc_(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask_(GL_FALSE); // Don't write to depth buffer for transparent objects
+    gl.Enable(GL_BLEND);
+    gl.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    gl.DepthMask(GL_FALSE); // Don't write to depth buffer for transparent objects
 
     shader->use();
     shader->setMat4("view", view);
@@ -300,8 +235,11 @@ void PlanetaryRings::render(Shader* shader, const Camera* camera, const glm::mat
     shader->setVec3("lightPos", lightPos);
     shader->setVec3("lightColor", lightColor);
     shader->setVec3("viewPos", viewPos);
+    if (lights) {
+        lights->setUniforms(shader);
+    }
 
-    glBindVertexArray(VAO_);
+    gl.BindVertexArray(VAO_);
 
     int particlesRendered = 0;
     for (const auto& particle : particles_) {
@@ -330,16 +268,17 @@ void PlanetaryRings::render(Shader* shader, const Camera* camera, const glm::mat
         shader->setFloat("alpha", particle.alpha * opacityMultiplier_);
 
         // Render particle
-        glDrawElements_(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        gl.DrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        RenderStats::addDraw(2);
         particlesRendered++;
     }
 
-    glBindVertexArray(0);
+    gl.BindVertexArray(0);
     shader->unuse();
 
     // Restore depth writing
-    glDepthMask_(GL_TRUE);
-    glDisable_(GL_BLEND);
+    gl.DepthMask(GL_TRUE);
+    gl.Disable(GL_BLEND);
 
     // Log rendering stats occasionally
     static int frameCount = 0;
@@ -352,7 +291,7 @@ void PlanetaryRings::setDensity(float density) {
     // Clamp density between 0.1 and 3.0
     density = std::clamp(density, 0.1f, 3.0f);
     
-    int newCount = static_cast<int>(particleCount_ * density);
+    int newCount = static_cast<int>(baseParticleCount_ * density);
     if (newCount != static_cast<int>(particles_.size())) {
         particleCount_ = newCount;
         generateRingParticles();
@@ -4,24 +4,18 @@
 #include <memory>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include "SceneRecords.hpp"
 
 class Shader;
 class Camera;
-
-struct RingParticle {
-    glm::vec3 position;
-    float orbitRadius;
-    float orbitAngle;
-    float orbitSpeed;
-    float size;
-    glm::vec3 color;
-    float alpha;
-};
+class ClusteredLighting;
 
 class PlanetaryRings {
 public:
     PlanetaryRings(const glm::vec3& planetPosition, float planetRadius, 
                    float innerRadius, float outerRadius, int particleCount, int seed = 0);
+    PlanetaryRings(const glm::vec3& planetPosition, float planetRadius, 
+                   float innerRadius, float outerRadius, std::vector<RingParticle> particles, int seed = 0);
     ~PlanetaryRings();
 
     // Non-copyable, non-movable
@@ -34,13 +28,17 @@ public:
     void update(float deltaTime);
     void render(Shader* shader, const Camera* camera, const glm::mat4& view, 
                 const glm::mat4& projection, const glm::vec3& lightPos, 
-                const glm::vec3& lightColor, const glm::vec3& viewPos);
+                const glm::vec3& lightColor, const glm::vec3& viewPos,
+                const ClusteredLighting* lights = nullptr);
 
     // Getters
     const glm::vec3& getPlanetPosition() const { return planetPosition_; }
     float getInnerRadius() const { return innerRadius_; }
     float getOuterRadius() const { return outerRadius_; }
     int getParticleCount() const { return particles_.size(); }
+    float getPlanetRadius() const { return planetRadius_; }
+    int getSeed() const { return seed_; }
+    const std::vector<RingParticle>& getParticles() const { return particles_; }
     bool isVisible() const { return visible_; }
 
     // Setters
@@ -61,6 +59,7 @@ private:
     float innerRadius_;
     float outerRadius_;
     int particleCount_;
+    int baseParticleCount_;  // Count at density 1.0
     int seed_;
     bool visible_;
     float orbitSpeedMultiplier_;
@@ -0,0 +1,382 @@
+#include "PngWriter.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// Deflate tables (RFC 1951, section 3.2.5)
+constexpr uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+constexpr uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+constexpr uint16_t DISTANCE_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+constexpr uint8_t DISTANCE_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+constexpr int WINDOW_SIZE = 32768;
+constexpr int MIN_MATCH = 3;
+constexpr int MAX_MATCH = 258;
+constexpr int MAX_CHAIN = 16;
+constexpr int HASH_BITS = 15;
+
+uint32_t reverseBits(uint32_t code, int length) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < length; ++i) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    return reversed;
+}
+
+/**
+ * @brief Fixed Huffman codes, pre-reversed for LSB-first output
+ */
+struct FixedCodes {
+    std::array<uint16_t, 288> literalCode{};
+    std::array<uint8_t, 288> literalLength{};
+    std::array<uint16_t, 30> distanceCode{};
+    std::array<uint8_t, 256> lengthSymbol{};     // Indexed by match length - 3
+    std::array<uint8_t, 512> distanceSymbol{};   // See distanceToSymbol()
+
+    FixedCodes() {
+        for (int symbol = 0; symbol < 288; ++symbol) {
+            uint32_t code;
+            int length;
+            if (symbol < 144) {
+                code = 0x30 + symbol;
+                length = 8;
+            } else if (symbol < 256) {
+                code = 0x190 + (symbol - 144);
+                length = 9;
+            } else if (symbol < 280) {
+                code = symbol - 256;
+                length = 7;
+            } else {
+                code = 0xC0 + (symbol - 280);
+                length = 8;
+            }
+            literalCode[symbol] = static_cast<uint16_t>(reverseBits(code, length));
+            literalLength[symbol] = static_cast<uint8_t>(length);
+        }
+        for (int symbol = 0; symbol < 30; ++symbol) {
+            distanceCode[symbol] = static_cast<uint16_t>(reverseBits(symbol, 5));
+        }
+
+        for (int length = MIN_MATCH; length <= MAX_MATCH; ++length) {
+            int symbol = 28;
+            while (LENGTH_BASE[symbol] > length) {
+                --symbol;
+            }
+            lengthSymbol[length - MIN_MATCH] = static_cast<uint8_t>(symbol);
+        }
+
+        // Distances 1..256 are looked up directly, larger ones by (distance - 1) >> 7
+        for (int i = 0; i < 512; ++i) {
+            int distance = i < 256 ? i + 1 : ((i - 256) << 7) + 1;
+            int symbol = 29;
+            while (DISTANCE_BASE[symbol] > distance) {
+                --symbol;
+            }
+            distanceSymbol[i] = static_cast<uint8_t>(symbol);
+        }
+    }
+
+    int distanceToSymbol(int distance) const {
+        return distance <= 256 ? distanceSymbol[distance - 1] : distanceSymbol[256 + ((distance - 1) >> 7)];
+    }
+};
+
+const FixedCodes& fixedCodes() {
+    static const FixedCodes codes;
+    return codes;
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    void write(uint32_t bits, int count) {
+        buffer_ |= static_cast<uint64_t>(bits) << count_;
+        count_ += count;
+        while (count_ >= 8) {
+            out_.push_back(static_cast<uint8_t>(buffer_));
+            buffer_ >>= 8;
+            count_ -= 8;
+        }
+    }
+
+    void flush() {
+        if (count_ > 0) {
+            out_.push_back(static_cast<uint8_t>(buffer_));
+        }
+        buffer_ = 0;
+        count_ = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint64_t buffer_ = 0;
+    int count_ = 0;
+};
+
+/**
+ * @brief Compress data as a single fixed-Huffman deflate block
+ */
+void deflateFixed(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+    const FixedCodes& codes = fixedCodes();
+    BitWriter bits(out);
+    bits.write(1, 1);  // BFINAL
+    bits.write(1, 2);  // BTYPE = fixed Huffman
+
+    auto writeLiteral = [&](int symbol) {
+        bits.write(codes.literalCode[symbol], codes.literalLength[symbol]);
+    };
+
+    std::vector<int32_t> head(size_t(1) << HASH_BITS, -1);
+    std::vector<int32_t> previous(WINDOW_SIZE, -1);
+    auto hashAt = [&](size_t pos) {
+        uint32_t value = data[pos] | (data[pos + 1] << 8) | (data[pos + 2] << 16);
+        return (value * 2654435761u) >> (32 - HASH_BITS);
+    };
+    auto insert = [&](size_t pos) {
+        uint32_t hash = hashAt(pos);
+        previous[pos & (WINDOW_SIZE - 1)] = head[hash];
+        head[hash] = static_cast<int32_t>(pos);
+    };
+
+    size_t pos = 0;
+    while (pos < size) {
+        int bestLength = 0;
+        int bestDistance = 0;
+
+        if (pos + MIN_MATCH <= size) {
+            int maxLength = static_cast<int>(std::min<size_t>(MAX_MATCH, size - pos));
+            int32_t candidate = head[hashAt(pos)];
+            for (int chain = 0; chain < MAX_CHAIN && candidate >= 0; ++chain) {
+                int distance = static_cast<int>(pos - static_cast<size_t>(candidate));
+                if (distance > WINDOW_SIZE - 1) {
+                    break;
+                }
+                if (data[candidate + bestLength] == data[pos + bestLength]) {
+                    int length = 0;
+                    while (length < maxLength && data[candidate + length] == data[pos + length]) {
+                        ++length;
+                    }
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = distance;
+                        if (length == maxLength) {
+                            break;
+                        }
+                    }
+                }
+                int32_t next = previous[candidate & (WINDOW_SIZE - 1)];
+                if (next >= candidate) {
+                    break;
+                }
+                candidate = next;
+            }
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            int lengthSymbol = codes.lengthSymbol[bestLength - MIN_MATCH];
+            writeLiteral(257 + lengthSymbol);
+            bits.write(bestLength - LENGTH_BASE[lengthSymbol], LENGTH_EXTRA[lengthSymbol]);
+
+            int distanceSymbol = codes.distanceToSymbol(bestDistance);
+            bits.write(codes.distanceCode[distanceSymbol], 5);
+            bits.write(bestDistance - DISTANCE_BASE[distanceSymbol], DISTANCE_EXTRA[distanceSymbol]);
+
+            size_t end = pos + bestLength;
+            for (; pos < end; ++pos) {
+                if (pos + MIN_MATCH <= size) {
+                    insert(pos);
+                }
+            }
+        } else {
+            writeLiteral(data[pos]);
+            if (pos + MIN_MATCH <= size) {
+                insert(pos);
+            }
+            ++pos;
+        }
+    }
+
+    writeLiteral(256);  // End of block
+    bits.flush();
+}
+
+uint32_t adler32(const uint8_t* data, size_t size) {
+    uint32_t a = 1;
+    uint32_t b = 0;
+    while (size > 0) {
+        // 5552 is the largest block that cannot overflow before the modulo
+        size_t block = std::min<size_t>(size, 5552);
+        size -= block;
+        while (block-- > 0) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    static const auto table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[n] = c;
+        }
+        return entries;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void appendBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void appendChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& payload) {
+    appendBigEndian(out, static_cast<uint32_t>(payload.size()));
+    size_t typeOffset = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), payload.begin(), payload.end());
+    appendBigEndian(out, crc32(out.data() + typeOffset, payload.size() + 4));
+}
+
+uint8_t paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return static_cast<uint8_t>(a);
+    }
+    return static_cast<uint8_t>(pb <= pc ? b : c);
+}
+
+/**
+ * @brief Filter every row, picking the filter with the smallest absolute sum
+ */
+void filterRows(const uint8_t* pixels, int width, int height, int channels, std::vector<uint8_t>& out) {
+    size_t stride = static_cast<size_t>(width) * channels;
+    out.resize((stride + 1) * height);
+
+    std::vector<uint8_t> candidates[5];
+    for (auto& candidate : candidates) {
+        candidate.resize(stride);
+    }
+    std::vector<uint8_t> zeroRow(stride, 0);
+
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* row = pixels + stride * y;
+        const uint8_t* above = y > 0 ? pixels + stride * (y - 1) : zeroRow.data();
+
+        for (size_t x = 0; x < stride; ++x) {
+            int left = x >= static_cast<size_t>(channels) ? row[x - channels] : 0;
+            int upLeft = x >= static_cast<size_t>(channels) ? above[x - channels] : 0;
+            candidates[0][x] = row[x];
+            candidates[1][x] = static_cast<uint8_t>(row[x] - left);
+            candidates[2][x] = static_cast<uint8_t>(row[x] - above[x]);
+            candidates[3][x] = static_cast<uint8_t>(row[x] - ((left + above[x]) >> 1));
+            candidates[4][x] = static_cast<uint8_t>(row[x] - paeth(left, above[x], upLeft));
+        }
+
+        int bestFilter = 0;
+        uint64_t bestScore = UINT64_MAX;
+        for (int filter = 0; filter < 5; ++filter) {
+            uint64_t score = 0;
+            for (uint8_t value : candidates[filter]) {
+                score += static_cast<uint64_t>(std::abs(static_cast<int8_t>(value)));
+            }
+            if (score < bestScore) {
+                bestScore = score;
+                bestFilter = filter;
+            }
+        }
+
+        uint8_t* target = out.data() + (stride + 1) * y;
+        target[0] = static_cast<uint8_t>(bestFilter);
+        std::memcpy(target + 1, candidates[bestFilter].data(), stride);
+    }
+}
+
+} // namespace
+
+bool PngWriter::encode(const uint8_t* pixels, int width, int height, int channels, std::vector<uint8_t>& out) {
+    if (!pixels || width <= 0 || height <= 0 || (channels != 3 && channels != 4)) {
+        return false;
+    }
+
+    std::vector<uint8_t> filtered;
+    filterRows(pixels, width, height, channels, filtered);
+
+    std::vector<uint8_t> compressed;
+    compressed.reserve(filtered.size() / 2);
+    compressed.push_back(0x78);  // zlib header: deflate, 32K window
+    compressed.push_back(0x01);  // fastest compression, no dictionary
+    deflateFixed(filtered.data(), filtered.size(), compressed);
+    appendBigEndian(compressed, adler32(filtered.data(), filtered.size()));
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.assign(signature, signature + sizeof(signature));
+
+    std::vector<uint8_t> header;
+    appendBigEndian(header, static_cast<uint32_t>(width));
+    appendBigEndian(header, static_cast<uint32_t>(height));
+    header.push_back(8);                          // Bit depth
+    header.push_back(channels == 4 ? 6 : 2);      // Color type: RGBA or RGB
+    header.push_back(0);                          // Compression
+    header.push_back(0);                          // Filter method
+    header.push_back(0);                          // No interlace
+    appendChunk(out, "IHDR", header);
+    appendChunk(out, "IDAT", compressed);
+    appendChunk(out, "IEND", {});
+    return true;
+}
+
+bool PngWriter::write(const std::string& filename, const uint8_t* pixels, int width, int height, int channels) {
+    std::vector<uint8_t> png;
+    if (!encode(pixels, width, height, channels, png)) {
+        spdlog::error("Unsupported image for PNG output: {}x{}x{}", width, height, channels);
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        spdlog::error("Failed to open image for writing: {}", filename);
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+    if (!file.good()) {
+        spdlog::error("Failed to write image: {}", filename);
+        return false;
+    }
+    return true;
+}
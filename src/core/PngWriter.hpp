@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Minimal self-contained PNG encoder for 8-bit RGB and RGBA images
+ *
+ * Rows are filtered with the per-row minimum-sum heuristic and compressed
+ * with a single fixed-Huffman deflate block using greedy hash-chain LZ77
+ * matching. That is well short of zlib's best ratio but several times faster,
+ * which is the right trade for bulk thumbnail output. Stateless and safe to
+ * call from several threads at once.
+ */
+class PngWriter {
+public:
+    /**
+     * @brief Encode an image
+     * @param pixels Tightly packed rows, top row first
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param channels 3 for RGB, 4 for RGBA
+     * @param out Receives the PNG file contents
+     * @return true on success, false for unsupported parameters
+     */
+    static bool encode(const uint8_t* pixels, int width, int height, int channels, std::vector<uint8_t>& out);
+
+    /**
+     * @brief Encode an image and write it to disk
+     * @param filename Output path
+     * @param pixels Tightly packed rows, top row first
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param channels 3 for RGB, 4 for RGBA
+     * @return true if the file was written
+     */
+    static bool write(const std::string& filename, const uint8_t* pixels, int width, int height, int channels);
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Per-frame rendering counters
+ *
+ * The draw paths bump these on the render thread; the application reads and
+ * resets them once per frame with takeFrame(). Counting costs a couple of
+ * integer adds per draw call, so it is always enabled.
+ */
+class RenderStats {
+public:
+    struct Counters {
+        uint64_t drawCalls = 0;
+        uint64_t triangles = 0;
+        uint64_t lodRebuilds = 0;
+        uint64_t glCalls = 0;      // Filled in from GLApi when call counting is enabled
+        uint64_t uploadBytes = 0;
+    };
+
+    /**
+     * @brief Count one draw call
+     * @param triangles Number of triangles submitted
+     */
+    static void addDraw(uint64_t triangles) {
+        Counters& counters = current();
+        ++counters.drawCalls;
+        counters.triangles += triangles;
+    }
+
+    /**
+     * @brief Count one mesh rebuild caused by a level-of-detail change
+     */
+    static void addLODRebuild() {
+        ++current().lodRebuilds;
+    }
+
+    /**
+     * @brief Get the counters of the frame so far and start a new frame
+     * @return Counters Totals since the previous call
+     */
+    static Counters takeFrame() {
+        Counters counters = current();
+        current() = Counters{};
+        return counters;
+    }
+
+private:
+    static Counters& current() {
+        static Counters counters;
+        return counters;
+    }
+};
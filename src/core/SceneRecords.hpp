@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+/*
+ * Plain records of a generated solar system. Generation fills them, snapshots
+ * store them as flat arrays and the renderers upload them, so they live in
+ * astralis_core and must stay trivially copyable.
+ */
+
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texCoords;
+
+    Vertex(const glm::vec3& pos, const glm::vec3& norm = glm::vec3(0.0f), const glm::vec2& tex = glm::vec2(0.0f))
+        : position(pos), normal(norm), texCoords(tex) {}
+};
+
+struct Asteroid {
+    glm::vec3 position;
+    glm::vec3 rotation;
+    glm::vec3 rotationSpeed;
+    float scale;
+    float orbitRadius;
+    float orbitAngle;
+    float orbitSpeed;
+    glm::vec3 color;
+};
+
+struct RingParticle {
+    glm::vec3 position;
+    float orbitRadius;
+    float orbitAngle;
+    float orbitSpeed;
+    float size;
+    glm::vec3 color;
+    float alpha;
+};
+
+enum class ParticleType {
+    SOLAR_FLARE,
+    COSMIC_DUST,
+    STELLAR_WIND,
+    CORONA_PARTICLES
+};
+
+struct Particle {
+    glm::vec3 position;
+    glm::vec3 velocity;
+    glm::vec3 acceleration;
+    glm::vec3 color;
+    float size;
+    float life;
+    float maxLife;
+    float alpha;
+    float temperature;
+    ParticleType type;
+
+    // Solar flare specific properties
+    float intensity;
+    float magneticField;
+
+    // Cosmic dust specific properties
+    float density;
+    float reflectivity;
+};
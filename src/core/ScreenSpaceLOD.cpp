@@ -0,0 +1,138 @@
+#include "ScreenSpaceLOD.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+
+} // namespace
+
+ScreenSpaceLOD::Level ScreenSpaceLOD::cubeSphereLevel(int resolution) {
+    const int segments = std::max(resolution - 1, 1);
+    // Each face spans a quarter of a great circle
+    return {resolution, static_cast<uint32_t>(6 * 2 * segments * segments), 0.5f * PI / segments};
+}
+
+ScreenSpaceLOD::Level ScreenSpaceLOD::uvSphereLevel(int latSegments, int lonSegments) {
+    latSegments = std::max(latSegments, 1);
+    lonSegments = std::max(lonSegments, 1);
+    return {latSegments, static_cast<uint32_t>(2 * latSegments * lonSegments),
+            std::max(PI / latSegments, 2.0f * PI / lonSegments)};
+}
+
+void ScreenSpaceLOD::beginFrame(const glm::mat4& view, const glm::mat4& projection, int viewportHeight) {
+    view_ = view;
+    nearPlane_ = projection[3][2] / (projection[2][2] - 1.0f);
+    // projection[1][1] is cot(fovy / 2), the half viewport height at unit depth
+    pixelsPerUnit_ = projection[1][1] * 0.5f * static_cast<float>(std::max(viewportHeight, 1));
+
+    // Frustum planes from the rows of the projection (Gribb-Hartmann)
+    auto row = [&projection](int i) {
+        return glm::vec4(projection[0][i], projection[1][i], projection[2][i], projection[3][i]);
+    };
+    planes_ = {row(3) + row(0), row(3) - row(0), row(3) + row(1),
+               row(3) - row(1), row(3) + row(2), row(3) - row(2)};
+    for (glm::vec4& plane : planes_) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+
+    requests_.clear();
+    triangleCount_ = 0;
+    coarsenedCount_ = 0;
+}
+
+size_t ScreenSpaceLOD::request(const glm::vec3& center, float radius, const std::vector<Level>& levels,
+                               int currentLevel, bool cullable) {
+    Request request{&levels, 0.0f, CULLED, cullable};
+    const glm::vec3 viewCenter = glm::vec3(view_ * glm::vec4(center, 1.0f));
+
+    bool visible = true;
+    for (const glm::vec4& plane : planes_) {
+        if (glm::dot(glm::vec3(plane), viewCenter) + plane.w < -radius) {
+            visible = false;
+            break;
+        }
+    }
+
+    if (levels.empty() || (!visible && cullable)) {
+        requests_.push_back(request);
+        return requests_.size() - 1;
+    }
+
+    const float surfaceDistance = std::max(glm::length(viewCenter) - radius, nearPlane_);
+    request.pixelRadius = radius * pixelsPerUnit_ / surfaceDistance;
+    const int finest = static_cast<int>(levels.size()) - 1;
+
+    if (!visible && currentLevel >= 0 && currentLevel <= finest) {
+        // Off-screen objects keep what they have, so turning around does not rebuild them
+        request.level = currentLevel;
+    } else if (!cullable || 2.0f * request.pixelRadius >= MIN_CULL_PIXELS) {
+        // Coarsest level within the target; switching down to a coarser level than the
+        // current one needs some margin so objects near a threshold do not rebuild every frame
+        request.level = finest;
+        for (int level = 0; level < finest; ++level) {
+            float threshold = targetError_;
+            if (currentLevel >= 0 && level < currentLevel) {
+                threshold *= COARSEN_HYSTERESIS;
+            }
+            if (getError(request, level) <= threshold) {
+                request.level = level;
+                break;
+            }
+        }
+    }
+
+    requests_.push_back(request);
+    return requests_.size() - 1;
+}
+
+void ScreenSpaceLOD::resolve() {
+    triangleCount_ = 0;
+    coarsenedCount_ = 0;
+    for (const Request& request : requests_) {
+        triangleCount_ += getTriangles(request, request.level);
+    }
+    if (triangleCount_ <= triangleBudget_) {
+        return;
+    }
+
+    // Min-heap of (error after the next coarsening step, request)
+    using Candidate = std::pair<float, size_t>;
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+    auto pushCandidate = [&](size_t index) {
+        const Request& request = requests_[index];
+        const int coarser = request.level - 1;
+        if (request.level != CULLED && (coarser >= 0 || request.cullable)) {
+            candidates.emplace(getError(request, coarser), index);
+        }
+    };
+    for (size_t i = 0; i < requests_.size(); ++i) {
+        pushCandidate(i);
+    }
+
+    while (triangleCount_ > triangleBudget_ && !candidates.empty()) {
+        const size_t index = candidates.top().second;
+        candidates.pop();
+
+        Request& request = requests_[index];
+        triangleCount_ -= getTriangles(request, request.level) - getTriangles(request, request.level - 1);
+        --request.level;
+        ++coarsenedCount_;
+        pushCandidate(index);
+    }
+}
+
+float ScreenSpaceLOD::getError(const Request& request, int level) const {
+    if (level == CULLED) {
+        return 2.0f * request.pixelRadius;
+    }
+    return (*request.levels)[static_cast<size_t>(level)].edgeLength * request.pixelRadius;
+}
+
+uint32_t ScreenSpaceLOD::getTriangles(const Request& request, int level) {
+    return level == CULLED ? 0u : (*request.levels)[static_cast<size_t>(level)].triangles;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Per-frame level-of-detail selection from projected screen-space error
+ *
+ * Every object of a frame requests one of its meshes. The screen-space error
+ * of a mesh is its typical triangle edge projected at the object's nearest
+ * surface point, in pixels, so the field of view and the viewport height
+ * drive the choice rather than raw distance. Each object starts at the
+ * coarsest mesh within the target error; if the frame then exceeds the
+ * triangle budget, the objects whose next coarser mesh adds the least error
+ * are coarsened until it fits.
+ *
+ * Level lists are ordered from coarsest to finest and must outlive resolve().
+ */
+class ScreenSpaceLOD {
+public:
+    /**
+     * @brief One selectable mesh of an object
+     */
+    struct Level {
+        int resolution;     // Mesh parameter the owner builds this level with
+        uint32_t triangles;
+        float edgeLength;   // Typical triangle edge in object radii
+    };
+
+    static constexpr int CULLED = -1;                    ///< Level of a cullable object that is not drawn
+    static constexpr size_t NO_REQUEST = SIZE_MAX;       ///< Request index of an object that was skipped
+    static constexpr float COARSEN_HYSTERESIS = 0.75f;   ///< Error fraction a coarser level needs to replace the current one
+    static constexpr float MIN_CULL_PIXELS = 1.0f;       ///< Cullable objects smaller than this diameter are dropped
+
+    /**
+     * @brief Describe a cube-sphere mesh (see Planet) as a level
+     * @param resolution Vertices per face edge
+     * @return Level Triangle count and edge length of the mesh
+     */
+    static Level cubeSphereLevel(int resolution);
+
+    /**
+     * @brief Describe a UV-sphere mesh (see Geometry::createSphere) as a level
+     * @param latSegments Latitude segments
+     * @param lonSegments Longitude segments
+     * @return Level Triangle count and edge length of the mesh
+     */
+    static Level uvSphereLevel(int latSegments, int lonSegments);
+
+    ScreenSpaceLOD() = default;
+
+    /**
+     * @brief Start a new frame and drop the requests of the previous one
+     * @param view View matrix
+     * @param projection Perspective projection matrix
+     * @param viewportHeight Height of the render target in pixels
+     */
+    void beginFrame(const glm::mat4& view, const glm::mat4& projection, int viewportHeight);
+
+    /**
+     * @brief Request a level for a sphere-bounded object
+     * @param center World-space center
+     * @param radius World-space radius
+     * @param levels Selectable meshes, coarsest first
+     * @param currentLevel Level currently built, or -1 if switching is free
+     * @param cullable True if the object may be dropped when tiny or outside the view
+     * @return size_t Request index for getLevel()
+     */
+    size_t request(const glm::vec3& center, float radius, const std::vector<Level>& levels,
+                   int currentLevel = -1, bool cullable = false);
+
+    /**
+     * @brief Coarsen the requested levels until the frame fits the triangle budget
+     */
+    void resolve();
+
+    /**
+     * @brief Get the level chosen for a request
+     * @param request Request index
+     * @return int Index into the request's levels, or CULLED
+     */
+    int getLevel(size_t request) const { return requests_[request].level; }
+
+    void setTargetError(float pixels) { targetError_ = pixels; }
+    float getTargetError() const { return targetError_; }
+    void setTriangleBudget(uint64_t triangles) { triangleBudget_ = triangles; }
+    uint64_t getTriangleBudget() const { return triangleBudget_; }
+
+    size_t getRequestCount() const { return requests_.size(); }
+    uint64_t getTriangleCount() const { return triangleCount_; }
+    size_t getCoarsenedCount() const { return coarsenedCount_; }
+
+private:
+    struct Request {
+        const std::vector<Level>* levels;
+        float pixelRadius; // Projected radius at the nearest surface point
+        int level;
+        bool cullable;
+    };
+
+    float getError(const Request& request, int level) const;
+    static uint32_t getTriangles(const Request& request, int level);
+
+    glm::mat4 view_{1.0f};
+    std::array<glm::vec4, 6> planes_{}; // View-space frustum planes, pointing inward
+    float nearPlane_ = 0.1f;
+    float pixelsPerUnit_ = 1.0f;        // Pixels spanned by one unit at unit depth
+
+    float targetError_ = 6.0f;
+    uint64_t triangleBudget_ = 1500000;
+
+    std::vector<Request> requests_;
+    uint64_t triangleCount_ = 0;
+    size_t coarsenedCount_ = 0;
+};
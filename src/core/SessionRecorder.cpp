@@ -0,0 +1,367 @@
+#include "SessionRecorder.hpp"
+#include "MappedFile.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+struct SessionFileHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t reserved;
+    uint64_t starSeed;
+    int32_t systemSeed;
+    int32_t planetCount;
+};
+
+constexpr char SESSION_MAGIC[8] = {'A', 'S', 'T', 'R', 'S', 'E', 'S', 'S'};
+constexpr uint8_t FRAME_TAG = 0xF1;
+constexpr uint8_t MOUSE_MOVED = 1;
+constexpr size_t FLUSH_THRESHOLD = 64 * 1024;
+constexpr size_t MAX_ACTION_TEXT = 1 << 20;
+
+void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void writeSigned(std::vector<uint8_t>& out, int64_t value) {
+    // Zigzag so small negative values (e.g. GLFW_KEY_UNKNOWN) stay short
+    writeVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+template <typename T>
+void writeRaw(std::vector<uint8_t>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+using StateList = std::vector<std::pair<int, Core::KeyState>>;
+
+/**
+ * @brief Write the entries of current that differ from previous
+ *
+ * Both lists are sorted by key; entries missing from current are written as
+ * Released.
+ */
+void writeStateChanges(std::vector<uint8_t>& out, const StateList& previous, const StateList& current) {
+    StateList changes;
+    auto prev = previous.begin();
+    auto cur = current.begin();
+    while (prev != previous.end() || cur != current.end()) {
+        if (cur == current.end() || (prev != previous.end() && prev->first < cur->first)) {
+            changes.emplace_back(prev->first, Core::KeyState::Released);
+            ++prev;
+        } else if (prev == previous.end() || cur->first < prev->first) {
+            changes.push_back(*cur);
+            ++cur;
+        } else {
+            if (prev->second != cur->second) {
+                changes.push_back(*cur);
+            }
+            ++prev;
+            ++cur;
+        }
+    }
+
+    writeVarint(out, changes.size());
+    for (const auto& [key, state] : changes) {
+        writeSigned(out, key);
+        out.push_back(static_cast<uint8_t>(state));
+    }
+}
+
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size, size_t position)
+        : data_(data)
+        , size_(size)
+        , position_(position) {
+    }
+
+    size_t position() const { return position_; }
+    bool atEnd() const { return position_ >= size_; }
+
+    bool readByte(uint8_t& value) {
+        if (position_ >= size_) {
+            return false;
+        }
+        value = data_[position_++];
+        return true;
+    }
+
+    bool readVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte;
+            if (!readByte(byte)) {
+                return false;
+            }
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readSigned(int64_t& value) {
+        uint64_t encoded;
+        if (!readVarint(encoded)) {
+            return false;
+        }
+        value = static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+        return true;
+    }
+
+    template <typename T>
+    bool readRaw(T& value) {
+        if (size_ - position_ < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, data_ + position_, sizeof(T));
+        position_ += sizeof(T);
+        return true;
+    }
+
+    bool readBytes(std::string& value, size_t length) {
+        if (size_ - position_ < length) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data_ + position_), length);
+        position_ += length;
+        return true;
+    }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t position_;
+};
+
+bool readStateChanges(ByteReader& reader, StateList& state) {
+    uint64_t count;
+    if (!reader.readVarint(count)) {
+        return false;
+    }
+
+    for (uint64_t i = 0; i < count; ++i) {
+        int64_t key;
+        uint8_t value;
+        if (!reader.readSigned(key) || !reader.readByte(value) ||
+            value > static_cast<uint8_t>(Core::KeyState::Held)) {
+            return false;
+        }
+
+        auto keyState = static_cast<Core::KeyState>(value);
+        auto it = std::lower_bound(state.begin(), state.end(), static_cast<int>(key),
+            [](const auto& entry, int k) { return entry.first < k; });
+        bool found = it != state.end() && it->first == key;
+
+        if (keyState == Core::KeyState::Released) {
+            if (found) {
+                state.erase(it);
+            }
+        } else if (found) {
+            it->second = keyState;
+        } else {
+            state.emplace(it, static_cast<int>(key), keyState);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+// SessionRecorder
+
+SessionRecorder::~SessionRecorder() {
+    close();
+}
+
+bool SessionRecorder::open(const std::string& filename, const SessionHeader& header) {
+    close();
+
+    file_.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        spdlog::error("Failed to create session log: {}", filename);
+        return false;
+    }
+
+    SessionFileHeader fileHeader{};
+    std::memcpy(fileHeader.magic, SESSION_MAGIC, sizeof(SESSION_MAGIC));
+    fileHeader.formatVersion = FORMAT_VERSION;
+    fileHeader.starSeed = header.starSeed;
+    fileHeader.systemSeed = header.systemSeed;
+    fileHeader.planetCount = header.planetCount;
+    file_.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+
+    filename_ = filename;
+    buffer_.clear();
+    buffer_.reserve(FLUSH_THRESHOLD + 4096);
+    previousInput_ = Core::InputSnapshot{};
+    frameCount_ = 0;
+
+    spdlog::info("Recording session to: {}", filename);
+    return true;
+}
+
+void SessionRecorder::recordFrame(const SessionFrame& frame) {
+    if (!file_.is_open()) {
+        return;
+    }
+
+    buffer_.push_back(FRAME_TAG);
+    writeRaw(buffer_, frame.deltaTime);
+
+    writeStateChanges(buffer_, previousInput_.keys, frame.input.keys);
+    writeStateChanges(buffer_, previousInput_.mouseButtons, frame.input.mouseButtons);
+
+    const auto& position = frame.input.mousePosition;
+    if (frameCount_ == 0 ||
+        position.x != previousInput_.mousePosition.x ||
+        position.y != previousInput_.mousePosition.y) {
+        buffer_.push_back(MOUSE_MOVED);
+        writeRaw(buffer_, position.x);
+        writeRaw(buffer_, position.y);
+    } else {
+        buffer_.push_back(0);
+    }
+
+    writeVarint(buffer_, frame.actions.size());
+    for (const auto& action : frame.actions) {
+        buffer_.push_back(static_cast<uint8_t>(action.type));
+        writeSigned(buffer_, action.intValue);
+        writeSigned(buffer_, action.intValue2);
+        writeRaw(buffer_, action.floatValue);
+        writeVarint(buffer_, action.text.size());
+        buffer_.insert(buffer_.end(), action.text.begin(), action.text.end());
+    }
+
+    previousInput_ = frame.input;
+    ++frameCount_;
+
+    if (buffer_.size() >= FLUSH_THRESHOLD) {
+        flushBuffer();
+    }
+}
+
+void SessionRecorder::close() {
+    if (!file_.is_open()) {
+        return;
+    }
+
+    flushBuffer();
+    file_.close();
+    spdlog::info("Session log {} closed after {} frames", filename_, frameCount_);
+}
+
+void SessionRecorder::flushBuffer() {
+    if (buffer_.empty()) {
+        return;
+    }
+
+    file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    if (!file_.good()) {
+        spdlog::error("Failed to write session log: {}", filename_);
+    }
+    buffer_.clear();
+}
+
+// SessionPlayer
+
+SessionPlayer::SessionPlayer()
+    : file_(std::make_unique<MappedFile>()) {
+}
+
+SessionPlayer::~SessionPlayer() = default;
+
+bool SessionPlayer::open(const std::string& filename) {
+    if (!file_->open(filename)) {
+        spdlog::error("Failed to open session log: {}", filename);
+        return false;
+    }
+
+    SessionFileHeader fileHeader;
+    if (file_->size() < sizeof(fileHeader)) {
+        spdlog::error("Session log is truncated: {}", filename);
+        file_->close();
+        return false;
+    }
+    std::memcpy(&fileHeader, file_->data(), sizeof(fileHeader));
+
+    if (std::memcmp(fileHeader.magic, SESSION_MAGIC, sizeof(SESSION_MAGIC)) != 0 ||
+        fileHeader.formatVersion != SessionRecorder::FORMAT_VERSION) {
+        spdlog::error("Not a session log or unsupported version: {}", filename);
+        file_->close();
+        return false;
+    }
+
+    header_.starSeed = fileHeader.starSeed;
+    header_.systemSeed = fileHeader.systemSeed;
+    header_.planetCount = fileHeader.planetCount;
+    position_ = sizeof(fileHeader);
+    frameIndex_ = 0;
+    currentInput_ = Core::InputSnapshot{};
+
+    spdlog::info("Replaying session from: {} ({} bytes)", filename, file_->size());
+    return true;
+}
+
+bool SessionPlayer::nextFrame(SessionFrame& frame) {
+    if (!file_->isOpen()) {
+        return false;
+    }
+
+    ByteReader reader(file_->data(), file_->size(), position_);
+    if (reader.atEnd()) {
+        return false;
+    }
+
+    uint8_t tag;
+    uint8_t mouseFlag;
+    uint64_t actionCount;
+    if (!reader.readByte(tag) || tag != FRAME_TAG ||
+        !reader.readRaw(frame.deltaTime) ||
+        !readStateChanges(reader, currentInput_.keys) ||
+        !readStateChanges(reader, currentInput_.mouseButtons) ||
+        !reader.readByte(mouseFlag) ||
+        (mouseFlag == MOUSE_MOVED &&
+         (!reader.readRaw(currentInput_.mousePosition.x) || !reader.readRaw(currentInput_.mousePosition.y))) ||
+        !reader.readVarint(actionCount)) {
+        spdlog::warn("Session log is corrupt at frame {}, stopping replay", frameIndex_);
+        return false;
+    }
+
+    frame.actions.clear();
+    for (uint64_t i = 0; i < actionCount; ++i) {
+        SessionAction action;
+        uint8_t type;
+        int64_t intValue;
+        int64_t intValue2;
+        uint64_t textLength;
+        if (!reader.readByte(type) ||
+            !reader.readSigned(intValue) ||
+            !reader.readSigned(intValue2) ||
+            !reader.readRaw(action.floatValue) ||
+            !reader.readVarint(textLength) ||
+            textLength > MAX_ACTION_TEXT ||
+            !reader.readBytes(action.text, static_cast<size_t>(textLength))) {
+            spdlog::warn("Session log is corrupt at frame {}, stopping replay", frameIndex_);
+            return false;
+        }
+        action.type = static_cast<SessionAction::Type>(type);
+        action.intValue = static_cast<int32_t>(intValue);
+        action.intValue2 = static_cast<int32_t>(intValue2);
+        frame.actions.push_back(std::move(action));
+    }
+
+    frame.input = currentInput_;
+    position_ = reader.position();
+    ++frameIndex_;
+    return true;
+}
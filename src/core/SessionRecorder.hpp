@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "InputManager.hpp"
+
+class MappedFile;
+
+/**
+ * @brief UI-level state change captured in a session log
+ *
+ * Actions are recorded with their resolved values (e.g. the seed picked by
+ * "Random System"), so replaying them never depends on wall-clock time or
+ * other non-deterministic input.
+ */
+struct SessionAction {
+    enum class Type : uint8_t {
+        Regenerate = 1,          // intValue = seed, intValue2 = planet count
+        SetAsteroidsVisible,     // intValue = visible
+        SetRingsVisible,         // intValue = visible
+        SetParticlesVisible,     // intValue = visible
+        SetAsteroidDensity,      // floatValue = density
+        SetRingDensity,          // floatValue = density
+        SetEmissionRate,         // floatValue = emission rate multiplier
+        SetCameraMode,           // intValue = Camera::Mode
+        SetMaxRenderDistance,    // floatValue = distance
+        ApplyConfig,             // text = full configuration JSON
+        SetMovementSpeed,        // floatValue = speed
+        SetMouseSensitivity,     // floatValue = sensitivity
+        SetMotionBlur,           // intValue = enabled
+        SetOrbitDistance,        // floatValue = distance
+        SetOrbitSpeed,           // floatValue = speed
+        CameraCommand            // intValue = CameraCommand, intValue2 = planet index
+    };
+
+    enum class CameraCommand : int32_t {
+        Reset = 0,
+        SystemTour,
+        ToggleQuickTour,
+        FocusSun,
+        OrbitSun,
+        TargetSun,
+        TargetPlanet,
+        GoToPlanet
+    };
+
+    Type type = Type::Regenerate;
+    int32_t intValue = 0;
+    int32_t intValue2 = 0;
+    float floatValue = 0.0f;
+    std::string text;
+
+    static SessionAction withInts(Type type, int32_t value, int32_t value2 = 0) {
+        SessionAction action;
+        action.type = type;
+        action.intValue = value;
+        action.intValue2 = value2;
+        return action;
+    }
+
+    static SessionAction withFloat(Type type, float value) {
+        SessionAction action;
+        action.type = type;
+        action.floatValue = value;
+        return action;
+    }
+
+    static SessionAction withText(Type type, std::string value) {
+        SessionAction action;
+        action.type = type;
+        action.text = std::move(value);
+        return action;
+    }
+};
+
+/**
+ * @brief Everything needed to reproduce one frame
+ */
+struct SessionFrame {
+    float deltaTime = 0.0f;
+    Core::InputSnapshot input;
+    std::vector<SessionAction> actions;
+};
+
+/**
+ * @brief Startup parameters stored in the session log header
+ */
+struct SessionHeader {
+    uint64_t starSeed = 0;
+    int32_t systemSeed = 0;
+    int32_t planetCount = 0;
+};
+
+/**
+ * @brief Writes a compact binary log of per-frame input and UI actions
+ *
+ * Key and mouse button states are stored as changes against the previous
+ * frame and the mouse position only when it moved, so an idle frame costs a
+ * handful of bytes. Output is buffered and written in large chunks.
+ */
+class SessionRecorder {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    SessionRecorder() = default;
+    ~SessionRecorder();
+
+    // Non-copyable, non-movable
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+    SessionRecorder(SessionRecorder&&) = delete;
+    SessionRecorder& operator=(SessionRecorder&&) = delete;
+
+    /**
+     * @brief Create the log file and write its header
+     * @param filename Path of the session log
+     * @param header Startup parameters needed to reproduce the session
+     * @return true if the file was created
+     */
+    bool open(const std::string& filename, const SessionHeader& header);
+
+    /**
+     * @brief Append one frame
+     * @param frame Frame delta time, input state and actions
+     */
+    void recordFrame(const SessionFrame& frame);
+
+    /**
+     * @brief Flush buffered frames and close the file
+     */
+    void close();
+
+    bool isOpen() const { return file_.is_open(); }
+    uint64_t getFrameCount() const { return frameCount_; }
+
+private:
+    void flushBuffer();
+
+    std::ofstream file_;
+    std::string filename_;
+    std::vector<uint8_t> buffer_;
+    Core::InputSnapshot previousInput_;
+    uint64_t frameCount_ = 0;
+};
+
+/**
+ * @brief Reads a session log written by SessionRecorder frame by frame
+ */
+class SessionPlayer {
+public:
+    SessionPlayer();
+    ~SessionPlayer();
+
+    // Non-copyable, non-movable
+    SessionPlayer(const SessionPlayer&) = delete;
+    SessionPlayer& operator=(const SessionPlayer&) = delete;
+    SessionPlayer(SessionPlayer&&) = delete;
+    SessionPlayer& operator=(SessionPlayer&&) = delete;
+
+    /**
+     * @brief Open a session log and validate its header
+     * @param filename Path of the session log
+     * @return true if the log can be replayed
+     */
+    bool open(const std::string& filename);
+
+    /**
+     * @brief Decode the next frame
+     * @param frame Receives the frame; its input is the full state, not a delta
+     * @return false at the end of the log or on a corrupt record
+     */
+    bool nextFrame(SessionFrame& frame);
+
+    const SessionHeader& getHeader() const { return header_; }
+    uint64_t getFrameIndex() const { return frameIndex_; }
+
+private:
+    std::unique_ptr<MappedFile> file_;
+    SessionHeader header_;
+    size_t position_ = 0;
+    uint64_t frameIndex_ = 0;
+    Core::InputSnapshot currentInput_;
+};
@@ -1,200 +1,265 @@
 #include "Shader.hpp"
+#include "GLApi.hpp"
+#include "ShaderCache.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 
-// Use GLFW's OpenGL loader
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
+namespace {
 
-// OpenGL types
-typedef unsigned int GLuint;
-typedef int GLint;
-typedef int GLsizei;
-typedef unsigned int GLenum;
-typedef unsigned char GLboolean;
-typedef float GLfloat;
-typedef char GLchar;
-
-// OpenGL constants
-#define GL_VERTEX_SHADER 0x8B31
-#define GL_FRAGMENT_SHADER 0x8B30
-#define GL_COMPILE_STATUS 0x8B81
-#define GL_LINK_STATUS 0x8B82
-#define GL_FALSE 0
-
-static GLuint(*glCreateShader)(GLenum) = nullptr;
-static void(*glShaderSource)(GLuint, GLsizei, const GLchar* const*, const GLint*) = nullptr;
-static void(*glCompileShader)(GLuint) = nullptr;
-static void(*glGetShaderiv)(GLuint, GLenum, GLint*) = nullptr;
-static void(*glGetShaderInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = nullptr;
-static void(*glDeleteShader)(GLuint) = nullptr;
-static GLuint(*glCreateProgram)() = nullptr;
-static void(*glAttachShader)(GLuint, GLuint) = nullptr;
-static void(*glLinkProgram)(GLuint) = nullptr;
-static void(*glGetProgramiv)(GLuint, GLenum, GLint*) = nullptr;
-static void(*glGetProgramInfoLog)(GLuint, GLsizei, GLsizei*, GLchar*) = nullptr;
-static void(*glDeleteProgram)(GLuint) = nullptr;
-static void(*glUseProgram)(GLuint) = nullptr;
-static GLint(*glGetUniformLocation)(GLuint, const GLchar*) = nullptr;
-static void(*glUniform1i)(GLint, GLint) = nullptr;
-static void(*glUniform1f)(GLint, GLfloat) = nullptr;
-static void(*glUniform3fv)(GLint, GLsizei, const GLfloat*) = nullptr;
-static void(*glUniform4fv)(GLint, GLsizei, const GLfloat*) = nullptr;
-static void(*glUniformMatrix4fv)(GLint, GLsizei, GLboolean, const GLfloat*) = nullptr;
+std::filesystem::file_time_type getWriteTime(const std::string& path) {
+    std::error_code error;
+    auto time = std::filesystem::last_write_time(path, error);
+    return error ? std::filesystem::file_time_type::min() : time;
+}
 
-static bool loadOpenGLFunctions() {
-    static bool loaded = false;
-    if (loaded) return true;
-    
-    glCreateShader = (GLuint(*)(GLenum))glfwGetProcAddress("glCreateShader");
-    glShaderSource = (void(*)(GLuint, GLsizei, const GLchar* const*, const GLint*))glfwGetProcAddress("glShaderSource");
-    glCompileShader = (void(*)(GLuint))glfwGetProcAddress("glCompileShader");
-    glGetShaderiv = (void(*)(GLuint, GLenum, GLint*))glfwGetProcAddress("glGetShaderiv");
-    glGetShaderInfoLog = (void(*)(GLuint, GLsizei, GLsizei*, GLchar*))glfwGetProcAddress("glGetShaderInfoLog");
-    glDeleteShader = (void(*)(GLuint))glfwGetProcAddress("glDeleteShader");
-    glCreateProgram = (GLuint(*)())glfwGetProcAddress("glCreateProgram");
-    glAttachShader = (void(*)(GLuint, GLuint))glfwGetProcAddress("glAttachShader");
-    glLinkProgram = (void(*)(GLuint))glfwGetProcAddress("glLinkProgram");
-    glGetProgramiv = (void(*)(GLuint, GLenum, GLint*))glfwGetProcAddress("glGetProgramiv");
-    glGetProgramInfoLog = (void(*)(GLuint, GLsizei, GLsizei*, GLchar*))glfwGetProcAddress("glGetProgramInfoLog");
-    glDeleteProgram = (void(*)(GLuint))glfwGetProcAddress("glDeleteProgram");
-    glUseProgram = (void(*)(GLuint))glfwGetProcAddress("glUseProgram");
-    glGetUniformLocation = (GLint(*)(GLuint, const GLchar*))glfwGetProcAddress("glGetUniformLocation");
-    glUniform1i = (void(*)(GLint, GLint))glfwGetProcAddress("glUniform1i");
-    glUniform1f = (void(*)(GLint, GLfloat))glfwGetProcAddress("glUniform1f");
-    glUniform3fv = (void(*)(GLint, GLsizei, const GLfloat*))glfwGetProcAddress("glUniform3fv");
-    glUniform4fv = (void(*)(GLint, GLsizei, const GLfloat*))glfwGetProcAddress("glUniform4fv");
-    glUniformMatrix4fv = (void(*)(GLint, GLsizei, GLboolean, const GLfloat*))glfwGetProcAddress("glUniformMatrix4fv");
-    
-    loaded = (glCreateShader && glShaderSource && glCompileShader && glGetShaderiv && 
-              glGetShaderInfoLog && glDeleteShader && glCreateProgram && glAttachShader && 
-              glLinkProgram && glGetProgramiv && glGetProgramInfoLog && glDeleteProgram && 
-              glUseProgram && glGetUniformLocation && glUniform1i && glUniform1f && 
-              glUniform3fv && glUniform4fv && glUniformMatrix4fv);
-    
-    return loaded;
+// Defines go right after #version, which must stay the first line; #line keeps error line numbers intact
+std::string injectDefines(const std::string& source, const std::vector<std::string>& defines) {
+    if (defines.empty() || source.empty()) {
+        return source;
+    }
+    size_t versionEnd = 0;
+    if (source.compare(0, 8, "#version") == 0) {
+        versionEnd = source.find('\n');
+        versionEnd = versionEnd == std::string::npos ? source.size() : versionEnd + 1;
+    }
+    std::string result = source.substr(0, versionEnd);
+    for (const auto& define : defines) {
+        result += "#define " + define + "\n";
+    }
+    result += "#line " + std::to_string(versionEnd > 0 ? 2 : 1) + "\n";
+    result += source.substr(versionEnd);
+    return result;
 }
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
-    : programId_(0) {
+} // namespace
+
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, ShaderCache* cache,
+               const std::vector<std::string>& defines)
+    : programId_(0)
+    , vertexShader_(0)
+    , fragmentShader_(0)
+    , pending_(false)
+    , parallel_(false)
+    , cache_(cache)
+    , cacheKey_(0)
+    , vertexPath_(vertexPath)
+    , fragmentPath_(fragmentPath)
+    , defines_(defines)
+    , vertexWriteTime_(getWriteTime(vertexPath))
+    , fragmentWriteTime_(getWriteTime(fragmentPath)) {
     
-    spdlog::info("Loading shader: {} + {}", vertexPath, fragmentPath);
+    if (defines_.empty()) {
+        spdlog::info("Loading shader: {} + {}", vertexPath, fragmentPath);
+    } else {
+        spdlog::info("Loading shader: {} + {} [{}]", vertexPath, fragmentPath, getDefineString());
+    }
     
-    // Load OpenGL functions dynamically
-    if (!loadOpenGLFunctions()) {
-        spdlog::error("Failed to load OpenGL functions");
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for shader compilation");
         return;
     }
     
-    spdlog::info("OpenGL functions loaded successfully");
-    
+    submit();
+}
+
+void Shader::submit() {
+    includes_.clear();
     try {
         // Load shader sources
-        std::string vertexCode = loadShaderSource(vertexPath);
-        std::string fragmentCode = loadShaderSource(fragmentPath);
+        std::string vertexCode = injectDefines(loadShaderSource(vertexPath_), defines_);
+        std::string fragmentCode = injectDefines(loadShaderSource(fragmentPath_), defines_);
         
         if (vertexCode.empty() || fragmentCode.empty()) {
             spdlog::error("Failed to load shader sources");
             return;
         }
         
-        // Compile shaders
-        GLuint vertexShader = compileShader(vertexCode, GL_VERTEX_SHADER);
-        GLuint fragmentShader = compileShader(fragmentCode, GL_FRAGMENT_SHADER);
-        
-        if (vertexShader == 0 || fragmentShader == 0) {
-            spdlog::error("Failed to compile shaders");
-            if (vertexShader != 0) glDeleteShader(vertexShader);
-            if (fragmentShader != 0) glDeleteShader(fragmentShader);
-            return;
+        // A cached binary skips compiling and linking entirely
+        const bool cacheable = cache_ && cache_->isSupported();
+        if (cacheable) {
+            cacheKey_ = cache_->getKey(vertexCode, fragmentCode);
+            programId_ = cache_->load(cacheKey_);
+            if (programId_ != 0) {
+                spdlog::info("Shader program loaded from cache with ID: {}", programId_);
+                return;
+            }
         }
         
-        // Create shader program
-        programId_ = createShaderProgram(vertexShader, fragmentShader);
-        
-        // Clean up individual shaders
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
-        
-        if (programId_ != 0) {
-            spdlog::info("Shader program created successfully with ID: {}", programId_);
-        } else {
-            spdlog::error("Failed to create shader program");
-        }
+        // Submit compile and link without querying any status, which would wait for the driver
+        vertexShader_ = compileShader(vertexCode, GL_VERTEX_SHADER);
+        fragmentShader_ = compileShader(fragmentCode, GL_FRAGMENT_SHADER);
+        programId_ = createShaderProgram(vertexShader_, fragmentShader_, cacheable);
+        pending_ = true;
+        parallel_ = GLApi::isExtensionSupported("GL_KHR_parallel_shader_compile");
         
     } catch (const std::exception& e) {
         spdlog::error("Exception during shader creation: {}", e.what());
+        deleteShaders();
+        if (programId_ != 0) {
+            gl.DeleteProgram(programId_);
+        }
         programId_ = 0;
+        pending_ = false;
     }
 }
 
 Shader::~Shader() {
+    deleteShaders();
     if (programId_ != 0) {
-        glDeleteProgram(programId_);
+        gl.DeleteProgram(programId_);
         spdlog::debug("Shader program {} deleted", programId_);
     }
 }
 
+bool Shader::enableParallelCompile() {
+    if (!GLApi::isExtensionSupported("GL_KHR_parallel_shader_compile")) {
+        spdlog::info("KHR_parallel_shader_compile not available, shaders compile on the driver thread");
+        return false;
+    }
+    if (gl.MaxShaderCompilerThreadsKHR) {
+        // 0xFFFFFFFF lets the driver pick the thread count
+        gl.MaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+    }
+    spdlog::info("Parallel shader compilation enabled");
+    return true;
+}
+
+bool Shader::isReady() const {
+    if (!pending_ || !parallel_) {
+        return true;
+    }
+    GLint complete = GL_FALSE;
+    gl.GetProgramiv(programId_, GL_COMPLETION_STATUS_KHR, &complete);
+    return complete == GL_TRUE;
+}
+
+bool Shader::finish() {
+    if (!pending_) {
+        return isValid();
+    }
+    pending_ = false;
+    
+    bool compiled = checkCompileErrors(vertexShader_, "VERTEX");
+    compiled = checkCompileErrors(fragmentShader_, "FRAGMENT") && compiled;
+    bool linked = compiled && checkLinkErrors(programId_);
+    deleteShaders();
+    
+    if (!linked) {
+        spdlog::error("Failed to create shader program");
+        gl.DeleteProgram(programId_);
+        programId_ = 0;
+        return false;
+    }
+    
+    spdlog::info("Shader program created successfully with ID: {}", programId_);
+    if (cache_ && cache_->isSupported()) {
+        cache_->store(cacheKey_, programId_);
+    }
+    return true;
+}
+
+bool Shader::reloadIfChanged() {
+    auto vertexWriteTime = getWriteTime(vertexPath_);
+    auto fragmentWriteTime = getWriteTime(fragmentPath_);
+    bool includeChanged = std::any_of(includes_.begin(), includes_.end(), [](const auto& include) {
+        return getWriteTime(include.first) != include.second;
+    });
+    if (vertexWriteTime == vertexWriteTime_ && fragmentWriteTime == fragmentWriteTime_ && !includeChanged) {
+        return false;
+    }
+    vertexWriteTime_ = vertexWriteTime;
+    fragmentWriteTime_ = fragmentWriteTime;
+    
+    finish();
+    spdlog::info("Reloading shader: {} + {}", vertexPath_, fragmentPath_);
+    
+    // Build the new program next to the current one so a broken edit keeps the last good program
+    GLuint previousProgram = programId_;
+    programId_ = 0;
+    submit();
+    if (!finish()) {
+        spdlog::warn("Shader reload failed, keeping the previous program");
+        programId_ = previousProgram;
+        return false;
+    }
+    
+    if (previousProgram != 0) {
+        gl.DeleteProgram(previousProgram);
+    }
+    uniformCache_.clear();
+    return true;
+}
+
+std::string Shader::getDefineString() const {
+    std::string result;
+    for (const auto& define : defines_) {
+        result += result.empty() ? define : " " + define;
+    }
+    return result;
+}
+
 void Shader::use() const {
-    if (programId_ != 0) {
-        glUseProgram(programId_);
+    if (isValid()) {
+        gl.UseProgram(programId_);
     } else {
         spdlog::warn("Attempting to use invalid shader program");
     }
 }
 
 void Shader::unuse() const {
-    glUseProgram(0);
+    gl.UseProgram(0);
 }
 
 void Shader::setInt(const std::string& name, int value) {
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform1i(location, value);
+        gl.Uniform1i(location, value);
     }
 }
 
 void Shader::setUint(const std::string& name, unsigned int value) {
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform1i(location, static_cast<int>(value));
+        gl.Uniform1i(location, static_cast<int>(value));
     }
 }
 
 void Shader::setBool(const std::string& name, bool value) {
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform1i(location, value ? 1 : 0);
+        gl.Uniform1i(location, value ? 1 : 0);
     }
 }
 
 void Shader::setFloat(const std::string& name, float value) {
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform1f(location, value);
+        gl.Uniform1f(location, value);
     }
 }
 
 void Shader::setVec3(const std::string& name, const glm::vec3& value) {
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform3fv(location, 1, &value[0]);
+        gl.Uniform3fv(location, 1, &value[0]);
     }
 }
 
 void Shader::setVec4(const std::string& name, const glm::vec4& value) {
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniform4fv(location, 1, &value[0]);
+        gl.Uniform4fv(location, 1, &value[0]);
     }
 }
 
 void Shader::setMat4(const std::string& name, const glm::mat4& value) {
     GLint location = getUniformLocation(name);
     if (location != -1) {
-        glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+        gl.UniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
     }
 }
 
@@ -209,54 +274,98 @@ std::string Shader::loadShaderSource(const std::string& filePath) {
     buffer << file.rdbuf();
     file.close();
     
-    std::string source = buffer.str();
+    std::string source = expandIncludes(buffer.str(), filePath, 0, 0);
     spdlog::debug("Loaded shader source from {}: {} characters", filePath, source.length());
     return source;
 }
 
-GLuint Shader::compileShader(const std::string& source, GLenum shaderType) {
-    GLuint shader = glCreateShader(shaderType);
-    const char* sourceCStr = source.c_str();
-    glShaderSource(shader, 1, &sourceCStr, nullptr);
-    glCompileShader(shader);
-    
-    checkCompileErrors(shader, shaderType == GL_VERTEX_SHADER ? "VERTEX" : "FRAGMENT");
+std::string Shader::expandIncludes(const std::string& source, const std::string& filePath, int sourceNumber, int depth) {
+    constexpr int MAX_INCLUDE_DEPTH = 8;
     
-    GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        glDeleteShader(shader);
-        return 0;
+    std::istringstream lines(source);
+    std::string result;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        size_t open = line.find('"');
+        size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+        if (line.compare(0, 8, "#include") != 0 || close == std::string::npos) {
+            result += line + '\n';
+            continue;
+        }
+        
+        // Paths are relative to the including file. There is no include-once: guard with #ifndef
+        std::string includePath = (std::filesystem::path(filePath).parent_path() / line.substr(open + 1, close - open - 1)).string();
+        auto included = std::find_if(includes_.begin(), includes_.end(),
+                                     [&](const auto& include) { return include.first == includePath; });
+        if (included == includes_.end()) {
+            included = includes_.emplace(includes_.end(), includePath, getWriteTime(includePath));
+        }
+        // Compile errors report "source:line"; an include's source number is its position in includes_ plus one
+        int includeNumber = static_cast<int>(included - includes_.begin()) + 1;
+        if (depth >= MAX_INCLUDE_DEPTH) {
+            spdlog::error("Shader includes nested too deeply in {}", filePath);
+            return "";
+        }
+        
+        std::ifstream file(includePath);
+        if (!file.is_open()) {
+            spdlog::error("Failed to open shader include {} from {}", includePath, filePath);
+            return "";
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        
+        std::string expanded = expandIncludes(buffer.str(), includePath, includeNumber, depth + 1);
+        if (expanded.empty()) {
+            return "";
+        }
+        result += "#line 1 " + std::to_string(includeNumber) + '\n';
+        result += expanded;
+        result += "#line " + std::to_string(lineNumber + 1) + ' ' + std::to_string(sourceNumber) + '\n';
     }
-    
+    return result;
+}
+
+GLuint Shader::compileShader(const std::string& source, GLenum shaderType) {
+    GLuint shader = gl.CreateShader(shaderType);
+    const char* sourceCStr = source.c_str();
+    gl.ShaderSource(shader, 1, &sourceCStr, nullptr);
+    gl.CompileShader(shader);
     return shader;
 }
 
-GLuint Shader::createShaderProgram(GLuint vertexShader, GLuint fragmentShader) {
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vertexShader);
-    glAttachShader(program, fragmentShader);
-    glLinkProgram(program);
-    
-    checkLinkErrors(program);
-    
-    GLint success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        glDeleteProgram(program);
-        return 0;
+GLuint Shader::createShaderProgram(GLuint vertexShader, GLuint fragmentShader, bool retrievable) {
+    GLuint program = gl.CreateProgram();
+    if (retrievable && gl.ProgramParameteri) {
+        gl.ProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     }
-    
+    gl.AttachShader(program, vertexShader);
+    gl.AttachShader(program, fragmentShader);
+    gl.LinkProgram(program);
     return program;
 }
 
+void Shader::deleteShaders() {
+    // Attached shaders are only flagged for deletion and go away with the program
+    if (vertexShader_ != 0) {
+        gl.DeleteShader(vertexShader_);
+        vertexShader_ = 0;
+    }
+    if (fragmentShader_ != 0) {
+        gl.DeleteShader(fragmentShader_);
+        fragmentShader_ = 0;
+    }
+}
+
 GLint Shader::getUniformLocation(const std::string& name) const {
     auto it = uniformCache_.find(name);
     if (it != uniformCache_.end()) {
         return it->second;
     }
     
-    GLint location = glGetUniformLocation(programId_, name.c_str());
+    GLint location = gl.GetUniformLocation(programId_, name.c_str());
     uniformCache_[name] = location;
     
     if (location == -1) {
@@ -266,22 +375,24 @@ GLint Shader::getUniformLocation(const std::string& name) const {
     return location;
 }
 
-void Shader::checkCompileErrors(GLuint shader, const std::string& type) {
+bool Shader::checkCompileErrors(GLuint shader, const std::string& type) {
     GLint success;
     GLchar infoLog[1024];
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    gl.GetShaderiv(shader, GL_COMPILE_STATUS, &success);
     if (!success) {
-        glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
+        gl.GetShaderInfoLog(shader, 1024, nullptr, infoLog);
         spdlog::error("Shader compilation error ({}): {}", type, infoLog);
     }
+    return success != 0;
 }
 
-void Shader::checkLinkErrors(GLuint program) {
+bool Shader::checkLinkErrors(GLuint program) {
     GLint success;
     GLchar infoLog[1024];
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    gl.GetProgramiv(program, GL_LINK_STATUS, &success);
     if (!success) {
-        glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+        gl.GetProgramInfoLog(program, 1024, nullptr, infoLog);
         spdlog::error("Shader program linking error: {}", infoLog);
     }
+    return success != 0;
 }
\ No newline at end of file
@@ -2,12 +2,29 @@
 
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <filesystem>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+class ShaderCache;
 
 class Shader {
 public:
-    Shader(const std::string& vertexPath, const std::string& fragmentPath);
+    /**
+     * @brief Load a program and submit its compile and link to the driver
+     *
+     * Nothing waits on the driver here: call finish() before using the
+     * program, ideally after other work so the compile runs in the background.
+     *
+     * @param vertexPath Vertex shader file
+     * @param fragmentPath Fragment shader file
+     * @param cache Program binary cache consulted before compiling, or nullptr
+     * @param defines Preprocessor symbols defined in both stages, e.g. "PLANET_ATMOSPHERE"
+     */
+    Shader(const std::string& vertexPath, const std::string& fragmentPath, ShaderCache* cache = nullptr,
+           const std::vector<std::string>& defines = {});
     ~Shader();
 
     // Non-copyable, non-movable
@@ -16,10 +33,43 @@ public:
     Shader(Shader&&) = delete;
     Shader& operator=(Shader&&) = delete;
 
+    /**
+     * @brief Let the driver compile shaders on its own threads
+     *
+     * Call once after loading OpenGL, before creating shaders.
+     *
+     * @return true if KHR_parallel_shader_compile is available
+     */
+    static bool enableParallelCompile();
+
+    /**
+     * @brief Check whether finish() would return without waiting on the driver
+     * @return bool Always true without KHR_parallel_shader_compile
+     */
+    bool isReady() const;
+
+    /**
+     * @brief Wait for the compile and link, report errors and store the binary in the cache
+     * @return true if the program is usable
+     */
+    bool finish();
+
+    /**
+     * @brief Rebuild the program if a source file or one of its includes changed on disk
+     *
+     * Compiles synchronously. If the new sources fail to compile or link,
+     * the previous program stays in use.
+     *
+     * @return true if the program was replaced
+     */
+    bool reloadIfChanged();
+
     void use() const;
     void unuse() const;
     
-    bool isValid() const { return programId_ != 0; }
+    bool isPending() const { return pending_; }
+    bool isValid() const { return programId_ != 0 && !pending_; }
+    const std::vector<std::string>& getDefines() const { return defines_; }
     GLuint getProgramId() const { return programId_; }
 
     // Uniform setters
@@ -33,12 +83,28 @@ public:
 
 private:
     GLuint programId_;
+    GLuint vertexShader_;
+    GLuint fragmentShader_;
+    bool pending_;
+    bool parallel_;
+    ShaderCache* cache_;
+    uint64_t cacheKey_;
+    std::string vertexPath_;
+    std::string fragmentPath_;
+    std::vector<std::string> defines_;
+    std::filesystem::file_time_type vertexWriteTime_;
+    std::filesystem::file_time_type fragmentWriteTime_;
+    std::vector<std::pair<std::string, std::filesystem::file_time_type>> includes_; // Files pulled in by #include
     mutable std::unordered_map<std::string, GLint> uniformCache_;
 
+    void submit();
+    std::string getDefineString() const;
     std::string loadShaderSource(const std::string& filePath);
+    std::string expandIncludes(const std::string& source, const std::string& filePath, int sourceNumber, int depth);
     GLuint compileShader(const std::string& source, GLenum shaderType);
-    GLuint createShaderProgram(GLuint vertexShader, GLuint fragmentShader);
+    GLuint createShaderProgram(GLuint vertexShader, GLuint fragmentShader, bool retrievable);
+    void deleteShaders();
     GLint getUniformLocation(const std::string& name) const;
-    void checkCompileErrors(GLuint shader, const std::string& type);
-    void checkLinkErrors(GLuint program);
+    bool checkCompileErrors(GLuint shader, const std::string& type);
+    bool checkLinkErrors(GLuint program);
 };
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "ShaderCache.hpp"
+#include "CacheEntry.hpp"
+#include "GLApi.hpp"
+#include "Hasher.hpp"
+#include <spdlog/spdlog.h>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+constexpr CacheEntry::Format SHADER_ENTRY = {
+    "shader", "program", {'A', 'S', 'T', 'R', 'P', 'R', 'O', 'G'}, ShaderCache::FORMAT_VERSION
+};
+
+constexpr uint64_t MAX_BINARY_SIZE = 64ull * 1024 * 1024;
+
+std::string getDriverString(GLenum name) {
+    const GLubyte* value = gl.GetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+} // namespace
+
+ShaderCache::ShaderCache(const std::string& directory)
+    : directory_(directory)
+    , supported_(false)
+    , hits_(0)
+    , misses_(0) {
+    if (!GLApi::isLoaded()) {
+        return;
+    }
+
+    driver_ = getDriverString(GL_VENDOR) + '\n' + getDriverString(GL_RENDERER) + '\n' + getDriverString(GL_VERSION);
+
+    GLint formatCount = 0;
+    if (gl.GetProgramBinary && gl.ProgramBinary) {
+        gl.GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    }
+    supported_ = formatCount > 0;
+    if (!supported_) {
+        spdlog::info("Driver does not support program binaries, shader cache disabled");
+    }
+}
+
+uint64_t ShaderCache::getKey(const std::string& vertexSource, const std::string& fragmentSource) const {
+    return Hasher()
+        .add(FORMAT_VERSION)
+        .add(driver_)
+        .add(vertexSource)
+        .add(fragmentSource)
+        .get();
+}
+
+unsigned int ShaderCache::load(uint64_t key) {
+    if (!supported_) {
+        return 0;
+    }
+    ++misses_; // Until the program links below
+
+    // The payload is the binary format followed by the program binary
+    std::vector<uint8_t> payload;
+    if (!CacheEntry(SHADER_ENTRY, directory_, key).read(0, sizeof(GLenum) + 1, sizeof(GLenum) + MAX_BINARY_SIZE, payload)) {
+        return 0;
+    }
+    GLenum binaryFormat = 0;
+    std::memcpy(&binaryFormat, payload.data(), sizeof(binaryFormat));
+
+    GLuint program = gl.CreateProgram();
+    gl.ProgramBinary(program, binaryFormat, payload.data() + sizeof(binaryFormat), static_cast<GLsizei>(payload.size() - sizeof(binaryFormat)));
+    GLint success = 0;
+    gl.GetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        // Drivers may refuse their own binaries after an update with the same version string
+        spdlog::info("Driver rejected cached shader program {:016x}, recompiling", key);
+        gl.DeleteProgram(program);
+        return 0;
+    }
+
+    --misses_;
+    ++hits_;
+    return program;
+}
+
+bool ShaderCache::store(uint64_t key, unsigned int program) {
+    if (!supported_ || program == 0) {
+        return false;
+    }
+
+    GLint length = 0;
+    gl.GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0 || static_cast<uint64_t>(length) > MAX_BINARY_SIZE) {
+        return false;
+    }
+
+    std::vector<uint8_t> binary(static_cast<size_t>(length));
+    GLsizei written = 0;
+    GLenum binaryFormat = 0;
+    gl.GetProgramBinary(program, length, &written, &binaryFormat, binary.data());
+    if (written <= 0) {
+        return false;
+    }
+    binary.resize(static_cast<size_t>(written));
+
+    const std::initializer_list<CacheEntry::Part> parts = {{&binaryFormat, sizeof(binaryFormat)}, {binary.data(), binary.size()}};
+    if (!CacheEntry(SHADER_ENTRY, directory_, key).write(0, parts)) {
+        return false;
+    }
+
+    spdlog::debug("Stored shader cache entry {:016x}: {} bytes", key, binary.size());
+    return true;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief On-disk cache of linked shader program binaries
+ *
+ * Entries are keyed by a hash of the shader sources and the driver identity
+ * (vendor, renderer and version strings), so a driver update or an edited
+ * shader simply misses. The driver may still reject a binary it produced
+ * itself; load() then returns 0 and the caller compiles from source and
+ * stores the fresh binary over the stale entry.
+ *
+ * Needs glGetProgramBinary/glProgramBinary (GL 4.1 or ARB_get_program_binary)
+ * and at least one binary format; otherwise every lookup misses. Must be
+ * used on the thread owning the OpenGL context.
+ */
+class ShaderCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    /**
+     * @brief Construct a cache rooted at a directory
+     * @param directory Directory holding cache entries (created on first store)
+     */
+    explicit ShaderCache(const std::string& directory);
+    ~ShaderCache() = default;
+
+    // Non-copyable, non-movable
+    ShaderCache(const ShaderCache&) = delete;
+    ShaderCache& operator=(const ShaderCache&) = delete;
+    ShaderCache(ShaderCache&&) = delete;
+    ShaderCache& operator=(ShaderCache&&) = delete;
+
+    /**
+     * @brief Compute the cache key of a program
+     * @param vertexSource Vertex shader source
+     * @param fragmentSource Fragment shader source
+     * @return uint64_t Cache key, also covering the driver identity
+     */
+    uint64_t getKey(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+    /**
+     * @brief Create a program from a cached binary
+     * @param key Cache key (see getKey)
+     * @return unsigned int Linked program, or 0 on a miss
+     */
+    unsigned int load(uint64_t key);
+
+    /**
+     * @brief Store the binary of a linked program
+     *
+     * The program should be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+     *
+     * @param key Cache key (see getKey)
+     * @param program Linked program
+     * @return true if successful
+     */
+    bool store(uint64_t key, unsigned int program);
+
+    bool isSupported() const { return supported_; }
+    int getHitCount() const { return hits_; }
+    int getMissCount() const { return misses_; }
+
+private:
+    std::string directory_;
+    std::string driver_;
+    bool supported_;
+    int hits_;
+    int misses_;
+};
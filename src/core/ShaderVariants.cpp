@@ -0,0 +1,53 @@
+#include "ShaderVariants.hpp"
+#include "Shader.hpp"
+#include <spdlog/spdlog.h>
+
+ShaderVariants::ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath,
+                               std::vector<std::string> symbols, ShaderCache* cache)
+    : vertexPath_(vertexPath)
+    , fragmentPath_(fragmentPath)
+    , symbols_(std::move(symbols))
+    , cache_(cache) {
+}
+
+ShaderVariants::~ShaderVariants() = default;
+
+Shader* ShaderVariants::submit(uint32_t mask) {
+    auto it = variants_.find(mask);
+    if (it != variants_.end()) {
+        return it->second.get();
+    }
+
+    std::vector<std::string> defines;
+    for (size_t i = 0; i < symbols_.size(); ++i) {
+        if (mask & (1u << i)) {
+            defines.push_back(symbols_[i]);
+        }
+    }
+    if (symbols_.size() < 32 && mask >> symbols_.size() != 0) {
+        spdlog::warn("Shader variant mask {:#x} has bits without a symbol in {}", mask, fragmentPath_);
+    }
+
+    auto shader = std::make_unique<Shader>(vertexPath_, fragmentPath_, cache_, defines);
+    Shader* result = shader.get();
+    variants_.emplace(mask, std::move(shader));
+    return result;
+}
+
+Shader* ShaderVariants::get(uint32_t mask) {
+    Shader* shader = submit(mask);
+    if (shader->isPending()) {
+        shader->finish();
+    }
+    return shader->isValid() ? shader : nullptr;
+}
+
+int ShaderVariants::reloadIfChanged() {
+    int reloaded = 0;
+    for (auto& [mask, shader] : variants_) {
+        if (shader->reloadIfChanged()) {
+            ++reloaded;
+        }
+    }
+    return reloaded;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Shader;
+class ShaderCache;
+
+/**
+ * @brief Preprocessor permutations of one shader program
+ *
+ * Each symbol passed to the constructor is one bit of a variant mask; the
+ * variant for a mask is compiled with "#define SYMBOL" for every set bit, so
+ * choices that used to be uniform branches (planet type, particle type) get
+ * their own branch-free program. Variants compile on first use, or ahead of
+ * time through submit(), and go through the program binary cache like any
+ * other Shader.
+ */
+class ShaderVariants {
+public:
+    /**
+     * @brief Describe the permutations of a program
+     * @param vertexPath Vertex shader file
+     * @param fragmentPath Fragment shader file
+     * @param symbols Define names, bit i of a mask selects symbols[i]
+     * @param cache Program binary cache, or nullptr
+     */
+    ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath,
+                   std::vector<std::string> symbols, ShaderCache* cache = nullptr);
+    ~ShaderVariants();
+
+    // Non-copyable, non-movable
+    ShaderVariants(const ShaderVariants&) = delete;
+    ShaderVariants& operator=(const ShaderVariants&) = delete;
+    ShaderVariants(ShaderVariants&&) = delete;
+    ShaderVariants& operator=(ShaderVariants&&) = delete;
+
+    /**
+     * @brief Submit a variant for compilation without waiting for it
+     * @param mask Variant mask
+     * @return Shader* The variant, to be finished before use
+     */
+    Shader* submit(uint32_t mask);
+
+    /**
+     * @brief Get a finished variant, compiling it on first use
+     * @param mask Variant mask
+     * @return Shader* The variant, or nullptr if it failed to build
+     */
+    Shader* get(uint32_t mask);
+
+    /**
+     * @brief Rebuild every variant whose sources changed on disk
+     * @return int Number of variants replaced
+     */
+    int reloadIfChanged();
+
+    size_t getVariantCount() const { return variants_.size(); }
+
+private:
+    std::string vertexPath_;
+    std::string fragmentPath_;
+    std::vector<std::string> symbols_;
+    ShaderCache* cache_;
+    std::map<uint32_t, std::unique_ptr<Shader>> variants_;
+};
@@ -1,4 +1,5 @@
 #include "SolarSystemManager.hpp"
+#include "ClusteredLighting.hpp"
 #include "Sun.hpp"
 #include "Planet.hpp"
 #include "PlanetManager.hpp"
@@ -8,16 +9,31 @@
 #include "Geometry.hpp"
 #include "Noise.hpp"
 #include "Shader.hpp"
+#include "ShaderVariants.hpp"
 #include "Camera.hpp"
+#include "Moon.hpp"
+#include "PlanetBiomes.hpp"
+#include "SystemSnapshot.hpp"
+#include "SystemGenerator.hpp"
 #include <spdlog/spdlog.h>
+#include <chrono>
 #include <random>
 
+// Point lights each particle system may add per frame
+static constexpr size_t MAX_PARTICLE_LIGHTS = 64;
+
+// Asteroid meshes as (latitude, longitude) sphere segments, coarsest first
+static constexpr int ASTEROID_LOD_SEGMENTS[][2] = {{6, 4}, {8, 6}, {16, 12}};
+
 SolarSystemManager::SolarSystemManager()
-    : sun_(nullptr)
+    : snapshot_(nullptr)
+    , snapshotDirectory_()
+    , snapshotsEnabled_(true)
+    , sun_(nullptr)
     , planetManager_(nullptr)
-    , asteroidGeometry_(nullptr)
     , noise_(nullptr)
     , currentSeed_(12345)
+    , currentPlanetCount_(8)
     , systemScale_(1.0f)
     , timeScale_(1.0f)
     , initialized_(false)
@@ -47,9 +63,15 @@ void SolarSystemManager::initialize(Noise* noise) {
     planetManager_ = std::make_unique<PlanetManager>();
     planetManager_->initialize(noise);
     
-    // Create asteroid geometry (simple sphere for asteroids)
-    asteroidGeometry_ = std::make_unique<Geometry>();
-    asteroidGeometry_->createSphere(1.0f, 8, 6); // Low-poly sphere for performance
+    // Create asteroid geometry (low-poly spheres, one per LOD level)
+    for (const auto& segments : ASTEROID_LOD_SEGMENTS) {
+        auto geometry = std::make_unique<Geometry>();
+        geometry->createSphere(1.0f, segments[0], segments[1]);
+        asteroidGeometries_.push_back(std::move(geometry));
+        asteroidLODLevels_.push_back(ScreenSpaceLOD::uvSphereLevel(segments[0], segments[1]));
+    }
+    
+    clusteredLighting_ = std::make_unique<ClusteredLighting>();
     
     initialized_ = true;
     spdlog::info("SolarSystemManager initialized successfully");
@@ -63,12 +85,38 @@ void SolarSystemManager::generateSolarSystem(int systemSeed, int planetCount) {
     
     // Update current seed
     currentSeed_ = systemSeed;
+    currentPlanetCount_ = planetCount;
     
     spdlog::info("Generating solar system with seed {} and {} planets", systemSeed, planetCount);
     
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
     // Clear existing system
     clear();
     
+    // Restore from a snapshot of a previous run if one matches
+    uint64_t snapshotKey = 0;
+    std::string snapshotPath;
+    if (snapshotsEnabled_ && !snapshotDirectory_.empty()) {
+        snapshotKey = SystemSnapshot::computeKey(systemSeed, planetCount, noise_->getSettingsHash());
+        snapshotPath = SystemSnapshot::getSnapshotPath(snapshotDirectory_, snapshotKey);
+        
+        auto snapshot = SystemSnapshot::load(snapshotPath, snapshotKey);
+        if (snapshot) {
+            if (restoreFromSnapshot(*snapshot)) {
+                snapshot_ = std::move(snapshot);
+                applySubsystemSettings();
+                float elapsedMs = std::chrono::duration<float, std::milli>(
+                    std::chrono::high_resolution_clock::now() - startTime).count();
+                spdlog::info("Solar system restored from snapshot in {:.1f} ms", elapsedMs);
+                return;
+            }
+            
+            spdlog::warn("Failed to restore snapshot {}, regenerating", snapshotPath);
+            clear();
+        }
+    }
+    
     // Setup sun
     setupSun(systemSeed);
     
@@ -84,7 +132,15 @@ void SolarSystemManager::generateSolarSystem(int systemSeed, int planetCount) {
     // Generate particle systems
     generateParticleSystems(systemSeed);
     
-    spdlog::info("Solar system generated successfully");
+    float elapsedMs = std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    spdlog::info("Solar system generated successfully in {:.1f} ms", elapsedMs);
+    
+    // Snapshots always hold the unscaled system; user settings are applied on top
+    if (!snapshotPath.empty()) {
+        writeSnapshot(snapshotPath, snapshotKey);
+    }
+    applySubsystemSettings();
 }
 
 void SolarSystemManager::update(float deltaTime) {
@@ -126,9 +182,10 @@ void SolarSystemManager::update(float deltaTime) {
     }
 }
 
-void SolarSystemManager::render(Shader* planetShader, Shader* sunShader, Shader* asteroidShader, 
-                               Shader* ringShader, Shader* particleShader, const Camera* camera, 
-                               const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos) {
+void SolarSystemManager::render(ShaderVariants* planetShaders, Shader* sunShader, Shader* asteroidShader, 
+                               Shader* ringShader, ShaderVariants* particleShaders, const Camera* camera, 
+                               const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos,
+                               int viewportHeight) {
     if (!initialized_ || !camera) {
         return;
     }
@@ -138,10 +195,37 @@ void SolarSystemManager::render(Shader* planetShader, Shader* sunShader, Shader*
     glm::vec3 sunColor = getSunLightColor();
     float lightIntensity = sun_ ? sun_->getCurrentLightIntensity() : 1.0f;
     
+    // Emissive particles add point lights on top of the sun; clustered once, shared by every lit shader
+    pointLights_.clear();
+    if (particlesVisible_) {
+        for (const auto& particleSystem : particleSystems_) {
+            if (particleSystem) {
+                particleSystem->collectLights(pointLights_, MAX_PARTICLE_LIGHTS);
+            }
+        }
+    }
+    clusteredLighting_->update(pointLights_, view, projection);
+    clusteredLighting_->bindTextures();
+    
+    // Mesh levels of planets, moons and asteroids come from one screen-space error budget
+    glm::vec3 cameraPos = camera->getPosition();
+    lod_.beginFrame(view, projection, viewportHeight);
+    if (planetManager_) {
+        planetManager_->requestLOD(lod_, cameraPos);
+    }
+    if (asteroidsVisible_) {
+        for (auto& belt : asteroidBelts_) {
+            if (belt) {
+                belt->requestLOD(lod_, cameraPos);
+            }
+        }
+    }
+    lod_.resolve();
+    
     // Render planets first (they need sun lighting)
-    if (planetManager_ && planetShader) {
-        planetManager_->render(planetShader, camera, view, projection, 
-                              sunPos, sunColor, viewPos, lightIntensity);
+    if (planetManager_ && planetShaders) {
+        planetManager_->render(planetShaders, camera, view, projection, 
+                              sunPos, sunColor, viewPos, lightIntensity, &lod_, clusteredLighting_.get());
     }
     
     // Render asteroid belts
@@ -149,7 +233,7 @@ void SolarSystemManager::render(Shader* planetShader, Shader* sunShader, Shader*
         for (auto& belt : asteroidBelts_) {
             if (belt && belt->isVisible()) {
                 belt->render(asteroidShader, camera, view, projection, 
-                           sunPos, sunColor, viewPos);
+                           sunPos, sunColor, viewPos, &lod_, clusteredLighting_.get());
             }
         }
     }
@@ -159,17 +243,20 @@ void SolarSystemManager::render(Shader* planetShader, Shader* sunShader, Shader*
         for (auto& rings : planetaryRings_) {
             if (rings && rings->isVisible()) {
                 rings->render(ringShader, camera, view, projection, 
-                            sunPos, sunColor, viewPos);
+                            sunPos, sunColor, viewPos, clusteredLighting_.get());
             }
         }
     }
     
     // Render particle systems
-    if (particlesVisible_ && particleShader) {
+    if (particlesVisible_ && particleShaders) {
         for (auto& particleSystem : particleSystems_) {
             if (particleSystem && particleSystem->isActive()) {
-                particleSystem->render(particleShader, camera, view, projection, 
-                                     sunPos, sunColor, viewPos);
+                Shader* particleShader = particleShaders->get(ParticleSystem::getShaderVariant(particleSystem->getType()));
+                if (particleShader) {
+                    particleSystem->render(particleShader, camera, view, projection, 
+                                         sunPos, sunColor, viewPos);
+                }
             }
         }
     }
@@ -180,6 +267,14 @@ void SolarSystemManager::render(Shader* planetShader, Shader* sunShader, Shader*
     }
 }
 
+std::vector<Geometry*> SolarSystemManager::getAsteroidGeometries() const {
+    std::vector<Geometry*> geometries;
+    for (const auto& geometry : asteroidGeometries_) {
+        geometries.push_back(geometry.get());
+    }
+    return geometries;
+}
+
 glm::vec3 SolarSystemManager::getSunPosition() const {
     if (sun_) {
         return sun_->getPosition();
@@ -205,6 +300,12 @@ void SolarSystemManager::clear() {
     // Clear planetary rings
     planetaryRings_.clear();
     
+    // Clear particle systems
+    particleSystems_.clear();
+    
+    // Nothing references the mapped snapshot anymore
+    snapshot_.reset();
+    
     spdlog::debug("Solar system cleared");
 }
 
@@ -214,56 +315,28 @@ void SolarSystemManager::setupSun(int systemSeed) {
         return;
     }
     
-    std::mt19937 rng(systemSeed);
-    std::uniform_real_distribution<float> sizeDist(12.0f, 16.0f); // Much larger sun
-    std::uniform_real_distribution<float> tempDist(5500.0f, 6000.0f); // Keep it in yellow range
-    std::uniform_real_distribution<float> colorVariation(0.9f, 1.1f);
+    SunLayout layout = SystemGenerator::generateSun(systemSeed);
     
-    float sunSize = sizeDist(rng);
-    float temperature = tempDist(rng);
-    
-    // Color based on temperature - make it more yellow/orange
-    glm::vec3 sunColor;
-    if (temperature < 5700.0f) {
-        sunColor = glm::vec3(1.0f, 0.8f, 0.4f) * colorVariation(rng); // Orange-yellow
-    } else if (temperature < 5900.0f) {
-        sunColor = glm::vec3(1.0f, 0.9f, 0.6f) * colorVariation(rng); // Yellow
-    } else {
-        sunColor = glm::vec3(1.0f, 0.95f, 0.8f) * colorVariation(rng); // Warm yellow
-    }
-    
-    sun_->setRadius(sunSize);
-    sun_->setColor(sunColor);
-    sun_->setTemperature(temperature);
+    sun_->setRadius(layout.radius);
+    sun_->setColor(layout.color);
+    sun_->setTemperature(layout.temperature);
     
     // Initialize the sun geometry
     sun_->initialize(64); // High resolution sphere for the sun
     
-    spdlog::info("Sun setup complete: size={:.2f}, temp={:.0f}K", sunSize, temperature);
+    spdlog::info("Sun setup complete: size={:.2f}, temp={:.0f}K", layout.radius, layout.temperature);
 }
 
 void SolarSystemManager::generateAsteroidBelts(int systemSeed) {
     asteroidBelts_.clear();
     
-    std::mt19937 rng(systemSeed + 1000); // Different seed for asteroids
-    std::uniform_int_distribution<int> beltCountDist(1, 3);
-    std::uniform_real_distribution<float> innerRadiusDist(40.0f, 80.0f);
-    std::uniform_real_distribution<float> widthDist(15.0f, 30.0f);
-    std::uniform_int_distribution<int> asteroidCountDist(200, 800);
-    
-    int beltCount = beltCountDist(rng);
-    
-    for (int i = 0; i < beltCount; ++i) {
-        float innerRadius = innerRadiusDist(rng) + i * 50.0f; // Space belts apart
-        float outerRadius = innerRadius + widthDist(rng);
-        int asteroidCount = asteroidCountDist(rng);
-        
-        auto belt = std::make_unique<AsteroidBelt>(innerRadius, outerRadius, asteroidCount, systemSeed + i);
-        belt->initialize(asteroidGeometry_.get());
+    for (const auto& layout : SystemGenerator::generateAsteroidBelts(systemSeed)) {
+        auto belt = std::make_unique<AsteroidBelt>(layout.innerRadius, layout.outerRadius, layout.asteroidCount, layout.seed);
+        belt->initialize(getAsteroidGeometries(), &asteroidLODLevels_);
         asteroidBelts_.push_back(std::move(belt));
     }
     
-    spdlog::info("Generated {} asteroid belts", beltCount);
+    spdlog::info("Generated {} asteroid belts", asteroidBelts_.size());
 }
 
 void SolarSystemManager::generatePlanetaryRings(int systemSeed) {
@@ -273,34 +346,12 @@ void SolarSystemManager::generatePlanetaryRings(int systemSeed) {
         return;
     }
     
-    std::mt19937 rng(systemSeed + 2000); // Different seed for rings
-    std::uniform_real_distribution<float> ringChance(0.0f, 1.0f);
-    std::uniform_real_distribution<float> ringWidthDist(2.0f, 8.0f);
-    std::uniform_int_distribution<int> particleCountDist(500, 2000);
-    
-    // Get planet information from planet manager
-    // Note: This is a simplified approach - in a real implementation,
-    // we'd need access to planet data from PlanetManager
-    
-    // For now, create rings at typical gas giant distances
-    std::vector<float> gasGiantDistances = {60.0f, 95.0f, 130.0f};
-    std::vector<float> gasGiantRadii = {8.0f, 12.0f, 10.0f};
-    
-    for (size_t i = 0; i < gasGiantDistances.size(); ++i) {
-        if (ringChance(rng) > 0.4f) { // 60% chance for rings
-            float planetRadius = gasGiantRadii[i];
-            float innerRadius = planetRadius * 1.5f;
-            float outerRadius = innerRadius + ringWidthDist(rng);
-            int particleCount = particleCountDist(rng);
-            
-            glm::vec3 planetPosition(gasGiantDistances[i], 0.0f, 0.0f); // Simplified position
-            
-            auto rings = std::make_unique<PlanetaryRings>(planetPosition, planetRadius, 
-                                                         innerRadius, outerRadius, 
-                                                         particleCount, systemSeed + static_cast<int>(i));
-            rings->initialize();
-            planetaryRings_.push_back(std::move(rings));
-        }
+    for (const auto& layout : SystemGenerator::generatePlanetaryRings(systemSeed)) {
+        auto rings = std::make_unique<PlanetaryRings>(layout.planetPosition, layout.planetRadius, 
+                                                     layout.innerRadius, layout.outerRadius, 
+                                                     layout.particleCount, layout.seed);
+        rings->initialize();
+        planetaryRings_.push_back(std::move(rings));
     }
     
     spdlog::info("Generated {} planetary ring systems", planetaryRings_.size());
@@ -325,6 +376,10 @@ void SolarSystemManager::setPlanetaryRingsVisible(bool visible) {
 }
 
 void SolarSystemManager::setAsteroidDensity(float density) {
+    if (density == asteroidDensity_) {
+        return;
+    }
+    asteroidDensity_ = density;
     for (auto& belt : asteroidBelts_) {
         if (belt) {
             belt->setDensity(density);
@@ -333,6 +388,10 @@ void SolarSystemManager::setAsteroidDensity(float density) {
 }
 
 void SolarSystemManager::setRingDensity(float density) {
+    if (density == ringDensity_) {
+        return;
+    }
+    ringDensity_ = density;
     for (auto& rings : planetaryRings_) {
         if (rings) {
             rings->setDensity(density);
@@ -350,11 +409,35 @@ void SolarSystemManager::setParticleSystemsVisible(bool visible) {
 }
 
 void SolarSystemManager::setParticleEmissionRate(float rate) {
+    if (rate == particleEmissionRate_) {
+        return;
+    }
+    particleEmissionRate_ = rate;
     for (auto& particleSystem : particleSystems_) {
         if (particleSystem) {
-            particleSystem->setEmissionRate(rate);
+            particleSystem->setEmissionRateScale(rate);
+        }
+    }
+}
+
+void SolarSystemManager::applySubsystemSettings() {
+    // Belts and rings are generated at density 1.0; only regenerate when it differs
+    for (auto& belt : asteroidBelts_) {
+        belt->setVisible(asteroidsVisible_);
+        if (asteroidDensity_ != 1.0f) {
+            belt->setDensity(asteroidDensity_);
+        }
+    }
+    for (auto& rings : planetaryRings_) {
+        rings->setVisible(ringsVisible_);
+        if (ringDensity_ != 1.0f) {
+            rings->setDensity(ringDensity_);
         }
     }
+    for (auto& particleSystem : particleSystems_) {
+        particleSystem->setActive(particlesVisible_);
+        particleSystem->setEmissionRateScale(particleEmissionRate_);
+    }
 }
 
 void SolarSystemManager::generateParticleSystems(int systemSeed) {
@@ -402,4 +485,246 @@ void SolarSystemManager::generateParticleSystems(int systemSeed) {
     }
     
     spdlog::info("Generated {} particle systems", particleSystems_.size());
+}
+
+bool SolarSystemManager::restoreFromSnapshot(const SystemSnapshot& snapshot) {
+    if (!sun_ || !planetManager_) {
+        return false;
+    }
+    
+    // Sun
+    const auto& sunRecord = snapshot.getSun();
+    sun_->setRadius(sunRecord.radius);
+    sun_->setColor(sunRecord.color);
+    sun_->setTemperature(sunRecord.temperature);
+    sun_->initialize(64);
+    
+    // Planets and moons; meshes are uploaded straight from the mapping
+    auto moons = snapshot.getMoons();
+    auto meshes = snapshot.getMeshes();
+    auto vertices = snapshot.getVertices();
+    auto indices = snapshot.getIndices();
+    auto biomes = snapshot.getBiomes();
+    
+    for (const auto& record : snapshot.getPlanets()) {
+        auto planet = std::make_unique<Planet>(record.radius, record.resolution, noise_);
+        planet->setMeshCache(planetManager_->getMeshCache());
+        planet->setHeightScale(record.heightScale);
+        planet->setNoiseFrequency(record.noiseFrequency);
+        planet->setNoiseOctaves(record.noiseOctaves);
+        planet->setTerrainPostProcess(SystemGenerator::generateTerrainFeatures(record.type, record.seed));
+        planet->setOrbitalParameters(record.orbitRadius, record.orbitSpeed);
+        
+        for (const auto& mesh : meshes.subspan(record.firstMesh, record.meshCount)) {
+            planet->setPrebuiltMesh(mesh.resolution,
+                                    vertices.data() + mesh.firstVertex, static_cast<size_t>(mesh.vertexCount),
+                                    indices.data() + mesh.firstIndex, static_cast<size_t>(mesh.indexCount));
+        }
+        planet->generate();
+        const uint64_t terrainKey = planet->getHeightMapKey();
+        
+        auto instance = std::make_unique<PlanetInstance>(
+            std::move(planet), record.position, record.scale, record.color,
+            record.rotationSpeed, record.seed, record.type
+        );
+        instance->currentRotation = record.currentRotation;
+        instance->orbitRadius = record.orbitRadius;
+        instance->orbitSpeed = record.orbitSpeed;
+        instance->currentOrbitAngle = record.currentOrbitAngle;
+        instance->orbitCenter = record.orbitCenter;
+        instance->orbitInclination = record.orbitInclination;
+        instance->orbitEccentricity = record.orbitEccentricity;
+        
+        // Stored biomes spare the height cubemap and the climate bake, unless the terrain or climate code changed
+        const size_t biomeCount = size_t(6) * Planet::HEIGHT_MAP_SIZE * Planet::HEIGHT_MAP_SIZE;
+        if (record.biomeCount == biomeCount &&
+            record.biomeKey == PlanetBiomes::getKey(terrainKey, record.seed, record.type, Planet::HEIGHT_MAP_SIZE)) {
+            auto first = biomes.begin() + record.firstBiome;
+            instance->biomes.assign(first, first + record.biomeCount);
+            instance->biomeTerrainKey = terrainKey;
+        }
+        
+        for (const auto& moonRecord : moons.subspan(record.firstMoon, record.moonCount)) {
+            auto moon = std::make_unique<Moon>(moonRecord.radius, moonRecord.orbitRadius, moonRecord.orbitSpeed,
+                                               moonRecord.color, PlanetManager::MOON_RESOLUTION);
+            moon->setOrbitInclination(moonRecord.orbitInclination);
+            moon->setOrbitAngle(moonRecord.orbitAngle);
+            instance->moons.push_back(std::move(moon));
+        }
+        
+        planetManager_->addPlanetInstance(std::move(instance));
+    }
+    
+    // Asteroid belts
+    auto asteroids = snapshot.getAsteroids();
+    for (const auto& record : snapshot.getBelts()) {
+        auto first = asteroids.begin() + record.firstAsteroid;
+        auto belt = std::make_unique<AsteroidBelt>(
+            record.innerRadius, record.outerRadius,
+            std::vector<Asteroid>(first, first + record.asteroidCount), record.seed
+        );
+        belt->initialize(getAsteroidGeometries(), &asteroidLODLevels_);
+        asteroidBelts_.push_back(std::move(belt));
+    }
+    
+    // Planetary rings
+    auto ringParticles = snapshot.getRingParticles();
+    for (const auto& record : snapshot.getRings()) {
+        auto first = ringParticles.begin() + record.firstParticle;
+        auto rings = std::make_unique<PlanetaryRings>(
+            record.planetPosition, record.planetRadius, record.innerRadius, record.outerRadius,
+            std::vector<RingParticle>(first, first + record.particleCount), record.seed
+        );
+        rings->initialize();
+        planetaryRings_.push_back(std::move(rings));
+    }
+    
+    // Particle systems with their live pools
+    auto particles = snapshot.getParticles();
+    for (const auto& record : snapshot.getParticleSystems()) {
+        if (record.type < static_cast<int32_t>(ParticleType::SOLAR_FLARE) ||
+            record.type > static_cast<int32_t>(ParticleType::CORONA_PARTICLES)) {
+            spdlog::error("Snapshot contains unknown particle type {}", record.type);
+            return false;
+        }
+        
+        auto particleSystem = std::make_unique<ParticleSystem>(
+            record.origin, static_cast<ParticleType>(record.type), record.maxParticles
+        );
+        particleSystem->initialize();
+        particleSystem->setEmissionRate(record.emissionRate);
+        particleSystem->restoreParticles(particles.data() + record.firstParticle,
+                                         static_cast<size_t>(record.particleCount));
+        particleSystems_.push_back(std::move(particleSystem));
+    }
+    
+    spdlog::info("Restored {} planets, {} asteroid belts, {} ring systems, {} particle systems from snapshot ({:.1f} KB)",
+                 planetManager_->getPlanetCount(), asteroidBelts_.size(), planetaryRings_.size(),
+                 particleSystems_.size(), snapshot.getSize() / 1024.0);
+    return true;
+}
+
+bool SolarSystemManager::writeSnapshot(const std::string& filename, uint64_t key) const {
+    if (!sun_ || !planetManager_) {
+        return false;
+    }
+    
+    SystemSnapshot::Contents contents;
+    contents.sun = {sun_->getColor(), sun_->getRadius(), sun_->getTemperature()};
+    
+    // Planets, moons and a mesh for every LOD the renderer can switch to
+    const std::vector<int> lodResolutions = planetManager_->getLODResolutions();
+    std::vector<Geometry::Vertex> lodVertices;
+    std::vector<unsigned int> lodIndices;
+    
+    for (size_t i = 0; i < planetManager_->getPlanetCount(); ++i) {
+        const PlanetInstance* instance = planetManager_->getPlanet(i);
+        const Planet* planet = instance->planet.get();
+        
+        SystemSnapshot::PlanetRecord record{};
+        record.position = instance->position;
+        record.color = instance->color;
+        record.orbitCenter = instance->orbitCenter;
+        record.scale = instance->scale;
+        record.rotationSpeed = instance->rotationSpeed;
+        record.currentRotation = instance->currentRotation;
+        record.seed = instance->seed;
+        record.type = instance->type;
+        record.orbitRadius = instance->orbitRadius;
+        record.orbitSpeed = instance->orbitSpeed;
+        record.currentOrbitAngle = instance->currentOrbitAngle;
+        record.orbitInclination = instance->orbitInclination;
+        record.orbitEccentricity = instance->orbitEccentricity;
+        record.radius = planet->getRadius();
+        record.heightScale = planet->getHeightScale();
+        record.noiseFrequency = planet->getNoiseFrequency();
+        record.noiseOctaves = planet->getNoiseOctaves();
+        record.resolution = planet->getResolution();
+        
+        record.firstMoon = static_cast<uint32_t>(contents.moons.size());
+        record.moonCount = static_cast<uint32_t>(instance->moons.size());
+        for (const auto& moon : instance->moons) {
+            contents.moons.push_back({moon->getColor(), moon->getRadius(), moon->getOrbitRadius(),
+                                      moon->getOrbitSpeed(), moon->getOrbitInclination(), moon->getOrbitAngle()});
+        }
+        
+        record.firstMesh = static_cast<uint32_t>(contents.meshes.size());
+        record.meshCount = static_cast<uint32_t>(lodResolutions.size());
+        for (int resolution : lodResolutions) {
+            // A shader-displaced planet's geometry is the shared undisplaced grid, never its terrain
+            const Geometry* geometry = planet->getGeometry();
+            const bool current = !planet->usesShaderDisplacement() && resolution == planet->getResolution() &&
+                                 geometry && geometry->getVertexCount() > 0;
+            if (!current) {
+                planet->buildMesh(resolution, lodVertices, lodIndices);
+            }
+            const auto& meshVertices = current ? geometry->getVertices() : lodVertices;
+            const auto& meshIndices = current ? geometry->getIndices() : lodIndices;
+            
+            SystemSnapshot::MeshRecord mesh{};
+            mesh.resolution = resolution;
+            mesh.firstVertex = contents.vertices.size();
+            mesh.vertexCount = meshVertices.size();
+            mesh.firstIndex = contents.indices.size();
+            mesh.indexCount = meshIndices.size();
+            contents.meshes.push_back(mesh);
+            
+            contents.vertices.insert(contents.vertices.end(), meshVertices.begin(), meshVertices.end());
+            contents.indices.insert(contents.indices.end(), meshIndices.begin(), meshIndices.end());
+        }
+        
+        record.firstBiome = contents.biomes.size();
+        if (!instance->biomes.empty()) {
+            record.biomeKey = PlanetBiomes::getKey(instance->biomeTerrainKey, instance->seed, instance->type,
+                                                   Planet::HEIGHT_MAP_SIZE);
+            record.biomeCount = instance->biomes.size();
+            contents.biomes.insert(contents.biomes.end(), instance->biomes.begin(), instance->biomes.end());
+        }
+        
+        contents.planets.push_back(record);
+    }
+    
+    // Asteroid belts
+    for (const auto& belt : asteroidBelts_) {
+        const auto& asteroids = belt->getAsteroids();
+        SystemSnapshot::BeltRecord record{};
+        record.innerRadius = belt->getInnerRadius();
+        record.outerRadius = belt->getOuterRadius();
+        record.seed = belt->getSeed();
+        record.firstAsteroid = contents.asteroids.size();
+        record.asteroidCount = asteroids.size();
+        contents.belts.push_back(record);
+        contents.asteroids.insert(contents.asteroids.end(), asteroids.begin(), asteroids.end());
+    }
+    
+    // Planetary rings
+    for (const auto& rings : planetaryRings_) {
+        const auto& particles = rings->getParticles();
+        SystemSnapshot::RingRecord record{};
+        record.planetPosition = rings->getPlanetPosition();
+        record.planetRadius = rings->getPlanetRadius();
+        record.innerRadius = rings->getInnerRadius();
+        record.outerRadius = rings->getOuterRadius();
+        record.seed = rings->getSeed();
+        record.firstParticle = contents.ringParticles.size();
+        record.particleCount = particles.size();
+        contents.rings.push_back(record);
+        contents.ringParticles.insert(contents.ringParticles.end(), particles.begin(), particles.end());
+    }
+    
+    // Particle systems
+    for (const auto& particleSystem : particleSystems_) {
+        const auto& particles = particleSystem->getParticles();
+        SystemSnapshot::ParticleSystemRecord record{};
+        record.origin = particleSystem->getOrigin();
+        record.type = static_cast<int32_t>(particleSystem->getType());
+        record.maxParticles = particleSystem->getMaxParticles();
+        record.emissionRate = particleSystem->getBaseEmissionRate();
+        record.firstParticle = contents.particles.size();
+        record.particleCount = particles.size();
+        contents.particleSystems.push_back(record);
+        contents.particles.insert(contents.particles.end(), particles.begin(), particles.end());
+    }
+    
+    return SystemSnapshot::write(filename, key, contents);
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 #include <glm/glm.hpp>
+#include "ScreenSpaceLOD.hpp"
 
 class Sun;
 class PlanetManager;
@@ -11,8 +14,12 @@ class PlanetaryRings;
 class ParticleSystem;
 class Noise;
 class Shader;
+class ShaderVariants;
 class Camera;
 class Geometry;
+class SystemSnapshot;
+class ClusteredLighting;
+struct PointLight;
 
 /**
  * @brief Manages the entire solar system including Sun, planets, and their interactions
@@ -49,19 +56,21 @@ public:
     
     /**
      * @brief Render the entire solar system
-     * @param planetShader Shader for rendering planets
+     * @param planetShaders Planet shader variants (see PlanetManager::getShaderVariant)
      * @param sunShader Shader for rendering the sun
      * @param asteroidShader Shader for rendering asteroids
      * @param ringShader Shader for rendering planetary rings
-     * @param particleShader Shader for rendering particle systems
+     * @param particleShaders Particle shader variants, one per particle type
      * @param camera Camera for rendering
      * @param view View matrix
      * @param projection Projection matrix
      * @param viewPos Camera position
+     * @param viewportHeight Height of the render target in pixels, for the LOD screen-space error
      */
-    void render(Shader* planetShader, Shader* sunShader, Shader* asteroidShader, 
-                Shader* ringShader, Shader* particleShader, const Camera* camera, 
-                const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos);
+    void render(ShaderVariants* planetShaders, Shader* sunShader, Shader* asteroidShader, 
+                Shader* ringShader, ShaderVariants* particleShaders, const Camera* camera, 
+                const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos,
+                int viewportHeight);
     
     /**
      * @brief Get the sun's position (light source)
@@ -73,6 +82,16 @@ public:
      */
     glm::vec3 getSunLightColor() const;
     
+    /**
+     * @brief Get the clustered point lights of the last rendered frame
+     */
+    const ClusteredLighting* getClusteredLighting() const { return clusteredLighting_.get(); }
+    
+    /**
+     * @brief Get the level-of-detail selection of the last rendered frame
+     */
+    const ScreenSpaceLOD& getLOD() const { return lod_; }
+    
     /**
      * @brief Get the planet manager for direct access
      */
@@ -112,6 +131,12 @@ public:
      */
     int getSeed() const { return currentSeed_; }
     
+    /**
+     * @brief Get the planet count requested for the current system
+     * @return Requested planet count
+     */
+    int getRequestedPlanetCount() const { return currentPlanetCount_; }
+    
     /**
      * @brief Get the system scale factor
      * @return Current system scale
@@ -196,16 +221,50 @@ public:
      */
     void setParticleEmissionRate(float rate);
 
+    /**
+     * @brief Set the directory used for generated system snapshots
+     * @param directory Snapshot directory (empty disables snapshots)
+     */
+    void setSnapshotDirectory(const std::string& directory) { snapshotDirectory_ = directory; }
+
+    /**
+     * @brief Get the snapshot directory
+     * @return Current snapshot directory
+     */
+    const std::string& getSnapshotDirectory() const { return snapshotDirectory_; }
+
+    /**
+     * @brief Enable or disable loading and writing system snapshots
+     * @param enabled Whether generateSolarSystem may use snapshots
+     */
+    void setSnapshotsEnabled(bool enabled) { snapshotsEnabled_ = enabled; }
+
+    /**
+     * @brief Check if system snapshots are enabled
+     * @return True if snapshots are enabled
+     */
+    bool areSnapshotsEnabled() const { return snapshotsEnabled_; }
+
 private:
+    // Declared first so the mapping outlives every object that references it
+    std::unique_ptr<SystemSnapshot> snapshot_;
+    std::string snapshotDirectory_;
+    bool snapshotsEnabled_;
+
     std::unique_ptr<Sun> sun_;
     std::unique_ptr<PlanetManager> planetManager_;
     std::vector<std::unique_ptr<AsteroidBelt>> asteroidBelts_;
     std::vector<std::unique_ptr<PlanetaryRings>> planetaryRings_;
     std::vector<std::unique_ptr<ParticleSystem>> particleSystems_;
-    std::unique_ptr<Geometry> asteroidGeometry_;
+    std::vector<std::unique_ptr<Geometry>> asteroidGeometries_; // Shared asteroid meshes, coarsest first
+    std::vector<ScreenSpaceLOD::Level> asteroidLODLevels_;
+    ScreenSpaceLOD lod_;
+    std::unique_ptr<ClusteredLighting> clusteredLighting_;
+    std::vector<PointLight> pointLights_; // Lights of the current frame, kept to reuse the allocation
     Noise* noise_;
     
     int currentSeed_;        // Current system seed
+    int currentPlanetCount_; // Planet count requested for the current system
     float systemScale_;     // Scale factor for the entire system
     float timeScale_;       // Time scale for orbital motion
     bool initialized_;
@@ -239,4 +298,30 @@ private:
      * @param systemSeed Seed for generation
      */
     void generateParticleSystems(int systemSeed);
+    
+    /**
+     * @brief Get the shared asteroid meshes to hand to a belt
+     * @return std::vector<Geometry*> Meshes, coarsest first
+     */
+    std::vector<Geometry*> getAsteroidGeometries() const;
+    
+    /**
+     * @brief Apply visibility, density and emission settings to freshly built subsystems
+     */
+    void applySubsystemSettings();
+    
+    /**
+     * @brief Rebuild the whole system from a mapped snapshot
+     * @param snapshot Validated snapshot; must stay alive while the system uses it
+     * @return true if every subsystem was restored
+     */
+    bool restoreFromSnapshot(const SystemSnapshot& snapshot);
+    
+    /**
+     * @brief Capture the current system (including all planet LOD meshes) to disk
+     * @param filename Snapshot file path
+     * @param key Snapshot key
+     * @return true if successful
+     */
+    bool writeSnapshot(const std::string& filename, uint64_t key) const;
 };
\ No newline at end of file
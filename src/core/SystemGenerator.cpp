@@ -0,0 +1,323 @@
+#include "SystemGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+SystemLayout SystemGenerator::generate(int systemSeed, int planetCount) {
+    SystemLayout layout;
+    layout.sun = generateSun(systemSeed);
+    layout.placementFailures = generatePlanets(systemSeed, planetCount, layout.planets);
+    for (auto& planet : layout.planets) {
+        // PlanetManager instances are always created at scale 1
+        planet.moons = generateMoons(planet.type, 1.0f, planet.seed);
+    }
+    layout.belts = generateAsteroidBelts(systemSeed);
+    layout.rings = generatePlanetaryRings(systemSeed);
+    return layout;
+}
+
+SunLayout SystemGenerator::generateSun(int systemSeed) {
+    std::mt19937 rng(systemSeed);
+    std::uniform_real_distribution<float> sizeDist(12.0f, 16.0f); // Much larger sun
+    std::uniform_real_distribution<float> tempDist(5500.0f, 6000.0f); // Keep it in yellow range
+    std::uniform_real_distribution<float> colorVariation(0.9f, 1.1f);
+
+    SunLayout sun;
+    sun.radius = sizeDist(rng);
+    sun.temperature = tempDist(rng);
+
+    // Color based on temperature - make it more yellow/orange
+    if (sun.temperature < 5700.0f) {
+        sun.color = glm::vec3(1.0f, 0.8f, 0.4f) * colorVariation(rng); // Orange-yellow
+    } else if (sun.temperature < 5900.0f) {
+        sun.color = glm::vec3(1.0f, 0.9f, 0.6f) * colorVariation(rng); // Yellow
+    } else {
+        sun.color = glm::vec3(1.0f, 0.95f, 0.8f) * colorVariation(rng); // Warm yellow
+    }
+    return sun;
+}
+
+int SystemGenerator::generatePlanets(int systemSeed, int planetCount, std::vector<PlanetLayout>& planets) {
+    planets.clear();
+    planets.reserve(static_cast<size_t>(std::max(planetCount, 0)));
+
+    std::mt19937 rng(systemSeed);
+    std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159f);
+    std::uniform_real_distribution<float> distanceDist(25.0f, 120.0f);
+    std::uniform_real_distribution<float> heightDist(-10.0f, 10.0f);
+
+    int failures = 0;
+    for (int i = 0; i < planetCount; ++i) {
+        glm::vec3 position;
+        bool validPosition = false;
+        int attempts = 0;
+        const int maxAttempts = 50;
+
+        do {
+            // Generate orbital position
+            float angle = angleDist(rng);
+            float distance = distanceDist(rng);
+            float height = heightDist(rng);
+
+            position = glm::vec3(
+                distance * cos(angle),
+                height,
+                distance * sin(angle)
+            );
+
+            // Generate planet properties based on distance and seed
+            int planetSeed = systemSeed + i * 1000 + attempts;
+            float radius = generatePlanetProperties(planetSeed, distance).radius;
+
+            // Check for collisions with existing planets
+            validPosition = true;
+            for (const auto& existing : planets) {
+                float minDistance = radius + existing.radius + 5.0f; // 5 unit buffer
+                float actualDistance = glm::length(position - existing.position);
+
+                if (actualDistance < minDistance) {
+                    validPosition = false;
+                    break;
+                }
+            }
+
+            attempts++;
+        } while (!validPosition && attempts < maxAttempts);
+
+        if (!validPosition) {
+            ++failures;
+            continue;
+        }
+
+        // Generate final planet properties
+        PlanetLayout planet;
+        planet.position = position;
+        planet.index = i;
+        planet.seed = systemSeed + i * 1000;
+        planet.attempts = attempts;
+        PlanetProperties properties = generatePlanetProperties(planet.seed, glm::length(position));
+        planet.radius = properties.radius;
+        planet.color = properties.color;
+        planet.rotationSpeed = properties.rotationSpeed;
+        planet.type = properties.type;
+        planets.push_back(planet);
+    }
+    return failures;
+}
+
+SystemGenerator::PlanetProperties SystemGenerator::generatePlanetProperties(int seed, float distance) {
+    std::mt19937 rng(seed);
+
+    // Determine planet type based on distance from center
+    int planetType = 0; // Default to rocky
+    if (distance < 50.0f) {
+        // Inner system: rocky or desert planets
+        std::uniform_int_distribution<int> innerTypeDist(0, 3);
+        int typeChoice = innerTypeDist(rng);
+        planetType = (typeChoice <= 1) ? 0 : 3; // 50% rocky, 50% desert
+    } else if (distance < 150.0f) {
+        // Middle system: rocky, ice, or desert
+        std::uniform_int_distribution<int> midTypeDist(0, 2);
+        planetType = midTypeDist(rng); // rocky, gas, or ice
+    } else {
+        // Outer system: gas giants and ice planets
+        std::uniform_int_distribution<int> outerTypeDist(0, 1);
+        planetType = (outerTypeDist(rng) == 0) ? 1 : 2; // gas or ice
+    }
+
+    // Planet radius based on distance and type - more realistic distribution
+    float radius;
+    if (distance < 50.0f) {
+        // Inner planets: smaller, rocky worlds
+        std::uniform_real_distribution<float> innerRadiusDist(0.8f, 2.5f);
+        radius = innerRadiusDist(rng);
+    } else if (distance < 100.0f) {
+        // Middle system: medium-sized planets
+        std::uniform_real_distribution<float> midRadiusDist(1.5f, 4.0f);
+        radius = midRadiusDist(rng);
+    } else {
+        // Outer system: larger planets, especially gas giants
+        std::uniform_real_distribution<float> outerRadiusDist(2.0f, 8.0f);
+        radius = outerRadiusDist(rng);
+    }
+
+    // Adjust radius based on type
+    if (planetType == 1) { // Gas giants are much larger
+        radius *= 2.2f;
+    } else if (planetType == 2) { // Ice planets are medium-large
+        radius *= 1.4f;
+    }
+
+    // Generate planet color based on type (will be overridden by shader)
+    glm::vec3 color;
+    switch(planetType) {
+        case 0: // Rocky
+            color = glm::vec3(0.6f, 0.5f, 0.4f);
+            break;
+        case 1: // Gas giant
+            color = glm::vec3(0.8f, 0.6f, 0.3f);
+            break;
+        case 2: // Ice
+            color = glm::vec3(0.7f, 0.8f, 0.9f);
+            break;
+        case 3: // Desert
+            color = glm::vec3(0.8f, 0.7f, 0.4f);
+            break;
+        default:
+            color = glm::vec3(0.5f, 0.5f, 0.5f);
+    }
+
+    // Add some variation to color
+    std::uniform_real_distribution<float> colorVariation(-0.1f, 0.1f);
+    color.r = std::clamp(color.r + colorVariation(rng), 0.2f, 1.0f);
+    color.g = std::clamp(color.g + colorVariation(rng), 0.2f, 1.0f);
+    color.b = std::clamp(color.b + colorVariation(rng), 0.2f, 1.0f);
+
+    // Rotation speed (smaller planets rotate faster, gas giants slower)
+    std::uniform_real_distribution<float> rotationDist(0.1f, 2.0f);
+    float rotationSpeed = rotationDist(rng) / radius;
+    if (planetType == 1) { // Gas giants rotate slower
+        rotationSpeed *= 0.5f;
+    }
+
+    PlanetProperties properties;
+    properties.radius = radius;
+    properties.color = color;
+    properties.rotationSpeed = rotationSpeed;
+    properties.type = planetType;
+    return properties;
+}
+
+std::vector<MoonLayout> SystemGenerator::generateMoons(int type, float scale, int seed) {
+    std::mt19937 rng(seed + 54321); // Different seed offset for moons
+
+    // Determine number of moons based on planet type and size
+    int maxMoons = 0;
+    if (type == 1) { // Gas giants
+        maxMoons = 4; // Gas giants can have more moons
+    } else if (scale > 8.0f) { // Large planets
+        maxMoons = 3;
+    } else if (scale > 5.0f) { // Medium planets
+        maxMoons = 2;
+    } else { // Small planets
+        maxMoons = 1;
+    }
+
+    std::uniform_int_distribution<int> moonCountDist(0, maxMoons);
+    int moonCount = moonCountDist(rng);
+
+    std::vector<MoonLayout> moons;
+    moons.reserve(static_cast<size_t>(moonCount));
+    for (int i = 0; i < moonCount; ++i) {
+        // Moon properties
+        std::uniform_real_distribution<float> radiusDist(1.0f, scale * 0.3f); // Moon size relative to planet
+        std::uniform_real_distribution<float> orbitDist(scale * 2.0f, scale * 6.0f); // Orbit distance
+        std::uniform_real_distribution<float> speedDist(0.5f, 2.0f); // Orbital speed
+        std::uniform_real_distribution<float> colorVariation(0.6f, 1.0f);
+
+        MoonLayout moon;
+        moon.radius = radiusDist(rng);
+        moon.orbitRadius = orbitDist(rng);
+        moon.orbitSpeed = speedDist(rng);
+
+        // Moon color (grayish with some variation)
+        moon.color = glm::vec3(
+            colorVariation(rng) * 0.8f,
+            colorVariation(rng) * 0.8f,
+            colorVariation(rng) * 0.8f
+        );
+        moons.push_back(moon);
+    }
+    return moons;
+}
+
+TerrainPostProcess::Settings SystemGenerator::generateTerrainFeatures(int type, int seed) {
+    std::mt19937 rng(seed + 31337); // Different seed offset for terrain features
+    TerrainPostProcess::Settings settings;
+    settings.seed = static_cast<uint32_t>(seed);
+
+    switch (type) {
+        case 0: { // Rocky: cratered highlands worn down by water
+            std::uniform_int_distribution<int> craterDist(20, 60);
+            settings.craterCount = craterDist(rng);
+            settings.craterMaxRadius = 0.25f;
+            settings.craterDepth = 0.4f;
+            settings.thermalIterations = 12;
+            settings.talusSlope = 2.0f;
+            settings.droplets = 30000;
+            settings.erosionRate = 0.3f;
+            break;
+        }
+        case 2: { // Ice: few shallow craters, slumped slopes
+            std::uniform_int_distribution<int> craterDist(5, 20);
+            settings.craterCount = craterDist(rng);
+            settings.craterMaxRadius = 0.15f;
+            settings.craterDepth = 0.25f;
+            settings.thermalIterations = 6;
+            settings.talusSlope = 3.0f;
+            break;
+        }
+        case 3: { // Desert: many craters, loose material and little water
+            std::uniform_int_distribution<int> craterDist(40, 100);
+            settings.craterCount = craterDist(rng);
+            settings.craterMaxRadius = 0.2f;
+            settings.craterDepth = 0.3f;
+            settings.thermalIterations = 24;
+            settings.talusSlope = 1.0f;
+            settings.droplets = 15000;
+            settings.erosionRate = 0.2f;
+            break;
+        }
+        default: // Gas giants have no surface
+            break;
+    }
+    return settings;
+}
+
+std::vector<AsteroidBeltLayout> SystemGenerator::generateAsteroidBelts(int systemSeed) {
+    std::mt19937 rng(systemSeed + 1000); // Different seed for asteroids
+    std::uniform_int_distribution<int> beltCountDist(1, 3);
+    std::uniform_real_distribution<float> innerRadiusDist(40.0f, 80.0f);
+    std::uniform_real_distribution<float> widthDist(15.0f, 30.0f);
+    std::uniform_int_distribution<int> asteroidCountDist(200, 800);
+
+    int beltCount = beltCountDist(rng);
+
+    std::vector<AsteroidBeltLayout> belts;
+    belts.reserve(static_cast<size_t>(beltCount));
+    for (int i = 0; i < beltCount; ++i) {
+        AsteroidBeltLayout belt;
+        belt.innerRadius = innerRadiusDist(rng) + i * 50.0f; // Space belts apart
+        belt.outerRadius = belt.innerRadius + widthDist(rng);
+        belt.asteroidCount = asteroidCountDist(rng);
+        belt.seed = systemSeed + i;
+        belts.push_back(belt);
+    }
+    return belts;
+}
+
+std::vector<RingLayout> SystemGenerator::generatePlanetaryRings(int systemSeed) {
+    std::mt19937 rng(systemSeed + 2000); // Different seed for rings
+    std::uniform_real_distribution<float> ringChance(0.0f, 1.0f);
+    std::uniform_real_distribution<float> ringWidthDist(2.0f, 8.0f);
+    std::uniform_int_distribution<int> particleCountDist(500, 2000);
+
+    // Rings are not attached to generated planets yet; they sit at typical gas giant distances
+    static const float gasGiantDistances[] = {60.0f, 95.0f, 130.0f};
+    static const float gasGiantRadii[] = {8.0f, 12.0f, 10.0f};
+
+    std::vector<RingLayout> rings;
+    for (size_t i = 0; i < 3; ++i) {
+        if (ringChance(rng) > 0.4f) { // 60% chance for rings
+            RingLayout ring;
+            ring.planetRadius = gasGiantRadii[i];
+            ring.innerRadius = ring.planetRadius * 1.5f;
+            ring.outerRadius = ring.innerRadius + ringWidthDist(rng);
+            ring.particleCount = particleCountDist(rng);
+            ring.planetPosition = glm::vec3(gasGiantDistances[i], 0.0f, 0.0f); // Simplified position
+            ring.seed = systemSeed + static_cast<int>(i);
+            rings.push_back(ring);
+        }
+    }
+    return rings;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <glm/glm.hpp>
+#include "TerrainPostProcess.hpp"
+
+/**
+ * @brief Generated parameters of a moon
+ */
+struct MoonLayout {
+    float radius = 0.0f;
+    float orbitRadius = 0.0f;
+    float orbitSpeed = 0.0f;
+    glm::vec3 color{0.0f};
+};
+
+/**
+ * @brief Generated parameters of a planet, before any mesh is built
+ */
+struct PlanetLayout {
+    glm::vec3 position{0.0f};
+    float radius = 0.0f;
+    glm::vec3 color{0.0f};
+    float rotationSpeed = 0.0f;
+    int index = 0;        // Slot in the requested planet list
+    int seed = 0;
+    int type = 0;         // 0=rocky, 1=gas, 2=ice, 3=desert
+    int attempts = 0;     // Placement attempts until a free orbit was found
+    std::vector<MoonLayout> moons;
+};
+
+/**
+ * @brief Generated parameters of the central star
+ */
+struct SunLayout {
+    float radius = 0.0f;
+    float temperature = 0.0f;
+    glm::vec3 color{1.0f};
+};
+
+/**
+ * @brief Generated parameters of an asteroid belt
+ */
+struct AsteroidBeltLayout {
+    float innerRadius = 0.0f;
+    float outerRadius = 0.0f;
+    int asteroidCount = 0;
+    int seed = 0;
+};
+
+/**
+ * @brief Generated parameters of a planetary ring system
+ */
+struct RingLayout {
+    glm::vec3 planetPosition{0.0f};
+    float planetRadius = 0.0f;
+    float innerRadius = 0.0f;
+    float outerRadius = 0.0f;
+    int particleCount = 0;
+    int seed = 0;
+};
+
+/**
+ * @brief Everything the generator decides for one system seed
+ */
+struct SystemLayout {
+    SunLayout sun;
+    std::vector<PlanetLayout> planets;
+    int placementFailures = 0; // Planets dropped because no free orbit was found
+    std::vector<AsteroidBeltLayout> belts;
+    std::vector<RingLayout> rings;
+};
+
+/**
+ * @brief Seed-driven solar system layout, independent of meshes and OpenGL
+ *
+ * SolarSystemManager and PlanetManager build their objects from these
+ * layouts, and the seed sweep tool samples them directly to collect
+ * distribution statistics. All functions are pure and thread-safe, and they
+ * do not log, so they can be called millions of times.
+ */
+class SystemGenerator {
+public:
+    /**
+     * @brief Derived properties of a planet at a given orbit distance
+     */
+    struct PlanetProperties {
+        float radius = 0.0f;
+        glm::vec3 color{0.0f};
+        float rotationSpeed = 0.0f;
+        int type = 0;
+    };
+
+    /**
+     * @brief Generate the full layout of a system
+     * @param systemSeed Seed for the entire system
+     * @param planetCount Number of planets to place
+     * @return SystemLayout Sun, planets with their moons, belts and rings
+     */
+    static SystemLayout generate(int systemSeed, int planetCount);
+
+    /**
+     * @brief Generate the central star
+     * @param systemSeed Seed for the entire system
+     * @return SunLayout Star parameters
+     */
+    static SunLayout generateSun(int systemSeed);
+
+    /**
+     * @brief Place planets on non-overlapping orbits
+     * @param systemSeed Seed for the entire system
+     * @param planetCount Number of planets to place
+     * @param planets Receives the placed planets, without moons
+     * @return int Number of planets that could not be placed
+     */
+    static int generatePlanets(int systemSeed, int planetCount, std::vector<PlanetLayout>& planets);
+
+    /**
+     * @brief Generate random planet properties based on seed
+     * @param seed Planet seed
+     * @param distance Distance from system center
+     * @return PlanetProperties Radius, color, rotation speed and type
+     */
+    static PlanetProperties generatePlanetProperties(int seed, float distance);
+
+    /**
+     * @brief Generate the moons of a planet
+     * @param type Planet type
+     * @param scale Planet instance scale
+     * @param seed Planet seed
+     * @return std::vector<MoonLayout> Moons, possibly empty
+     */
+    static std::vector<MoonLayout> generateMoons(int type, float scale, int seed);
+
+    /**
+     * @brief Generate the crater and erosion settings of a planet's terrain
+     * @param type Planet type
+     * @param seed Planet seed
+     * @return TerrainPostProcess::Settings Settings, disabled for gas giants
+     */
+    static TerrainPostProcess::Settings generateTerrainFeatures(int type, int seed);
+
+    /**
+     * @brief Generate the asteroid belts of a system
+     * @param systemSeed Seed for the entire system
+     * @return std::vector<AsteroidBeltLayout> One to three belts
+     */
+    static std::vector<AsteroidBeltLayout> generateAsteroidBelts(int systemSeed);
+
+    /**
+     * @brief Generate the planetary ring systems of a system
+     * @param systemSeed Seed for the entire system
+     * @return std::vector<RingLayout> Ring systems, possibly empty
+     */
+    static std::vector<RingLayout> generatePlanetaryRings(int systemSeed);
+};
@@ -0,0 +1,266 @@
+#include "SystemSnapshot.hpp"
+#include "MappedFile.hpp"
+#include "Hasher.hpp"
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+namespace {
+
+enum Section : uint32_t {
+    SECTION_SUN = 0,
+    SECTION_PLANETS,
+    SECTION_MOONS,
+    SECTION_MESHES,
+    SECTION_VERTICES,
+    SECTION_INDICES,
+    SECTION_BELTS,
+    SECTION_ASTEROIDS,
+    SECTION_RINGS,
+    SECTION_RING_PARTICLES,
+    SECTION_PARTICLE_SYSTEMS,
+    SECTION_PARTICLES,
+    SECTION_BIOMES,
+    SECTION_COUNT
+};
+
+struct SectionEntry {
+    uint64_t offset;
+    uint64_t count;
+    uint64_t elementSize;
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t headerSize;
+    uint64_t key;
+    uint64_t payloadHash;
+    uint64_t fileSize;
+    SectionEntry sections[SECTION_COUNT];
+};
+
+constexpr char SNAPSHOT_MAGIC[8] = {'A', 'S', 'T', 'R', 'S', 'N', 'A', 'P'};
+constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+static_assert(std::is_trivially_copyable_v<Vertex>, "Vertex must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<Asteroid>, "Asteroid must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<RingParticle>, "RingParticle must be trivially copyable");
+static_assert(std::is_trivially_copyable_v<Particle>, "Particle must be trivially copyable");
+
+uint64_t alignUp(uint64_t value) {
+    return (value + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Validate a section entry and return a typed view of it
+ */
+template<typename T>
+bool mapSection(const MappedFile& file, const SnapshotHeader& header, Section section,
+                std::span<const T>& out) {
+    const SectionEntry& entry = header.sections[section];
+    if (entry.elementSize != sizeof(T) || entry.offset % alignof(T) != 0) {
+        return false;
+    }
+    if (entry.offset > file.size() || entry.count > (file.size() - entry.offset) / sizeof(T)) {
+        return false;
+    }
+    out = std::span<const T>(reinterpret_cast<const T*>(file.data() + entry.offset),
+                             static_cast<size_t>(entry.count));
+    return true;
+}
+
+} // namespace
+
+SystemSnapshot::SystemSnapshot() = default;
+SystemSnapshot::~SystemSnapshot() = default;
+
+uint64_t SystemSnapshot::computeKey(int systemSeed, int planetCount, uint64_t noiseSettingsHash) {
+    return Hasher()
+        .add(FORMAT_VERSION)
+        .add(GENERATOR_VERSION)
+        .add(systemSeed)
+        .add(planetCount)
+        .add(noiseSettingsHash)
+        .get();
+}
+
+std::string SystemSnapshot::getSnapshotPath(const std::string& directory, uint64_t key) {
+    char name[40];
+    std::snprintf(name, sizeof(name), "system_%016llx.snap", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+bool SystemSnapshot::write(const std::string& filename, uint64_t key, const Contents& contents) {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.key = key;
+
+    struct Blob {
+        const void* data;
+        uint64_t count;
+        uint64_t elementSize;
+    };
+    const Blob blobs[SECTION_COUNT] = {
+        {&contents.sun, 1, sizeof(SunRecord)},
+        {contents.planets.data(), contents.planets.size(), sizeof(PlanetRecord)},
+        {contents.moons.data(), contents.moons.size(), sizeof(MoonRecord)},
+        {contents.meshes.data(), contents.meshes.size(), sizeof(MeshRecord)},
+        {contents.vertices.data(), contents.vertices.size(), sizeof(Vertex)},
+        {contents.indices.data(), contents.indices.size(), sizeof(unsigned int)},
+        {contents.belts.data(), contents.belts.size(), sizeof(BeltRecord)},
+        {contents.asteroids.data(), contents.asteroids.size(), sizeof(Asteroid)},
+        {contents.rings.data(), contents.rings.size(), sizeof(RingRecord)},
+        {contents.ringParticles.data(), contents.ringParticles.size(), sizeof(RingParticle)},
+        {contents.particleSystems.data(), contents.particleSystems.size(), sizeof(ParticleSystemRecord)},
+        {contents.particles.data(), contents.particles.size(), sizeof(Particle)},
+        {contents.biomes.data(), contents.biomes.size(), sizeof(uint8_t)},
+    };
+
+    // Lay out sections back to back, each aligned for in-place use
+    uint64_t offset = alignUp(sizeof(SnapshotHeader));
+    for (uint32_t i = 0; i < SECTION_COUNT; ++i) {
+        header.sections[i] = {offset, blobs[i].count, blobs[i].elementSize};
+        offset = alignUp(offset + blobs[i].count * blobs[i].elementSize);
+    }
+    header.fileSize = offset;
+
+    // Assemble the payload so it can be hashed before the header is written
+    std::vector<uint8_t> payload(static_cast<size_t>(header.fileSize - alignUp(sizeof(SnapshotHeader))), 0);
+    for (uint32_t i = 0; i < SECTION_COUNT; ++i) {
+        uint64_t bytes = blobs[i].count * blobs[i].elementSize;
+        if (bytes > 0) {
+            std::memcpy(payload.data() + (header.sections[i].offset - alignUp(sizeof(SnapshotHeader))),
+                        blobs[i].data, static_cast<size_t>(bytes));
+        }
+    }
+    header.payloadHash = Hasher::hash(payload.data(), payload.size());
+
+    try {
+        std::filesystem::path path(filename);
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        std::string tempName = filename + ".tmp";
+        {
+            std::ofstream file(tempName, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                spdlog::error("Failed to open snapshot file for writing: {}", tempName);
+                return false;
+            }
+
+            std::vector<char> headerBlock(static_cast<size_t>(alignUp(sizeof(SnapshotHeader))), 0);
+            std::memcpy(headerBlock.data(), &header, sizeof(SnapshotHeader));
+            file.write(headerBlock.data(), static_cast<std::streamsize>(headerBlock.size()));
+            file.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+            if (!file.good()) {
+                spdlog::error("Failed to write snapshot file: {}", tempName);
+                return false;
+            }
+        }
+        std::filesystem::rename(tempName, filename);
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to write snapshot {}: {}", filename, e.what());
+        return false;
+    }
+
+    spdlog::info("System snapshot written: {} ({:.1f} KB)", filename, header.fileSize / 1024.0);
+    return true;
+}
+
+std::unique_ptr<SystemSnapshot> SystemSnapshot::load(const std::string& filename, uint64_t key) {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->open(filename)) {
+        return nullptr;
+    }
+
+    if (file->size() < sizeof(SnapshotHeader)) {
+        spdlog::warn("Snapshot {} is truncated, ignoring", filename);
+        return nullptr;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, file->data(), sizeof(SnapshotHeader));
+
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header.formatVersion != FORMAT_VERSION ||
+        header.headerSize != sizeof(SnapshotHeader)) {
+        spdlog::warn("Snapshot {} has an unsupported format, ignoring", filename);
+        return nullptr;
+    }
+    if (header.key != key) {
+        spdlog::warn("Snapshot {} is stale (key mismatch), ignoring", filename);
+        return nullptr;
+    }
+    if (header.fileSize != file->size()) {
+        spdlog::warn("Snapshot {} size mismatch, ignoring", filename);
+        return nullptr;
+    }
+
+    const size_t payloadOffset = static_cast<size_t>(alignUp(sizeof(SnapshotHeader)));
+    if (Hasher::hash(file->data() + payloadOffset, file->size() - payloadOffset) != header.payloadHash) {
+        spdlog::warn("Snapshot {} failed hash validation, ignoring", filename);
+        return nullptr;
+    }
+
+    std::unique_ptr<SystemSnapshot> snapshot(new SystemSnapshot());
+    std::span<const SunRecord> sun;
+    bool valid = mapSection(*file, header, SECTION_SUN, sun) && sun.size() == 1 &&
+        mapSection(*file, header, SECTION_PLANETS, snapshot->planets_) &&
+        mapSection(*file, header, SECTION_MOONS, snapshot->moons_) &&
+        mapSection(*file, header, SECTION_MESHES, snapshot->meshes_) &&
+        mapSection(*file, header, SECTION_VERTICES, snapshot->vertices_) &&
+        mapSection(*file, header, SECTION_INDICES, snapshot->indices_) &&
+        mapSection(*file, header, SECTION_BELTS, snapshot->belts_) &&
+        mapSection(*file, header, SECTION_ASTEROIDS, snapshot->asteroids_) &&
+        mapSection(*file, header, SECTION_RINGS, snapshot->rings_) &&
+        mapSection(*file, header, SECTION_RING_PARTICLES, snapshot->ringParticles_) &&
+        mapSection(*file, header, SECTION_PARTICLE_SYSTEMS, snapshot->particleSystems_) &&
+        mapSection(*file, header, SECTION_PARTICLES, snapshot->particles_) &&
+        mapSection(*file, header, SECTION_BIOMES, snapshot->biomes_);
+
+    // Cross-check record ranges so consumers can index without bounds checks
+    for (const auto& planet : snapshot->planets_) {
+        if (!valid) break;
+        valid = uint64_t(planet.firstMoon) + planet.moonCount <= snapshot->moons_.size() &&
+                uint64_t(planet.firstMesh) + planet.meshCount <= snapshot->meshes_.size() &&
+                planet.firstBiome <= snapshot->biomes_.size() &&
+                planet.biomeCount <= snapshot->biomes_.size() - planet.firstBiome;
+    }
+    for (const auto& mesh : snapshot->meshes_) {
+        if (!valid) break;
+        valid = mesh.firstVertex + mesh.vertexCount <= snapshot->vertices_.size() &&
+                mesh.firstIndex + mesh.indexCount <= snapshot->indices_.size();
+    }
+    for (const auto& belt : snapshot->belts_) {
+        if (!valid) break;
+        valid = belt.firstAsteroid + belt.asteroidCount <= snapshot->asteroids_.size();
+    }
+    for (const auto& rings : snapshot->rings_) {
+        if (!valid) break;
+        valid = rings.firstParticle + rings.particleCount <= snapshot->ringParticles_.size();
+    }
+    for (const auto& system : snapshot->particleSystems_) {
+        if (!valid) break;
+        valid = system.firstParticle + system.particleCount <= snapshot->particles_.size();
+    }
+
+    if (!valid) {
+        spdlog::warn("Snapshot {} has an invalid section table, ignoring", filename);
+        return nullptr;
+    }
+
+    snapshot->sun_ = sun[0];
+    snapshot->file_ = std::move(file);
+    return snapshot;
+}
+
+size_t SystemSnapshot::getSize() const {
+    return file_ ? file_->size() : 0;
+}
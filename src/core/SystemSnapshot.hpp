@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "SceneRecords.hpp"
+
+class MappedFile;
+
+/**
+ * @brief Versioned binary snapshot of a fully generated solar system
+ *
+ * The file is a fixed header followed by flat arrays of plain records, each
+ * aligned so that it can be used in place from a read-only memory mapping.
+ * Loading a snapshot is therefore a page-in plus GPU upload; no noise is
+ * evaluated and no random distributions are sampled.
+ *
+ * Snapshots are addressed by a key derived from the system seed, planet count,
+ * noise settings and GENERATOR_VERSION. Bump GENERATOR_VERSION whenever the
+ * generation code changes its output so stale snapshots are ignored. The data
+ * is stored in native byte order; the files are a local cache, not an
+ * interchange format.
+ */
+class SystemSnapshot {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+    static constexpr uint32_t GENERATOR_VERSION = 3;
+
+    struct SunRecord {
+        glm::vec3 color;
+        float radius;
+        float temperature;
+    };
+
+    struct PlanetRecord {
+        glm::vec3 position;
+        glm::vec3 color;
+        glm::vec3 orbitCenter;
+        float scale;
+        float rotationSpeed;
+        float currentRotation;
+        int32_t seed;
+        int32_t type;
+        float orbitRadius;
+        float orbitSpeed;
+        float currentOrbitAngle;
+        float orbitInclination;
+        float orbitEccentricity;
+
+        // Terrain parameters of the Planet mesh
+        float radius;
+        float heightScale;
+        float noiseFrequency;
+        int32_t noiseOctaves;
+        int32_t resolution;
+
+        uint32_t firstMoon;
+        uint32_t moonCount;
+        uint32_t firstMesh;
+        uint32_t meshCount;
+
+        // Biome indices, usable while biomeKey matches PlanetBiomes::getKey of the restored terrain
+        uint64_t biomeKey;
+        uint64_t firstBiome;
+        uint64_t biomeCount;
+    };
+
+    struct MoonRecord {
+        glm::vec3 color;
+        float radius;
+        float orbitRadius;
+        float orbitSpeed;
+        float orbitInclination;
+        float orbitAngle;
+    };
+
+    struct MeshRecord {
+        int32_t resolution;
+        uint32_t reserved;
+        uint64_t firstVertex;
+        uint64_t vertexCount;
+        uint64_t firstIndex;
+        uint64_t indexCount;
+    };
+
+    struct BeltRecord {
+        float innerRadius;
+        float outerRadius;
+        int32_t seed;
+        uint32_t reserved;
+        uint64_t firstAsteroid;
+        uint64_t asteroidCount;
+    };
+
+    struct RingRecord {
+        glm::vec3 planetPosition;
+        float planetRadius;
+        float innerRadius;
+        float outerRadius;
+        int32_t seed;
+        uint32_t reserved;
+        uint64_t firstParticle;
+        uint64_t particleCount;
+    };
+
+    struct ParticleSystemRecord {
+        glm::vec3 origin;
+        int32_t type;
+        int32_t maxParticles;
+        float emissionRate;
+        uint64_t firstParticle;
+        uint64_t particleCount;
+    };
+
+    /**
+     * @brief Everything captured from a generated system, used when writing
+     */
+    struct Contents {
+        SunRecord sun{};
+        std::vector<PlanetRecord> planets;
+        std::vector<MoonRecord> moons;
+        std::vector<MeshRecord> meshes;
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        std::vector<BeltRecord> belts;
+        std::vector<Asteroid> asteroids;
+        std::vector<RingRecord> rings;
+        std::vector<RingParticle> ringParticles;
+        std::vector<ParticleSystemRecord> particleSystems;
+        std::vector<Particle> particles;
+        std::vector<uint8_t> biomes;
+    };
+
+    ~SystemSnapshot();
+
+    // Non-copyable, non-movable
+    SystemSnapshot(const SystemSnapshot&) = delete;
+    SystemSnapshot& operator=(const SystemSnapshot&) = delete;
+    SystemSnapshot(SystemSnapshot&&) = delete;
+    SystemSnapshot& operator=(SystemSnapshot&&) = delete;
+
+    /**
+     * @brief Compute the cache key for a system
+     * @param systemSeed Seed passed to generateSolarSystem
+     * @param planetCount Requested planet count
+     * @param noiseSettingsHash Noise::getSettingsHash() of the terrain noise
+     * @return uint64_t Snapshot key
+     */
+    static uint64_t computeKey(int systemSeed, int planetCount, uint64_t noiseSettingsHash);
+
+    /**
+     * @brief Get the snapshot file path for a key
+     * @param directory Snapshot directory
+     * @param key Snapshot key
+     * @return std::string Path of the snapshot file
+     */
+    static std::string getSnapshotPath(const std::string& directory, uint64_t key);
+
+    /**
+     * @brief Write a snapshot atomically (temporary file + rename)
+     * @param filename Target file path
+     * @param key Snapshot key stored in the header
+     * @param contents Captured system data
+     * @return true if successful
+     */
+    static bool write(const std::string& filename, uint64_t key, const Contents& contents);
+
+    /**
+     * @brief Map and validate a snapshot
+     * @param filename Snapshot file path
+     * @param key Expected snapshot key
+     * @return Snapshot, or nullptr if missing, stale or corrupt
+     */
+    static std::unique_ptr<SystemSnapshot> load(const std::string& filename, uint64_t key);
+
+    const SunRecord& getSun() const { return sun_; }
+    std::span<const PlanetRecord> getPlanets() const { return planets_; }
+    std::span<const MoonRecord> getMoons() const { return moons_; }
+    std::span<const MeshRecord> getMeshes() const { return meshes_; }
+    std::span<const Vertex> getVertices() const { return vertices_; }
+    std::span<const unsigned int> getIndices() const { return indices_; }
+    std::span<const BeltRecord> getBelts() const { return belts_; }
+    std::span<const Asteroid> getAsteroids() const { return asteroids_; }
+    std::span<const RingRecord> getRings() const { return rings_; }
+    std::span<const RingParticle> getRingParticles() const { return ringParticles_; }
+    std::span<const ParticleSystemRecord> getParticleSystems() const { return particleSystems_; }
+    std::span<const Particle> getParticles() const { return particles_; }
+    std::span<const uint8_t> getBiomes() const { return biomes_; }
+
+    /**
+     * @brief Get the mapped file size
+     * @return size_t Size in bytes
+     */
+    size_t getSize() const;
+
+private:
+    SystemSnapshot();
+
+    std::unique_ptr<MappedFile> file_;
+
+    SunRecord sun_{};
+    std::span<const PlanetRecord> planets_;
+    std::span<const MoonRecord> moons_;
+    std::span<const MeshRecord> meshes_;
+    std::span<const Vertex> vertices_;
+    std::span<const unsigned int> indices_;
+    std::span<const BeltRecord> belts_;
+    std::span<const Asteroid> asteroids_;
+    std::span<const RingRecord> rings_;
+    std::span<const RingParticle> ringParticles_;
+    std::span<const ParticleSystemRecord> particleSystems_;
+    std::span<const Particle> particles_;
+    std::span<const uint8_t> biomes_;
+};
@@ -0,0 +1,467 @@
+#include "TerrainPostProcess.hpp"
+#include "CubeFace.hpp"
+#include "Hasher.hpp"
+#include "ParallelFor.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+// Bump whenever a stage changes its output for the same settings
+static constexpr uint32_t POST_PROCESS_VERSION = 2;
+
+namespace {
+
+constexpr int TILE_SIZE = 32;
+constexpr int HALO = 6;              // Thermal iterations per exchange; droplets may wander this far out
+constexpr int HYDRAULIC_ROUNDS = 4;  // Tile grid shifts by half a tile between rounds
+
+// Crater profile in crater radii: a bowl with a flat floor and a raised rim
+constexpr float CRATER_FLOOR = -0.7f;
+constexpr float RIM_WIDTH = 0.4f;
+constexpr float RIM_STEEPNESS = 1.5f;
+constexpr float CRATER_SMOOTHNESS = 0.3f;
+constexpr float MIN_CRATER_FRACTION = 0.1f; // Smallest crater radius relative to the largest
+
+constexpr float THERMAL_RATE = 0.125f; // Per neighbour; 4 * rate <= 0.5 keeps the iteration stable
+
+// Droplet parameters, after Hans Theobald Beyer's particle erosion
+constexpr int DROPLET_LIFETIME = 30;
+constexpr float INERTIA = 0.05f;
+constexpr float SEDIMENT_CAPACITY = 4.0f;
+constexpr float MIN_SEDIMENT_CAPACITY = 0.01f;
+constexpr float DEPOSITION_RATE = 0.3f;
+constexpr float EVAPORATION_RATE = 0.02f;
+constexpr float GRAVITY = 4.0f;
+constexpr int DROPLET_STEP_WORK = 4; // A droplet step costs about as much as four thermal sample updates
+
+float smoothMin(float a, float b, float k) {
+    const float h = std::clamp((b - a + k) / (2.0f * k), 0.0f, 1.0f);
+    return a * h + b * (1.0f - h) - k * h * (1.0f - h);
+}
+
+// Height of a crater of unit depth at t crater radii from its center; 0 from 1 + RIM_WIDTH on
+float craterProfile(float t) {
+    const float cavity = t * t - 1.0f;
+    const float rimX = std::min(t - 1.0f - RIM_WIDTH, 0.0f);
+    const float rim = RIM_STEEPNESS * rimX * rimX;
+    const float shape = -smoothMin(-cavity, -CRATER_FLOOR, CRATER_SMOOTHNESS);
+    return smoothMin(shape, rim, CRATER_SMOOTHNESS) / -CRATER_FLOOR;
+}
+
+float texelCoordinate(int texel, int size) {
+    return (static_cast<float>(texel) + 0.5f) * 2.0f / static_cast<float>(size) - 1.0f;
+}
+
+float angleBetween(const glm::vec3& a, const glm::vec3& b) {
+    return std::acos(std::clamp(glm::dot(a, b), -1.0f, 1.0f));
+}
+
+// Index of a texel that may lie past the face edge; those are taken from the face it folds onto
+size_t getTexelIndex(int face, int x, int y, int size) {
+    if (x < 0 || x >= size || y < 0 || y >= size) {
+        float faceX = 0.0f;
+        float faceY = 0.0f;
+        face = cubeFaceCoords(cubeFacePoint(face, texelCoordinate(x, size), texelCoordinate(y, size)), faceX, faceY);
+        x = std::clamp(static_cast<int>(std::floor((faceX + 1.0f) * 0.5f * size)), 0, size - 1);
+        y = std::clamp(static_cast<int>(std::floor((faceY + 1.0f) * 0.5f * size)), 0, size - 1);
+    }
+    return (static_cast<size_t>(face) * size + y) * size + x;
+}
+
+} // namespace
+
+TerrainPostProcess::Stats TerrainPostProcess::apply(std::vector<float>& heights, int size) const {
+    Stats stats;
+    if (!isEnabled() || size < 2 || heights.size() != static_cast<size_t>(size) * size * 6) {
+        return stats;
+    }
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Scale every stage down evenly when the settings ask for more than the budget allows
+    const uint64_t work = estimateWork(size);
+    const double scale = work > workBudget_ ? static_cast<double>(workBudget_) / work : 1.0;
+    stats.craters = static_cast<int>(settings_.craterCount * scale);
+    stats.thermalIterations = static_cast<int>(settings_.thermalIterations * scale);
+    stats.droplets = static_cast<int>(settings_.droplets * scale);
+    stats.work = static_cast<uint64_t>(work * scale);
+    if (scale < 1.0) {
+        spdlog::debug("Terrain post-process over budget ({} > {} samples), scaled to {:.0f}%",
+                      work, workBudget_, scale * 100.0);
+    }
+
+    std::vector<Crater> craters = makeCraters();
+    craters.resize(static_cast<size_t>(stats.craters));
+    stampCraters(heights, size, craters);
+    erodeThermal(heights, size, stats.thermalIterations);
+    erodeHydraulic(heights, size, stats.droplets);
+
+    stats.milliseconds = std::chrono::duration<float, std::milli>(
+        std::chrono::high_resolution_clock::now() - startTime).count();
+    spdlog::debug("Terrain post-process: {} craters, {} thermal iterations, {} droplets in {:.1f} ms",
+                  stats.craters, stats.thermalIterations, stats.droplets, stats.milliseconds);
+    return stats;
+}
+
+float TerrainPostProcess::sample(const std::vector<float>& heights, int size, const glm::vec3& direction) {
+    float faceX = 0.0f;
+    float faceY = 0.0f;
+    const int face = cubeFaceCoords(direction, faceX, faceY);
+
+    // Bilinear between texel centers, clamped at the face edges
+    const int last = std::max(size - 2, 0);
+    const float x = std::clamp((faceX + 1.0f) * 0.5f * size - 0.5f, 0.0f, static_cast<float>(size - 1));
+    const float y = std::clamp((faceY + 1.0f) * 0.5f * size - 0.5f, 0.0f, static_cast<float>(size - 1));
+    const int x0 = std::min(static_cast<int>(x), last);
+    const int y0 = std::min(static_cast<int>(y), last);
+    const int x1 = std::min(x0 + 1, size - 1);
+    const int y1 = std::min(y0 + 1, size - 1);
+    const float fx = x - x0;
+    const float fy = y - y0;
+
+    const float* faceHeights = heights.data() + static_cast<size_t>(face) * size * size;
+    const float top = faceHeights[y0 * size + x0] * (1.0f - fx) + faceHeights[y0 * size + x1] * fx;
+    const float bottom = faceHeights[y1 * size + x0] * (1.0f - fx) + faceHeights[y1 * size + x1] * fx;
+    return top * (1.0f - fy) + bottom * fy;
+}
+
+bool TerrainPostProcess::isEnabled() const {
+    return settings_.craterCount > 0 || settings_.thermalIterations > 0 || settings_.droplets > 0;
+}
+
+uint64_t TerrainPostProcess::estimateWork(int size) const {
+    const double samples = 6.0 * size * size;
+
+    // A crater touches the samples of its spherical cap, rim included
+    double craterWork = 0.0;
+    for (const Crater& crater : makeCraters()) {
+        const float reach = std::min(crater.radius * (1.0f + RIM_WIDTH), 3.14159265f);
+        craterWork += samples * 0.5 * (1.0 - std::cos(reach));
+    }
+
+    return static_cast<uint64_t>(craterWork + samples * std::max(settings_.thermalIterations, 0) +
+                                 static_cast<double>(std::max(settings_.droplets, 0)) * DROPLET_LIFETIME * DROPLET_STEP_WORK);
+}
+
+uint64_t TerrainPostProcess::getSettingsHash() const {
+    if (!isEnabled()) {
+        return 0;
+    }
+    return Hasher()
+        .add(POST_PROCESS_VERSION)
+        .add(settings_.seed)
+        .add(settings_.craterCount)
+        .add(settings_.craterMaxRadius)
+        .add(settings_.craterDepth)
+        .add(settings_.thermalIterations)
+        .add(settings_.talusSlope)
+        .add(settings_.droplets)
+        .add(settings_.erosionRate)
+        .add(workBudget_)
+        .get();
+}
+
+std::vector<TerrainPostProcess::Tile> TerrainPostProcess::makeTiles(int size, int offset) {
+    std::vector<int> cuts{0};
+    for (int cut = offset > 0 ? offset : TILE_SIZE; cut < size; cut += TILE_SIZE) {
+        cuts.push_back(cut);
+    }
+    cuts.push_back(size);
+
+    std::vector<Tile> tiles;
+    for (int face = 0; face < 6; ++face) {
+        for (size_t row = 0; row + 1 < cuts.size(); ++row) {
+            for (size_t column = 0; column + 1 < cuts.size(); ++column) {
+                tiles.push_back({face, cuts[column], cuts[row],
+                                 cuts[column + 1] - cuts[column], cuts[row + 1] - cuts[row]});
+            }
+        }
+    }
+    return tiles;
+}
+
+std::vector<TerrainPostProcess::Crater> TerrainPostProcess::makeCraters() const {
+    std::mt19937 rng(settings_.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // Power-law sizes: many small craters, few large ones
+    const float maxRadius = std::max(settings_.craterMaxRadius, 1e-4f);
+    const float minRadius = maxRadius * MIN_CRATER_FRACTION;
+    const float ratio = MIN_CRATER_FRACTION * MIN_CRATER_FRACTION;
+
+    std::vector<Crater> craters;
+    craters.reserve(static_cast<size_t>(std::max(settings_.craterCount, 0)));
+    for (int i = 0; i < settings_.craterCount; ++i) {
+        const float z = unit(rng) * 2.0f - 1.0f;
+        const float phi = unit(rng) * 6.28318531f;
+        const float ring = std::sqrt(std::max(1.0f - z * z, 0.0f));
+        const float radius = minRadius / std::sqrt(1.0f - unit(rng) * (1.0f - ratio));
+        craters.push_back({glm::vec3(ring * std::cos(phi), ring * std::sin(phi), z), radius,
+                           settings_.craterDepth * radius / maxRadius});
+    }
+    return craters;
+}
+
+void TerrainPostProcess::stampCraters(std::vector<float>& heights, int size, const std::vector<Crater>& craters) const {
+    if (craters.empty()) {
+        return;
+    }
+
+    // Tiles only write their own samples, so craters are stamped in place
+    const std::vector<Tile> tiles = makeTiles(size, 0);
+    forEachRowRange(static_cast<int>(tiles.size()), [&](int first, int end) {
+        std::vector<const Crater*> nearby;
+        for (int index = first; index < end; ++index) {
+            const Tile& tile = tiles[static_cast<size_t>(index)];
+
+            // Bounding cone of the tile, from its center to its farthest corner
+            const float left = texelCoordinate(tile.x, size);
+            const float right = texelCoordinate(tile.x + tile.width - 1, size);
+            const float top = texelCoordinate(tile.y, size);
+            const float bottom = texelCoordinate(tile.y + tile.height - 1, size);
+            const glm::vec3 center = glm::normalize(cubeFacePoint(tile.face, 0.5f * (left + right), 0.5f * (top + bottom)));
+            float tileAngle = 0.0f;
+            for (const glm::vec2& corner : {glm::vec2(left, top), glm::vec2(right, top),
+                                            glm::vec2(left, bottom), glm::vec2(right, bottom)}) {
+                tileAngle = std::max(tileAngle, angleBetween(center, glm::normalize(cubeFacePoint(tile.face, corner.x, corner.y))));
+            }
+
+            nearby.clear();
+            for (const Crater& crater : craters) {
+                if (angleBetween(center, crater.direction) <= tileAngle + crater.radius * (1.0f + RIM_WIDTH)) {
+                    nearby.push_back(&crater);
+                }
+            }
+            if (nearby.empty()) {
+                continue;
+            }
+
+            for (int y = tile.y; y < tile.y + tile.height; ++y) {
+                for (int x = tile.x; x < tile.x + tile.width; ++x) {
+                    const glm::vec3 direction = glm::normalize(
+                        cubeFacePoint(tile.face, texelCoordinate(x, size), texelCoordinate(y, size)));
+                    float& height = heights[getTexelIndex(tile.face, x, y, size)];
+                    for (const Crater* crater : nearby) {
+                        const float t = angleBetween(direction, crater->direction) / crater->radius;
+                        if (t < 1.0f + RIM_WIDTH) {
+                            height += crater->depth * craterProfile(t);
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+void TerrainPostProcess::erodeThermal(std::vector<float>& heights, int size, int iterations) const {
+    if (iterations <= 0) {
+        return;
+    }
+
+    // Height difference between neighbouring texels that starts a slide; texels span about 2 / size radians
+    const float talus = settings_.talusSlope * 2.0f / size;
+    const std::vector<Tile> tiles = makeTiles(size, 0);
+    std::vector<float> next(heights.size());
+
+    for (int done = 0; done < iterations; done += HALO) {
+        // Each exchange allows HALO iterations before the halo's outer edge reaches the interior
+        const int steps = std::min(HALO, iterations - done);
+        forEachRowRange(static_cast<int>(tiles.size()), [&](int first, int end) {
+            std::vector<float> current;
+            std::vector<float> updated;
+            for (int index = first; index < end; ++index) {
+                const Tile& tile = tiles[static_cast<size_t>(index)];
+                const int width = tile.width + 2 * HALO;
+                const int height = tile.height + 2 * HALO;
+                current.resize(static_cast<size_t>(width) * height);
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        current[static_cast<size_t>(y) * width + x] =
+                            heights[getTexelIndex(tile.face, tile.x + x - HALO, tile.y + y - HALO, size)];
+                    }
+                }
+                updated = current;
+
+                // Symmetric exchange with the four neighbours conserves material
+                for (int step = 0; step < steps; ++step) {
+                    for (int y = 1; y < height - 1; ++y) {
+                        for (int x = 1; x < width - 1; ++x) {
+                            const size_t i = static_cast<size_t>(y) * width + x;
+                            const float h = current[i];
+                            float change = 0.0f;
+                            for (size_t neighbour : {i - 1, i + 1, i - width, i + width}) {
+                                const float difference = current[neighbour] - h;
+                                const float excess = std::max(std::abs(difference) - talus, 0.0f);
+                                change += difference > 0.0f ? excess : -excess;
+                            }
+                            updated[i] = h + THERMAL_RATE * change;
+                        }
+                    }
+                    std::swap(current, updated);
+                }
+
+                for (int y = 0; y < tile.height; ++y) {
+                    for (int x = 0; x < tile.width; ++x) {
+                        next[getTexelIndex(tile.face, tile.x + x, tile.y + y, size)] =
+                            current[static_cast<size_t>(y + HALO) * width + x + HALO];
+                    }
+                }
+            }
+        });
+        std::swap(heights, next);
+    }
+}
+
+void TerrainPostProcess::erodeHydraulic(std::vector<float>& heights, int size, int droplets) const {
+    if (droplets <= 0) {
+        return;
+    }
+
+    const uint64_t samples = static_cast<uint64_t>(size) * size * 6;
+    const float erosionRate = std::clamp(settings_.erosionRate, 0.0f, 1.0f);
+
+    for (int round = 0; round < HYDRAULIC_ROUNDS; ++round) {
+        // Shifting the tiles every round keeps droplets from stopping at the same lines
+        const std::vector<Tile> tiles = makeTiles(size, round % 2 == 0 ? 0 : TILE_SIZE / 2);
+        const uint64_t roundDroplets = static_cast<uint64_t>(droplets) / HYDRAULIC_ROUNDS +
+                                       (round < droplets % HYDRAULIC_ROUNDS ? 1 : 0);
+
+        // Every tile records how its droplets changed the tile and its halo
+        std::vector<std::vector<float>> changes(tiles.size());
+        forEachRowRange(static_cast<int>(tiles.size()), [&](int first, int end) {
+            std::vector<float> map;
+            for (int index = first; index < end; ++index) {
+                const Tile& tile = tiles[static_cast<size_t>(index)];
+                const int width = tile.width + 2 * HALO;
+                const int height = tile.height + 2 * HALO;
+                map.resize(static_cast<size_t>(width) * height);
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        map[static_cast<size_t>(y) * width + x] =
+                            heights[getTexelIndex(tile.face, tile.x + x - HALO, tile.y + y - HALO, size)];
+                    }
+                }
+                std::vector<float>& change = changes[static_cast<size_t>(index)];
+                change = map;
+
+                // Bilinear height and gradient of the cell containing a position
+                auto evaluate = [&map, width](float px, float py, glm::vec3& result) {
+                    const int x = static_cast<int>(px);
+                    const int y = static_cast<int>(py);
+                    const float fx = px - x;
+                    const float fy = py - y;
+                    const size_t i = static_cast<size_t>(y) * width + x;
+                    const float nw = map[i];
+                    const float ne = map[i + 1];
+                    const float sw = map[i + width];
+                    const float se = map[i + width + 1];
+                    result.x = (ne - nw) * (1.0f - fy) + (se - sw) * fy;
+                    result.y = (sw - nw) * (1.0f - fx) + (se - ne) * fx;
+                    result.z = nw * (1.0f - fx) * (1.0f - fy) + ne * fx * (1.0f - fy) + sw * (1.0f - fx) * fy + se * fx * fy;
+                };
+                auto inside = [width, height](float px, float py) {
+                    return px >= 0.0f && py >= 0.0f && px < width - 1 && py < height - 1;
+                };
+
+                // Droplets start in the interior and are seeded per tile, independent of the thread layout
+                std::seed_seq seeds{settings_.seed, static_cast<uint32_t>(round), static_cast<uint32_t>(index)};
+                std::mt19937 rng(seeds);
+                std::uniform_real_distribution<float> startX(HALO, static_cast<float>(HALO + tile.width - 1));
+                std::uniform_real_distribution<float> startY(HALO, static_cast<float>(HALO + tile.height - 1));
+                const uint64_t tileDroplets =
+                    (roundDroplets * static_cast<uint64_t>(tile.width * tile.height) + samples / 2) / samples;
+
+                for (uint64_t droplet = 0; droplet < tileDroplets; ++droplet) {
+                    glm::vec2 position(startX(rng), startY(rng));
+                    glm::vec2 direction(0.0f);
+                    float speed = 1.0f;
+                    float water = 1.0f;
+                    float sediment = 0.0f;
+
+                    for (int step = 0; step < DROPLET_LIFETIME; ++step) {
+                        glm::vec3 current;
+                        evaluate(position.x, position.y, current);
+                        direction = direction * INERTIA - glm::vec2(current.x, current.y) * (1.0f - INERTIA);
+                        const float length = glm::length(direction);
+                        if (length <= 0.0f) {
+                            break;
+                        }
+                        direction /= length;
+
+                        const glm::vec2 oldPosition = position;
+                        position += direction;
+                        if (!inside(position.x, position.y)) {
+                            position = oldPosition;
+                            break;
+                        }
+                        glm::vec3 moved;
+                        evaluate(position.x, position.y, moved);
+                        const float deltaHeight = moved.z - current.z;
+
+                        // Erode or deposit on the four texels around the old position
+                        const int x = static_cast<int>(oldPosition.x);
+                        const int y = static_cast<int>(oldPosition.y);
+                        const float fx = oldPosition.x - x;
+                        const float fy = oldPosition.y - y;
+                        const size_t i = static_cast<size_t>(y) * width + x;
+                        const float weights[4] = {(1.0f - fx) * (1.0f - fy), fx * (1.0f - fy), (1.0f - fx) * fy, fx * fy};
+                        const size_t cells[4] = {i, i + 1, i + width, i + width + 1};
+
+                        const float capacity = std::max(-deltaHeight, MIN_SEDIMENT_CAPACITY) * speed * water * SEDIMENT_CAPACITY;
+                        if (sediment > capacity || deltaHeight > 0.0f) {
+                            // Uphill the droplet fills the pit behind it, never above its own height
+                            const float amount = deltaHeight > 0.0f ? std::min(deltaHeight, sediment)
+                                                                    : (sediment - capacity) * DEPOSITION_RATE;
+                            sediment -= amount;
+                            for (int corner = 0; corner < 4; ++corner) {
+                                map[cells[corner]] += amount * weights[corner];
+                            }
+                        } else {
+                            const float amount = std::min((capacity - sediment) * erosionRate, -deltaHeight);
+                            sediment += amount;
+                            for (int corner = 0; corner < 4; ++corner) {
+                                map[cells[corner]] -= amount * weights[corner];
+                            }
+                        }
+
+                        speed = std::sqrt(std::max(speed * speed - deltaHeight * GRAVITY, 0.0f));
+                        water *= 1.0f - EVAPORATION_RATE;
+                    }
+
+                    // Whatever the droplet still carries settles where it stops
+                    const int x = static_cast<int>(position.x);
+                    const int y = static_cast<int>(position.y);
+                    const float fx = position.x - x;
+                    const float fy = position.y - y;
+                    const size_t i = static_cast<size_t>(y) * width + x;
+                    map[i] += sediment * (1.0f - fx) * (1.0f - fy);
+                    map[i + 1] += sediment * fx * (1.0f - fy);
+                    map[i + width] += sediment * (1.0f - fx) * fy;
+                    map[i + width + 1] += sediment * fx * fy;
+                }
+
+                for (size_t i = 0; i < map.size(); ++i) {
+                    change[i] = map[i] - change[i];
+                }
+            }
+        });
+
+        // Merge in tile order, so channels and deposits crossing a tile edge reach the texels'
+        // owners, material is conserved and the result does not depend on the thread layout
+        for (size_t index = 0; index < tiles.size(); ++index) {
+            const Tile& tile = tiles[index];
+            const int width = tile.width + 2 * HALO;
+            const int height = tile.height + 2 * HALO;
+            const std::vector<float>& change = changes[index];
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    const float delta = change[static_cast<size_t>(y) * width + x];
+                    if (delta != 0.0f) {
+                        heights[getTexelIndex(tile.face, tile.x + x - HALO, tile.y + y - HALO, size)] += delta;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+/**
+ * @brief Crater stamping and erosion applied to a planet's height cubemap
+ *
+ * Runs on the terrain heights before the height scale, laid out like
+ * Planet::buildHeightMap: six faces of size x size texel-centered samples in
+ * GL face order. The stages run in order:
+ *  - craters: seeded bowls with raised rims, stamped in 3D so they cross face edges
+ *  - thermal erosion: material slides down slopes steeper than the talus slope
+ *  - hydraulic erosion: simulated droplets carve channels and deposit sediment
+ *
+ * Every face is split into tiles processed on all cores. A tile is copied with
+ * a halo of its neighbours, taken from the adjacent face where it crosses a
+ * cube edge, so tiles never touch shared data while they run. Thermal erosion
+ * runs a few iterations per tile and writes back the interior. Droplets may
+ * cross into the halo; each tile's changes, halo included, are added to the
+ * heights in tile order after every round, so channels continue across tile
+ * edges and material is conserved. Results only depend on the settings, not
+ * on the number of threads.
+ *
+ * The work is estimated up front; erosion iterations and droplets are scaled
+ * down so the estimate stays within the work budget, which keeps generation
+ * time bounded however the settings are set.
+ */
+class TerrainPostProcess {
+public:
+    static constexpr uint64_t DEFAULT_WORK_BUDGET = 16000000; ///< Sample updates per apply(), about 300 ms on one core
+
+    /**
+     * @brief Stage parameters; heights are normalized terrain heights, angles in radians
+     */
+    struct Settings {
+        uint32_t seed = 0;
+        int craterCount = 0;
+        float craterMaxRadius = 0.2f;   // Angular radius of the largest crater
+        float craterDepth = 0.5f;       // Depth of the largest crater; smaller ones scale with their radius
+        int thermalIterations = 0;
+        float talusSlope = 1.0f;        // Height per radian above which material slides
+        int droplets = 0;
+        float erosionRate = 0.3f;       // Fraction of the sediment capacity a droplet picks up per step
+    };
+
+    /**
+     * @brief Work actually done by an apply()
+     */
+    struct Stats {
+        int craters = 0;
+        int thermalIterations = 0;
+        int droplets = 0;
+        uint64_t work = 0;       // Estimated sample updates
+        float milliseconds = 0.0f;
+    };
+
+    TerrainPostProcess() = default;
+    explicit TerrainPostProcess(const Settings& settings) : settings_(settings) {}
+
+    /**
+     * @brief Run every enabled stage on a height cubemap
+     * @param heights Heights, size^2 per face in GL face order, first row first; modified in place
+     * @param size Texels per face edge
+     * @return Stats Stage sizes after budgeting and the time taken
+     */
+    Stats apply(std::vector<float>& heights, int size) const;
+
+    /**
+     * @brief Sample a height cubemap bilinearly
+     * @param heights Heights as passed to apply()
+     * @param size Texels per face edge
+     * @param direction Direction from the planet center, need not be normalized
+     * @return float Interpolated height
+     */
+    static float sample(const std::vector<float>& heights, int size, const glm::vec3& direction);
+
+    /**
+     * @brief Check if any stage would change the heights
+     * @return true if craters, thermal or hydraulic erosion are enabled
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Estimate the sample updates apply() would do before budgeting
+     * @param size Texels per face edge
+     * @return uint64_t Estimated work
+     */
+    uint64_t estimateWork(int size) const;
+
+    /**
+     * @brief Hash the settings for cache keys
+     * @return uint64_t Hash of every setting, 0 when disabled
+     */
+    uint64_t getSettingsHash() const;
+
+    void setSettings(const Settings& settings) { settings_ = settings; }
+    const Settings& getSettings() const { return settings_; }
+
+    void setWorkBudget(uint64_t budget) { workBudget_ = budget; }
+    uint64_t getWorkBudget() const { return workBudget_; }
+
+private:
+    struct Crater {
+        glm::vec3 direction;
+        float radius;
+        float depth;
+    };
+
+    /**
+     * @brief Rectangle of one face processed as a unit
+     */
+    struct Tile {
+        int face;
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    static std::vector<Tile> makeTiles(int size, int offset);
+    std::vector<Crater> makeCraters() const;
+
+    void stampCraters(std::vector<float>& heights, int size, const std::vector<Crater>& craters) const;
+    void erodeThermal(std::vector<float>& heights, int size, int iterations) const;
+    void erodeHydraulic(std::vector<float>& heights, int size, int droplets) const;
+
+    Settings settings_;
+    uint64_t workBudget_ = DEFAULT_WORK_BUDGET;
+};
@@ -1,80 +1,12 @@
 #include "Texture.hpp"
+#include "CompressedTexture.hpp"
+#include "GLApi.hpp"
 #include <spdlog/spdlog.h>
-
-// Use GLFW's OpenGL loader
-#define GLFW_INCLUDE_NONE
-#include <GLFW/glfw3.h>
+#include <algorithm>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
 
-// OpenGL types
-typedef unsigned int GLuint;
-typedef int GLint;
-typedef int GLsizei;
-typedef unsigned int GLenum;
-typedef unsigned char GLboolean;
-typedef float GLfloat;
-typedef char GLchar;
-
-// OpenGL constants
-#define GL_TEXTURE_2D 0x0DE1
-#define GL_TEXTURE_CUBE_MAP 0x8513
-#define GL_TEXTURE_CUBE_MAP_POSITIVE_X 0x8515
-#define GL_TEXTURE_CUBE_MAP_NEGATIVE_X 0x8516
-#define GL_TEXTURE_CUBE_MAP_POSITIVE_Y 0x8517
-#define GL_TEXTURE_CUBE_MAP_NEGATIVE_Y 0x8518
-#define GL_TEXTURE_CUBE_MAP_POSITIVE_Z 0x8519
-#define GL_TEXTURE_CUBE_MAP_NEGATIVE_Z 0x851A
-#define GL_TEXTURE_WRAP_R 0x8072
-#define GL_RED 0x1903
-#define GL_RGB 0x1907
-#define GL_RGBA 0x1908
-#define GL_UNSIGNED_BYTE 0x1401
-#define GL_TEXTURE0 0x84C0
-#define GL_TEXTURE_WRAP_S 0x2802
-#define GL_TEXTURE_WRAP_T 0x2803
-#define GL_TEXTURE_MIN_FILTER 0x2801
-#define GL_TEXTURE_MAG_FILTER 0x2800
-#define GL_REPEAT 0x2901
-#define GL_CLAMP_TO_EDGE 0x812F
-#define GL_LINEAR 0x2601
-#define GL_LINEAR_MIPMAP_LINEAR 0x2703
-
-// OpenGL function pointers
-static void(*glGenTextures)(GLsizei, GLuint*) = nullptr;
-static void(*glBindTexture)(GLenum, GLuint) = nullptr;
-static void(*glTexImage2D)(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) = nullptr;
-static void(*glGenerateMipmap)(GLenum) = nullptr;
-static void(*glActiveTexture)(GLenum) = nullptr;
-static void(*glTexParameteri)(GLenum, GLenum, GLint) = nullptr;
-static void(*glDeleteTextures)(GLsizei, const GLuint*) = nullptr;
-
-// Function to load OpenGL functions dynamically
-static bool loadOpenGLFunctions() {
-    static bool loaded = false;
-    if (loaded) return true;
-
-    glGenTextures = (void(*)(GLsizei, GLuint*))glfwGetProcAddress("glGenTextures");
-    glBindTexture = (void(*)(GLenum, GLuint))glfwGetProcAddress("glBindTexture");
-    glTexImage2D = (void(*)(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*))glfwGetProcAddress("glTexImage2D");
-    glGenerateMipmap = (void(*)(GLenum))glfwGetProcAddress("glGenerateMipmap");
-    glActiveTexture = (void(*)(GLenum))glfwGetProcAddress("glActiveTexture");
-    glTexParameteri = (void(*)(GLenum, GLenum, GLint))glfwGetProcAddress("glTexParameteri");
-    glDeleteTextures = (void(*)(GLsizei, const GLuint*))glfwGetProcAddress("glDeleteTextures");
-
-    loaded = (glGenTextures && glBindTexture && glTexImage2D && glGenerateMipmap && 
-              glActiveTexture && glTexParameteri && glDeleteTextures);
-    
-    if (loaded) {
-        spdlog::info("Texture OpenGL functions loaded successfully");
-    } else {
-        spdlog::error("Failed to load Texture OpenGL functions");
-    }
-    
-    return loaded;
-}
-
 namespace Core {
 
 Texture::Texture() 
@@ -120,13 +52,23 @@ Texture& Texture::operator=(Texture&& other) noexcept {
 }
 
 bool Texture::loadFromFile(const std::string& filepath) {
-    if (!loadOpenGLFunctions()) {
-        spdlog::error("Failed to load OpenGL functions for texture loading");
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for texture loading");
         return false;
     }
     
     cleanup();
 
+    // Offline-compressed textures skip decoding and upload a fraction of the bytes
+    if (isCompressionSupported() && CompressedTexture::isUpToDate(filepath)) {
+        CompressedTexture compressed;
+        std::string compressedPath = CompressedTexture::getPathFor(filepath);
+        if (compressed.load(compressedPath) && loadFromCompressed(compressed)) {
+            spdlog::info("Loaded texture: {} ({}x{}, compressed)", compressedPath, width_, height_);
+            return true;
+        }
+    }
+
     // Set stb_image to flip loaded texture's on the y-axis
     stbi_set_flip_vertically_on_load(true);
 
@@ -137,8 +79,8 @@ bool Texture::loadFromFile(const std::string& filepath) {
     }
 
     // Generate texture
-    glGenTextures(1, &textureId_);
-    glBindTexture(GL_TEXTURE_2D, textureId_);
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_2D, textureId_);
 
     // Determine format based on channels
     GLenum format;
@@ -154,8 +96,8 @@ bool Texture::loadFromFile(const std::string& filepath) {
     }
 
     // Upload texture data
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width_, height_, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    gl.TexImage2D(GL_TEXTURE_2D, 0, format, width_, height_, 0, format, GL_UNSIGNED_BYTE, data);
+    gl.GenerateMipmap(GL_TEXTURE_2D);
 
     // Set default texture parameters
     setWrapMode(GL_REPEAT, GL_REPEAT);
@@ -169,8 +111,8 @@ bool Texture::loadFromFile(const std::string& filepath) {
 }
 
 bool Texture::loadCubemap(const std::vector<std::string>& faces) {
-    if (!loadOpenGLFunctions()) {
-        spdlog::error("Failed to load OpenGL functions for cubemap loading");
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for cubemap loading");
         return false;
     }
 
@@ -181,9 +123,25 @@ bool Texture::loadCubemap(const std::vector<std::string>& faces) {
 
     cleanup();
 
+    if (isCompressionSupported()) {
+        CompressedTexture compressed;
+        for (const auto& face : faces) {
+            CompressedTexture faceTexture;
+            if (!CompressedTexture::isUpToDate(face) || !faceTexture.load(CompressedTexture::getPathFor(face)) ||
+                !compressed.appendFaces(faceTexture)) {
+                compressed = CompressedTexture();
+                break;
+            }
+        }
+        if (compressed.getFaceCount() == 6 && loadFromCompressed(compressed)) {
+            spdlog::info("Loaded cubemap with {} compressed faces ({}x{})", faces.size(), width_, height_);
+            return true;
+        }
+    }
+
     isCubemap_ = true;
-    glGenTextures(1, &textureId_);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, textureId_);
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_CUBE_MAP, textureId_);
 
     // Cubemap face targets in order: +X, -X, +Y, -Y, +Z, -Z
     GLenum targets[6] = {
@@ -219,24 +177,206 @@ bool Texture::loadCubemap(const std::vector<std::string>& faces) {
         if (channels == 4) format = GL_RGBA;
         else if (channels == 1) format = GL_RED;
 
-        glTexImage2D(targets[i], 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        gl.TexImage2D(targets[i], 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
         stbi_image_free(data);
     }
 
     // Set cubemap parameters
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
 
     spdlog::info("Loaded cubemap with {} faces ({}x{}, {} channels)", faces.size(), width_, height_, channels_);
     return true;
 }
 
+bool Texture::loadFromMemory(const unsigned char* pixels, int width, int height, int channels) {
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for texture creation");
+        return false;
+    }
+
+    GLenum format;
+    switch (channels) {
+        case 1: format = GL_RED; break;
+        case 3: format = GL_RGB; break;
+        case 4: format = GL_RGBA; break;
+        default:
+            spdlog::error("Unsupported number of channels: {}", channels);
+            return false;
+    }
+
+    cleanup();
+
+    width_ = width;
+    height_ = height;
+    channels_ = channels;
+    isCubemap_ = false;
+
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_2D, textureId_);
+
+    // Rows of 1- and 3-channel images are not necessarily 4-byte aligned
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    gl.TexImage2D(GL_TEXTURE_2D, 0, format, width_, height_, 0, format, GL_UNSIGNED_BYTE, pixels);
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    gl.GenerateMipmap(GL_TEXTURE_2D);
+
+    // Same defaults as loadFromFile
+    setWrapMode(GL_REPEAT, GL_REPEAT);
+    setFilterMode(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+    return true;
+}
+
+bool Texture::loadFromFloatData(const float* rgba, int width, int height) {
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for texture creation");
+        return false;
+    }
+
+    cleanup();
+
+    width_ = width;
+    height_ = height;
+    channels_ = 4;
+    isCubemap_ = false;
+
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_2D, textureId_);
+    gl.TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width_, height_, 0, GL_RGBA, GL_FLOAT, rgba);
+
+    // Lookup tables are addressed at texel centers; mipmaps would blend unrelated table slices
+    setWrapMode(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+    setFilterMode(GL_LINEAR, GL_LINEAR);
+    return true;
+}
+
+bool Texture::loadCubemapFromFloatData(const float* faces, int size) {
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for cubemap creation");
+        return false;
+    }
+
+    cleanup();
+
+    width_ = size;
+    height_ = size;
+    channels_ = 1;
+    isCubemap_ = true;
+
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_CUBE_MAP, textureId_);
+
+    const size_t faceSize = static_cast<size_t>(size) * size;
+    for (GLenum face = 0; face < 6; ++face) {
+        gl.TexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_R16F, size, size, 0, GL_RED, GL_FLOAT,
+                      faces + face * faceSize);
+    }
+
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    return true;
+}
+
+bool Texture::loadCubemapFromByteData(const uint8_t* faces, int size) {
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for cubemap creation");
+        return false;
+    }
+
+    cleanup();
+
+    width_ = size;
+    height_ = size;
+    channels_ = 1;
+    isCubemap_ = true;
+
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_CUBE_MAP, textureId_);
+
+    // Rows of single bytes are not 4-byte aligned for every size
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    const size_t faceSize = static_cast<size_t>(size) * size;
+    for (GLenum face = 0; face < 6; ++face) {
+        gl.TexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_R8, size, size, 0, GL_RED, GL_UNSIGNED_BYTE,
+                      faces + face * faceSize);
+    }
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    return true;
+}
+
+bool Texture::loadFromCompressed(const CompressedTexture& compressed) {
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for compressed texture loading");
+        return false;
+    }
+
+    const int faceCount = compressed.getFaceCount();
+    if (faceCount != 1 && faceCount != 6) {
+        spdlog::error("Compressed texture must have 1 or 6 faces, got {}", faceCount);
+        return false;
+    }
+
+    cleanup();
+
+    const bool hasAlpha = compressed.getFormat() == CompressedTexture::Format::BC3;
+    const GLenum internalFormat = hasAlpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    width_ = compressed.getWidth();
+    height_ = compressed.getHeight();
+    channels_ = hasAlpha ? 4 : 3;
+    isCubemap_ = faceCount == 6;
+
+    const GLenum bindTarget = isCubemap_ ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(bindTarget, textureId_);
+
+    // Every level is precomputed, so no glGenerateMipmap
+    for (int face = 0; face < faceCount; ++face) {
+        GLenum faceTarget = isCubemap_ ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(face) : GL_TEXTURE_2D;
+        int levelWidth = width_;
+        int levelHeight = height_;
+        for (int level = 0; level < compressed.getLevelCount(); ++level) {
+            const auto& image = compressed.getImage(face, level);
+            gl.CompressedTexImage2D(faceTarget, level, internalFormat, levelWidth, levelHeight, 0,
+                                    static_cast<GLsizei>(image.size()), image.data());
+            levelWidth = std::max(levelWidth / 2, 1);
+            levelHeight = std::max(levelHeight / 2, 1);
+        }
+    }
+    gl.TexParameteri(bindTarget, GL_TEXTURE_MAX_LEVEL, compressed.getLevelCount() - 1);
+
+    if (isCubemap_) {
+        // Same parameters as loadCubemap
+        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    } else {
+        setWrapMode(GL_REPEAT, GL_REPEAT);
+        setFilterMode(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+    }
+    return true;
+}
+
+bool Texture::isCompressionSupported() {
+    return GLApi::isExtensionSupported("GL_EXT_texture_compression_s3tc");
+}
+
 bool Texture::create(int width, int height, GLenum format) {
-    if (!loadOpenGLFunctions()) {
-        spdlog::error("Failed to load OpenGL functions for texture creation");
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for texture creation");
         return false;
     }
     
@@ -247,10 +387,10 @@ bool Texture::create(int width, int height, GLenum format) {
     channels_ = (format == GL_RGBA) ? 4 : (format == GL_RGB) ? 3 : 1;
     isCubemap_ = false;
 
-    glGenTextures(1, &textureId_);
-    glBindTexture(GL_TEXTURE_2D, textureId_);
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_2D, textureId_);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width_, height_, 0, format, GL_UNSIGNED_BYTE, nullptr);
+    gl.TexImage2D(GL_TEXTURE_2D, 0, format, width_, height_, 0, format, GL_UNSIGNED_BYTE, nullptr);
 
     // Set default texture parameters
     setWrapMode(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
@@ -260,9 +400,40 @@ bool Texture::create(int width, int height, GLenum format) {
     return true;
 }
 
+bool Texture::createCubemap(int width, int height, GLenum format) {
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for cubemap creation");
+        return false;
+    }
+
+    cleanup();
+
+    width_ = width;
+    height_ = height;
+    channels_ = (format == GL_RGBA) ? 4 : (format == GL_RGB) ? 3 : 1;
+    isCubemap_ = true;
+
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_CUBE_MAP, textureId_);
+
+    for (GLenum face = 0; face < 6; ++face) {
+        gl.TexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, format, width_, height_, 0, format, GL_UNSIGNED_BYTE, nullptr);
+    }
+
+    // Same parameters as loadCubemap
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    gl.TexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    spdlog::debug("Created empty cubemap ({}x{}, format: {})", width_, height_, format);
+    return true;
+}
+
 bool Texture::createDummyTexture() {
-    if (!loadOpenGLFunctions()) {
-        spdlog::error("Failed to load OpenGL functions for dummy texture creation");
+    if (!GLApi::isLoaded()) {
+        spdlog::error("OpenGL functions not loaded for dummy texture creation");
         return false;
     }
     
@@ -276,10 +447,10 @@ bool Texture::createDummyTexture() {
     // Create a 1x1 white pixel
     unsigned char whitePixel[4] = {255, 255, 255, 255}; // RGBA
 
-    glGenTextures(1, &textureId_);
-    glBindTexture(GL_TEXTURE_2D, textureId_);
+    gl.GenTextures(1, &textureId_);
+    gl.BindTexture(GL_TEXTURE_2D, textureId_);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, whitePixel);
+    gl.TexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, whitePixel);
 
     // Set default texture parameters
     setWrapMode(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
@@ -289,38 +460,60 @@ bool Texture::createDummyTexture() {
     return true;
 }
 
+bool Texture::createDummyCubemap() {
+    if (!createCubemap(1, 1, GL_RGBA)) {
+        return false;
+    }
+
+    unsigned char whitePixel[4] = {255, 255, 255, 255}; // RGBA
+    for (GLenum face = 0; face < 6; ++face) {
+        gl.TexSubImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, 0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, whitePixel);
+    }
+
+    spdlog::info("Created dummy 1x1 white cubemap");
+    return true;
+}
+
+void Texture::generateMipmaps() {
+    if (textureId_ != 0 && GLApi::isLoaded()) {
+        GLenum target = isCubemap_ ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+        gl.BindTexture(target, textureId_);
+        gl.GenerateMipmap(target);
+    }
+}
+
 void Texture::bind(unsigned int unit) const {
-    if (textureId_ != 0 && loadOpenGLFunctions()) {
-        glActiveTexture(GL_TEXTURE0 + unit);
-        glBindTexture(isCubemap_ ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, textureId_);
+    if (textureId_ != 0 && GLApi::isLoaded()) {
+        gl.ActiveTexture(GL_TEXTURE0 + unit);
+        gl.BindTexture(isCubemap_ ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, textureId_);
     }
 }
 
 void Texture::unbind() const {
-    if (loadOpenGLFunctions()) {
-        glBindTexture(isCubemap_ ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, 0);
+    if (GLApi::isLoaded()) {
+        gl.BindTexture(isCubemap_ ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, 0);
     }
 }
 
 void Texture::setWrapMode(GLenum wrapS, GLenum wrapT) {
-    if (textureId_ != 0 && loadOpenGLFunctions()) {
-        glBindTexture(GL_TEXTURE_2D, textureId_);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
+    if (textureId_ != 0 && GLApi::isLoaded()) {
+        gl.BindTexture(GL_TEXTURE_2D, textureId_);
+        gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrapS);
+        gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapT);
     }
 }
 
 void Texture::setFilterMode(GLenum minFilter, GLenum magFilter) {
-    if (textureId_ != 0 && loadOpenGLFunctions()) {
-        glBindTexture(GL_TEXTURE_2D, textureId_);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
+    if (textureId_ != 0 && GLApi::isLoaded()) {
+        gl.BindTexture(GL_TEXTURE_2D, textureId_);
+        gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, minFilter);
+        gl.TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, magFilter);
     }
 }
 
 void Texture::cleanup() {
-    if (textureId_ != 0 && loadOpenGLFunctions()) {
-        glDeleteTextures(1, &textureId_);
+    if (textureId_ != 0 && GLApi::isLoaded()) {
+        gl.DeleteTextures(1, &textureId_);
         textureId_ = 0;
         width_ = 0;
         height_ = 0;
@@ -10,6 +10,8 @@ typedef unsigned int GLenum;
 // OpenGL constants
 #define GL_RGBA 0x1908
 
+class CompressedTexture;
+
 namespace Core {
 
 class Texture {
@@ -26,18 +28,47 @@ public:
     Texture(Texture&& other) noexcept;
     Texture& operator=(Texture&& other) noexcept;
 
-    // Load texture from file
+    // Load texture from file, preferring a compressed .atex next to it
     bool loadFromFile(const std::string& filepath);
 
-    // Load cubemap from 6 files
+    // Load cubemap from 6 files, preferring compressed .atex faces
     bool loadCubemap(const std::vector<std::string>& faces);
 
+    // Create a mipmapped 2D texture from tightly packed pixels, first row at the bottom
+    bool loadFromMemory(const unsigned char* pixels, int width, int height, int channels);
+
+    // Create a half-float lookup table from tightly packed RGBA floats: no mipmaps, linear, clamped
+    bool loadFromFloatData(const float* rgba, int width, int height);
+
+    // Create a single-channel half-float cubemap from six square faces of tightly packed floats,
+    // back to back in GL face order (+X, -X, +Y, -Y, +Z, -Z): no mipmaps, linear, clamped
+    bool loadCubemapFromFloatData(const float* faces, int size);
+
+    // Create a single-channel 8-bit cubemap of indices, laid out like loadCubemapFromFloatData:
+    // no mipmaps, nearest, clamped, so texels never blend into values that mean something else
+    bool loadCubemapFromByteData(const uint8_t* faces, int size);
+
+    // Upload a block-compressed 2D texture (1 face) or cubemap (6 faces) with its mip chain
+    bool loadFromCompressed(const CompressedTexture& compressed);
+
+    // Whether the context can sample the formats written by texture_compress
+    static bool isCompressionSupported();
+
     // Create empty texture with specified dimensions
     bool create(int width, int height, GLenum format = GL_RGBA);
 
+    // Create an empty cubemap with faces of the specified dimensions
+    bool createCubemap(int width, int height, GLenum format = GL_RGBA);
+
     // Create a dummy 1x1 white texture
     bool createDummyTexture();
 
+    // Create a dummy cubemap with 1x1 white faces
+    bool createDummyCubemap();
+
+    // Build the mipmap chain from level 0
+    void generateMipmaps();
+
     // Bind texture to specified texture unit
     void bind(unsigned int unit = 0) const;
 
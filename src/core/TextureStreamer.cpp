@@ -0,0 +1,365 @@
+#include "TextureStreamer.hpp"
+#include "CompressedTexture.hpp"
+#include "Texture.hpp"
+#include "GLApi.hpp"
+#include "WorkerThread.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <stb/stb_image.h>
+
+namespace Core {
+
+namespace {
+
+GLenum formatForChannels(int channels) {
+    switch (channels) {
+        case 1: return GL_RED;
+        case 3: return GL_RGB;
+        case 4: return GL_RGBA;
+        default: return 0;
+    }
+}
+
+bool hasCompressedFiles(const std::vector<std::string>& paths) {
+    for (const auto& path : paths) {
+        if (!CompressedTexture::isUpToDate(path)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+void TextureStreamer::ImageDeleter::operator()(uint8_t* pixels) const {
+    stbi_image_free(pixels);
+}
+
+struct TextureStreamer::Request {
+    Texture* target = nullptr;
+    std::vector<std::string> paths;
+    bool cubemap = false;
+    bool compressed = false;  // Read .atex files instead of decoding the images
+
+    // Written by decode threads under the streamer mutex
+    std::vector<Image> faces;
+    std::vector<CompressedTexture> compressedFaces;
+    size_t facesRemaining = 0;
+    bool failed = false;
+
+    // Upload progress, render thread only
+    std::unique_ptr<Texture> staged;
+    size_t face = 0;
+    int row = 0;
+};
+
+TextureStreamer::TextureStreamer(int decodeThreads, size_t uploadBudgetBytes)
+    : uploadBudgetBytes_(std::max<size_t>(uploadBudgetBytes, 1))
+    , compressedSupported_(Texture::isCompressionSupported())
+    , pending_(0)
+    , uploadedBytes_(0)
+    , uploadBuffers_{}
+    , nextUploadBuffer_(0)
+    , nextDecoder_(0)
+{
+    if (GLApi::isLoaded()) {
+        gl.GenBuffers(static_cast<GLsizei>(uploadBuffers_.size()), uploadBuffers_.data());
+    }
+
+    for (int i = 0; i < std::max(decodeThreads, 1); ++i) {
+        decoders_.push_back(std::make_unique<WorkerThread>("TextureDecoder" + std::to_string(i)));
+    }
+}
+
+TextureStreamer::~TextureStreamer() {
+    // Finish queued decodes before the queues go away
+    decoders_.clear();
+
+    if (GLApi::isLoaded() && uploadBuffers_[0] != 0) {
+        gl.DeleteBuffers(static_cast<GLsizei>(uploadBuffers_.size()), uploadBuffers_.data());
+    }
+    if (pending_ > 0) {
+        spdlog::warn("Texture streamer destroyed with {} textures still loading", pending_);
+    }
+}
+
+void TextureStreamer::loadTexture(Texture& target, const std::string& filepath) {
+    if (!target.isValid()) {
+        target.createDummyTexture();
+    }
+
+    auto request = std::make_shared<Request>();
+    request->target = &target;
+    request->paths.push_back(filepath);
+    request->compressed = compressedSupported_ && hasCompressedFiles(request->paths);
+    request->faces.resize(1);
+    request->compressedFaces.resize(1);
+    request->facesRemaining = 1;
+    ++pending_;
+    submitDecode(request, 0);
+}
+
+void TextureStreamer::loadCubemap(Texture& target, const std::vector<std::string>& faces) {
+    if (faces.size() != 6) {
+        spdlog::error("Cubemap requires exactly 6 faces, got {}", faces.size());
+        return;
+    }
+    if (!target.isValid()) {
+        target.createDummyCubemap();
+    }
+
+    auto request = std::make_shared<Request>();
+    request->target = &target;
+    request->paths = faces;
+    request->cubemap = true;
+    request->compressed = compressedSupported_ && hasCompressedFiles(request->paths);
+    request->faces.resize(faces.size());
+    request->compressedFaces.resize(faces.size());
+    request->facesRemaining = faces.size();
+    ++pending_;
+    for (size_t face = 0; face < faces.size(); ++face) {
+        submitDecode(request, face);
+    }
+}
+
+void TextureStreamer::submitDecode(const std::shared_ptr<Request>& request, size_t face) {
+    WorkerThread& decoder = *decoders_[nextDecoder_];
+    nextDecoder_ = (nextDecoder_ + 1) % decoders_.size();
+    decoder.submit([this, request, face]() {
+        decode(request, face);
+    });
+}
+
+void TextureStreamer::decode(const std::shared_ptr<Request>& request, size_t face) {
+    const std::string& path = request->paths[face];
+
+    if (request->compressed) {
+        // An unreadable file leaves the face empty; upload() then falls back to the images
+        CompressedTexture compressed;
+        compressed.load(CompressedTexture::getPathFor(path));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        request->compressedFaces[face] = std::move(compressed);
+        if (--request->facesRemaining == 0) {
+            decoded_.push_back(request);
+        }
+        return;
+    }
+
+    // Textures are flipped for OpenGL's bottom-up rows; cubemap faces are not
+    stbi_set_flip_vertically_on_load_thread(request->cubemap ? 0 : 1);
+
+    // The decoded buffer is uploaded from as is, so there is no copy between decode and upload
+    Image image;
+    image.pixels.reset(stbi_load(path.c_str(), &image.width, &image.height, &image.channels, 0));
+    if (!image.pixels) {
+        spdlog::error("Failed to load texture: {} ({})", path, stbi_failure_reason());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    request->failed = request->failed || !image.pixels;
+    request->faces[face] = std::move(image);
+    if (--request->facesRemaining == 0) {
+        decoded_.push_back(request);
+    }
+}
+
+void TextureStreamer::update() {
+    upload(uploadBudgetBytes_);
+}
+
+void TextureStreamer::finish() {
+    // A second pass picks up requests that fell back from compressed files
+    while (pending_ > 0) {
+        for (auto& decoder : decoders_) {
+            decoder->flush();
+        }
+        upload(std::numeric_limits<size_t>::max());
+    }
+}
+
+void TextureStreamer::upload(size_t budget) {
+    std::vector<std::shared_ptr<Request>> retries;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!decoded_.empty()) {
+            auto request = std::move(decoded_.front());
+            decoded_.pop_front();
+
+            bool incomplete = std::any_of(request->compressedFaces.begin(), request->compressedFaces.end(),
+                                          [](const CompressedTexture& face) { return face.isEmpty(); });
+            if (request->compressed && incomplete) {
+                request->compressed = false;
+                request->compressedFaces.assign(request->faces.size(), CompressedTexture());
+                request->facesRemaining = request->faces.size();
+                retries.push_back(std::move(request));
+            } else {
+                uploads_.push_back(std::move(request));
+            }
+        }
+    }
+    for (const auto& request : retries) {
+        spdlog::warn("Compressed texture unusable, decoding {} instead", request->paths.front());
+        for (size_t face = 0; face < request->faces.size(); ++face) {
+            submitDecode(request, face);
+        }
+    }
+    if (uploads_.empty() || !GLApi::isLoaded()) {
+        return;
+    }
+
+    // Image rows are tightly packed
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    while (!uploads_.empty() && budget > 0) {
+        Request& request = *uploads_.front();
+        bool done = false;
+        if (request.compressed) {
+            uploadCompressed(request, budget);
+            done = true;
+        } else if (request.staged || beginUpload(request)) {
+            done = uploadSlice(request, budget);
+            if (done) {
+                deliver(request);
+            }
+        } else {
+            for (auto& image : request.faces) {
+                image.pixels.reset();
+            }
+            done = true;
+        }
+
+        if (done) {
+            uploads_.pop_front();
+            --pending_;
+        }
+    }
+
+    gl.PixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+bool TextureStreamer::beginUpload(Request& request) {
+    if (request.failed) {
+        spdlog::warn("Keeping placeholder for {}", request.paths.front());
+        return false;
+    }
+
+    const Image& first = request.faces.front();
+    for (const auto& image : request.faces) {
+        if (image.width != first.width || image.height != first.height || image.channels != first.channels) {
+            spdlog::error("Cubemap faces differ in size or channels: {}", request.paths.front());
+            return false;
+        }
+    }
+    GLenum format = formatForChannels(first.channels);
+    if (format == 0) {
+        spdlog::error("Unsupported number of channels: {} ({})", first.channels, request.paths.front());
+        return false;
+    }
+
+    // Storage is allocated up front; rows arrive over the next frames
+    request.staged = std::make_unique<Texture>();
+    bool created = request.cubemap ? request.staged->createCubemap(first.width, first.height, format)
+                                   : request.staged->create(first.width, first.height, format);
+    if (!created) {
+        request.staged.reset();
+        return false;
+    }
+    return true;
+}
+
+bool TextureStreamer::uploadSlice(Request& request, size_t& budget) {
+    const GLenum bindTarget = request.cubemap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+    gl.BindTexture(bindTarget, request.staged->getId());
+
+    while (budget > 0) {
+        Image& image = request.faces[request.face];
+        const size_t rowBytes = static_cast<size_t>(image.width) * static_cast<size_t>(image.channels);
+        const int rows = static_cast<int>(std::clamp<size_t>(budget / rowBytes, 1,
+                                                             static_cast<size_t>(image.height - request.row)));
+        const size_t bytes = rowBytes * static_cast<size_t>(rows);
+        const uint8_t* source = image.pixels.get() + rowBytes * static_cast<size_t>(request.row);
+
+        // Orphan the buffer so the driver never waits on a previous slice still in flight
+        unsigned int buffer = uploadBuffers_[nextUploadBuffer_];
+        nextUploadBuffer_ = (nextUploadBuffer_ + 1) % uploadBuffers_.size();
+        const void* pixels = nullptr;
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+        gl.BufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<ptrdiff_t>(bytes), nullptr, GL_STREAM_DRAW);
+        void* mapped = gl.MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<ptrdiff_t>(bytes),
+                                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped) {
+            std::memcpy(mapped, source, bytes);
+            gl.UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        } else {
+            // Fall back to a plain client-memory upload
+            gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            pixels = source;
+        }
+
+        GLenum faceTarget = request.cubemap ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + static_cast<GLenum>(request.face)
+                                            : GL_TEXTURE_2D;
+        gl.TexSubImage2D(faceTarget, 0, 0, request.row, image.width, rows, formatForChannels(image.channels),
+                         GL_UNSIGNED_BYTE, pixels);
+        gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        request.row += rows;
+        uploadedBytes_ += bytes;
+        budget -= std::min(budget, bytes);
+
+        if (request.row == image.height) {
+            image.pixels.reset();
+            request.row = 0;
+            if (++request.face == request.faces.size()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void TextureStreamer::uploadCompressed(Request& request, size_t& budget) {
+    // Blocks are already GPU-ready and a fraction of the decoded size, so the
+    // whole chain goes up at once and is charged against the budget afterwards
+    CompressedTexture merged;
+    for (const auto& face : request.compressedFaces) {
+        if (!merged.appendFaces(face)) {
+            spdlog::warn("Keeping placeholder for {}", request.paths.front());
+            return;
+        }
+    }
+
+    request.staged = std::make_unique<Texture>();
+    if (!request.staged->loadFromCompressed(merged)) {
+        request.staged.reset();
+        spdlog::warn("Keeping placeholder for {}", request.paths.front());
+        return;
+    }
+
+    uploadedBytes_ += merged.getDataSize();
+    budget -= std::min(budget, merged.getDataSize());
+    deliver(request);
+}
+
+void TextureStreamer::deliver(Request& request) {
+    Texture& staged = *request.staged;
+    if (!request.cubemap && !request.compressed) {
+        // Same sampling setup as Texture::loadFromFile
+        staged.generateMipmaps();
+        staged.setWrapMode(GL_REPEAT, GL_REPEAT);
+        staged.setFilterMode(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+    }
+
+    spdlog::info("Streamed {}: {} ({}x{}, {} channels{})", request.cubemap ? "cubemap" : "texture",
+                 request.paths.front(), staged.getWidth(), staged.getHeight(), staged.getChannels(),
+                 request.compressed ? ", compressed" : "");
+
+    // Replaces and frees the placeholder
+    *request.target = std::move(staged);
+    request.staged.reset();
+}
+
+} // namespace Core
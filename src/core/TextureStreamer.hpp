@@ -0,0 +1,126 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class WorkerThread;
+
+namespace Core {
+
+class Texture;
+
+/**
+ * @brief Loads textures in the background and uploads them in bounded slices
+ *
+ * Image files are decoded on a pool of worker threads; cubemap faces decode
+ * in parallel. Uploads read straight from the decoder's buffer, which is freed
+ * once its last row is on the GPU. Requested textures show a 1x1
+ * white placeholder until their pixels are on the GPU. Once per frame,
+ * update() streams at most the upload budget through a small ring of pixel
+ * unpack buffers with glTexSubImage2D, so a large image is spread over
+ * several frames instead of stalling one. When every file of a request has
+ * an offline-compressed .atex sibling and the context supports it, the
+ * workers read that instead and the whole mip chain is uploaded in one go.
+ *
+ * Requests and update() must be made on the thread owning the OpenGL context,
+ * and target textures must outlive the streamer or their delivery.
+ */
+class TextureStreamer {
+public:
+    /**
+     * @brief Start the decode threads
+     * @param decodeThreads Number of decode threads
+     * @param uploadBudgetBytes Maximum bytes uploaded per update() call
+     */
+    TextureStreamer(int decodeThreads, size_t uploadBudgetBytes);
+    ~TextureStreamer();
+
+    // Non-copyable, non-movable
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+    TextureStreamer(TextureStreamer&&) = delete;
+    TextureStreamer& operator=(TextureStreamer&&) = delete;
+
+    /**
+     * @brief Queue a 2D texture; the target gets a placeholder until it is ready
+     * @param target Texture receiving the image
+     * @param filepath Image file
+     */
+    void loadTexture(Texture& target, const std::string& filepath);
+
+    /**
+     * @brief Queue a cubemap; the target gets a placeholder until it is ready
+     * @param target Texture receiving the cubemap
+     * @param faces Six image files in +X, -X, +Y, -Y, +Z, -Z order
+     */
+    void loadCubemap(Texture& target, const std::vector<std::string>& faces);
+
+    /**
+     * @brief Upload decoded images within the per-frame budget
+     */
+    void update();
+
+    /**
+     * @brief Block until every queued texture has been decoded and uploaded
+     */
+    void finish();
+
+    /**
+     * @brief Get the number of textures not yet delivered
+     * @return size_t Textures decoding or uploading
+     */
+    size_t getPendingCount() const { return pending_; }
+
+    /**
+     * @brief Get the total number of bytes uploaded so far
+     * @return size_t Uploaded bytes, compressed textures counted at their block size
+     */
+    size_t getUploadedBytes() const { return uploadedBytes_; }
+
+private:
+    static constexpr size_t UPLOAD_BUFFERS = 3;
+
+    struct ImageDeleter {
+        void operator()(uint8_t* pixels) const;
+    };
+
+    struct Image {
+        std::unique_ptr<uint8_t, ImageDeleter> pixels;  // Decoded by stb_image, rows bottom-up for 2D textures
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+    };
+
+    struct Request;
+
+    void submitDecode(const std::shared_ptr<Request>& request, size_t face);
+    void decode(const std::shared_ptr<Request>& request, size_t face);
+    void upload(size_t budget);
+    bool beginUpload(Request& request);
+    bool uploadSlice(Request& request, size_t& budget);
+    void uploadCompressed(Request& request, size_t& budget);
+    void deliver(Request& request);
+
+    size_t uploadBudgetBytes_;
+    bool compressedSupported_;
+    size_t pending_;
+    size_t uploadedBytes_;
+
+    std::array<unsigned int, UPLOAD_BUFFERS> uploadBuffers_;
+    size_t nextUploadBuffer_;
+
+    std::deque<std::shared_ptr<Request>> uploads_;  // Render thread only
+
+    std::mutex mutex_;
+    std::deque<std::shared_ptr<Request>> decoded_;  // Filled by decode threads
+
+    std::vector<std::unique_ptr<WorkerThread>> decoders_;  // Declared last: joined before the queues go away
+    size_t nextDecoder_;
+};
+
+} // namespace Core
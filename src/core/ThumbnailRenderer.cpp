@@ -0,0 +1,189 @@
+#include "ThumbnailRenderer.hpp"
+#include "PngWriter.hpp"
+#include "WorkerThread.hpp"
+#include "GLApi.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+ThumbnailRenderer::ThumbnailRenderer(int width, int height, const std::string& outputDirectory, int encoderThreads)
+    : width_(width)
+    , height_(height)
+    , outputDirectory_(outputDirectory)
+    , valid_(false)
+    , framebuffer_(0)
+    , colorBuffer_(0)
+    , depthBuffer_(0)
+    , nextSlot_(0)
+    , nextEncoder_(0)
+    , imagesWritten_(0)
+{
+    if (!GLApi::isLoaded() || width_ <= 0 || height_ <= 0) {
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(outputDirectory_, error);
+    if (error) {
+        spdlog::error("Failed to create thumbnail directory {}: {}", outputDirectory_, error.message());
+        return;
+    }
+
+    gl.GenRenderbuffers(1, &colorBuffer_);
+    gl.BindRenderbuffer(GL_RENDERBUFFER, colorBuffer_);
+    gl.RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width_, height_);
+    gl.GenRenderbuffers(1, &depthBuffer_);
+    gl.BindRenderbuffer(GL_RENDERBUFFER, depthBuffer_);
+    gl.RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width_, height_);
+    gl.BindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    gl.GenFramebuffers(1, &framebuffer_);
+    gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer_);
+    gl.FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer_);
+    GLenum status = gl.CheckFramebufferStatus(GL_FRAMEBUFFER);
+    gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        spdlog::error("Thumbnail framebuffer is incomplete (status 0x{:X})", status);
+        return;
+    }
+
+    const ptrdiff_t frameBytes = static_cast<ptrdiff_t>(width_) * height_ * 4;
+    for (auto& slot : slots_) {
+        gl.GenBuffers(1, &slot.buffer);
+        gl.BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+        gl.BufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+    }
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    encoderThreads = std::max(encoderThreads, 1);
+    for (int i = 0; i < encoderThreads; ++i) {
+        encoders_.push_back(std::make_unique<WorkerThread>("png-encoder-" + std::to_string(i)));
+    }
+
+    valid_ = true;
+    spdlog::info("Thumbnail renderer ready: {}x{}, {} encoder threads, output to {}",
+                 width_, height_, encoderThreads, outputDirectory_);
+}
+
+ThumbnailRenderer::~ThumbnailRenderer() {
+    finish();
+
+    for (auto& slot : slots_) {
+        if (slot.buffer) {
+            gl.DeleteBuffers(1, &slot.buffer);
+        }
+    }
+    if (framebuffer_) {
+        gl.DeleteFramebuffers(1, &framebuffer_);
+    }
+    if (colorBuffer_) {
+        gl.DeleteRenderbuffers(1, &colorBuffer_);
+    }
+    if (depthBuffer_) {
+        gl.DeleteRenderbuffers(1, &depthBuffer_);
+    }
+}
+
+void ThumbnailRenderer::beginFrame() {
+    if (!valid_) return;
+
+    gl.BindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    gl.Viewport(0, 0, width_, height_);
+}
+
+void ThumbnailRenderer::endFrame(int seed) {
+    if (!valid_) return;
+
+    // Reuse the oldest slot; its fence has had READBACK_SLOTS - 1 frames to signal
+    ReadbackSlot& slot = slots_[nextSlot_];
+    nextSlot_ = (nextSlot_ + 1) % READBACK_SLOTS;
+    harvest(slot);
+
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    gl.PixelStorei(GL_PACK_ALIGNMENT, 1);
+    gl.ReadPixels(0, 0, width_, height_, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = gl.FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.seed = seed;
+
+    gl.BindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void ThumbnailRenderer::finish() {
+    if (!valid_) return;
+
+    // Harvest in submission order so files appear in seed order
+    for (size_t i = 0; i < READBACK_SLOTS; ++i) {
+        harvest(slots_[(nextSlot_ + i) % READBACK_SLOTS]);
+    }
+    for (auto& encoder : encoders_) {
+        encoder->flush();
+    }
+}
+
+void ThumbnailRenderer::harvest(ReadbackSlot& slot) {
+    if (!slot.fence) return;
+
+    // A hung or lost context must not stall an unattended batch, so give up after a while
+    const uint64_t timeoutNs = 1000000000ull;
+    GLenum result = gl.ClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+    for (int retry = 1; retry < MAX_READBACK_WAITS && result == GL_TIMEOUT_EXPIRED; ++retry) {
+        result = gl.ClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+    }
+    gl.DeleteSync(slot.fence);
+    slot.fence = nullptr;
+    if (result == GL_TIMEOUT_EXPIRED) {
+        spdlog::error("Thumbnail readback of seed {} did not finish within {} s, skipping it", slot.seed, MAX_READBACK_WAITS);
+        return;
+    }
+    if (result == GL_WAIT_FAILED) {
+        spdlog::error("Waiting for thumbnail readback of seed {} failed", slot.seed);
+        return;
+    }
+
+    const size_t frameBytes = static_cast<size_t>(width_) * height_ * 4;
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const void* mapped = gl.MapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<ptrdiff_t>(frameBytes), GL_MAP_READ_BIT);
+    if (mapped) {
+        std::vector<uint8_t> pixels(frameBytes);
+        std::memcpy(pixels.data(), mapped, frameBytes);
+        gl.UnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        encode(std::move(pixels), slot.seed);
+    } else {
+        spdlog::error("Failed to map thumbnail readback buffer for seed {}", slot.seed);
+    }
+    gl.BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void ThumbnailRenderer::encode(std::vector<uint8_t> pixels, int seed) {
+    WorkerThread& encoder = *encoders_[nextEncoder_];
+    nextEncoder_ = (nextEncoder_ + 1) % encoders_.size();
+
+    // Keep memory bounded when encoding can't keep up with rendering
+    if (encoder.getPendingCount() >= MAX_PENDING_PER_ENCODER) {
+        encoder.flush();
+    }
+
+    std::string filename = (std::filesystem::path(outputDirectory_) / ("system_" + std::to_string(seed) + ".png")).string();
+    const int width = width_;
+    const int height = height_;
+    encoder.submit([pixels = std::move(pixels), filename = std::move(filename), width, height]() {
+        // GL rows are bottom-up; PNG wants top row first and no alpha
+        std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+        for (int y = 0; y < height; ++y) {
+            const uint8_t* src = pixels.data() + static_cast<size_t>(height - 1 - y) * width * 4;
+            uint8_t* dst = rgb.data() + static_cast<size_t>(y) * width * 3;
+            for (int x = 0; x < width; ++x) {
+                dst[x * 3 + 0] = src[x * 4 + 0];
+                dst[x * 3 + 1] = src[x * 4 + 1];
+                dst[x * 3 + 2] = src[x * 4 + 2];
+            }
+        }
+        if (!PngWriter::write(filename, rgb.data(), width, height, 3)) {
+            spdlog::error("Failed to write thumbnail {}", filename);
+        }
+    });
+    ++imagesWritten_;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class WorkerThread;
+
+/**
+ * @brief Renders into an offscreen framebuffer and writes each frame as a PNG
+ *
+ * Frames are read back asynchronously: glReadPixels targets one of a small
+ * ring of pixel pack buffers and a fence marks when the copy is done, so the
+ * CPU only maps a buffer once the GPU has moved on to later frames. The
+ * mapped pixels are handed to encoder threads, which flip, convert and write
+ * the PNG files while the next seeds are being generated and rendered.
+ *
+ * Requires a current OpenGL context for its whole lifetime.
+ */
+class ThumbnailRenderer {
+public:
+    /**
+     * @brief Create the framebuffer, readback buffers and encoder threads
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param outputDirectory Directory receiving system_<seed>.png files (created if missing)
+     * @param encoderThreads Number of PNG encoder threads
+     */
+    ThumbnailRenderer(int width, int height, const std::string& outputDirectory, int encoderThreads);
+    ~ThumbnailRenderer();
+
+    // Non-copyable, non-movable
+    ThumbnailRenderer(const ThumbnailRenderer&) = delete;
+    ThumbnailRenderer& operator=(const ThumbnailRenderer&) = delete;
+    ThumbnailRenderer(ThumbnailRenderer&&) = delete;
+    ThumbnailRenderer& operator=(ThumbnailRenderer&&) = delete;
+
+    /**
+     * @brief Check if the framebuffer and output directory are usable
+     * @return true if frames can be rendered
+     */
+    bool isValid() const { return valid_; }
+
+    /**
+     * @brief Bind the offscreen framebuffer and set the viewport
+     */
+    void beginFrame();
+
+    /**
+     * @brief Start the readback of the rendered frame and unbind the framebuffer
+     * @param seed Seed of the rendered system, used for the file name
+     */
+    void endFrame(int seed);
+
+    /**
+     * @brief Wait for every outstanding readback and PNG write
+     */
+    void finish();
+
+    int getWidth() const { return width_; }
+    int getHeight() const { return height_; }
+    size_t getImagesWritten() const { return imagesWritten_; }
+
+private:
+    static constexpr size_t READBACK_SLOTS = 3;
+    static constexpr size_t MAX_PENDING_PER_ENCODER = 4;
+    static constexpr int MAX_READBACK_WAITS = 10; // One-second fence waits before a readback is given up
+
+    struct ReadbackSlot {
+        unsigned int buffer = 0;
+        void* fence = nullptr;
+        int seed = 0;
+    };
+
+    void harvest(ReadbackSlot& slot);
+    void encode(std::vector<uint8_t> pixels, int seed);
+
+    int width_;
+    int height_;
+    std::string outputDirectory_;
+    bool valid_;
+
+    unsigned int framebuffer_;
+    unsigned int colorBuffer_;
+    unsigned int depthBuffer_;
+    std::array<ReadbackSlot, READBACK_SLOTS> slots_;
+    size_t nextSlot_;
+
+    std::vector<std::unique_ptr<WorkerThread>> encoders_;
+    size_t nextEncoder_;
+    size_t imagesWritten_;
+};
@@ -1,28 +1,35 @@
 #include "Window.hpp"
+#include "GLApi.hpp"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
-Window::Window(int width, int height, const std::string& title) {
-    // Initialize GLFW
-    if (!glfwInit()) {
-        throw std::runtime_error("Failed to initialize GLFW!");
+Window::Window(int width, int height, const std::string& title, Surface surface) {
+    if (surface == Surface::Headless) {
+        window_ = createHeadlessWindow(width, height, title);
+        if (!window_) {
+            spdlog::warn("No headless OpenGL context available, falling back to a hidden window");
+        }
     }
     
-    // Set OpenGL version (3.3 Core)
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-    
-    // Additional hints
-    glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
-    glfwWindowHint(GLFW_SAMPLES, 4); // 4x MSAA
-    
-    // Create window
-    window_ = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
     if (!window_) {
-        glfwTerminate();
-        throw std::runtime_error("Failed to create GLFW window!");
+        // Initialize GLFW
+        if (!glfwInit()) {
+            throw std::runtime_error("Failed to initialize GLFW!");
+        }
+        
+        setContextHints();
+        
+        // Additional hints
+        glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+        glfwWindowHint(GLFW_SAMPLES, 4); // 4x MSAA
+        glfwWindowHint(GLFW_VISIBLE, surface == Surface::Visible ? GLFW_TRUE : GLFW_FALSE);
+        
+        // Create window
+        window_ = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+        if (!window_) {
+            glfwTerminate();
+            throw std::runtime_error("Failed to create GLFW window!");
+        }
     }
     
     // Make context current
@@ -40,6 +47,48 @@ Window::Window(int width, int height, const std::string& title) {
     spdlog::info("Window created: {}x{}", width, height);
 }
 
+void Window::setContextHints() {
+    // Set OpenGL version (3.3 Core)
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+}
+
+GLFWwindow* Window::createHeadlessWindow(int width, int height, const std::string& title) {
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4)
+    // The null platform needs no display server; the context comes from OSMesa or surfaceless EGL
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    bool initialized = glfwInit() == GLFW_TRUE;
+    glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+    if (!initialized) {
+        return nullptr;
+    }
+    
+    for (int contextApi : {GLFW_OSMESA_CONTEXT_API, GLFW_EGL_CONTEXT_API}) {
+        glfwDefaultWindowHints();
+        setContextHints();
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, contextApi);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        
+        GLFWwindow* window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+        if (window) {
+            spdlog::info("Created headless {} context", contextApi == GLFW_OSMESA_CONTEXT_API ? "OSMesa" : "EGL");
+            return window;
+        }
+    }
+    
+    glfwDefaultWindowHints();
+    glfwTerminate();
+    return nullptr;
+#else
+    (void)width;
+    (void)height;
+    (void)title;
+    return nullptr;
+#endif
+}
+
 Window::~Window() {
     if (window_) {
         glfwDestroyWindow(window_);
@@ -59,6 +108,10 @@ void Window::swapBuffers() {
     glfwSwapBuffers(window_);
 }
 
+void Window::setVSync(bool enabled) {
+    glfwSwapInterval(enabled ? 1 : 0);
+}
+
 bool Window::isKeyPressed(int key) const {
     return glfwGetKey(window_, key) == GLFW_PRESS;
 }
@@ -115,7 +168,9 @@ void Window::setCursorPosCallback(std::function<void(double, double)> callback)
 
 // Static callback functions
 void Window::framebufferSizeCallback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    if (GLApi::isLoaded()) {
+        gl.Viewport(0, 0, width, height);
+    }
     
     Window* win = static_cast<Window*>(glfwGetWindowUserPointer(window));
     if (win && win->resizeCallback_) {
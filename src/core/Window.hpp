@@ -6,7 +6,13 @@
 
 class Window {
 public:
-    Window(int width, int height, const std::string& title);
+    enum class Surface {
+        Visible,
+        Hidden,     // Invisible window on the regular window system
+        Headless    // No window system (OSMesa/EGL on GLFW's null platform), falls back to Hidden
+    };
+
+    Window(int width, int height, const std::string& title, Surface surface = Surface::Visible);
     ~Window();
 
     // Non-copyable, non-movable
@@ -19,6 +25,7 @@ public:
     bool shouldClose() const;
     void pollEvents();
     void swapBuffers();
+    void setVSync(bool enabled);
     
     // Get GLFW window pointer (for InputManager)
     GLFWwindow* getGLFWwindow() const { return window_; }
@@ -42,6 +49,9 @@ public:
     void setCursorPosCallback(std::function<void(double, double)> callback);
 
 private:
+    static void setContextHints();
+    static GLFWwindow* createHeadlessWindow(int width, int height, const std::string& title);
+
     static void framebufferSizeCallback(GLFWwindow* window, int width, int height);
     static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
     static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
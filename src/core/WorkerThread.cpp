@@ -0,0 +1,64 @@
+#include "WorkerThread.hpp"
+#include <spdlog/spdlog.h>
+
+WorkerThread::WorkerThread(const std::string& name)
+    : name_(name)
+    , busy_(false)
+    , stopping_(false)
+    , thread_(&WorkerThread::run, this) {
+}
+
+WorkerThread::~WorkerThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+}
+
+void WorkerThread::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    wake_.notify_one();
+}
+
+void WorkerThread::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return jobs_.empty() && !busy_; });
+}
+
+size_t WorkerThread::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size() + (busy_ ? 1 : 0);
+}
+
+void WorkerThread::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+        if (jobs_.empty()) {
+            // Only reached when stopping with nothing left to do
+            break;
+        }
+
+        std::function<void()> job = std::move(jobs_.front());
+        jobs_.pop_front();
+        busy_ = true;
+        lock.unlock();
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            spdlog::error("{} worker job failed: {}", name_, e.what());
+        }
+
+        lock.lock();
+        busy_ = false;
+        if (jobs_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
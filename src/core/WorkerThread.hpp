@@ -0,0 +1,60 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Single background thread running queued jobs in submission order
+ *
+ * Used to keep blocking work such as file I/O off the render thread. Jobs
+ * that throw are logged and dropped. The destructor finishes every queued
+ * job before joining, so work submitted before shutdown is never lost.
+ */
+class WorkerThread {
+public:
+    /**
+     * @brief Start the worker
+     * @param name Name used in log messages
+     */
+    explicit WorkerThread(const std::string& name);
+    ~WorkerThread();
+
+    // Non-copyable, non-movable
+    WorkerThread(const WorkerThread&) = delete;
+    WorkerThread& operator=(const WorkerThread&) = delete;
+    WorkerThread(WorkerThread&&) = delete;
+    WorkerThread& operator=(WorkerThread&&) = delete;
+
+    /**
+     * @brief Queue a job
+     * @param job Work to run on the worker thread
+     */
+    void submit(std::function<void()> job);
+
+    /**
+     * @brief Block until every queued job has finished
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of jobs queued or running
+     * @return size_t Pending job count
+     */
+    size_t getPendingCount() const;
+
+private:
+    void run();
+
+    std::string name_;
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<std::function<void()>> jobs_;
+    bool busy_;
+    bool stopping_;
+    std::thread thread_;  // Started last, after every member it uses
+};
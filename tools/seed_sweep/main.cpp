@@ -0,0 +1,287 @@
+#include "core/SystemGenerator.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Fixed-width histogram with under/overflow bins, or a categorical one when labels are given
+ */
+class Histogram {
+public:
+    Histogram(std::string name, double lower, double width, size_t binCount)
+        : name_(std::move(name))
+        , lower_(lower)
+        , width_(width)
+        , bins_(binCount, 0) {
+    }
+
+    Histogram(std::string name, std::vector<std::string> labels)
+        : name_(std::move(name))
+        , lower_(0.0)
+        , width_(1.0)
+        , labels_(std::move(labels))
+        , bins_(labels_.size(), 0) {
+    }
+
+    void add(double value) {
+        double bin = (value - lower_) / width_;
+        if (bin < 0.0) {
+            ++underflow_;
+        } else if (bin >= static_cast<double>(bins_.size())) {
+            ++overflow_;
+        } else {
+            ++bins_[static_cast<size_t>(bin)];
+        }
+    }
+
+    void merge(const Histogram& other) {
+        for (size_t i = 0; i < bins_.size(); ++i) {
+            bins_[i] += other.bins_[i];
+        }
+        underflow_ += other.underflow_;
+        overflow_ += other.overflow_;
+    }
+
+    void writeCsv(std::ostream& out) const {
+        if (underflow_ > 0) {
+            out << name_ << ",underflow,," << lower_ << ',' << underflow_ << '\n';
+        }
+        for (size_t i = 0; i < bins_.size(); ++i) {
+            if (!labels_.empty()) {
+                out << name_ << ',' << labels_[i] << ",,," << bins_[i] << '\n';
+            } else {
+                double from = lower_ + width_ * static_cast<double>(i);
+                out << name_ << ',' << i << ',' << from << ',' << from + width_ << ',' << bins_[i] << '\n';
+            }
+        }
+        if (overflow_ > 0) {
+            out << name_ << ",overflow," << lower_ + width_ * static_cast<double>(bins_.size()) << ",," << overflow_ << '\n';
+        }
+    }
+
+private:
+    std::string name_;
+    double lower_;
+    double width_;
+    std::vector<std::string> labels_;
+    std::vector<uint64_t> bins_;
+    uint64_t underflow_ = 0;
+    uint64_t overflow_ = 0;
+};
+
+/**
+ * @brief Statistics gathered by one worker, merged once at the end
+ */
+struct SweepStats {
+    enum Id {
+        PlanetType,
+        PlanetRadius,
+        RockyRadius,
+        GasRadius,
+        IceRadius,
+        DesertRadius,
+        OrbitDistance,
+        MoonsPerPlanet,
+        MoonsPerSystem,
+        PlacementAttempts,
+        PlacementFailures,
+        SunRadius,
+        AsteroidBelts,
+        AsteroidsPerBelt,
+        RingSystems
+    };
+
+    explicit SweepStats(int planetCount) {
+        const size_t planets = static_cast<size_t>(planetCount);
+        histograms.emplace_back("planet_type", std::vector<std::string>{"rocky", "gas", "ice", "desert"});
+        histograms.emplace_back("planet_radius", 0.0, 0.5, 40);
+        histograms.emplace_back("planet_radius_rocky", 0.0, 0.5, 40);
+        histograms.emplace_back("planet_radius_gas", 0.0, 0.5, 40);
+        histograms.emplace_back("planet_radius_ice", 0.0, 0.5, 40);
+        histograms.emplace_back("planet_radius_desert", 0.0, 0.5, 40);
+        histograms.emplace_back("planet_orbit_distance", 0.0, 5.0, 30);
+        histograms.emplace_back("moons_per_planet", 0.0, 1.0, 5);
+        histograms.emplace_back("moons_per_system", 0.0, 1.0, planets * 4 + 1);
+        histograms.emplace_back("placement_attempts", 1.0, 1.0, 50);
+        histograms.emplace_back("placement_failures", 0.0, 1.0, planets + 1);
+        histograms.emplace_back("sun_radius", 12.0, 0.25, 16);
+        histograms.emplace_back("asteroid_belts", 0.0, 1.0, 4);
+        histograms.emplace_back("asteroids_per_belt", 200.0, 50.0, 13);
+        histograms.emplace_back("ring_systems", 0.0, 1.0, 4);
+    }
+
+    void add(const SystemLayout& layout) {
+        histograms[SunRadius].add(layout.sun.radius);
+        histograms[PlacementFailures].add(layout.placementFailures);
+        failures += static_cast<uint64_t>(layout.placementFailures);
+
+        size_t moons = 0;
+        for (const auto& planet : layout.planets) {
+            histograms[PlanetType].add(planet.type);
+            histograms[PlanetRadius].add(planet.radius);
+            if (planet.type >= 0 && planet.type <= 3) {
+                histograms[RockyRadius + planet.type].add(planet.radius);
+            }
+            histograms[OrbitDistance].add(glm::length(planet.position));
+            histograms[MoonsPerPlanet].add(static_cast<double>(planet.moons.size()));
+            histograms[PlacementAttempts].add(planet.attempts);
+            moons += planet.moons.size();
+        }
+        histograms[MoonsPerSystem].add(static_cast<double>(moons));
+        planets += layout.planets.size();
+
+        histograms[AsteroidBelts].add(static_cast<double>(layout.belts.size()));
+        for (const auto& belt : layout.belts) {
+            histograms[AsteroidsPerBelt].add(belt.asteroidCount);
+        }
+        histograms[RingSystems].add(static_cast<double>(layout.rings.size()));
+        ++systems;
+    }
+
+    void merge(const SweepStats& other) {
+        for (size_t i = 0; i < histograms.size(); ++i) {
+            histograms[i].merge(other.histograms[i]);
+        }
+        systems += other.systems;
+        planets += other.planets;
+        failures += other.failures;
+    }
+
+    std::vector<Histogram> histograms;
+    uint64_t systems = 0;
+    uint64_t planets = 0;
+    uint64_t failures = 0;
+};
+
+struct Options {
+    int64_t firstSeed = 0;
+    int64_t count = 1000000;
+    int planetCount = 8;
+    int threads = 0; // 0 uses every hardware thread
+    std::string output = "seed_sweep.csv";
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        try {
+            if (arg == "--first" && hasValue) {
+                options.firstSeed = std::stoll(argv[++i]);
+            } else if (arg == "--count" && hasValue) {
+                options.count = std::stoll(argv[++i]);
+            } else if (arg == "--planets" && hasValue) {
+                options.planetCount = std::stoi(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                options.threads = std::stoi(argv[++i]);
+            } else if (arg == "--output" && hasValue) {
+                options.output = argv[++i];
+            } else {
+                std::cout << "Seed sweep: generation statistics over a range of system seeds\n";
+                std::cout << "Usage: " << argv[0] << " [options]\n";
+                std::cout << "Options:\n";
+                std::cout << "  --first <seed>    First system seed (default: 0)\n";
+                std::cout << "  --count <n>       Number of seeds (default: 1000000)\n";
+                std::cout << "  --planets <n>     Planets requested per system (default: 8)\n";
+                std::cout << "  --threads <n>     Worker threads (default: all cores)\n";
+                std::cout << "  --output <file>   Histogram CSV (default: seed_sweep.csv)\n";
+                return false;
+            }
+        }
+        catch (const std::exception&) {
+            spdlog::error("Invalid value for {}: {}", arg, argv[i]);
+            return false;
+        }
+    }
+
+    if (options.count <= 0 || options.planetCount < 0 || options.planetCount > 64) {
+        spdlog::error("Seed count must be positive and planets between 0 and 64");
+        return false;
+    }
+    if (options.firstSeed < std::numeric_limits<int>::min() ||
+        options.firstSeed + options.count - 1 > std::numeric_limits<int>::max()) {
+        spdlog::error("Seed range must fit in a 32-bit int");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    int threadCount = options.threads > 0 ? options.threads
+                                          : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    spdlog::info("Sweeping {} seeds from {} with {} planets on {} threads",
+                 options.count, options.firstSeed, options.planetCount, threadCount);
+
+    // Workers claim chunks of seeds so uneven placement costs balance out
+    constexpr int64_t CHUNK_SIZE = 4096;
+    std::atomic<int64_t> nextSeed{options.firstSeed};
+    const int64_t endSeed = options.firstSeed + options.count;
+
+    std::vector<SweepStats> stats(static_cast<size_t>(threadCount), SweepStats(options.planetCount));
+    std::vector<std::thread> workers;
+    auto startTime = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&, t]() {
+            SweepStats& local = stats[static_cast<size_t>(t)];
+            for (;;) {
+                int64_t begin = nextSeed.fetch_add(CHUNK_SIZE);
+                if (begin >= endSeed) {
+                    break;
+                }
+                int64_t end = std::min(begin + CHUNK_SIZE, endSeed);
+                for (int64_t seed = begin; seed < end; ++seed) {
+                    local.add(SystemGenerator::generate(static_cast<int>(seed), options.planetCount));
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    SweepStats total(options.planetCount);
+    for (const auto& local : stats) {
+        total.merge(local);
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::ofstream file(options.output, std::ios::trunc);
+    if (!file.is_open()) {
+        spdlog::error("Failed to write {}", options.output);
+        return 1;
+    }
+    file << "histogram,bin,lower,upper,count\n";
+    for (const auto& histogram : total.histograms) {
+        histogram.writeCsv(file);
+    }
+    if (!file.good()) {
+        spdlog::error("Failed to write {}", options.output);
+        return 1;
+    }
+
+    uint64_t requested = total.systems * static_cast<uint64_t>(options.planetCount);
+    spdlog::info("Swept {} systems in {:.2f} s ({:.0f} seeds/s): {} planets, {} placement failures ({:.3f}%) -> {}",
+                 total.systems, elapsed, elapsed > 0.0 ? static_cast<double>(total.systems) / elapsed : 0.0,
+                 total.planets, total.failures,
+                 requested > 0 ? 100.0 * static_cast<double>(total.failures) / static_cast<double>(requested) : 0.0,
+                 options.output);
+    return 0;
+}
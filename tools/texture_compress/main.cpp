@@ -0,0 +1,142 @@
+#include "core/CompressedTexture.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb/stb_image.h>
+
+namespace {
+
+enum class FormatChoice {
+    Auto,
+    BC1,
+    BC3
+};
+
+struct Options {
+    std::vector<std::string> inputs;
+    std::string output;  // Only with a single input; defaults to the .atex sibling
+    FormatChoice format = FormatChoice::Auto;
+    bool flip = true;    // 2D textures are stored bottom-up; cubemap faces are not
+};
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--format" && hasValue) {
+            std::string value = argv[++i];
+            if (value == "auto") {
+                options.format = FormatChoice::Auto;
+            } else if (value == "bc1") {
+                options.format = FormatChoice::BC1;
+            } else if (value == "bc3") {
+                options.format = FormatChoice::BC3;
+            } else {
+                spdlog::error("Unknown format: {}", value);
+                return false;
+            }
+        } else if (arg == "--output" && hasValue) {
+            options.output = argv[++i];
+        } else if (arg == "--no-flip") {
+            options.flip = false;
+        } else if (!arg.empty() && arg[0] != '-') {
+            options.inputs.push_back(arg);
+        } else {
+            std::cout << "Texture compress: convert images to block-compressed .atex files with mipmaps\n";
+            std::cout << "Usage: " << argv[0] << " [options] <image>...\n";
+            std::cout << "Options:\n";
+            std::cout << "  --format <f>      bc1, bc3 or auto: bc3 only if the image has alpha (default: auto)\n";
+            std::cout << "  --output <file>   Output for a single image (default: image path with .atex)\n";
+            std::cout << "  --no-flip         Keep rows top-down, for cubemap faces\n";
+            return false;
+        }
+    }
+
+    if (options.inputs.empty()) {
+        spdlog::error("No input images");
+        return false;
+    }
+    if (!options.output.empty() && options.inputs.size() > 1) {
+        spdlog::error("--output needs exactly one input image");
+        return false;
+    }
+    return true;
+}
+
+CompressedTexture::Format chooseFormat(FormatChoice choice, const uint8_t* rgba, size_t pixelCount) {
+    switch (choice) {
+        case FormatChoice::BC1: return CompressedTexture::Format::BC1;
+        case FormatChoice::BC3: return CompressedTexture::Format::BC3;
+        case FormatChoice::Auto: break;
+    }
+    for (size_t i = 0; i < pixelCount; ++i) {
+        if (rgba[i * 4 + 3] != 255) {
+            return CompressedTexture::Format::BC3;
+        }
+    }
+    return CompressedTexture::Format::BC1;
+}
+
+bool compressImage(const std::string& input, const std::string& output, const Options& options) {
+    stbi_set_flip_vertically_on_load(options.flip ? 1 : 0);
+
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* data = stbi_load(input.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        spdlog::error("Failed to load {}: {}", input, stbi_failure_reason());
+        return false;
+    }
+
+    const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+    CompressedTexture::Format format = chooseFormat(options.format, data, pixelCount);
+    CompressedTexture texture;
+    bool added = texture.addFace(data, width, height, format);
+    stbi_image_free(data);
+    if (!added || !texture.save(output)) {
+        return false;
+    }
+
+    // Compare with what the engine uploads for the image: RGBA8 plus a full mip chain
+    size_t uncompressedSize = 0;
+    for (int w = width, h = height;; w = std::max(w / 2, 1), h = std::max(h / 2, 1)) {
+        uncompressedSize += static_cast<size_t>(w) * static_cast<size_t>(h) * 4;
+        if (w == 1 && h == 1) {
+            break;
+        }
+    }
+    spdlog::info("{} -> {} ({}x{}, {}, {} levels): {:.1f} KB, {:.1f}:1 vs RGBA8", input, output, width, height,
+                 format == CompressedTexture::Format::BC1 ? "BC1" : "BC3", texture.getLevelCount(),
+                 static_cast<double>(texture.getDataSize()) / 1024.0,
+                 static_cast<double>(uncompressedSize) / static_cast<double>(texture.getDataSize()));
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto& input : options.inputs) {
+        std::string output = options.output.empty() ? CompressedTexture::getPathFor(input) : options.output;
+        if (!compressImage(input, output, options)) {
+            ++failures;
+        }
+    }
+
+    if (failures > 0) {
+        spdlog::error("{} of {} images failed", failures, options.inputs.size());
+        return 1;
+    }
+    return 0;
+}